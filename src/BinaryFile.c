@@ -36,6 +36,8 @@
 #include "FPFC.h"
 #include "App.h"
 #include "RPN.h"
+#include "Dict.h"
+#include "Catalog.h"
 #include <string.h>
 #include <glob.h>
 #include <unistd.h>
@@ -43,9 +45,11 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <errno.h>
+#include <stddef.h>
+#include <pthread.h>
 
 const int32_t BF_MAGIC=0x45454642; //BFEE (Binary File Env. Emergencies) in little endian
-const int32_t BF_VERSION=2;
+const int32_t BF_VERSION=3;      // Version 3 : TOL in field header
 
 static int BFTypeSize[] = {1,1,1,2,4,8,1,2,4,8,4,8,4,8,0};
 
@@ -125,6 +129,9 @@ static TBFFiles* BinaryFile_New(int N) {
    // Initialize the members
    files->N = N;
    files->Flags = 0;
+   files->TolMode = BF_TOL_NONE;
+   files->Tol = 0.0;
+   files->Async = NULL;
 
    // Allocate memory for the files themselves
    if( !(files->Files=malloc(N*sizeof(*files->Files))) ) {
@@ -202,6 +209,7 @@ static TBFFiles* BinaryFile_OpenFiles(const char **FileNames,int N,TBFFlag Mode)
    TBFFile  *restrict file;
    struct stat statbuf;
    int      i,mode,mmode;
+   size_t   hsize;
 
    // If memory was not allocated, abort
    if( !files ) {
@@ -296,8 +304,8 @@ static TBFFiles* BinaryFile_OpenFiles(const char **FileNames,int N,TBFFlag Mode)
             goto error;
          }
 
-         // Make sure we will have the right binary offsets
-         if( file->Header.FSize!=sizeof(TBFFileHeader) || file->Header.HSize!=sizeof(TBFFldHeader) ) {
+         // Make sure we will have the right binary offsets (older field headers, without TOL, are expanded when read)
+         if( file->Header.FSize!=sizeof(TBFFileHeader) || file->Header.HSize>sizeof(TBFFldHeader) || file->Header.HSize<offsetof(TBFFldHeader,TOL) ) {
             Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: This library is incompatible with this BinaryFile (%s) FileHeader is %d bytes (library: %d) and the FldHeader is %u bytes (library: %d).\n",
                   FileNames[i],file->Header.FSize,sizeof(TBFFileHeader),file->Header.HSize,sizeof(TBFFldHeader));
             goto error;
@@ -327,14 +335,24 @@ static TBFFiles* BinaryFile_OpenFiles(const char **FileNames,int N,TBFFlag Mode)
          }
 
          // Read the index
+         hsize = file->Header.HSize;
          if( Mode&BF_WRITE ) {
             // iUse pread to prevent moving the position of the cursor in the file
-            if( pread(file->FD,file->Index.Headers,sizeof(*file->Index.Headers)*file->Index.N,file->Header.IOffset+sizeof(file->Index.N))!=sizeof(*file->Index.Headers)*file->Index.N ) {
+            if( pread(file->FD,file->Index.Headers,hsize*file->Index.N,file->Header.IOffset+sizeof(file->Index.N))!=hsize*file->Index.N ) {
                Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Problem reading index for file %s : %s\n",FileNames[i],strerror(errno));
                goto error;
             }
          } else {
-            memcpy(file->Index.Headers,AddrAt(file->Addr,file->Header.IOffset+sizeof(file->Index.N)),sizeof(*file->Index.Headers)*file->Index.N);
+            memcpy(file->Index.Headers,AddrAt(file->Addr,file->Header.IOffset+sizeof(file->Index.N)),hsize*file->Index.N);
+         }
+
+         // Expand the older field headers in place (from the end, since they are smaller)
+         if( hsize!=sizeof(TBFFldHeader) ) {
+            int32_t h;
+            for(h=file->Index.N-1; h>=0; --h) {
+               memmove(&file->Index.Headers[h],AddrAt(file->Index.Headers,h*hsize),hsize);
+               memset(AddrAt(&file->Index.Headers[h],hsize),0,sizeof(TBFFldHeader)-hsize);
+            }
          }
       } else {
          // Write an invalid header as a place holder
@@ -431,6 +449,42 @@ TBFFiles* BinaryFile_LinkPattern(const char* Pattern) {
    return bf;
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_LinkPatternCatalog>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Ouvre et lie les fichiers correspondant au pattern donné en
+ *            mode lecture seulement et retourne leur catalogue
+ *
+ * Parametres :
+ *    <Pattern>   : Le pattern des fichiers à ouvrir et lier.
+ *    <Cat>       : [OUT] Le catalogue des fichiers liés (voir Catalog_Get)
+ *
+ * Retour   : Un pointeur vers les fichiers ouvert
+ *
+ * Remarques :
+ *    - Le catalogue doit être libéré par l'appelant (Catalog_Free)
+ *
+ *----------------------------------------------------------------------------
+ */
+TBFFiles* BinaryFile_LinkPatternCatalog(const char* Pattern,TCatalog **Cat) {
+   // Expand the pattern into a list of files
+   glob_t gfiles = (glob_t){0,NULL,0};
+
+   *Cat = NULL;
+   if( glob(Pattern,0,NULL,&gfiles) || !gfiles.gl_pathc ) {
+      return NULL;
+   }
+
+   TBFFiles *bf = BinaryFile_Link((const char**)gfiles.gl_pathv,(int)gfiles.gl_pathc);
+   if( bf ) {
+      // The index of the opened files is used, they are not reopened
+      *Cat = Catalog_Get((const char**)gfiles.gl_pathv,(int)gfiles.gl_pathc,NULL,bf);
+   }
+   globfree(&gfiles);
+   return bf;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <BinaryFile_Close>
  * Creation : Février 2017 - E. Legault-Ouellet - CMC/CMOE
@@ -454,6 +508,12 @@ int BinaryFile_Close(TBFFiles *Files) {
    if( !Files )
       return APP_ERR;
 
+   // Flush the pending asynchronous writes before writing the index
+   if( BinaryFile_AsyncStop(Files) != APP_OK ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Some fields could not be written\n");
+      code = APP_ERR;
+   }
+
    for(i=0,file=Files->Files; i<Files->N; ++i,++file) {
       // Only write something if something changed
       if( file->Flags&BF_DIRTY ) {
@@ -475,6 +535,8 @@ int BinaryFile_Close(TBFFiles *Files) {
 
          // Update the total file size
          file->Header.Size = file->Header.IOffset+sizeof(file->Index.N)+sizeof(*file->Index.Headers)*file->Index.N;
+         file->Header.Version = BF_VERSION;
+         file->Header.HSize = sizeof(TBFFldHeader);
 
          // Write the file header
          bytes = sizeof(file->Header);
@@ -640,6 +702,485 @@ TBFType BinaryFile_Type(int DaTyp,int NBytes) {
    }
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_SetTolerance>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Définir la tolérance de la compression avec perte des champs
+ *            BF_CFLOAT32 et BF_CFLOAT64
+ *
+ * Parametres :
+ *    <File>   : Le BF dans lequel les champs seront écrits
+ *    <Mode>   : Le mode (BF_TOL_NONE,BF_TOL_ABS,BF_TOL_REL,BF_TOL_DICT)
+ *    <Tol>    : La tolérance (ignorée pour BF_TOL_NONE et BF_TOL_DICT)
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - En mode BF_TOL_DICT, la tolérance absolue est la précision (Precision)
+ *      de la variable dans le dictionnaire, qui doit avoir été chargé
+ *      (Dict_Parse). Les variables sans précision sont compressées sans perte
+ *
+ *----------------------------------------------------------------------------
+ */
+int BinaryFile_SetTolerance(TBFFiles *File,TBFTolMode Mode,double Tol) {
+   if( !File )
+      return APP_ERR;
+
+   if( (Mode==BF_TOL_ABS || Mode==BF_TOL_REL) && !(Tol>0.0) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Invalid compression tolerance (%e), must be positive\n",Tol);
+      return APP_ERR;
+   }
+
+   File->TolMode = Mode;
+   File->Tol = Mode==BF_TOL_ABS || Mode==BF_TOL_REL ? Tol : 0.0;
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_GetTol>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne la tolérance à utiliser pour compresser une variable
+ *
+ * Parametres :
+ *    <File>   : Le BF dans lequel le champ sera écrit
+ *    <NomVar> : Le nom de la variable du champ
+ *
+ * Retour   : La tolérance au format FPFC (>0 absolue, <0 relative, 0 sans perte)
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+static double BinaryFile_GetTol(TBFFiles *File,const char *NomVar) {
+   TDictVar *var;
+   char     nomvar[5]={'\0'};
+
+   switch( File->TolMode ) {
+      case BF_TOL_ABS:  return File->Tol;
+      case BF_TOL_REL:  return -File->Tol;
+      case BF_TOL_DICT:
+         memcpy(nomvar,NomVar,FtnStrSize(NomVar,4));
+         if( (var=Dict_GetVar(nomvar)) && var->Precision!=DICT_NOTSET && var->Precision>0.0 ) {
+            return var->Precision;
+         }
+         return FPFC_LOSSLESS;
+      case BF_TOL_NONE:
+      default:          return FPFC_LOSSLESS;
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_Tolerance>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne la tolérance avec laquelle un champ a été compressé
+ *
+ * Parametres :
+ *    <Key>       : Clé du champ
+ *    <File>      : Handle vers le fichier BF
+ *
+ * Retour   : La tolérance (>0 absolue, <0 relative, 0 sans perte)
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+double BinaryFile_Tolerance(TBFKey Key,TBFFiles *File) {
+   TBFFldHeader *restrict h;
+
+   return (h=BinaryFile_GetHeader(File,Key)) ? h->TOL : 0.0;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_Pack>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Compresser un champ (si son type le demande)
+ *
+ * Parametres :
+ *    <Data>   : Le champ à compresser
+ *    <N>      : Le nombre de valeurs du champ
+ *    <Type>   : [IN/OUT] Le type de donnée (devient non compressé si la compression échoue)
+ *    <Tol>    : [IN/OUT] La tolérance (remise à 0 si la compression échoue)
+ *    <Buf>    : [OUT] Les données compressées (NULL si le champ est écrit tel quel)
+ *    <Size>   : [OUT] La taille (octets) des données à écrire
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - Fonction réentrante, appelée par les threads de compression en mode asynchrone
+ *
+ *----------------------------------------------------------------------------
+ */
+static int BinaryFile_Pack(void *Data,size_t N,TBFType *Type,double *Tol,void **Buf,size_t *Size) {
+   int code;
+
+   *Buf = NULL;
+   *Size = N*BFTypeSize[*Type];
+
+   if( *Type!=BF_CFLOAT32 && *Type!=BF_CFLOAT64 )
+      return APP_OK;
+
+   // Allocate a temporary buffer for the compressed data
+   APP_MEM_ASRT( *Buf,malloc(*Size) );
+
+   code = *Type==BF_CFLOAT32 ? FPFC_CompressTol(Data,N,*Tol,*Buf,*Size,Size) : FPFC_CompresslTol(Data,N,*Tol,*Buf,*Size,Size);
+   if( code != APP_OK ) {
+      // If the compression failed, just write the field uncompressed
+      *Type = *Type==BF_CFLOAT32 ? BF_FLOAT32 : BF_FLOAT64;
+      *Tol = FPFC_LOSSLESS;
+      *Size = N*BFTypeSize[*Type];
+      APP_FREE(*Buf);
+   }
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_Append>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Ajouter un champ à la fin d'un fichier et son entête à l'index
+ *
+ * Parametres :
+ *    <File>   : Le fichier dans lequel écrire
+ *    <Head>   : L'entête du champ (NBYTES doit être la taille des données)
+ *    <Data>   : Les données à écrire
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - Le KEY de l'entête est la position du champ dans le fichier
+ *
+ *----------------------------------------------------------------------------
+ */
+static int BinaryFile_Append(TBFFile *File,const TBFFldHeader *Head,const void *Data) {
+   TBFFldHeader *headers;
+
+   if( write(File->FD,Data,Head->NBYTES) != Head->NBYTES ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not write the field : %s\n",strerror(errno));
+      if( lseek(File->FD,File->Header.IOffset,SEEK_SET) == -1 ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not seek to previous file position : %s\n",strerror(errno));
+      }
+      return APP_ERR;
+   }
+
+   // Make space in the index
+   if( !(headers=realloc(File->Index.Headers,(File->Index.N+1)*sizeof(*File->Index.Headers))) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not allocate memory for index, field will be ignored.\n");
+      return APP_ERR;
+   }
+   File->Index.Headers = headers;
+
+   headers[File->Index.N] = *Head;
+   headers[File->Index.N].KEY = File->Header.IOffset;
+   ++File->Index.N;
+
+   // Update the offset
+   File->Header.IOffset += Head->NBYTES;
+
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Asynchronous writer
+ *
+ * Les champs sont copiés et mis dans une file de travail. Un bassin de threads
+ * les compresse en parallèle et les place dans un anneau indexé par leur
+ * numéro de séquence. Un seul thread d'écriture les ajoute au fichier dans
+ * l'ordre d'appel. La file est bornée (QSize champs en vol) : BinaryFile_Write
+ * bloque quand elle est pleine.
+ *----------------------------------------------------------------------------
+ */
+typedef struct TBFJob {
+   struct TBFJob *Next;    // Next job in the work queue
+   TBFFldHeader  Head;     // Field header (NBYTES, DATYP, NBITS and TOL are set when packed)
+   void          *Data;    // Copy of the field
+   void          *Buf;     // Compressed field (NULL if written as is)
+   size_t        N;        // Number of values
+   double        Tol;      // Lossy compression tolerance
+   uint64_t      Seq;      // Sequence number (write order)
+   int           Code;     // Packing result
+} TBFJob;
+
+typedef struct TBFAsync {
+   pthread_mutex_t Mutex;
+   pthread_cond_t  Work;      // Signaled when a job is queued or on stop
+   pthread_cond_t  Ready;     // Signaled when a job is packed or on stop
+   pthread_cond_t  Free;      // Signaled when a job is written
+   pthread_t       *Workers;  // Compression threads
+   pthread_t       Writer;    // Writer thread
+   TBFFile         *File;     // File written to
+   TBFJob          *Head,*Tail; // Jobs waiting to be packed
+   TBFJob          **Ring;    // Packed jobs waiting to be written, indexed by Seq%QSize
+   uint64_t        Seq;       // Next sequence number to assign
+   uint64_t        Next;      // Next sequence number to write
+   int             NWorkers;  // Number of compression threads
+   int             QSize;     // Maximum number of jobs in flight
+   int             NJobs;     // Number of jobs in flight
+   int             Stop;      // Stop requested
+   int             Error;     // A field could not be written
+} TBFAsync;
+
+static void BinaryFile_JobFree(TBFJob *Job) {
+   if( Job ) {
+      APP_FREE(Job->Data);
+      APP_FREE(Job->Buf);
+      free(Job);
+   }
+}
+
+static void* BinaryFile_AsyncWorker(void *Arg) {
+   TBFAsync *async=(TBFAsync*)Arg;
+   TBFJob   *job;
+   TBFType  type;
+   size_t   size;
+
+   for(;;) {
+      pthread_mutex_lock(&async->Mutex);
+      while( !async->Head && !async->Stop )
+         pthread_cond_wait(&async->Work,&async->Mutex);
+      if( !(job=async->Head) ) {
+         pthread_mutex_unlock(&async->Mutex);
+         break;
+      }
+      if( !(async->Head=job->Next) )
+         async->Tail = NULL;
+      pthread_mutex_unlock(&async->Mutex);
+
+      type = job->Head.DATYP;
+      job->Code = BinaryFile_Pack(job->Data,job->N,&type,&job->Tol,&job->Buf,&size);
+      job->Head.NBYTES= size;
+      job->Head.NBITS = BFTypeSize[type]*CHAR_BIT;
+      job->Head.DATYP = type;
+      job->Head.TOL   = job->Tol;
+
+      pthread_mutex_lock(&async->Mutex);
+      async->Ring[job->Seq%async->QSize] = job;
+      if( job->Seq == async->Next )
+         pthread_cond_signal(&async->Ready);
+      pthread_mutex_unlock(&async->Mutex);
+   }
+   return NULL;
+}
+
+static void* BinaryFile_AsyncWriter(void *Arg) {
+   TBFAsync *async=(TBFAsync*)Arg;
+   TBFJob   *job;
+   int      code;
+
+   pthread_mutex_lock(&async->Mutex);
+   for(;;) {
+      while( !(job=async->Ring[async->Next%async->QSize]) && !(async->Stop && !async->NJobs) )
+         pthread_cond_wait(&async->Ready,&async->Mutex);
+      if( !job )
+         break;
+      async->Ring[async->Next%async->QSize] = NULL;
+      ++async->Next;
+      pthread_mutex_unlock(&async->Mutex);
+
+      code = job->Code==APP_OK ? BinaryFile_Append(async->File,&job->Head,job->Buf?job->Buf:job->Data) : APP_ERR;
+      BinaryFile_JobFree(job);
+
+      pthread_mutex_lock(&async->Mutex);
+      if( code != APP_OK )
+         async->Error = 1;
+      --async->NJobs;
+      pthread_cond_signal(&async->Free);
+   }
+   pthread_mutex_unlock(&async->Mutex);
+
+   return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_AsyncStart>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Activer l'écriture asynchrone
+ *
+ * Parametres :
+ *    <File>      : Le BF (ouvert en écriture)
+ *    <NThreads>  : Nombre de threads de compression (<=0 pour le nombre de processeurs)
+ *    <QueueSize> : Nombre maximal de champs en vol (<=0 pour 2*NThreads)
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - BinaryFile_Write copie le champ et retourne immédiatement, sauf si la
+ *      file est pleine. Chaque champ en vol garde une copie de ses données
+ *    - Les champs sont écrits dans l'ordre des appels à BinaryFile_Write
+ *    - L'index n'est pas cohérent tant que BinaryFile_AsyncStop (ou
+ *      BinaryFile_Close) n'a pas été appelé : ne pas lire ou chercher avant
+ *
+ *----------------------------------------------------------------------------
+ */
+int BinaryFile_AsyncStart(TBFFiles *File,int NThreads,int QueueSize) {
+   TBFAsync *async;
+   TBFFile  *file=BinaryFile_GetFile(File,0);
+   int      n;
+
+   if( !file || !(file->Flags&BF_WRITE) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Invalid file given or file is not opened for writing\n");
+      return APP_ERR;
+   }
+   if( File->Async ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Asynchronous writer already started\n");
+      return APP_ERR;
+   }
+
+   if( NThreads<=0 && (NThreads=sysconf(_SC_NPROCESSORS_ONLN))<=0 )
+      NThreads = 1;
+   if( QueueSize<=0 )
+      QueueSize = 2*NThreads;
+
+   APP_MEM_ASRT( async,calloc(1,sizeof(*async)) );
+   if( !(async->Workers=calloc(NThreads,sizeof(*async->Workers))) || !(async->Ring=calloc(QueueSize,sizeof(*async->Ring))) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not allocate memory for asynchronous writer\n");
+      goto error;
+   }
+   async->File = file;
+   async->QSize = QueueSize;
+
+   pthread_mutex_init(&async->Mutex,NULL);
+   pthread_cond_init(&async->Work,NULL);
+   pthread_cond_init(&async->Ready,NULL);
+   pthread_cond_init(&async->Free,NULL);
+
+   if( pthread_create(&async->Writer,NULL,BinaryFile_AsyncWriter,async) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not start writer thread\n");
+      goto destroy;
+   }
+   for(n=0; n<NThreads; ++n) {
+      if( pthread_create(&async->Workers[n],NULL,BinaryFile_AsyncWorker,async) ) {
+         Lib_Log(APP_LIBEER,APP_WARNING,"BinaryFile: Could only start %d of %d compression threads\n",n,NThreads);
+         break;
+      }
+      async->NWorkers++;
+   }
+
+   File->Async = async;
+
+   // Without any compression thread, we can't go on
+   if( !async->NWorkers ) {
+      BinaryFile_AsyncStop(File);
+      return APP_ERR;
+   }
+   return APP_OK;
+
+destroy:
+   pthread_cond_destroy(&async->Free);
+   pthread_cond_destroy(&async->Ready);
+   pthread_cond_destroy(&async->Work);
+   pthread_mutex_destroy(&async->Mutex);
+error:
+   APP_FREE(async->Ring);
+   APP_FREE(async->Workers);
+   free(async);
+   return APP_ERR;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_AsyncStop>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Vider la file d'écriture asynchrone et revenir en mode synchrone
+ *
+ * Parametres :
+ *    <File>   : Le BF
+ *
+ * Retour   : APP_OK si ok, APP_ERR si au moins un champ n'a pu être écrit
+ *
+ * Remarques :
+ *    - Appelé par BinaryFile_Close avant l'écriture de l'index
+ *
+ *----------------------------------------------------------------------------
+ */
+int BinaryFile_AsyncStop(TBFFiles *File) {
+   TBFAsync *async;
+   int      n,code;
+
+   if( !File || !(async=File->Async) )
+      return APP_OK;
+
+   pthread_mutex_lock(&async->Mutex);
+   async->Stop = 1;
+   pthread_cond_broadcast(&async->Work);
+   pthread_cond_broadcast(&async->Ready);
+   pthread_mutex_unlock(&async->Mutex);
+
+   for(n=0; n<async->NWorkers; ++n)
+      pthread_join(async->Workers[n],NULL);
+   pthread_join(async->Writer,NULL);
+
+   code = async->Error ? APP_ERR : APP_OK;
+
+   pthread_cond_destroy(&async->Free);
+   pthread_cond_destroy(&async->Ready);
+   pthread_cond_destroy(&async->Work);
+   pthread_mutex_destroy(&async->Mutex);
+   free(async->Ring);
+   free(async->Workers);
+   free(async);
+   File->Async = NULL;
+
+   return code;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_AsyncQueue>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Mettre un champ dans la file d'écriture asynchrone
+ *
+ * Parametres :
+ *    <Async>  : L'écrivain asynchrone
+ *    <Head>   : L'entête du champ (DATYP est le type demandé)
+ *    <Data>   : Le champ (copié)
+ *    <N>      : Le nombre de valeurs du champ
+ *    <Tol>    : La tolérance de compression
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - Bloque tant que la file est pleine
+ *
+ *----------------------------------------------------------------------------
+ */
+static int BinaryFile_AsyncQueue(TBFAsync *Async,const TBFFldHeader *Head,const void *Data,size_t N,double Tol) {
+   TBFJob *job;
+   size_t size=N*BFTypeSize[Head->DATYP];
+
+   APP_MEM_ASRT( job,calloc(1,sizeof(*job)) );
+   if( !(job->Data=malloc(size)) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not allocate memory for asynchronous write\n");
+      free(job);
+      return APP_ERR;
+   }
+   memcpy(job->Data,Data,size);
+   job->Head = *Head;
+   job->N = N;
+   job->Tol = Tol;
+
+   pthread_mutex_lock(&Async->Mutex);
+   while( Async->NJobs>=Async->QSize )
+      pthread_cond_wait(&Async->Free,&Async->Mutex);
+
+   job->Seq = Async->Seq++;
+   ++Async->NJobs;
+   if( Async->Tail ) {
+      Async->Tail->Next = job;
+   } else {
+      Async->Head = job;
+   }
+   Async->Tail = job;
+   pthread_cond_signal(&Async->Work);
+   pthread_mutex_unlock(&Async->Mutex);
+
+   return APP_OK;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <BinaryFile_Write>
  * Creation : Février 2017 - E. Legault-Ouellet - CMC/CMOE
@@ -671,14 +1212,19 @@ TBFType BinaryFile_Type(int DaTyp,int NBytes) {
  * Retour   : APP_OK si ok, APP_ERR sinon
  *
  * Remarques :
+ *    - En mode asynchrone (BinaryFile_AsyncStart), le champ est copié et
+ *      écrit plus tard; les erreurs d'écriture sont rapportées par
+ *      BinaryFile_AsyncStop ou BinaryFile_Close
  *
  *----------------------------------------------------------------------------
  */
 int BinaryFile_Write(void *Data,TBFType DataType,TBFFiles *File,int DateO,int Deet,int NPas,int NI,int NJ,int NK,int IP1,int IP2,int IP3,const char* TypVar,const char *NomVar,const char *Etiket,const char *GrTyp,int IG1,int IG2,int IG3,int IG4) {
-   size_t size;
+   size_t size,n=(size_t)NI*NJ*NK;
    void *buf;
-   TBFFldHeader *restrict h;
+   double tol=FPFC_LOSSLESS;
+   TBFFldHeader h;
    TBFFile *restrict file = BinaryFile_GetFile(File,0);
+   int code;
 
    // Make sure the file is open for writing
    if( !file || !(file->Flags&BF_WRITE) ) {
@@ -686,100 +1232,53 @@ int BinaryFile_Write(void *Data,TBFType DataType,TBFFiles *File,int DateO,int De
       return APP_ERR;
    }
 
-   // Calculate an upper limit (in bytes) to the size of the field to write
-   size = NI*NJ*NK*BFTypeSize[DataType];
-
    // From this point on, consider the file dirty (if an error occur, the field will just be ignored)
    file->Flags |= BF_DIRTY;
 
-   switch( DataType ) {
-      case BF_CFLOAT32:
-         // Allocate a temporary buffer for the compressed data
-         APP_MEM_ASRT( buf,malloc(size) );
-         if( FPFC_Compress(Data,NI*NJ*NK,buf,size,&size) != APP_OK ) {
-            // If the compression failed, just write the field uncompressed
-            DataType = BF_FLOAT32;
-         }
-         if( write(file->FD,DataType==BF_FLOAT32?Data:buf,size) != size ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not write the field : %s\n",strerror(errno));
-            if( lseek(file->FD,file->Header.IOffset,SEEK_SET) == -1 ) {
-               Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not seek to previous file position : %s\n",strerror(errno));
-            }
-            free(buf);
-            return APP_ERR;
-         }
-         free(buf);
-         break;
-      case BF_CFLOAT64:
-         APP_MEM_ASRT( buf,malloc(size) );
-         if( FPFC_Compressl(Data,NI*NJ*NK,buf,size,&size) != APP_OK ) {
-            // If the compression fails, just write the field uncompressed
-            DataType = BF_FLOAT64;
-         }
-         if( write(file->FD,DataType==BF_FLOAT64?Data:buf,size) != size ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not write the field : %s\n",strerror(errno));
-            if( lseek(file->FD,file->Header.IOffset,SEEK_SET) == -1 ) {
-               Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not seek to previous file position : %s\n",strerror(errno));
-            }
-            free(buf);
-            return APP_ERR;
-         }
-         free(buf);
-         break;
-      default:
-         if( write(file->FD,Data,size) != size ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not write the field : %s\n",strerror(errno));
-            if( lseek(file->FD,file->Header.IOffset,SEEK_SET) == -1 ) {
-               Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not seek to previous file position : %s\n",strerror(errno));
-            }
-            return APP_ERR;
-         }
-         break;
+   // Get the tolerance of the lossy compression, if any
+   if( DataType==BF_CFLOAT32 || DataType==BF_CFLOAT64 ) {
+      tol = BinaryFile_GetTol(File,NomVar);
    }
 
-   // Make space in the index
-   ++file->Index.N;
-   if( !(buf=realloc(file->Index.Headers,file->Index.N*sizeof(*file->Index.Headers))) ) {
-      --file->Index.N;
-      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not allocate memory for index, field will be ignored.\n");
-      return APP_ERR;
+   // Fill the header
+   memset(&h,0,sizeof(h));
+   h.DATEO = DateO;
+   h.DEET  = Deet;
+   h.NPAS  = NPas;
+   h.DATYP = DataType;
+   h.IP1   = IP1;
+   h.IP2   = IP2;
+   h.IP3   = IP3;
+   h.NI    = NI;
+   h.NJ    = NJ;
+   h.NK    = NK;
+   h.IG1   = IG1;
+   h.IG2   = IG2;
+   h.IG3   = IG3;
+   h.IG4   = IG4;
+
+   memcpy(h.TYPVAR,TypVar,FtnStrSize(TypVar,2));
+   memcpy(h.NOMVAR,NomVar,FtnStrSize(NomVar,4));
+   memcpy(h.ETIKET,Etiket,FtnStrSize(Etiket,12));
+   h.GRTYP = GrTyp[0];
+
+   if( File->Async ) {
+      return BinaryFile_AsyncQueue(File->Async,&h,Data,n,tol);
    }
-   file->Index.Headers = buf;
-
-   h = &file->Index.Headers[file->Index.N-1];
 
-   // Fill the header
-   h->KEY   = file->Header.IOffset;
-   h->NBYTES= size;
-   h->DATEO = DateO;
-   h->DEET  = Deet;
-   h->NPAS  = NPas;
-   h->NBITS = BFTypeSize[DataType]*CHAR_BIT;
-   h->DATYP = DataType;
-   h->IP1   = IP1;
-   h->IP2   = IP2;
-   h->IP3   = IP3;
-   h->NI    = NI;
-   h->NJ    = NJ;
-   h->NK    = NK;
-   h->IG1   = IG1;
-   h->IG2   = IG2;
-   h->IG3   = IG3;
-   h->IG4   = IG4;
-
-   memset(h->TYPVAR,0,2);
-   memset(h->NOMVAR,0,4);
-   memset(h->ETIKET,0,12);
-
-   memcpy(h->TYPVAR,TypVar,FtnStrSize(TypVar,2));
-   memcpy(h->NOMVAR,NomVar,FtnStrSize(NomVar,4));
-   memcpy(h->ETIKET,Etiket,FtnStrSize(Etiket,12));
-   h->GRTYP = GrTyp[0];
+   if( BinaryFile_Pack(Data,n,&DataType,&tol,&buf,&size) != APP_OK ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not allocate memory for compression\n");
+      return APP_ERR;
+   }
+   h.NBYTES= size;
+   h.NBITS = BFTypeSize[DataType]*CHAR_BIT;
+   h.DATYP = DataType;
+   h.TOL   = tol;
 
-   // Update the offset
-   file->Header.IOffset += size;
+   code = BinaryFile_Append(file,&h,buf?buf:Data);
+   APP_FREE(buf);
 
-   return APP_OK;
+   return code;
 }
 
 /*----------------------------------------------------------------------------
@@ -830,6 +1329,37 @@ int BinaryFile_WriteFSTD(void *Data,int NPak,TBFFiles *File,int DateO,int Deet,i
    return BinaryFile_Write(Data,type,File,DateO,Deet,NPas,NI,NJ,NK,IP1,IP2,IP3,TypVar,NomVar,Etiket,GrTyp,IG1,IG2,IG3,IG4);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_DateV>
+ * Creation : Février 2017 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Calculer la date de validité d'un champ
+ *
+ * Parametres :
+ *    <DateO>     : Date d'origine du champ
+ *    <Deet>      : Durée d'un pas de temps (s)
+ *    <Npas>      : Nombre de pas de temps
+ *
+ * Retour   : La date de validité (0 si inconnue)
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+int BinaryFile_DateV(int DateO,int Deet,int Npas) {
+#ifdef HAVE_RMN
+   if( !DateO ) return 0;
+   // Calculer la date de validitee du champs
+   int datev;
+   double nhour=(Npas*Deet)/3600.0;
+   f77name(incdatr)(&datev,&DateO,&nhour);
+   return datev!=101010101 ? datev : 0;
+#else
+   Lib_Log(APP_LIBEER,APP_ERROR,"%s: Need RMNLIB\n",__func__);
+   return 0;
+#endif
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <BinaryFile_Find>
  * Creation : Février 2017 - E. Legault-Ouellet - CMC/CMOE
@@ -855,19 +1385,6 @@ int BinaryFile_WriteFSTD(void *Data,int NPak,TBFFiles *File,int DateO,int Deet,i
  *
  *----------------------------------------------------------------------------
  */
-static int GetDateV(int DateO,int Deet,int Npas) {
-#ifdef HAVE_RMN
-   if( !DateO ) return 0;
-   // Calculer la date de validitee du champs
-   int datev;
-   double nhour=(Npas*Deet)/3600.0;
-   f77name(incdatr)(&datev,&DateO,&nhour);
-   return datev!=101010101 ? datev : 0;
-#else
-   Lib_Log(APP_LIBEER,APP_ERROR,"%s: Need RMNLIB\n",__func__);
-   return 0;
-#endif
-}
 TBFKey BinaryFile_Find(TBFFiles *File,int *NI,int *NJ,int *NK,int DateV,const char *Etiket,int IP1,int IP2,int IP3,const char* TypVar,const char *NomVar) {
    TBFFldHeader *restrict h;
    TBFFile *restrict file;
@@ -890,9 +1407,9 @@ TBFKey BinaryFile_Find(TBFFiles *File,int *NI,int *NJ,int *NK,int DateV,const ch
    // Look for the field in the index
    for(f=0,file=File->Files; f<File->N; ++f,++file) {
       for(i=0,h=file->Index.Headers; i<file->Index.N; ++i,++h) {
-         //printf("Comparing datev=(%d|%d) ip1=(%d|%d) ip2=(%d|%d) ip3=(%d|%d) NomVar=(%.*s|%.4s) TypVar=(%.*s|%.2s) Etiket=(%.*s|%.12s)\n",DateV,GetDateV(h->DATEO,h->DEET,h->NPAS),IP1,h->IP1,IP2,h->IP2,IP3,h->IP3,nnv,NomVar,h->NOMVAR,ntv,TypVar,h->TYPVAR,net,Etiket,h->ETIKET);
-         //printf("DateV[%d] IP1[%d] IP2[%d] IP3[%d] NOMVAR[%d] TYPVAR[%d] ETIKET[%d]\n",(DateV==-1 || DateV==GetDateV(h->DATEO,h->DEET,h->NPAS),(IP1==-1 || IP1==h->IP1),(IP2==-1 || IP2==h->IP2),(IP3==-1 || IP3==h->IP3),(nonv || nnv==strnlen(h->NOMVAR,4) && !strncmp(NomVar,h->NOMVAR,nnv)),(notv || ntv==strnlen(h->TYPVAR,2) && !strncmp(TypVar,h->TYPVAR,ntv)),(noet || net==strnlen(h->ETIKET,12) && !strncmp(Etiket,h->ETIKET,net)));
-         if( (DateV==-1 || DateV==GetDateV(h->DATEO,h->DEET,h->NPAS))
+         //printf("Comparing datev=(%d|%d) ip1=(%d|%d) ip2=(%d|%d) ip3=(%d|%d) NomVar=(%.*s|%.4s) TypVar=(%.*s|%.2s) Etiket=(%.*s|%.12s)\n",DateV,BinaryFile_DateV(h->DATEO,h->DEET,h->NPAS),IP1,h->IP1,IP2,h->IP2,IP3,h->IP3,nnv,NomVar,h->NOMVAR,ntv,TypVar,h->TYPVAR,net,Etiket,h->ETIKET);
+         //printf("DateV[%d] IP1[%d] IP2[%d] IP3[%d] NOMVAR[%d] TYPVAR[%d] ETIKET[%d]\n",(DateV==-1 || DateV==BinaryFile_DateV(h->DATEO,h->DEET,h->NPAS),(IP1==-1 || IP1==h->IP1),(IP2==-1 || IP2==h->IP2),(IP3==-1 || IP3==h->IP3),(nonv || nnv==strnlen(h->NOMVAR,4) && !strncmp(NomVar,h->NOMVAR,nnv)),(notv || ntv==strnlen(h->TYPVAR,2) && !strncmp(TypVar,h->TYPVAR,ntv)),(noet || net==strnlen(h->ETIKET,12) && !strncmp(Etiket,h->ETIKET,net)));
+         if( (DateV==-1 || DateV==BinaryFile_DateV(h->DATEO,h->DEET,h->NPAS))
                && (IP1==-1 || IP1==h->IP1)
                && (IP2==-1 || IP2==h->IP2)
                && (IP3==-1 || IP3==h->IP3)
@@ -900,7 +1417,7 @@ TBFKey BinaryFile_Find(TBFFiles *File,int *NI,int *NJ,int *NK,int DateV,const ch
                && (notv || ntv==strnlen(h->TYPVAR,2) && !strncmp(TypVar,h->TYPVAR,ntv))
                && (noet || net==strnlen(h->ETIKET,12) && !strncmp(Etiket,h->ETIKET,net)) ) {
             // We found the field, return its key
-            //printf("Found field datev=(%d|%d) ip1=(%d|%d) ip2=(%d|%d) ip3=(%d|%d) NomVar=(%.*s|%.4s) TypVar=(%.*s|%.2s) Etiket=(%.*s|%.12s)\n",DateV,GetDateV(h->DATEO,h->DEET,h->NPAS),IP1,h->IP1,IP2,h->IP2,IP3,h->IP3,nnv,NomVar,h->NOMVAR,ntv,TypVar,h->TYPVAR,net,Etiket,h->ETIKET);
+            //printf("Found field datev=(%d|%d) ip1=(%d|%d) ip2=(%d|%d) ip3=(%d|%d) NomVar=(%.*s|%.4s) TypVar=(%.*s|%.2s) Etiket=(%.*s|%.12s)\n",DateV,BinaryFile_DateV(h->DATEO,h->DEET,h->NPAS),IP1,h->IP1,IP2,h->IP2,IP3,h->IP3,nnv,NomVar,h->NOMVAR,ntv,TypVar,h->TYPVAR,net,Etiket,h->ETIKET);
             //printf("Note that nnv=%d ntv=%d net=%d nlenNV=%d nlenTV=%d nlenET=%d\n",nnv,ntv,net,(int)strnlen(h->NOMVAR,4),(int)strnlen(h->TYPVAR,2),(int)strnlen(h->ETIKET,12));
             *NI=h->NI; *NJ=h->NJ; *NK=h->NK;
             return BinaryFile_MakeKey(f,i);
@@ -938,6 +1455,10 @@ TBFKey BinaryFile_ReadIndex(void *Buf,TBFKey Key,TBFFiles *File) {
       return -1;
    }
 
+   if( h->TOL != 0.0 ) {
+      Lib_Log(APP_LIBEER,APP_DEBUG,"BinaryFile: Field %.4s was compressed with a %s tolerance of %e\n",h->NOMVAR,h->TOL>0.0?"absolute":"relative",fabs(h->TOL));
+   }
+
    // Check if we have a file mapping or we are using traditionnal means
    if( file->Addr != MAP_FAILED ) {
       // Get the address where the data is
@@ -1042,52 +1563,103 @@ TBFKey BinaryFile_Read(void *Buf,TBFFiles *File,int *NI,int *NJ,int *NK,int Date
  * Retour   : APP_OK si ok, APP_ERR sinon
  *
  * Remarques :
+ *    - Les paires les plus fréquentes ont des noyaux dédiés (vectorisables)
+ *    - Si DestBuf==SrcBuf, la conversion est faite sur place, ce qui n'est
+ *      possible que si le type destination n'est pas plus petit que le type
+ *      source
  *
  *----------------------------------------------------------------------------
  */
+static void BF_CvtI16F32(float *restrict Dest,const int16_t *restrict Src,size_t N) {
+   size_t i;
+   #pragma omp simd
+   for(i=0; i<N; ++i) Dest[i] = (float)Src[i];
+}
+static void BF_CvtU16F32(float *restrict Dest,const uint16_t *restrict Src,size_t N) {
+   size_t i;
+   #pragma omp simd
+   for(i=0; i<N; ++i) Dest[i] = (float)Src[i];
+}
+static void BF_CvtF64F32(float *restrict Dest,const double *restrict Src,size_t N) {
+   size_t i;
+   #pragma omp simd
+   for(i=0; i<N; ++i) Dest[i] = (float)Src[i];
+}
+static void BF_CvtF32F64(double *restrict Dest,const float *restrict Src,size_t N) {
+   size_t i;
+   #pragma omp simd
+   for(i=0; i<N; ++i) Dest[i] = (double)Src[i];
+}
+
+// Forward loop for distinct buffers, backward loop for in place widening
 #define BF_CONVERT_LOOP(DestType,DestBuf,SrcType,SrcBuf,N) { \
-   int i; \
+   size_t i; \
    for(i=0; i<N; ++i) { \
       DestBuf[i] = (DestType)((SrcType*)SrcBuf)[i]; \
    } \
 }
-#define BF_CONVERT_SRC(DestType,DestBuf,SrcBFType,SrcBuf,N) { \
-   DestType *restrict dest = DestBuf; \
+#define BF_CONVERT_RLOOP(DestType,DestBuf,SrcType,SrcBuf,N) { \
+   size_t i; \
+   for(i=N; i>0; --i) { \
+      DestBuf[i-1] = (DestType)((SrcType*)SrcBuf)[i-1]; \
+   } \
+}
+#define BF_CONVERT_SRC(LOOP,DestType,DestBuf,SrcBFType,SrcBuf,N) { \
+   DestType *dest = DestBuf; \
    switch( SrcBFType ) { \
-      case BF_STRING:   BF_CONVERT_LOOP(DestType,dest,char,SrcBuf,N);       break; \
-      case BF_BINARY:   BF_CONVERT_LOOP(DestType,dest,char,SrcBuf,N);       break; \
-      case BF_INT8:     BF_CONVERT_LOOP(DestType,dest,int8_t,SrcBuf,N);     break; \
-      case BF_INT16:    BF_CONVERT_LOOP(DestType,dest,int16_t,SrcBuf,N);    break; \
-      case BF_INT32:    BF_CONVERT_LOOP(DestType,dest,int32_t,SrcBuf,N);    break; \
-      case BF_INT64:    BF_CONVERT_LOOP(DestType,dest,int64_t,SrcBuf,N);    break; \
-      case BF_UINT8:    BF_CONVERT_LOOP(DestType,dest,uint8_t,SrcBuf,N);    break; \
-      case BF_UINT16:   BF_CONVERT_LOOP(DestType,dest,uint16_t,SrcBuf,N);   break; \
-      case BF_UINT32:   BF_CONVERT_LOOP(DestType,dest,uint32_t,SrcBuf,N);   break; \
-      case BF_UINT64:   BF_CONVERT_LOOP(DestType,dest,uint64_t,SrcBuf,N);   break; \
-      case BF_FLOAT32:  BF_CONVERT_LOOP(DestType,dest,float,SrcBuf,N);      break; \
-      case BF_FLOAT64:  BF_CONVERT_LOOP(DestType,dest,double,SrcBuf,N);     break; \
+      case BF_STRING:   LOOP(DestType,dest,char,SrcBuf,N);       break; \
+      case BF_BINARY:   LOOP(DestType,dest,char,SrcBuf,N);       break; \
+      case BF_INT8:     LOOP(DestType,dest,int8_t,SrcBuf,N);     break; \
+      case BF_INT16:    LOOP(DestType,dest,int16_t,SrcBuf,N);    break; \
+      case BF_INT32:    LOOP(DestType,dest,int32_t,SrcBuf,N);    break; \
+      case BF_INT64:    LOOP(DestType,dest,int64_t,SrcBuf,N);    break; \
+      case BF_UINT8:    LOOP(DestType,dest,uint8_t,SrcBuf,N);    break; \
+      case BF_UINT16:   LOOP(DestType,dest,uint16_t,SrcBuf,N);   break; \
+      case BF_UINT32:   LOOP(DestType,dest,uint32_t,SrcBuf,N);   break; \
+      case BF_UINT64:   LOOP(DestType,dest,uint64_t,SrcBuf,N);   break; \
+      case BF_FLOAT32:  LOOP(DestType,dest,float,SrcBuf,N);      break; \
+      case BF_FLOAT64:  LOOP(DestType,dest,double,SrcBuf,N);     break; \
       case BF_NOTYPE:   \
       default: return APP_ERR;   \
    } \
 }
+#define BF_CONVERT_DEST(LOOP,DestBFType,DestBuf,SrcBFType,SrcBuf,N) { \
+   switch( DestBFType ) { \
+      case BF_STRING:   BF_CONVERT_SRC(LOOP,char,DestBuf,SrcBFType,SrcBuf,N);      break; \
+      case BF_BINARY:   BF_CONVERT_SRC(LOOP,char,DestBuf,SrcBFType,SrcBuf,N);      break; \
+      case BF_INT8:     BF_CONVERT_SRC(LOOP,int8_t,DestBuf,SrcBFType,SrcBuf,N);    break; \
+      case BF_INT16:    BF_CONVERT_SRC(LOOP,int16_t,DestBuf,SrcBFType,SrcBuf,N);   break; \
+      case BF_INT32:    BF_CONVERT_SRC(LOOP,int32_t,DestBuf,SrcBFType,SrcBuf,N);   break; \
+      case BF_INT64:    BF_CONVERT_SRC(LOOP,int64_t,DestBuf,SrcBFType,SrcBuf,N);   break; \
+      case BF_UINT8:    BF_CONVERT_SRC(LOOP,uint8_t,DestBuf,SrcBFType,SrcBuf,N);   break; \
+      case BF_UINT16:   BF_CONVERT_SRC(LOOP,uint16_t,DestBuf,SrcBFType,SrcBuf,N);  break; \
+      case BF_UINT32:   BF_CONVERT_SRC(LOOP,uint32_t,DestBuf,SrcBFType,SrcBuf,N);  break; \
+      case BF_UINT64:   BF_CONVERT_SRC(LOOP,uint64_t,DestBuf,SrcBFType,SrcBuf,N);  break; \
+      case BF_FLOAT32:  BF_CONVERT_SRC(LOOP,float,DestBuf,SrcBFType,SrcBuf,N);     break; \
+      case BF_FLOAT64:  BF_CONVERT_SRC(LOOP,double,DestBuf,SrcBFType,SrcBuf,N);    break; \
+      case BF_NOTYPE: \
+      default: return APP_ERR; \
+   } \
+}
 static int BinaryFile_Convert(TBFType DestType,void* DestBuf,TBFType SrcType,void* SrcBuf,size_t N) {
-   switch( DestType ) {
-      case BF_STRING:   BF_CONVERT_SRC(char,DestBuf,SrcType,SrcBuf,N);      break;
-      case BF_BINARY:   BF_CONVERT_SRC(char,DestBuf,SrcType,SrcBuf,N);      break;
-      case BF_INT8:     BF_CONVERT_SRC(int8_t,DestBuf,SrcType,SrcBuf,N);    break;
-      case BF_INT16:    BF_CONVERT_SRC(int16_t,DestBuf,SrcType,SrcBuf,N);   break;
-      case BF_INT32:    BF_CONVERT_SRC(int32_t,DestBuf,SrcType,SrcBuf,N);   break;
-      case BF_INT64:    BF_CONVERT_SRC(int64_t,DestBuf,SrcType,SrcBuf,N);   break;
-      case BF_UINT8:    BF_CONVERT_SRC(uint8_t,DestBuf,SrcType,SrcBuf,N);   break;
-      case BF_UINT16:   BF_CONVERT_SRC(uint16_t,DestBuf,SrcType,SrcBuf,N);  break;
-      case BF_UINT32:   BF_CONVERT_SRC(uint32_t,DestBuf,SrcType,SrcBuf,N);  break;
-      case BF_UINT64:   BF_CONVERT_SRC(uint64_t,DestBuf,SrcType,SrcBuf,N);  break;
-      case BF_FLOAT32:  BF_CONVERT_SRC(float,DestBuf,SrcType,SrcBuf,N);     break;
-      case BF_FLOAT64:  BF_CONVERT_SRC(double,DestBuf,SrcType,SrcBuf,N);    break;
-      case BF_NOTYPE:
-      default: return APP_ERR;
+
+   if( DestBuf == SrcBuf ) {
+      if( DestType==SrcType )
+         return APP_OK;
+      if( BFTypeSize[DestType] < BFTypeSize[SrcType] )
+         return APP_ERR;
+      BF_CONVERT_DEST(BF_CONVERT_RLOOP,DestType,DestBuf,SrcType,SrcBuf,N);
+      return APP_OK;
+   }
+
+   switch( DestType<<8|SrcType ) {
+      case BF_FLOAT32<<8|BF_INT16:   BF_CvtI16F32(DestBuf,SrcBuf,N); return APP_OK;
+      case BF_FLOAT32<<8|BF_UINT16:  BF_CvtU16F32(DestBuf,SrcBuf,N); return APP_OK;
+      case BF_FLOAT32<<8|BF_FLOAT64: BF_CvtF64F32(DestBuf,SrcBuf,N); return APP_OK;
+      case BF_FLOAT64<<8|BF_FLOAT32: BF_CvtF32F64(DestBuf,SrcBuf,N); return APP_OK;
    }
 
+   BF_CONVERT_DEST(BF_CONVERT_LOOP,DestType,DestBuf,SrcType,SrcBuf,N);
    return APP_OK;
 }
 
@@ -1106,46 +1678,65 @@ static int BinaryFile_Convert(TBFType DestType,void* DestBuf,TBFType SrcType,voi
  * Retour   : La clé du champ lu ou -1 si pas trouvé
  *
  * Remarques :
+ *    - Un champ non compressé est converti directement depuis le fichier mappé
+ *    - Un champ compressé (ou lu sans mapping) est lu dans Buf et converti
+ *      sur place si le type destination est au moins aussi grand que le type
+ *      source. Sinon, un buffer temporaire est nécessaire
  *
  *----------------------------------------------------------------------------
  */
 TBFKey BinaryFile_ReadIndexInto(void *Buf,TBFKey Key,TBFFiles *File,TBFType DestType) {
    TBFFldHeader *restrict h;
    TBFFile *restrict file;
+   TBFType type;
    void *tbuf=NULL;
+   size_t n;
+   int mapped=0;
 
    // Make sure we have a valid file and key
    if( !File || !(File->Flags&BF_READ) || !(file=BinaryFile_GetFile(File,Key)) || !(h=BinaryFile_GetHeader(File,Key)) ) {
       return -1;
    }
 
+   // Type of the data once read (compressed fields are inflated in their uncompressed type)
+   switch( (type=h->DATYP) ) {
+      case BF_CFLOAT32: type=BF_FLOAT32; break;
+      case BF_CFLOAT64: type=BF_FLOAT64; break;
+      default: break;
+   }
+   if( DestType==BF_CFLOAT32 )  DestType=BF_FLOAT32;
+   if( DestType==BF_CFLOAT64 )  DestType=BF_FLOAT64;
+
    // Check if we need to convert
-   if( h->DATYP == DestType ) {
-      return BinaryFile_ReadIndex(tbuf,Key,File);
+   if( type == DestType ) {
+      return BinaryFile_ReadIndex(Buf,Key,File);
    }
 
-   // Allocate a temporary buffer to read the data into
-   size_t n = h->NI*h->NJ*h->NK;
-   if( !(tbuf=malloc(BFTypeSize[DestType]*n)) ) {
+   n = (size_t)h->NI*h->NJ*h->NK;
+
+   if( type==h->DATYP && file->Addr!=MAP_FAILED && !((uintptr_t)AddrAt(file->Addr,h->KEY)%BFTypeSize[type]) ) {
+      // Convert straight from the mapping (fields following a compressed field might not be aligned)
+      tbuf = AddrAt(file->Addr,h->KEY);
+      mapped = 1;
+   } else if( BFTypeSize[DestType] >= BFTypeSize[type] ) {
+      // Read in the destination buffer and convert in place
+      tbuf = Buf;
+   } else if( !(tbuf=malloc(BFTypeSize[type]*n)) ) {
       Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not allocate memory for temporary buffer\n");
       return -1;
    }
 
    // Read the data
-   if( BinaryFile_ReadIndex(tbuf,Key,File) < 0 ) {
-      free(tbuf);
-      return -1;
+   if( !mapped && BinaryFile_ReadIndex(tbuf,Key,File)<0 ) {
+      Key = -1;
+   } else if( BinaryFile_Convert(DestType,Buf,type,tbuf,n)!=APP_OK ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not convert from type %d to type %d\n",h->DATYP,DestType);
+      Key = -1;
    }
 
-   // Convert the data
-   if( BinaryFile_Convert(DestType,Buf,h->DATYP,tbuf,n)!=APP_OK ) {
-      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not convert from type %d to type %d\n",h->DATYP,DestType);
+   if( !mapped && tbuf!=Buf )
       free(tbuf);
-      return -1;
-   }
 
-   // Success
-   free(tbuf);
    return Key;
 }
 
@@ -1184,3 +1775,65 @@ TBFKey BinaryFile_ReadInto(void *Buf,TBFFiles *File,int *NI,int *NJ,int *NK,int
    }
    return -1;
 }
+
+/*----------------------------------------------------------------------------
+ * Nom      : <BinaryFile_ReadDef>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lit un champ directement dans une composante d'un TDef
+ *
+ * Parametres :
+ *    <Def>       : [OUT] Le TDef à remplir (dimensions identiques au champ)
+ *    <Comp>      : La composante à remplir
+ *    <Key>       : Clé du champ à lire
+ *    <File>      : Handle vers le fichier BF
+ *
+ * Retour   : La clé du champ lu ou -1 si erreur
+ *
+ * Remarques :
+ *    - Le champ est converti au type du TDef sans buffer intermédiaire
+ *      (voir BinaryFile_ReadIndexInto)
+ *    - Pour la composante 0, un masque (TYPVAR @@, mêmes identificateurs) est
+ *      lu dans Def->Mask, qui est alloué au besoin
+ *
+ *----------------------------------------------------------------------------
+ */
+TBFKey BinaryFile_ReadDef(TDef *Def,int Comp,TBFKey Key,TBFFiles *File) {
+   static const TBFType deftype[] = { BF_NOTYPE,BF_BINARY,BF_UINT8,BF_INT8,BF_UINT16,BF_INT16,BF_UINT32,BF_INT32,BF_UINT64,BF_INT64,BF_FLOAT32,BF_FLOAT64 };
+   TBFFldHeader *restrict h;
+   TBFKey mkey;
+   char etiket[13]={'\0'},nomvar[5]={'\0'};
+   int ni,nj,nk;
+
+   if( !Def || Comp<0 || Comp>=Def->NC || !Def->Data[Comp] || !(h=BinaryFile_GetHeader(File,Key)) ) {
+      return -1;
+   }
+
+   if( h->NI!=Def->NI || h->NJ!=Def->NJ || h->NK!=Def->NK ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Field dimensions (%dx%dx%d) differ from the definition's (%dx%dx%d)\n",h->NI,h->NJ,h->NK,Def->NI,Def->NJ,Def->NK);
+      return -1;
+   }
+
+   if( BinaryFile_ReadIndexInto(Def->Data[Comp],Key,File,deftype[Def->Type]) < 0 ) {
+      return -1;
+   }
+
+   // Look for a mask associated with the field
+   if( !Comp ) {
+      memcpy(etiket,h->ETIKET,12);
+      memcpy(nomvar,h->NOMVAR,4);
+      mkey = BinaryFile_Find(File,&ni,&nj,&nk,BinaryFile_DateV(h->DATEO,h->DEET,h->NPAS),etiket,h->IP1,h->IP2,h->IP3,"@@",nomvar);
+
+      if( mkey>=0 && ni==Def->NI && nj==Def->NJ && nk==Def->NK ) {
+         if( !Def->Mask && !(Def->Mask=malloc((size_t)ni*nj*nk)) ) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"BinaryFile: Could not allocate memory for mask\n");
+            return -1;
+         }
+         if( BinaryFile_ReadIndexInto(Def->Mask,mkey,File,BF_INT8) < 0 ) {
+            return -1;
+         }
+      }
+   }
+
+   return Key;
+}
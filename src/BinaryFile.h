@@ -39,8 +39,11 @@
 #include <inttypes.h>
 #include <limits.h>
 
+#include "Catalog.h"
+
 typedef enum TBFFlag {BF_READ=1,BF_WRITE=2,BF_CLEAR=4,BF_DIRTY=8,BF_SEEKED=16} TBFFlag;
 typedef enum TBFType {BF_STRING,BF_BINARY,BF_INT8,BF_INT16,BF_INT32,BF_INT64,BF_UINT8,BF_UINT16,BF_UINT32,BF_UINT64,BF_FLOAT32,BF_FLOAT64,BF_CFLOAT32,BF_CFLOAT64,BF_NOTYPE} TBFType;
+typedef enum TBFTolMode {BF_TOL_NONE,BF_TOL_ABS,BF_TOL_REL,BF_TOL_DICT} TBFTolMode;
 
 // Field header
 typedef struct TBFFldHeader {
@@ -58,7 +61,8 @@ typedef struct TBFFldHeader {
    char     NOMVAR[4];        // Nom de la variable
    char     ETIKET[12];       // Etiquette du champs
    char     GRTYP;            // Type de grilles
-   char     BUF;              // Buffer to get to 96 bytes
+   char     BUF;              // Padding (the header is 96 bytes up to TOL, 104 bytes in all)
+   double   TOL;              // Tolérance de la compression avec perte (>0 absolue, <0 relative, 0 sans perte) (Version 3)
 } TBFFldHeader;
 
 // File header
@@ -89,18 +93,31 @@ typedef struct TBFFiles {
    TBFFile     *Files;  // Files linked
    int         N;       // Number of files linked
    int         Flags;   // Mode of the files (all files must be opened for the same purpose
+   TBFTolMode  TolMode; // Lossy compression mode for BF_CFLOAT32/BF_CFLOAT64 fields
+   double      Tol;     // Lossy compression tolerance (BF_TOL_ABS, BF_TOL_REL)
+   struct TBFAsync *Async; // Asynchronous writer (NULL if writing synchronously)
 } TBFFiles;
 
 typedef int64_t TBFKey;
 
+extern const int32_t BF_MAGIC;
+
+struct TDef;
+
 // Function declaration
 
 TBFFiles* BinaryFile_Open(const char *FileName,TBFFlag Mode);
 TBFFiles* BinaryFile_Link(const char** FileNames,int N);
 TBFFiles* BinaryFile_LinkPattern(const char* Pattern);
+TBFFiles* BinaryFile_LinkPatternCatalog(const char* Pattern,TCatalog **Cat);
 int BinaryFile_Close(TBFFiles *File);
 
 TBFType BinaryFile_Type(int DaTyp,int NBytes);
+int BinaryFile_DateV(int DateO,int Deet,int Npas);
+int BinaryFile_SetTolerance(TBFFiles *File,TBFTolMode Mode,double Tol);
+double BinaryFile_Tolerance(TBFKey Key,TBFFiles *File);
+int BinaryFile_AsyncStart(TBFFiles *File,int NThreads,int QueueSize);
+int BinaryFile_AsyncStop(TBFFiles *File);
 
 int BinaryFile_Write(void *Data,TBFType DataType,TBFFiles *File,int DateO,int Deet,int NPas,int NI,int NJ,int NK,int IP1,int IP2,int IP3,const char* TypVar,const char *NomVar,const char *Etiket,const char *GrTyp,int IG1,int IG2,int IG3,int IG4);
 int BinaryFile_WriteFSTD(void *Data,int NPak,TBFFiles *File,int DateO,int Deet,int NPas,int NI,int NJ,int NK,int IP1,int IP2,int IP3,const char* TypVar,const char *NomVar,const char *Etiket,const char *GrTyp,int IG1,int IG2,int IG3,int IG4,int DaTyp,int Over);
@@ -111,5 +128,6 @@ TBFKey BinaryFile_ReadIndex(void *Buf,TBFKey Key,TBFFiles *File);
 TBFKey BinaryFile_Read(void *Buf,TBFFiles *File,int *NI,int *NJ,int *NK,int DateO,const char *Etiket,int IP1,int IP2,int IP3,const char* TypVar,const char *NomVar);
 TBFKey BinaryFile_ReadIndexInto(void *Buf,TBFKey Key,TBFFiles *File,TBFType DestType);
 TBFKey BinaryFile_ReadInto(void *Buf,TBFFiles *File,int *NI,int *NJ,int *NK,int DateO,const char *Etiket,int IP1,int IP2,int IP3,const char* TypVar,const char *NomVar,TBFType DestType);
+TBFKey BinaryFile_ReadDef(struct TDef *Def,int Comp,TBFKey Key,TBFFiles *File);
 
 #endif // _BINARYFILE_H
@@ -0,0 +1,976 @@
+/*==============================================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadian
+ * 2121 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet    : Catalogue des entêtes de fichiers standards et BinaryFile
+ * Fichier   : Catalog.c
+ * Creation  : Octobre 2026
+ * Auteur    : Eric Legault-Ouellet
+ *
+ * Description: Catalogue persistant (fichier sidecar) des entêtes de champs
+ *              d'un ensemble de fichiers, pour éviter de relire les entêtes
+ *              de chaque fichier à chaque ouverture
+ *
+ * Note: Une entrée de fichier est valide tant que sa taille et sa date de
+ *       modification n'ont pas changé. Seuls les fichiers nouveaux ou
+ *       modifiés sont relus lors d'une synchronisation.
+ *
+ * License:
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *==============================================================================
+ */
+#include "App.h"
+#include "eerUtils.h"
+#include "Catalog.h"
+#include "BinaryFile.h"
+#include "RPN.h"
+#include <string.h>
+#include <limits.h>
+#include <libgen.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define CATALOG_MAGIC   0x54414345  // ECAT in little endian
+#define CATALOG_VERSION 2
+
+// Sidecar file header
+typedef struct TCatalogHeader {
+   int32_t  Magic;      // Magic number
+   uint32_t Version;    // Version of the catalogue
+   uint32_t FSize;      // Field header size
+   int32_t  NFile;      // Number of file entries
+} TCatalogHeader;
+
+// Sidecar file entry (followed by the path and the field headers)
+typedef struct TCatalogEntry {
+   int64_t  Size;       // Size of the file when scanned
+   int64_t  MTime;      // Modification time of the file when scanned
+   int32_t  Type;       // Type of file
+   int32_t  N;          // Number of fields
+   int32_t  PathLen;    // Length of the path (without the terminating '\0')
+   int32_t  Pad;
+} TCatalogEntry;
+
+typedef struct TCatalogKey {
+   const char *Path;
+   int        Idx;
+} TCatalogKey;
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_New>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne un catalogue vide
+ *
+ * Parametres :
+ *    <Path>   : Le chemin du fichier sidecar
+ *
+ * Retour   : Le catalogue ou NULL en cas d'erreur
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+static TCatalog* Catalog_New(const char *Path) {
+   TCatalog *cat;
+
+   if( !(cat=calloc(1,sizeof(*cat))) || !(cat->Path=strdup(Path)) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+      APP_FREE(cat);
+      return NULL;
+   }
+   return cat;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Clear>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Vider un catalogue de ses entrées
+ *
+ * Parametres :
+ *    <Cat>    : Le catalogue
+ *
+ * Retour   :
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+static void Catalog_Clear(TCatalog *Cat) {
+   int i;
+
+   for(i=0; i<Cat->NFile; ++i) {
+      APP_FREE(Cat->Files[i].Path);
+      APP_FREE(Cat->Files[i].Fields);
+   }
+   APP_FREE(Cat->Files);
+   APP_FREE(Cat->Set);
+   APP_FREE(Cat->Keys);
+   Cat->NFile = 0;
+   Cat->NSet = 0;
+   Cat->NKey = 0;
+   Cat->Complete = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Free>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Libérer un catalogue
+ *
+ * Parametres :
+ *    <Cat>    : Le catalogue
+ *
+ * Retour   :
+ *
+ * Remarques : Le catalogue n'est pas sauvegardé (voir Catalog_Save)
+ *
+ *----------------------------------------------------------------------------
+ */
+void Catalog_Free(TCatalog *Cat) {
+   if( Cat ) {
+      Catalog_Clear(Cat);
+      APP_FREE(Cat->Path);
+      free(Cat);
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Load>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Charger un catalogue depuis son fichier sidecar
+ *
+ * Parametres :
+ *    <Path>   : Le chemin du fichier sidecar
+ *
+ * Retour   : Le catalogue ou NULL en cas d'erreur
+ *
+ * Remarques :
+ *    - Si le fichier n'existe pas ou est invalide, un catalogue vide est
+ *      retourné et sera écrit au prochain Catalog_Save
+ *
+ *----------------------------------------------------------------------------
+ */
+TCatalog* Catalog_Load(const char *Path) {
+   TCatalog       *cat;
+   TCatalogHeader head;
+   TCatalogEntry  entry;
+   TCatalogFile   *file;
+   FILE           *fp;
+   int            i,j;
+
+   if( !Path || !(cat=Catalog_New(Path)) )
+      return NULL;
+
+   if( !(fp=fopen(Path,"rb")) ) {
+      // No catalogue yet
+      cat->Dirty = 1;
+      return cat;
+   }
+
+   if( fread(&head,sizeof(head),1,fp)!=1 || head.Magic!=CATALOG_MAGIC || head.Version!=CATALOG_VERSION || head.FSize!=sizeof(TCatalogField) || head.NFile<0 ) {
+      Lib_Log(APP_LIBEER,APP_WARNING,"Catalog: Invalid or incompatible catalogue %s, it will be rebuilt\n",Path);
+      goto invalid;
+   }
+
+   if( !(cat->Files=calloc(head.NFile?head.NFile:1,sizeof(*cat->Files))) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+      goto invalid;
+   }
+
+   for(i=0; i<head.NFile; ++i) {
+      file = &cat->Files[cat->NFile];
+
+      if( fread(&entry,sizeof(entry),1,fp)!=1 || entry.N<0 || entry.PathLen<=0 || entry.PathLen>=PATH_MAX ) {
+         Lib_Log(APP_LIBEER,APP_WARNING,"Catalog: Truncated catalogue %s, it will be rebuilt\n",Path);
+         goto invalid;
+      }
+      ++cat->NFile;
+
+      file->Size  = entry.Size;
+      file->MTime = entry.MTime;
+      file->Type  = entry.Type;
+      file->N     = entry.N;
+      if( !(file->Path=calloc(entry.PathLen+1,1)) || !(file->Fields=malloc((entry.N?entry.N:1)*sizeof(*file->Fields))) ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+         goto invalid;
+      }
+      if( fread(file->Path,entry.PathLen,1,fp)!=1 || (entry.N && fread(file->Fields,sizeof(*file->Fields),entry.N,fp)!=(size_t)entry.N) ) {
+         Lib_Log(APP_LIBEER,APP_WARNING,"Catalog: Truncated catalogue %s, it will be rebuilt\n",Path);
+         goto invalid;
+      }
+      for(j=0; j<file->N; ++j) {
+         file->Fields[j].File = i;
+         file->Fields[j].Key  = -1;
+      }
+   }
+
+   fclose(fp);
+   return cat;
+
+invalid:
+   fclose(fp);
+   Catalog_Clear(cat);
+   cat->Dirty = 1;
+   return cat;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Save>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Écrire un catalogue dans son fichier sidecar
+ *
+ * Parametres :
+ *    <Cat>    : Le catalogue
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - Rien n'est écrit si le catalogue n'a pas changé
+ *    - Le fichier est écrit sous un nom temporaire puis renommé, pour que
+ *      les lecteurs concurrents voient toujours un catalogue complet
+ *
+ *----------------------------------------------------------------------------
+ */
+int Catalog_Save(TCatalog *Cat) {
+   TCatalogHeader head;
+   TCatalogEntry  entry;
+   TCatalogFile   *file;
+   FILE           *fp;
+   char           tmp[PATH_MAX];
+   int            i;
+
+   if( !Cat )
+      return APP_ERR;
+
+   if( !Cat->Dirty )
+      return APP_OK;
+
+   snprintf(tmp,PATH_MAX,"%s.%d",Cat->Path,(int)getpid());
+   if( !(fp=fopen(tmp,"wb")) ) {
+      Lib_Log(APP_LIBEER,APP_WARNING,"Catalog: Could not write catalogue %s\n",tmp);
+      return APP_ERR;
+   }
+
+   head = (TCatalogHeader){CATALOG_MAGIC,CATALOG_VERSION,sizeof(TCatalogField),Cat->NFile};
+   if( fwrite(&head,sizeof(head),1,fp)!=1 )
+      goto error;
+
+   for(i=0,file=Cat->Files; i<Cat->NFile; ++i,++file) {
+      entry = (TCatalogEntry){file->Size,file->MTime,file->Type,file->N,(int32_t)strlen(file->Path),0};
+      if( fwrite(&entry,sizeof(entry),1,fp)!=1
+            || fwrite(file->Path,entry.PathLen,1,fp)!=1
+            || (file->N && fwrite(file->Fields,sizeof(*file->Fields),file->N,fp)!=(size_t)file->N) )
+         goto error;
+   }
+
+   if( fclose(fp) ) {
+      fp = NULL;
+      goto error;
+   }
+
+   if( rename(tmp,Cat->Path) ) {
+      Lib_Log(APP_LIBEER,APP_WARNING,"Catalog: Could not replace catalogue %s\n",Cat->Path);
+      unlink(tmp);
+      return APP_ERR;
+   }
+
+   Cat->Dirty = 0;
+   return APP_OK;
+
+error:
+   Lib_Log(APP_LIBEER,APP_WARNING,"Catalog: Problem writing catalogue %s\n",tmp);
+   if( fp ) fclose(fp);
+   unlink(tmp);
+   return APP_ERR;
+}
+
+// Copy a fortran string without its trailing spaces
+static void Catalog_StrCpy(char *Dest,const char *Src,size_t Max) {
+   size_t n;
+
+   for(n=strnlen(Src,Max); n>0&&Src[n-1]==' '; --n)
+      ;
+   memcpy(Dest,Src,n);
+   Dest[n] = '\0';
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_ScanBF>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire les entêtes d'un fichier BinaryFile
+ *
+ * Parametres :
+ *    <File>   : L'entrée du fichier à remplir
+ *    <Idx>    : L'index du fichier dans le catalogue
+ *    <BF>     : Le fichier s'il est déjà ouvert (NULL sinon)
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - Si le fichier est déjà ouvert, son index en mémoire est utilisé
+ *
+ *----------------------------------------------------------------------------
+ */
+static int Catalog_ScanBF(TCatalogFile *File,int Idx,const TBFFile *BF) {
+   TBFFiles       *bf=NULL;
+   TBFFldHeader   *h;
+   TCatalogField  *f;
+   int            i,n;
+
+   if( !BF ) {
+      if( !(bf=BinaryFile_Open(File->Path,BF_READ)) )
+         return APP_ERR;
+      BF = &bf->Files[0];
+   }
+
+   n = BF->Index.N;
+   if( !(File->Fields=malloc((n?n:1)*sizeof(*File->Fields))) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+      if( bf ) BinaryFile_Close(bf);
+      return APP_ERR;
+   }
+
+   for(i=0,h=BF->Index.Headers,f=File->Fields; i<n; ++i,++h,++f) {
+      memset(f,0,sizeof(*f));
+      f->DATEV = BinaryFile_DateV(h->DATEO,h->DEET,h->NPAS);
+      f->DATEO = h->DATEO;
+      f->DEET  = h->DEET;
+      f->NPAS  = h->NPAS;
+      f->NI    = h->NI;
+      f->NJ    = h->NJ;
+      f->NK    = h->NK;
+      f->NBITS = h->NBITS;
+      f->DATYP = h->DATYP;
+      f->IP1   = h->IP1;
+      f->IP2   = h->IP2;
+      f->IP3   = h->IP3;
+      f->IG1   = h->IG1;
+      f->IG2   = h->IG2;
+      f->IG3   = h->IG3;
+      f->IG4   = h->IG4;
+      Catalog_StrCpy(f->TYPVAR,h->TYPVAR,2);
+      Catalog_StrCpy(f->NOMVAR,h->NOMVAR,4);
+      Catalog_StrCpy(f->ETIKET,h->ETIKET,12);
+      f->GRTYP[0] = h->GRTYP;
+      f->File  = Idx;
+      f->Idx   = i;
+      f->Key   = -1;
+   }
+   File->N = n;
+   File->Type = CAT_BF;
+
+   if( bf ) BinaryFile_Close(bf);
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_ScanRPN>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire les entêtes d'un fichier standard
+ *
+ * Parametres :
+ *    <File>   : L'entrée du fichier à remplir
+ *    <Idx>    : L'index du fichier dans le catalogue
+ *    <Unit>   : L'unité du fichier s'il est déjà ouvert (-1 sinon)
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *    - Si le fichier est déjà ouvert, les handles des champs sont conservés
+ *      (TCatalogField.Key). L'unité ne doit pas encore être liée (fstlnk),
+ *      sinon la recherche déborderait sur les fichiers suivants
+ *
+ *----------------------------------------------------------------------------
+ */
+static int Catalog_ScanRPN(TCatalogFile *File,int Idx,int Unit) {
+#ifdef HAVE_RMN
+   TRPNHeader     h;
+   TCatalogField  *f;
+   int            fid,i,n,*flds=NULL;
+
+   if( (fid=Unit)<0 && (fid=cs_fstouv(File->Path,"STD+RND+R/O"))<0 ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Problem opening file %s\n",File->Path);
+      return APP_ERR;
+   }
+
+   if( RPN_GetAllFields(fid,-1,"",-1,-1,-1,"","",&flds,&n)!=APP_OK || !(File->Fields=malloc((n?n:1)*sizeof(*File->Fields))) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not list the fields of %s\n",File->Path);
+      APP_FREE(flds);
+      if( Unit<0 ) cs_fstfrm(fid);
+      return APP_ERR;
+   }
+
+   for(i=0,f=File->Fields; i<n; ++i,++f) {
+      memset(&h,0,sizeof(h));
+      if( cs_fstprm(flds[i],&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
+            h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3) ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Couldn't get info on field (cs_fstprm) in %s\n",File->Path);
+         APP_FREE(File->Fields);
+         free(flds);
+         if( Unit<0 ) cs_fstfrm(fid);
+         return APP_ERR;
+      }
+
+      memset(f,0,sizeof(*f));
+      f->DATEV = BinaryFile_DateV(h.DATEO,h.DEET,h.NPAS);
+      f->DATEO = h.DATEO;
+      f->DEET  = h.DEET;
+      f->NPAS  = h.NPAS;
+      f->NI    = h.NI;
+      f->NJ    = h.NJ;
+      f->NK    = h.NK;
+      f->NBITS = h.NBITS;
+      f->DATYP = h.DATYP;
+      f->IP1   = h.IP1;
+      f->IP2   = h.IP2;
+      f->IP3   = h.IP3;
+      f->IG1   = h.IG1;
+      f->IG2   = h.IG2;
+      f->IG3   = h.IG3;
+      f->IG4   = h.IG4;
+      Catalog_StrCpy(f->TYPVAR,h.TYPVAR,2);
+      Catalog_StrCpy(f->NOMVAR,h.NOMVAR,4);
+      Catalog_StrCpy(f->ETIKET,h.ETIKET,12);
+      f->GRTYP[0] = h.GRTYP[0];
+      f->File  = Idx;
+      f->Idx   = i;
+      f->Key   = Unit<0 ? -1 : flds[i];
+   }
+   File->N = n;
+   File->Type = CAT_RPN;
+
+   free(flds);
+   if( Unit<0 ) cs_fstfrm(fid);
+   return APP_OK;
+#else
+   (void)File; (void)Idx; (void)Unit;
+   Lib_Log(APP_LIBEER,APP_ERROR,"%s: Need RMNLIB\n",__func__);
+   return APP_ERR;
+#endif
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_KeyRPN>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Associer les handles d'un fichier standard ouvert aux champs
+ *            déjà catalogués de ce fichier
+ *
+ * Parametres :
+ *    <File>   : L'entrée du fichier
+ *    <Unit>   : L'unité du fichier (pas encore liée)
+ *
+ * Retour   : APP_OK si ok, APP_ERR si le fichier doit être relu
+ *
+ * Remarques :
+ *    - Seul l'index du fichier est consulté (fstinl), les entêtes ne sont
+ *      pas relues
+ *
+ *----------------------------------------------------------------------------
+ */
+static int Catalog_KeyRPN(TCatalogFile *File,int Unit) {
+   int i,n,*flds=NULL;
+
+   if( File->Type!=CAT_RPN || RPN_GetAllFields(Unit,-1,"",-1,-1,-1,"","",&flds,&n)!=APP_OK || n!=File->N ) {
+      APP_FREE(flds);
+      return APP_ERR;
+   }
+   for(i=0; i<n; ++i) {
+      File->Fields[i].Key = flds[i];
+   }
+   free(flds);
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Scan>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire les entêtes d'un fichier (standard ou BinaryFile)
+ *
+ * Parametres :
+ *    <File>   : L'entrée du fichier à remplir
+ *    <Idx>    : L'index du fichier dans le catalogue
+ *    <Unit>   : L'unité du fichier standard s'il est déjà ouvert (-1 sinon)
+ *    <BF>     : Le BinaryFile s'il est déjà ouvert (NULL sinon)
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+static int Catalog_Scan(TCatalogFile *File,int Idx,int Unit,const TBFFile *BF) {
+   TBFFileHeader  head;
+   FILE           *fp;
+   int            bf=0;
+
+   APP_FREE(File->Fields);
+   File->N = 0;
+   File->Type = CAT_UNKNOWN;
+
+   if( BF ) return Catalog_ScanBF(File,Idx,BF);
+   if( Unit>=0 ) return Catalog_ScanRPN(File,Idx,Unit);
+
+   // Look for the BinaryFile magic number
+   if( (fp=fopen(File->Path,"rb")) ) {
+      bf = fread(&head,sizeof(head),1,fp)==1 && head.Magic==BF_MAGIC;
+      fclose(fp);
+   }
+
+   return bf ? Catalog_ScanBF(File,Idx,NULL) : Catalog_ScanRPN(File,Idx,-1);
+}
+
+static int Catalog_CmpKey(const void *A,const void *B) {
+   return strcmp(((const TCatalogKey*)A)->Path,((const TCatalogKey*)B)->Path);
+}
+
+static int Catalog_CmpHandle(const void *A,const void *B) {
+   int32_t a=(*(TCatalogField* const*)A)->Key,b=(*(TCatalogField* const*)B)->Key;
+
+   return (a>b)-(a<b);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Sync>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Synchroniser le catalogue avec une liste de fichiers
+ *
+ * Parametres :
+ *    <Cat>    : Le catalogue
+ *    <Files>  : La liste des fichiers
+ *    <N>      : Le nombre de fichiers
+ *    <Units>  : Les unités des fichiers standards déjà ouverts, dans l'ordre
+ *               de Files (NULL si les fichiers ne sont pas ouverts)
+ *    <BF>     : Les BinaryFile déjà ouverts, dans l'ordre de Files (NULL si
+ *               les fichiers ne sont pas ouverts)
+ *
+ * Retour   : APP_OK si ok, APP_ERR si au moins un fichier n'a pu être lu
+ *
+ * Remarques :
+ *    - Les fichiers dont la taille ou la date de modification ont changé,
+ *      ainsi que les nouveaux fichiers, sont relus
+ *    - Seuls les fichiers de la liste sont actifs (visibles par Catalog_Find),
+ *      dans l'ordre de la liste. Un fichier présent plusieurs fois dans la
+ *      liste n'est actif qu'une fois. Les autres entrées sont conservées pour
+ *      les autres ensembles de fichiers partageant le même catalogue
+ *    - Avec Units, les handles des champs sont conservés et indexés (voir
+ *      Catalog_FindKey). Les unités ne doivent pas encore être liées
+ *
+ *----------------------------------------------------------------------------
+ */
+int Catalog_Sync(TCatalog *Cat,const char **Files,int N,const int *Units,const struct TBFFiles *BF) {
+   TCatalogKey    *keys=NULL,key,*found;
+   TCatalogFile   *file;
+   TCatalogField  **flds;
+   const TBFFile  *bf;
+   struct stat    st;
+   char           path[PATH_MAX];
+   int            i,j,lo,hi,idx,nk,unit,code=APP_OK;
+
+   if( !Cat || !Files || N<0 || (BF && BF->N<N) )
+      return APP_ERR;
+
+   // Sort the known entries by path so that lookups are in O(log n)
+   nk = Cat->NFile;
+   APP_FREE(Cat->Set);
+   APP_FREE(Cat->Keys);
+   Cat->NSet = Cat->NKey = Cat->Complete = 0;
+   if( !(keys=malloc((nk+N+1)*sizeof(*keys))) || !(Cat->Set=malloc((N+1)*sizeof(*Cat->Set))) ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+      free(keys);
+      return APP_ERR;
+   }
+   for(i=0; i<nk; ++i) {
+      Cat->Files[i].Active = 0;
+      keys[i] = (TCatalogKey){Cat->Files[i].Path,i};
+   }
+   qsort(keys,nk,sizeof(*keys),Catalog_CmpKey);
+
+   for(i=0; i<N; ++i) {
+      unit = Units ? Units[i] : -1;
+      bf   = BF ? &BF->Files[i] : NULL;
+
+      if( !realpath(Files[i],path) || stat(path,&st) ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not stat file %s\n",Files[i]);
+         code = APP_ERR;
+         continue;
+      }
+
+      key.Path = path;
+      if( (found=bsearch(&key,keys,nk,sizeof(*keys),Catalog_CmpKey)) ) {
+         idx = found->Idx;
+         if( Cat->Files[idx].Active ) {
+            // Same file listed more than once
+            continue;
+         }
+      } else {
+         if( !(file=realloc(Cat->Files,(Cat->NFile+1)*sizeof(*Cat->Files))) ) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+            code = APP_ERR;
+            break;
+         }
+         Cat->Files = file;
+         idx = Cat->NFile;
+         memset(&Cat->Files[idx],0,sizeof(*Cat->Files));
+         if( !(Cat->Files[idx].Path=strdup(path)) ) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+            code = APP_ERR;
+            break;
+         }
+         Cat->Files[idx].Size = -1;
+         ++Cat->NFile;
+
+         // Keep the keys sorted so that the new entry is found if listed again
+         for(lo=0,hi=nk; lo<hi; ) {
+            j = (lo+hi)/2;
+            if( strcmp(keys[j].Path,path)<0 ) lo=j+1; else hi=j;
+         }
+         j = lo;
+         memmove(keys+j+1,keys+j,(nk-j)*sizeof(*keys));
+         keys[j] = (TCatalogKey){Cat->Files[idx].Path,idx};
+         ++nk;
+      }
+
+      file = &Cat->Files[idx];
+      if( file->Size!=st.st_size || file->MTime!=st.st_mtime || (unit>=0 && Catalog_KeyRPN(file,unit)!=APP_OK) ) {
+         Lib_Log(APP_LIBEER,APP_DEBUG,"Catalog: Scanning %s\n",path);
+         Cat->Dirty = 1;
+         if( Catalog_Scan(file,idx,unit,bf)!=APP_OK ) {
+            file->Size = -1;
+            code = APP_ERR;
+            continue;
+         }
+         file->Size  = st.st_size;
+         file->MTime = st.st_mtime;
+      } else if( unit<0 ) {
+         for(j=0; j<file->N; ++j)
+            file->Fields[j].Key = -1;
+      }
+      file->Active = 1;
+      Cat->Set[Cat->NSet++] = idx;
+      Cat->NKey += unit>=0 ? file->N : 0;
+   }
+   free(keys);
+
+   // Index the linked fields by handle
+   if( Units && Cat->NKey ) {
+      if( !(Cat->Keys=malloc(Cat->NKey*sizeof(*Cat->Keys))) ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: Could not allocate memory\n");
+         Cat->NKey = 0;
+         return APP_ERR;
+      }
+      for(i=0,flds=Cat->Keys; i<Cat->NSet; ++i) {
+         file = &Cat->Files[Cat->Set[i]];
+         for(j=0; j<file->N; ++j) {
+            if( file->Fields[j].Key>=0 )
+               *flds++ = &file->Fields[j];
+         }
+      }
+      Cat->NKey = (int32_t)(flds-Cat->Keys);
+      qsort(Cat->Keys,Cat->NKey,sizeof(*Cat->Keys),Catalog_CmpHandle);
+   } else {
+      Cat->NKey = 0;
+   }
+
+   Cat->Complete = code==APP_OK;
+   return code;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Get>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Charger, synchroniser et sauvegarder le catalogue par défaut
+ *            d'une liste de fichiers
+ *
+ * Parametres :
+ *    <Files>  : La liste des fichiers
+ *    <N>      : Le nombre de fichiers
+ *    <Units>  : Les unités des fichiers déjà ouverts (voir Catalog_Sync)
+ *    <BF>     : Les BinaryFile déjà ouverts (voir Catalog_Sync)
+ *
+ * Retour   : Le catalogue ou NULL en cas d'erreur
+ *
+ * Remarques :
+ *    - Le catalogue est le fichier CATALOG_NAME du répertoire du premier
+ *      fichier. S'il ne peut être écrit, le catalogue reste en mémoire
+ *    - TCatalog.Complete indique si tous les fichiers ont pu être catalogués
+ *
+ *----------------------------------------------------------------------------
+ */
+TCatalog* Catalog_Get(const char **Files,int N,const int *Units,const struct TBFFiles *BF) {
+   TCatalog *cat;
+   char     dir[PATH_MAX],path[PATH_MAX];
+
+   if( !Files || N<=0 )
+      return NULL;
+
+   strncpy(dir,Files[0],PATH_MAX-1);
+   dir[PATH_MAX-1] = '\0';
+   snprintf(path,PATH_MAX,"%s/%s",dirname(dir),CATALOG_NAME);
+
+   if( !(cat=Catalog_Load(path)) )
+      return NULL;
+
+   if( Catalog_Sync(cat,Files,N,Units,BF)!=APP_OK ) {
+      Lib_Log(APP_LIBEER,APP_WARNING,"Catalog: Some files could not be cataloged\n");
+   }
+   Catalog_Save(cat);
+
+   return cat;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_FindKey>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne le champ correspondant à un handle de fichiers liés
+ *
+ * Parametres :
+ *    <Cat>    : Le catalogue
+ *    <Key>    : Le handle du champ
+ *
+ * Retour   : Le champ ou NULL s'il n'est pas dans le catalogue
+ *
+ * Remarques :
+ *    - Seuls les champs synchronisés avec leurs unités sont indexés
+ *      (voir Catalog_Sync)
+ *
+ *----------------------------------------------------------------------------
+ */
+TCatalogField* Catalog_FindKey(const TCatalog *Cat,int Key) {
+   TCatalogField  fld,*key=&fld,**found;
+
+   if( !Cat || !Cat->NKey || Key<0 )
+      return NULL;
+
+   fld.Key = Key;
+   found = bsearch(&key,Cat->Keys,Cat->NKey,sizeof(*Cat->Keys),Catalog_CmpHandle);
+   return found ? *found : NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_Find>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne la liste des champs correspondants aux critères donnés
+ *
+ * Parametres :
+ *    <Cat>    : Le catalogue
+ *    <DateV>  : Date valide (-1 pour toutes les dates)
+ *    <Etiket> : L'etiket (String vide ou NULL pour toutes les etiket)
+ *    <IP1>    : IP1 du champ (-1 pour tous les IP1)
+ *    <IP2>    : IP2 du champ (-1 pour tous les IP2)
+ *    <IP3>    : IP3 du champ (-1 pour tous les IP3)
+ *    <TypVar> : Le typvar (String vide ou NULL pour tous les typvar)
+ *    <NomVar> : Le nomvar (String vide ou NULL pour tous les nomvar)
+ *    <Flds>   : [OUT] Les champs trouvés (dans l'ordre des fichiers)
+ *    <NFld>   : [OUT] Le nombre de champs trouvés
+ *
+ * Retour   : APP_ERR si erreur, APP_OK si ok.
+ *
+ * Remarques :
+ *    - Seuls les fichiers actifs (dernier Catalog_Sync) sont considérés,
+ *      dans l'ordre de la synchronisation
+ *    - La liste retournée doit être libérée par l'appelant; les champs
+ *      pointés appartiennent au catalogue
+ *
+ *----------------------------------------------------------------------------
+ */
+int Catalog_Find(TCatalog *Cat,int DateV,const char *Etiket,int IP1,int IP2,int IP3,const char *TypVar,const char *NomVar,TCatalogField ***Flds,int *NFld) {
+   TCatalogField  **flds,*f;
+   char           etiket[13],typvar[3],nomvar[5];
+   int            i,j,n=0,nmax=0;
+
+   *Flds = NULL;
+   *NFld = 0;
+
+   if( !Cat )
+      return APP_ERR;
+
+   Catalog_StrCpy(etiket,Etiket?Etiket:"",12);
+   Catalog_StrCpy(typvar,TypVar?TypVar:"",2);
+   Catalog_StrCpy(nomvar,NomVar?NomVar:"",4);
+
+   for(i=0; i<Cat->NSet; ++i) {
+      nmax += Cat->Files[Cat->Set[i]].N;
+   }
+   APP_MEM_ASRT( flds,malloc((nmax?nmax:1)*sizeof(*flds)) );
+
+   for(i=0; i<Cat->NSet; ++i) {
+      for(j=0,f=Cat->Files[Cat->Set[i]].Fields; j<Cat->Files[Cat->Set[i]].N; ++j,++f) {
+         if( (DateV==-1 || DateV==f->DATEV)
+               && (IP1==-1 || IP1==f->IP1)
+               && (IP2==-1 || IP2==f->IP2)
+               && (IP3==-1 || IP3==f->IP3)
+               && (!*nomvar || !strcmp(nomvar,f->NOMVAR))
+               && (!*typvar || !strcmp(typvar,f->TYPVAR))
+               && (!*etiket || !strcmp(etiket,f->ETIKET)) ) {
+            flds[n++] = f;
+         }
+      }
+   }
+
+   *Flds = flds;
+   *NFld = n;
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_GetDates>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne la liste des DateV d'une liste de champs
+ *
+ * Parametres :
+ *    <Flds>   : Les champs (voir Catalog_Find)
+ *    <NFld>   : Le nombre de champs
+ *    <Uniq>   : Si vrai, retourne la liste triée des dates uniques. Sinon,
+ *               retourne les dates dans l'ordre des champs
+ *    <DateV>  : [OUT] Les dates valides
+ *    <NDateV> : [OUT] Le nombre de dates retournées
+ *
+ * Retour   : APP_ERR si erreur, APP_OK si ok.
+ *
+ * Remarques :
+ *    - Équivalent de RPN_GetAllDates, sans accès aux fichiers
+ *
+ *----------------------------------------------------------------------------
+ */
+int Catalog_GetDates(TCatalogField **Flds,int NFld,int Uniq,int **DateV,int *NDateV) {
+   int i,*dates;
+
+   *DateV = NULL;
+   *NDateV = 0;
+   APP_MEM_ASRT( dates,malloc((NFld?NFld:1)*sizeof(*dates)) );
+
+   for(i=0; i<NFld; ++i) {
+      dates[i] = Flds[i]->DATEV;
+   }
+
+   if( Uniq ) {
+      qsort(dates,NFld,sizeof(*dates),QSort_Int);
+      Unique(dates,&NFld,sizeof(*dates));
+   }
+
+   *DateV = dates;
+   *NDateV = NFld;
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_GetIps>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne la liste des IPx d'une liste de champs
+ *
+ * Parametres :
+ *    <Flds>   : Les champs (voir Catalog_Find)
+ *    <NFld>   : Le nombre de champs
+ *    <IpN>    : Le numéro de l'ip voulu (1 for IP1, 2 for IP2, 3 for IP3)
+ *    <Uniq>   : Si vrai, retourne la liste triée des IPx uniques
+ *    <Ips>    : [OUT] Les IPx
+ *    <NIp>    : [OUT] Le nombre d'IPx retournés
+ *
+ * Retour   : APP_ERR si erreur, APP_OK si ok.
+ *
+ * Remarques :
+ *    - Équivalent de RPN_GetAllIps, sans accès aux fichiers
+ *
+ *----------------------------------------------------------------------------
+ */
+int Catalog_GetIps(TCatalogField **Flds,int NFld,int IpN,int Uniq,int **Ips,int *NIp) {
+   int i,*ips;
+
+   *Ips = NULL;
+   *NIp = 0;
+
+   if( IpN<1 || IpN>3 ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"Catalog: [%d] is not a valid IP number. Valid numbers are 1,2 and 3.\n",IpN);
+      return APP_ERR;
+   }
+   APP_MEM_ASRT( ips,malloc((NFld?NFld:1)*sizeof(*ips)) );
+
+   for(i=0; i<NFld; ++i) {
+      ips[i] = IpN==1 ? Flds[i]->IP1 : IpN==2 ? Flds[i]->IP2 : Flds[i]->IP3;
+   }
+
+   if( Uniq ) {
+      qsort(ips,NFld,sizeof(*ips),QSort_Int);
+      Unique(ips,&NFld,sizeof(*ips));
+   }
+
+   *Ips = ips;
+   *NIp = NFld;
+   return APP_OK;
+}
+
+static int Catalog_CmpVar(const void *A,const void *B) {
+   return strncmp((const char*)A,(const char*)B,5);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Catalog_GetVars>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne la liste des variables d'une liste de champs
+ *
+ * Parametres :
+ *    <Flds>   : Les champs (voir Catalog_Find)
+ *    <NFld>   : Le nombre de champs
+ *    <Uniq>   : Si vrai, retourne la liste triée des variables uniques
+ *    <Vars>   : [OUT] Les noms de variables, 5 caractères par nom ('\0' inclus)
+ *    <NVar>   : [OUT] Le nombre de variables retournées
+ *
+ * Retour   : APP_ERR si erreur, APP_OK si ok.
+ *
+ * Remarques :
+ *    - La i-ème variable est à (*Vars)+i*5
+ *
+ *----------------------------------------------------------------------------
+ */
+int Catalog_GetVars(TCatalogField **Flds,int NFld,int Uniq,char **Vars,int *NVar) {
+   char *vars;
+   int  i;
+
+   *Vars = NULL;
+   *NVar = 0;
+   APP_MEM_ASRT( vars,calloc(NFld?NFld:1,5) );
+
+   for(i=0; i<NFld; ++i) {
+      memcpy(vars+i*5,Flds[i]->NOMVAR,5);
+   }
+
+   if( Uniq ) {
+      qsort(vars,NFld,5,Catalog_CmpVar);
+      Unique(vars,&NFld,5);
+   }
+
+   *Vars = vars;
+   *NVar = NFld;
+   return APP_OK;
+}
@@ -0,0 +1,100 @@
+/*==============================================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadian
+ * 2121 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet    : Catalogue des entêtes de fichiers standards et BinaryFile
+ * Fichier   : Catalog.h
+ * Creation  : Octobre 2026
+ * Auteur    : Eric Legault-Ouellet
+ *
+ * Description: Catalogue persistant (fichier sidecar) des entêtes de champs
+ *              d'un ensemble de fichiers, pour éviter de relire les entêtes
+ *              de chaque fichier à chaque ouverture
+ *
+ * License:
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *==============================================================================
+ */
+#ifndef _CATALOG_H
+#define _CATALOG_H
+
+#include <inttypes.h>
+
+#define CATALOG_NAME ".eercat"   // Default sidecar name (in the directory of the first file)
+
+typedef enum TCatalogType {CAT_UNKNOWN,CAT_RPN,CAT_BF} TCatalogType;
+
+// Field header
+typedef struct TCatalogField {
+   int32_t  DATEV;            // Date de validité du champ
+   int32_t  DATEO;            // Date d'origine du champs
+   int32_t  DEET;             // Duree d'un pas de temps
+   int32_t  NPAS;             // Pas de temps
+   int32_t  NI,NJ,NK;         // Dimensions
+   int32_t  NBITS;            // Nombre de bits du champs
+   int32_t  DATYP;            // Type de donnees
+   int32_t  IP1,IP2,IP3;      // Specificateur du champs
+   int32_t  IG1,IG2,IG3,IG4;  // Descripteur de grille
+   char     TYPVAR[3];        // Type de variable
+   char     NOMVAR[5];        // Nom de la variable
+   char     ETIKET[13];       // Etiquette du champs
+   char     GRTYP[2];         // Type de grilles
+   int32_t  File;             // Index du fichier dans le catalogue
+   int32_t  Idx;              // Index du champ dans son fichier
+   int32_t  Key;              // Handle du champ dans les fichiers liés (-1 si aucun, non sauvegardé)
+} TCatalogField;
+
+// File entry
+typedef struct TCatalogFile {
+   char           *Path;      // Path of the file
+   int64_t        Size;       // Size of the file when scanned (bytes)
+   int64_t        MTime;      // Modification time of the file when scanned
+   TCatalogType   Type;       // Type of file
+   int32_t        N;          // Number of fields
+   TCatalogField  *Fields;    // Field headers
+   int            Active;     // Part of the last synchronized set
+} TCatalogFile;
+
+typedef struct TCatalog {
+   char           *Path;      // Path of the sidecar file
+   TCatalogFile   *Files;     // Files known to the catalogue
+   int32_t        NFile;      // Number of files
+   int32_t        *Set;       // Active files, in the order of the last synchronization
+   int32_t        NSet;       // Number of active files
+   TCatalogField  **Keys;     // Linked fields sorted by handle
+   int32_t        NKey;       // Number of linked fields
+   int            Complete;   // All the files of the last synchronization were cataloged
+   int            Dirty;      // Needs to be saved
+} TCatalog;
+
+struct TBFFiles;
+
+TCatalog* Catalog_Load(const char *Path);
+int       Catalog_Save(TCatalog *Cat);
+void      Catalog_Free(TCatalog *Cat);
+int       Catalog_Sync(TCatalog *Cat,const char **Files,int N,const int *Units,const struct TBFFiles *BF);
+TCatalog* Catalog_Get(const char **Files,int N,const int *Units,const struct TBFFiles *BF);
+
+TCatalogField* Catalog_FindKey(const TCatalog *Cat,int Key);
+int Catalog_Find(TCatalog *Cat,int DateV,const char *Etiket,int IP1,int IP2,int IP3,const char *TypVar,const char *NomVar,TCatalogField ***Flds,int *NFld);
+int Catalog_GetDates(TCatalogField **Flds,int NFld,int Uniq,int **DateV,int *NDateV);
+int Catalog_GetIps(TCatalogField **Flds,int NFld,int IpN,int Uniq,int **Ips,int *NIp);
+int Catalog_GetVars(TCatalogField **Flds,int NFld,int Uniq,char **Vars,int *NVar);
+
+#endif // _CATALOG_H
@@ -43,6 +43,7 @@
 #include "GeoRef.h"
 #include "eerUtils.h"
 #include "Vertex.h"
+#include "OMP_Utils.h"
 
 // Sizes in bytes of the different data types
 // TODO: revisit for architecture dependencies
@@ -595,6 +596,12 @@ int Def_Paste(TDef *DefTo,TDef *DefPaste,int X0, int Y0) {
  * Retour       :
  *
  * Remarques    :
+ *   - Les polygones sont remplis par balayage avec une table des aretes actives: les aretes
+ *     sont extraites une seule fois et triees selon Y, seules celles qui croisent la rangee
+ *     courante sont evaluees
+ *   - Les lignes sont tracees par Bresenham en segments horizontaux
+ *   - Les segments horizontaux sont appliques par Def_SetSpan, specialise par type et mode
+ *     de combinaison
  *
  *---------------------------------------------------------------------------------------------------------------
 */
@@ -624,17 +631,70 @@ static void inline Def_SetValue(TDef *Def,int X, int Y,int Z, double Value,TDef_
    }
 }
 
+// Combinaison d'un segment de N points d'un type donne, meme traitement que Def_SetValue
+#define DEF_SETSPAN(TYPE) {\
+   TYPE *data=(TYPE*)Def->Data[0]+idx;\
+   switch(Comb) {\
+      case CB_REPLACE: for(x=0;x<n;x++) data[x]=Value; break;\
+      case CB_MIN    : for(x=0;x<n;x++) { val=data[x]; if (!(val==val && val!=nodata)) val=0.0; if (Value<val) data[x]=Value; } break;\
+      case CB_MAX    : for(x=0;x<n;x++) { val=data[x]; if (!(val==val && val!=nodata)) val=0.0; if (Value>val) data[x]=Value; } break;\
+      case CB_AVERAGE: for(x=0;x<n;x++) Def->Accum[idx+x]++;\
+      case CB_SUM    : for(x=0;x<n;x++) { val=data[x]; if (!(val==val && val!=nodata)) val=0.0; data[x]=Value+val; } break;\
+   }\
+}
+
+static void Def_SetSpan(TDef *Def,int X0,int X1,int Y,double Value,TDef_Combine Comb) {
+
+   unsigned long idx;
+   double        val,nodata=Def->NoData;
+   int           x,n;
+
+   // Clip the span to the grid
+   if (Y<0 || Y>=Def->NJ) return;
+   if (X0<0) X0=0;
+   if (X1>=Def->NI) X1=Def->NI-1;
+   if (X0>X1) return;
+
+   idx=FIDX2D(Def,X0,Y);
+   n=X1-X0+1;
+
+   switch(Def->Type) {
+      case TD_UByte:   DEF_SETSPAN(unsigned char);      break;
+      case TD_Byte:    DEF_SETSPAN(char);               break;
+      case TD_UInt16:  DEF_SETSPAN(unsigned short);     break;
+      case TD_Int16:   DEF_SETSPAN(short);              break;
+      case TD_UInt32:  DEF_SETSPAN(unsigned int);       break;
+      case TD_Int32:   DEF_SETSPAN(int);                break;
+      case TD_UInt64:  DEF_SETSPAN(unsigned long long); break;
+      case TD_Int64:   DEF_SETSPAN(long long);          break;
+      case TD_Float32: DEF_SETSPAN(float);              break;
+      case TD_Float64: DEF_SETSPAN(double);             break;
+      case TD_Unknown:
+      case TD_Binary:
+      default:         for(x=X0;x<=X1;x++) Def_SetValue(Def,x,Y,0,Value,Comb);
+   }
+}
+
+typedef struct {
+   double X0,Y0,X1,Y1;           // Extremites de l'arete (Y0<Y1, ou Y0==Y1 pour un segment horizontal)
+} TDef_Edge;
+
+static int QSort_DefEdge(const void *A,const void *B) {
+   const TDef_Edge *a=(const TDef_Edge*)A,*b=(const TDef_Edge*)B;
+
+   return((a->Y0>b->Y0)-(a->Y0<b->Y0));
+}
+
 int Def_Rasterize(TDef *Def,TGeoRef *Ref,OGRGeometryH Geom,double Value,TDef_Combine Comb) {
 
 #ifdef HAVE_GDAL
    int    i,j,g,ind1,ind2;
    int    x,y,miny,maxy,minx,maxx;
-   int    ints,n,ns,np;
-   int   *polyInts;
+   int    ints,n,ns,np,ne,nh,na,ie,ih;
+   int   *polyInts,*act;
    double dminy,dmaxy,dx1,dy1,dx2,dy2,dy;
-   double intersect,tmpd;
-   int    horizontal_x1,horizontal_x2;
-   int    dnx,dny,x0,x1,y0,y1,fr,sx,sy;
+   int    dnx,dny,x0,x1,y0,y1,fr,sx,sy,xs;
+   TDef_Edge *edges,*hors;
 
    OGRGeometryH geom;
 
@@ -713,16 +773,20 @@ int Def_Rasterize(TDef *Def,TGeoRef *Ref,OGRGeometryH Geom,double Value,TDef_Com
             if (FIN2D(Def,x0,y0))
                Def_Set(Def,0,FIDX2D(Def,x0,y0),Value);
             if (dnx>dny) {
+               // Accumulate the points of a same row and apply them as a single span
                fr=dny-(dnx>>1);
+               xs=x0+sx;
                while(x0!=x1) {
                   if (fr>=0) {
+                     if (x0!=xs-sx) Def_SetSpan(Def,sx>0?xs:x0,sx>0?x0:xs,y0,Value,Comb);
                      y0+=sy;
                      fr-=dnx;
+                     xs=x0+sx;
                   }
                   x0+=sx;
                   fr+=dny;
-                  Def_SetValue(Def,x0,y0,0,Value,Comb);
                }
+               if (x0!=xs-sx) Def_SetSpan(Def,sx>0?xs:x0,sx>0?x0:xs,y0,Value,Comb);
             } else {
                fr=dnx-(dny>>1);
                while(y0!=y1) {
@@ -745,83 +809,89 @@ int Def_Rasterize(TDef *Def,TGeoRef *Ref,OGRGeometryH Geom,double Value,TDef_Com
          maxx=Def->NI-1;
 
          polyInts=(int*)malloc(sizeof(int)*n);
+         act=(int*)malloc(sizeof(int)*n);
+         edges=(TDef_Edge*)malloc(sizeof(TDef_Edge)*n*2);
+         if (!polyInts || !act || !edges) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate edge table\n",__func__);
+            free(polyInts); free(act); free(edges);
+            return(0);
+         }
+         hors=edges+n;
+
+         // Build the edge table once, with the edges going up and the bottom horizontal segments apart
+         ne=nh=0;
+         ns=OGR_G_GetGeometryCount(Geom);
+         for (g=0;g<(ns==0?1:ns);g++) {
+            if (ns) {
+               geom=OGR_G_GetGeometryRef(Geom,g);
+            } else {
+               geom=Geom;
+            }
+            np=OGR_G_GetPointCount(geom);
+
+            for (i=0;i<np;i++) {
+               ind2=i;
+               ind1=i==0?np-1:i-1;
+
+               dx1=OGR_G_GetX(geom,ind1);
+               dy1=OGR_G_GetY(geom,ind1);
+
+               dx2=OGR_G_GetX(geom,ind2);
+               dy2=OGR_G_GetY(geom,ind2);
+
+               if (dy1<dy2) {
+                  edges[ne++]=(TDef_Edge){ dx1,dy1,dx2,dy2 };
+               } else if (dy1>dy2) {
+                  edges[ne++]=(TDef_Edge){ dx2,dy2,dx1,dy1 };
+               } else if (dx1>dx2) {
+                  /*AE: DO NOT skip bottom horizontal segments
+                  -Fill them separately-
+                  They are not taken into account twice.*/
+                  hors[nh++]=(TDef_Edge){ dx2,dy1,dx1,dy2 };
+               }
+               // skip top horizontal segments (they are already filled in the regular loop)
+            }
+         }
+         qsort(edges,ne,sizeof(TDef_Edge),QSort_DefEdge);
+         qsort(hors,nh,sizeof(TDef_Edge),QSort_DefEdge);
 
-         // Fix in 1.3: count a vertex only once
+         // Scan the rows, keeping the list of the edges crossing the current one
+         na=ie=ih=0;
          for (y=miny;y<=maxy;y++) {
             dy=y; // center height of line
-            ints=0 ;
 
-            // Initialize polyInts, otherwise it can sometimes causes a segfault
-            for (i=0;i<n;i++) {
-               polyInts[i]=-1;
+            // fill the horizontal segments lying on this line (separately from the rest)
+            for(;ih<nh && hors[ih].Y0<dy;ih++);
+            for(j=ih;j<nh && hors[j].Y0==dy;j++) {
+               x0=lrint(hors[j].X0);
+               x1=lrint(hors[j].X1);
+               if ((x0>maxx) || (x1<minx))
+                  continue;
+               Def_SetSpan(Def,x0,x1-1,y,Value,Comb);
             }
 
-            ns=OGR_G_GetGeometryCount(Geom);
-            for (g=0;g<(ns==0?1:ns);g++) {
-               if (ns) {
-                  geom=OGR_G_GetGeometryRef(Geom,g);
-               } else {
-                  geom=Geom;
-               }
-               np=OGR_G_GetPointCount(geom);
-
-               for (i=0;i<np;i++) {
-                  ind2=i;
-                  ind1=i==0?np-1:i-1;
-
-                  dx1=OGR_G_GetX(geom,ind1);
-                  dy1=OGR_G_GetY(geom,ind1);
-
-                  dx2=OGR_G_GetX(geom,ind2);
-                  dy2=OGR_G_GetY(geom,ind2);
-
-                  if ((dy1<dy && dy2<dy) || (dy1>dy && dy2>dy))
-                     continue;
-
-                  if (dy1<dy2) {
-                  } else if (dy1>dy2) {
-                     tmpd=dy2;
-                     dy2=dy1;
-                     dy1=tmpd;
-                     tmpd=dx2;
-                     dx2=dx1;
-                     dx1=tmpd;
-                  } else { // if (fabs(dy1-dy2)< 1.e-6)
-                           /*AE: DO NOT skip bottom horizontal segments
-                           -Fill them separately-
-                           They are not taken into account twice.*/
-                     if (dx1>dx2) {
-                        horizontal_x1=lrint(dx2);
-                        horizontal_x2=lrint(dx1);
-                        if ((horizontal_x1>maxx) || (horizontal_x2<minx))
-                           continue;
-
-                        // fill the horizontal segment (separately from the rest)
-                        for(x=horizontal_x1;x<horizontal_x2;x++)
-                           Def_SetValue(Def,x,y,0,Value,Comb);
-                        continue;
-                     } else {
-                        // skip top horizontal segments (they are already filled in the regular loop)
-                        continue;
-                     }
-                  }
+            // Activate the edges starting before this line and drop the ones ending on or before it
+            for(;ie<ne && edges[ie].Y0<=dy;ie++) act[na++]=ie;
+            for(i=j=0;i<na;i++) {
+               if (edges[act[i]].Y1>dy) act[j++]=act[i];
+            }
+            na=j;
 
-                  if ((dy<dy2) && (dy>=dy1)) {
-                     intersect=(dy-dy1)*(dx2-dx1)/(dy2-dy1)+dx1;
-                     polyInts[ints++]=lrint(intersect);
-                  }
-               }
+            for(i=ints=0;i<na;i++) {
+               const TDef_Edge *e=&edges[act[i]];
+               polyInts[ints++]=lrint((dy-e->Y0)*(e->X1-e->X0)/(e->Y1-e->Y0)+e->X0);
             }
             qsort(polyInts,ints,sizeof(int),QSort_Int);
 
-            for (i=0;i<ints;i+=2) {
+            for (i=0;i+1<ints;i+=2) {
                if (polyInts[i]<=maxx && polyInts[i+1]>=minx) {
-                  for(x=polyInts[i];x<=polyInts[i+1];x++)
-                     Def_SetValue(Def,x,y,0,Value,Comb);
+                  Def_SetSpan(Def,polyInts[i],polyInts[i+1],y,Value,Comb);
                }
             }
          }
          free(polyInts);
+         free(act);
+         free(edges);
          break;
    }
    return(1);
@@ -831,6 +901,115 @@ int Def_Rasterize(TDef *Def,TGeoRef *Ref,OGRGeometryH Geom,double Value,TDef_Com
 #endif
 }
 
+/*----------------------------------------------------------------------------------------------------------
+ * Nom          : <Def_MaskOGR>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Construire le masque d'un champs a partir d'un polygone
+ *
+ * Parametres   :
+ *   <Def>      : Definition des donnees raster
+ *   <Geom>     : Polygone (en coordonnees de grille)
+ *   <Comb>     : Mode de combinaison avec le masque existant (CB_REPLACE,CB_MIN=et,CB_MAX=ou)
+ *   <NThreads> : Nombre de threads (0 pour tous ceux disponibles)
+ *
+ * Retour       : Nombre de points de grille dans le polygone (-1 si erreur)
+ *
+ * Remarques    :
+ *   - Un point de grille est masque (1) si son centre est dans le polygone, le meme
+ *     critere que gpce_polygon_contains_point
+ *   - Le polygone est prepare une seule fois (gpce_prepare_polygon) et chaque rangee
+ *     est traitee d'un seul balayage (gpce_prepared_contains_row), ce qui evite
+ *     de parcourir tous les contours pour chaque point de grille
+ *   - Si le masque n'existe pas, il est cree et CB_REPLACE est utilise
+ *   - Le masque est le meme pour tous les niveaux
+ *   - Le polygone est d'abord rasterise dans un plan temporaire. En cas d'erreur,
+ *     le masque existant n'est pas modifie et aucun masque n'est cree
+ *
+ *---------------------------------------------------------------------------------------------------------------
+*/
+int Def_MaskOGR(TDef *Def,OGRGeometryH Geom,TDef_Combine Comb,int NThreads) {
+
+#if defined(HAVE_GDAL) && defined(HAVE_GPC)
+   gpc_polygon    poly;
+   gpce_prepared *prep;
+   char          *plane,*mask;
+   unsigned long  i;
+   int            j,k,n,nin=0,error=0;
+
+   if (!Def) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Invalid destination\n",__func__);
+      return(-1);
+   }
+   if (!Geom) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Invalid source\n",__func__);
+      return(-1);
+   }
+   if (Comb==CB_SUM || Comb==CB_AVERAGE) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Invalid combination mode for a mask, must be CB_REPLACE, CB_MIN or CB_MAX\n",__func__);
+      return(-1);
+   }
+
+   // The polygon is rasterized in a scratch plane, the mask is only modified once it is complete
+   if (!(plane=(char*)malloc(FSIZE2D(Def)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate mask plane\n",__func__);
+      return(-1);
+   }
+
+   OGM_GPCNew(&poly);
+   OGM_GPCFromOGR(&poly,Geom);
+   prep=gpce_prepare_polygon(&poly,0);
+   gpc_free_polygon(&poly);
+   if (!prep) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to prepare polygon\n",__func__);
+      free(plane);
+      return(-1);
+   }
+
+   #pragma omp parallel for private(j,n) shared(Def,prep,plane,error) reduction(+:nin) schedule(dynamic,16) num_threads(NThreads>0?NThreads:omp_get_max_threads()) if(NThreads!=1)
+   for(j=0;j<Def->NJ;j++) {
+      // Grid point centers of the row
+      if ((n=gpce_prepared_contains_row(prep,j,0.0,1.0,Def->NI,&plane[(unsigned long)j*Def->NI]))<0) {
+         OMP_ATOMIC_WRITE(error=1);
+      } else {
+         nin+=n;
+      }
+   }
+   gpce_prepared_free(prep);
+
+   if (error) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to compute the rows of the mask (gpce_prepared_contains_row)\n",__func__);
+      free(plane);
+      return(-1);
+   }
+
+   if (!Def->Mask) {
+      if (!(Def->Mask=(char*)malloc(FSIZE3D(Def)))) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate mask\n",__func__);
+         free(plane);
+         return(-1);
+      }
+      Comb=CB_REPLACE;
+   }
+
+   // Nothing can fail from here on, combine the plane in every level
+   for(k=0;k<Def->NK;k++) {
+      mask=&Def->Mask[(unsigned long)k*FSIZE2D(Def)];
+      switch(Comb) {
+         case CB_MIN: for(i=0;i<FSIZE2D(Def);i++) mask[i]=mask[i]&&plane[i]; break;
+         case CB_MAX: for(i=0;i<FSIZE2D(Def);i++) mask[i]=mask[i]||plane[i]; break;
+         default    : memcpy(mask,plane,FSIZE2D(Def));
+      }
+   }
+   free(plane);
+
+   return(nin);
+#else
+   Lib_Log(APP_LIBEER,APP_ERROR,"Function %s is not available, needs to be built with GDAL and GPC\n",__func__);
+   return(-1);
+#endif
+}
+
 /*--------------------------------------------------------------------------------------------------------------
  * Nom          : <Def_GridCell2OGR>
  * Creation     : Mars 2006 J.P. Gauthier - CMC/CMOE
@@ -1104,6 +1283,7 @@ int Def_GridInterpOGR(TDef *ToDef,TGeoRef *ToRef,OGR_Layer *Layer,TGeoRef *Layer
 
 #ifdef HAVE_GDAL
    long     f,n=0,nt=0,idx2;
+   size_t   mark;
    double   value,val,area,dp;
    int      fld=-1,pi,pj,error=0,isize=0;
    char     mode,type,*c;
@@ -1247,13 +1427,16 @@ int Def_GridInterpOGR(TDef *ToDef,TGeoRef *ToRef,OGR_Layer *Layer,TGeoRef *Layer
       }
 
       // Trouve la feature en intersection
-      #pragma omp parallel for private(f,geom,hgeom,utmgeom,env,co,value,vr,n,area,mode,type,lp) firstprivate(pick,poly) shared(Layer,LayerRef,ToRef,Mode,Comb,fld,tr,error,ip,index,isize) reduction(+:nt)
+      #pragma omp parallel for private(f,geom,hgeom,utmgeom,env,co,value,vr,n,area,mode,type,lp,mark) firstprivate(pick,poly) shared(Layer,LayerRef,ToRef,Mode,Comb,fld,tr,error,ip,index,isize) reduction(+:nt)
       for(f=0;f<Layer->NFeature;f++) {
          
          if (index) index[f]=NULL;
          if (error) continue;
          n=0;
 
+         // The master thread's arena may hold its caller's data, only release what this feature uses
+         mark=OGM_ArenaMark();
+
          if (Layer->Select[f] && Layer->Feature[f]) {
 
             geom=utmgeom=NULL;
@@ -1390,6 +1573,9 @@ int Def_GridInterpOGR(TDef *ToDef,TGeoRef *ToRef,OGR_Layer *Layer,TGeoRef *Layer
             }
             if (geom)    OGR_G_DestroyGeometry(geom);
             if (utmgeom) OGR_G_DestroyGeometry(utmgeom);
+
+            // Release this feature's geometry scratch space
+            OGM_ArenaRelease(mark);
          }
       }
 
@@ -340,6 +340,7 @@ TDef *Def_Resize(TDef *Def,int NI,int NJ,int NK);
 int   Def_Paste(TDef *DefTo,TDef *DefPaste,int X0,int Y0);
 
 int   Def_Rasterize(TDef *Def,struct TGeoRef *Ref,OGRGeometryH Geom,double Value,TDef_Combine Comb);
+int   Def_MaskOGR(TDef *Def,OGRGeometryH Geom,TDef_Combine Comb,int NThreads);
 int   Def_GridCell2OGR(OGRGeometryH Geom,struct TGeoRef *RefTo,struct TGeoRef *RefFrom,int I,int J,int Seg);
 
 int   Def_EZInterp(TDef *ToDef,TDef *FromDef,TGeoRef *ToRef,TGeoRef *FromRef,char *Interp,char *Extrap,char Mask,float *Index);
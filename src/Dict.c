@@ -37,7 +37,22 @@
 
 #include "Dict.h"
 #include "RPN.h"
+#include "OMP_Utils.h"
 #include <float.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define DICT_BINMAGIC   0x54434944   // DICT in little endian
+#define DICT_BINVERSION 1
+#define DICT_BINNULL    0xFFFFFFFF   // String table offset of a NULL string
+
+#define DICT_KEYLEN     40           // Maximum length of an index key
+#define DICT_MAXKEY     16           // Maximum number of index keys per element
 
 char *TSHORT[]      = { "Description courte ","Short Description  " };
 char *TLONG[]       = { "Description longue ","Long  Description  " };
@@ -75,10 +90,30 @@ char *TAND[]        = { "et","and" };
 char *TDAY[]        = { "le jour","day" };
 char *THOUR[]       = { "l'heure","hour" };
 
+typedef struct {
+   TList        **Nodes;                              // List nodes by list position
+   int            N;                                  // Number of nodes
+   int           *Pos;                                // List positions of each key, in list order
+   char         (*Keys)[DICT_KEYLEN];                 // Key of each entry ("<dimension>:<value>")
+   int           *Start,*Count;                       // Range of each key within Pos
+   int           *Slots;                              // Open addressing slots (key index, -1 if empty)
+   unsigned       Size;                               // Number of slots (power of 2)
+   int            Built;                              // Is the index up to date
+} TDictIndex;
+
+typedef int (TDictKeyProc)(void *Data,char Keys[][DICT_KEYLEN]);
+
+typedef struct {
+   int           *Pos[2],N[2],Cur[2];                 // Candidate positions (up to two lists walked merged)
+   unsigned       Gen;                                // Index generation of the positions
+} TDictCand;
+
 typedef struct {
    char          *Name,*Date,*Version,String[64];     // Dictionary metadata
    TList         *Vars;                               // List of dictionary variables
    TList         *Types;                              // List of dictionary types
+   TDictIndex     VarIdx,TypeIdx;                     // Name and search context indexes
+   unsigned       Gen;                                // Variable index generation
 } TDict;
 
 typedef struct {
@@ -89,13 +124,63 @@ typedef struct {
    char          *ETIKET;                             // Search etiket
    int            IP1,IP2,IP3;                        // IP to look for
    int            AltIP1,AltIP2,AltIP3;               // Alternate IP to look for (OLD/NEW)
+   TDictCand      Cand;                               // Candidates of the current iteration (Dict_IterateVar)
+   TList         *CandNext;                           // Iterator position matching the candidates
 } TDictSearch;
 
+// Compiled binary dictionary layout: header, var records, type records, code records and string table
+typedef struct {
+   int32_t  Magic,Version;                            // File identification
+   uint64_t StrSize;                                  // Size of the string table
+   int32_t  NVar,NType,NCode;                         // Number of records
+   uint32_t Name,Date,Ver,String;                     // Dictionary metadata (string table offsets)
+} TDictBinHeader;
+
+typedef struct {
+   int64_t  Date;
+   double   Min,Max,Magnitude,Factor,Delta,Precision;
+   float    Level;
+   int32_t  Nature,Pack,Kind,IP1,IP2,IP3;
+   int32_t  NCodes,NMeanings,Code;                    // Codes and meanings are in the code records starting at Code
+   uint32_t Origin,Name,Short[2],Long[2],Units,ETIKET;
+} TDictBinVar;
+
+typedef struct {
+   int64_t  Date;
+   int32_t  Nature;
+   uint32_t Origin,Name,Short[2],Long[2];
+} TDictBinType;
+
+typedef struct {
+   int32_t  Value;
+   uint32_t Meaning[2];
+} TDictBinCode;
+
+typedef struct {
+   char          *Buf;                                // String data
+   size_t         Len,Size;                           // Used and allocated size
+   uint32_t      *Slots;                              // Deduplication slots (offset+1, 0 if empty)
+   unsigned       NSlot,N;                            // Number of slots and of strings
+   int            Error;                              // Allocation error occured
+} TDictStrTable;
+
 static          TDict       Dict;                     // Global dictionary
 static __thread TDictSearch DictSearch;               // Per thread search params
+static pthread_mutex_t      DictMutex=PTHREAD_MUTEX_INITIALIZER;
 
-static int Dict_ParseVar(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encoding Encoding);
-static int Dict_ParseType(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encoding Encoding);
+typedef struct {
+   void          *Data;                               // TDictVar or TDictType
+   int            Idx;                                // Position in the document
+} TDictItem;
+
+static TDictVar*  Dict_ParseVar(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encoding Encoding);
+static TDictType* Dict_ParseType(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encoding Encoding);
+static TList*     Dict_Merge(TList *List,TList *New,TList_CompareProc *Proc);
+static TList*     Dict_ItemList(TDictItem *Items,int N,int (*Sort)(const void*,const void*));
+static int        Dict_SortItemVar(const void *A,const void *B);
+static int        Dict_SortItemType(const void *A,const void *B);
+static void       Dict_Index(void);
+static int        Dict_MatchVar(TDictVar *Var,char *Name,const TDictSearch *Search);
 
 char* strncpy0(char *restrict Dest,char *restrict Src,size_t Num) {
    strncpy(Dest,Src,Num-1);
@@ -336,6 +421,7 @@ void Dict_SetSearch(int SearchMode,int SearchState,char *SearchOrigin,int Search
    DictSearch.IP2=SearchIP2;
    DictSearch.IP3=SearchIP3;
    DictSearch.ETIKET=SearchETIKET;
+   DictSearch.CandNext=NULL;
 
 #ifdef HAVE_RMN
    if (DictSearch.IP1>0) {
@@ -374,17 +460,36 @@ void Dict_SetModifier(char *Modifier) {
  *
  * Remarques :
  *    - Based heavily on r.dict code
+ *    - Compiled binary dictionaries (Dict_Save) are recognized and loaded through Dict_Load
+ *    - The metvar and typvar nodes are parsed in parallel, then sorted once and
+ *      merged into the dictionary. The resulting order is the same as with one
+ *      sorted insertion per node in document order
+ *    - Nothing is added to the dictionary if any node fails to parse
  *----------------------------------------------------------------------------
 */
 int Dict_Parse(char *Filename,TDict_Encoding Encoding) {
 
    xmlDocPtr    doc;
    xmlNsPtr     ns;
-   xmlNodePtr   node;
+   xmlNodePtr   root,node,*xnodes=NULL;
    xmlDtdPtr    dtd ;
    xmlValidCtxt ctxt;
    xmlChar     *tmpc;
-   char        *c,ok,dtdfile[256];
+   char        *c,ok=0,dtdfile[256];
+   FILE        *fp;
+   int32_t      magic=0;
+   TDictItem   *vars=NULL,*types=NULL;
+   TList       *lvars=NULL,*ltypes=NULL;
+   int          n,v,t,nv,nt;
+
+   // Check for a compiled binary dictionary
+   if ((fp=fopen(Filename,"r"))) {
+      if (fread(&magic,sizeof(magic),1,fp)!=1) magic=0;
+      fclose(fp);
+   }
+   if (magic==DICT_BINMAGIC) {
+      return(Dict_Load(Filename));
+   }
 
    xmlDoValidityCheckingDefaultValue=1;
    LIBXML_TEST_VERSION
@@ -397,13 +502,15 @@ int Dict_Parse(char *Filename,TDict_Encoding Encoding) {
    }
 
    // Check the document is of the right kind
-   if (!(node = xmlDocGetRootElement(doc))) {
+   if (!(root=node=xmlDocGetRootElement(doc))) {
       Lib_Log(APP_LIBEER,APP_ERROR,"%s: Empty document\n",__func__);
       xmlFreeDoc(doc);
       return(0);
    }
 
-   Dict.Name=NULL;
+   APP_FREE(Dict.Name);
+   APP_FREE(Dict.Date);
+   APP_FREE(Dict.Version);
 
    tmpc=xmlGetProp(node,"date");
    Dict.Date=strdup(tmpc);
@@ -443,23 +550,70 @@ int Dict_Parse(char *Filename,TDict_Encoding Encoding) {
 
    node=node->children;
 
-   // Now, walk the tree
-   ok=1;
-   while (node) {
+   // Now, walk the tree to collect the variable and type nodes
+   for(nv=nt=0;node;node=node->next) {
+      if (!strcmp(node->name,"metvar")) nv++;
+      if (!strcmp(node->name,"typvar")) nt++;
+   }
+
+   APP_MEM_ASRT_END(xnodes,malloc((nv+nt+1)*sizeof(xmlNodePtr)));
+   APP_MEM_ASRT_END(vars,calloc(nv+1,sizeof(TDictItem)));
+   APP_MEM_ASRT_END(types,calloc(nt+1,sizeof(TDictItem)));
 
+   // Variable nodes first then type nodes, keeping their position in the document
+   for(n=v=t=0,node=root->children;node;node=node->next,n++) {
       if (!strcmp(node->name,"metvar")) {
-         if (!(ok=Dict_ParseVar(doc,ns,node,Encoding))) break;
+         vars[v].Idx=n;
+         xnodes[v++]=node;
       }
-
       if (!strcmp(node->name,"typvar")) {
-         if (!(ok=Dict_ParseType(doc,ns,node,Encoding))) break;
+         types[t].Idx=n;
+         xnodes[nv+t++]=node;
+      }
+   }
+
+   #pragma omp parallel for schedule(dynamic,16)
+   for(n=0;n<nv+nt;n++) {
+      if (n<nv) {
+         vars[n].Data=Dict_ParseVar(doc,ns,xnodes[n],Encoding);
+      } else {
+         types[n-nv].Data=Dict_ParseType(doc,ns,xnodes[n],Encoding);
+      }
+   }
+
+   // Every node has to be parsed, then sort once
+   for(v=0;v<nv && vars[v].Data;v++);
+   for(t=0;t<nt && types[t].Data;t++);
+   if (v==nv && t==nt) {
+      lvars=nv?Dict_ItemList(vars,nv,Dict_SortItemVar):NULL;
+      ltypes=nt?Dict_ItemList(types,nt,Dict_SortItemType):NULL;
+      if ((nv && !lvars) || (nt && !ltypes)) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for dictionary %s\n",__func__,Filename);
+      } else {
+         ok=1;
       }
+   }
 
-      node=node->next;
+   if (!ok) {
+      for(v=0;v<nv;v++) APP_FREE(vars[v].Data);
+      for(t=0;t<nt;t++) APP_FREE(types[t].Data);
+      APP_FREE(lvars);
+      APP_FREE(ltypes);
+      goto end;
    }
 
+   // Merge into the dictionary
+   Dict.Vars=Dict_Merge(Dict.Vars,lvars,Dict_SortVar);
+   Dict.Types=Dict_Merge(Dict.Types,ltypes,Dict_SortType);
+   OMP_ATOMIC_WRITE(Dict.VarIdx.Built=0);
+   OMP_ATOMIC_WRITE(Dict.TypeIdx.Built=0);
+
+end:
 //    xmlFreeDtd(dtd);
     xmlFreeDoc(doc);
+    APP_FREE(xnodes);
+    APP_FREE(vars);
+    APP_FREE(types);
 
     return(ok);
 }
@@ -477,19 +631,23 @@ int Dict_Parse(char *Filename,TDict_Encoding Encoding) {
  *  <Encoding> : Encoding mode (DICT_ASCII,DICT_UTF8,DICT_ISO8859_1)
  *
  * Retour:
+ *  <Var>      : Parsed variable (NULL on error)
  *
  * Remarques :
  *    - Based heavily on r.dict code
+ *    - Called in parallel on the nodes of a document by Dict_Parse
  *----------------------------------------------------------------------------
 */
-static int Dict_ParseVar(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encoding Encoding) {
+static TDictVar* Dict_ParseVar(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encoding Encoding) {
 
    TDictVar  *metvar;
    xmlNodePtr trotteur,trotteur1;
    char      *tmpc;
    int        i,y,m,d;
 
-   metvar=(TDictVar*)calloc(1,sizeof(TDictVar));
+   if (!(metvar=(TDictVar*)calloc(1,sizeof(TDictVar)))) {
+      return(NULL);
+   }
    metvar->IP1=metvar->IP2=metvar->IP3=metvar->Pack=-1;
    metvar->Min=metvar->Max=metvar->Magnitude=metvar->Precision=DICT_NOTSET;
    metvar->Level=FLT_MAX;
@@ -532,12 +690,14 @@ static int Dict_ParseVar(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encodin
       if (!strcmp((char*)Node->name,"nomvar")) {
          if( !(tmpc=xmlNodeListGetString(Doc,Node->children,1)) ) {
             Lib_Log(APP_LIBEER,APP_ERROR,"%s: Empty variable definition\n",__func__);
-            return(0);
+            free(metvar);
+            return(NULL);
          }
          strncpy0(metvar->Name,tmpc,5);
          xmlFree(tmpc);
          if (tmpc=(char*)xmlGetProp(Node,"ip1")) {
             metvar->IP1=atoi(tmpc);
+            #pragma omp critical(DictIP)
             IPDecode(metvar->IP1,&metvar->Level,&metvar->Kind);
             xmlFree(tmpc);
          }
@@ -668,12 +828,11 @@ static int Dict_ParseVar(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encodin
 
    // Will be usefull for the search later on
    if( metvar->IP1==-1 && metvar->Kind!=-1 && metvar->Level!=FLT_MAX ) {
+      #pragma omp critical(DictIP)
       metvar->IP1 = IPEncode(metvar->Level,metvar->Kind,1);
    }
 
-   Dict.Vars=TList_AddSorted(Dict.Vars,Dict_SortVar,metvar);
-
-   return(1);
+   return(metvar);
 }
 
 /*----------------------------------------------------------------------------
@@ -689,19 +848,23 @@ static int Dict_ParseVar(xmlDocPtr Doc,xmlNsPtr NS,xmlNodePtr Node,TDict_Encodin
  *  <Encoding> : Encoding mode (DICT_ASCII,DICT_UTF8,DICT_ISO8859_1)
  *
  * Retour:
+ *  <Type>     : Parsed type (NULL on error)
  *
  * Remarques :
  *    - Based heavily on r.dict code
+ *    - Called in parallel on the nodes of a document by Dict_Parse
  *----------------------------------------------------------------------------
 */
-static int Dict_ParseType(xmlDocPtr Doc, xmlNsPtr NS, xmlNodePtr Node,TDict_Encoding Encoding) {
+static TDictType* Dict_ParseType(xmlDocPtr Doc, xmlNsPtr NS, xmlNodePtr Node,TDict_Encoding Encoding) {
 
    TDictType *type;
    xmlNodePtr trotteur,trotteur1;
    xmlChar   *tmpc;
    int       y,m,d;
 
-   type=(TDictType*)calloc(1,sizeof(TDictType));
+   if (!(type=(TDictType*)calloc(1,sizeof(TDictType)))) {
+      return(NULL);
+   }
 
    if (tmpc=(char*)xmlGetProp(Node,"origin")) {
       strncpy0(type->Origin,tmpc,32);
@@ -754,11 +917,998 @@ static int Dict_ParseType(xmlDocPtr Doc, xmlNsPtr NS, xmlNodePtr Node,TDict_Enco
       Node=Node->next;
    }
 
-   Dict.Types=TList_AddSorted(Dict.Types,Dict_SortType,type);
+   return(type);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_Hash>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Hash a string (FNV-1a).
+ *
+ * Parametres  :
+ *  <Str>      : String to hash
+ *  <NoCase>   : Ignore case (same key for strcasecmp equal strings)
+ *
+ * Retour:
+ *  <Hash>     : Hash value
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static inline uint32_t Dict_Hash(const char *Str,int NoCase) {
+
+   uint32_t h=2166136261u;
+
+   while(*Str) {
+      h^=(unsigned char)(NoCase?toupper(*Str):*Str);
+      h*=16777619u;
+      Str++;
+   }
+   return(h);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_Merge>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Merge two sorted lists.
+ *
+ * Parametres  :
+ *  <List>     : Sorted list to merge into
+ *  <New>      : Sorted list to merge
+ *  <Proc>     : Sort procedure of both lists
+ *
+ * Retour:
+ *  <TList*>   : Head of the merged list
+ *
+ * Remarques :
+ *    - On ties, the nodes of New come first, as if they were added one by one
+ *      with TList_AddSorted
+ *----------------------------------------------------------------------------
+*/
+static TList* Dict_Merge(TList *List,TList *New,TList_CompareProc *Proc) {
+
+   TList head,*tail=&head;
+
+   head.Next=NULL;
+   while(List && New) {
+      if (Proc(List->Data,New->Data)>=0) {
+         tail->Next=New;
+         New=New->Next;
+      } else {
+         tail->Next=List;
+         List=List->Next;
+      }
+      tail->Next->Prev=tail;
+      tail=tail->Next;
+   }
+   if ((tail->Next=List?List:New)) {
+      tail->Next->Prev=tail;
+   }
+   if (head.Next) {
+      head.Next->Prev=NULL;
+   }
+   return(head.Next);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_SortItemVar>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Order two parsed variables (qsort).
+ *
+ * Parametres  :
+ *  <A>        : Variable item to compare to
+ *  <B>        : Variable item to compare
+ *
+ * Retour:
+ *   0 si egal, -1 si plus petit 1 si plus grand
+ *
+ * Remarques :
+ *    - Ties are in reverse document order, as with successive TList_AddSorted
+ *----------------------------------------------------------------------------
+*/
+static int Dict_SortItemVar(const void *A,const void *B) {
+
+   int cmp;
+
+   if ((cmp=Dict_SortVar(((TDictItem*)A)->Data,((TDictItem*)B)->Data)))
+      return(cmp);
+
+   return(((TDictItem*)B)->Idx-((TDictItem*)A)->Idx);
+}
+
+static int Dict_SortItemType(const void *A,const void *B) {
+
+   int cmp;
+
+   if ((cmp=Dict_SortType(((TDictItem*)A)->Data,((TDictItem*)B)->Data)))
+      return(cmp);
+
+   return(((TDictItem*)B)->Idx-((TDictItem*)A)->Idx);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_ItemList>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Sort parsed items and link them in a list.
+ *
+ * Parametres  :
+ *  <Items>    : Parsed items
+ *  <N>        : Number of items
+ *  <Sort>     : Sort procedure (Dict_SortItemVar,Dict_SortItemType)
+ *
+ * Retour:
+ *  <TList*>   : Head of the sorted list (NULL on error)
+ *
+ * Remarques :
+ *    - The nodes are allocated in one block, starting with the head
+ *----------------------------------------------------------------------------
+*/
+static TList* Dict_ItemList(TDictItem *Items,int N,int (*Sort)(const void*,const void*)) {
+
+   TList *nodes;
+   int    n;
+
+   if (!(nodes=(TList*)calloc(N,sizeof(TList)))) {
+      return(NULL);
+   }
+
+   qsort(Items,N,sizeof(TDictItem),Sort);
+
+   for(n=0;n<N;n++) {
+      nodes[n].Data=Items[n].Data;
+      nodes[n].Next=n+1<N?&nodes[n+1]:NULL;
+      nodes[n].Prev=n?&nodes[n-1]:NULL;
+   }
+   return(nodes);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_BinStr>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Copy a string of the binary dictionary string table.
+ *
+ * Parametres  :
+ *  <Dest>     : Destination string
+ *  <Tbl>      : String table
+ *  <Off>      : Offset in the string table
+ *  <Len>      : Size of the destination
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - The offsets have been validated against the table size at load
+ *----------------------------------------------------------------------------
+*/
+static inline void Dict_BinStr(char *Dest,const char *Tbl,uint32_t Off,int Len) {
+   strncpy0(Dest,(char*)(Tbl+Off),Len);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_Load>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Load a compiled binary dictionary file (see Dict_Save).
+ *
+ * Parametres  :
+ *  <Filename> : Binary dictionary file
+ *
+ * Retour:
+ *  <Ok>       : (1=Ok,0=Erreur)
+ *
+ * Remarques :
+ *    - The file is mapped and its records are expanded in one block of
+ *      variables, types and list nodes. The records are stored already sorted,
+ *      so loading is linear instead of one sorted insertion per variable
+ *    - If a dictionary is already loaded, the new one is merged into it
+ *    - The strings are stored as encoded when the file was written, the encoding
+ *      given to Dict_Parse does not apply
+ *----------------------------------------------------------------------------
+*/
+int Dict_Load(char *Filename) {
+
+   TDictBinHeader *head;
+   TDictBinVar    *bvar;
+   TDictBinType   *btype;
+   TDictBinCode   *bcode;
+   TDictVar       *vars=NULL;
+   TDictType      *types=NULL;
+   TList          *nodes=NULL,*list;
+   struct stat     statbuf;
+   const char     *str;
+   void           *addr=MAP_FAILED;
+   uint32_t       *off;
+   size_t          size;
+   int             fd,n,c,m,code=0;
+
+   if ((fd=open(Filename,O_RDONLY))<0 || fstat(fd,&statbuf)) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not open dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+
+   if (statbuf.st_size<sizeof(TDictBinHeader) || (addr=mmap(NULL,statbuf.st_size,PROT_READ,MAP_PRIVATE,fd,0))==MAP_FAILED) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not map dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+
+   head=(TDictBinHeader*)addr;
+   if (head->Magic!=DICT_BINMAGIC || head->Version!=DICT_BINVERSION) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Invalid or incompatible binary dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+
+   // Make sure the file agrees with the header on the size
+   size=sizeof(TDictBinHeader)+head->NVar*sizeof(TDictBinVar)+head->NType*sizeof(TDictBinType)+head->NCode*sizeof(TDictBinCode);
+   if (head->NVar<0 || head->NType<0 || head->NCode<0 || !head->StrSize || size+head->StrSize!=statbuf.st_size) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Corrupted binary dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+   bvar=(TDictBinVar*)(head+1);
+   btype=(TDictBinType*)(bvar+head->NVar);
+   bcode=(TDictBinCode*)(btype+head->NType);
+   str=(const char*)(bcode+head->NCode);
+
+   // Validate every string offset once so that the expansion does not have to
+   if (str[head->StrSize-1]!='\0') {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Corrupted binary dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+   for(n=0;n<head->NVar;n++) {
+      if (bvar[n].NCodes<0 || bvar[n].NCodes>64 || bvar[n].NMeanings<0 || bvar[n].NMeanings>64 || bvar[n].Code<0 || (int64_t)bvar[n].Code+bvar[n].NMeanings>head->NCode) break;
+      for(off=&bvar[n].Origin;off<=&bvar[n].ETIKET;off++) if (*off>=head->StrSize) break;
+      if (off<=&bvar[n].ETIKET) break;
+   }
+   for(c=0;c<head->NType && n==head->NVar;c++) {
+      for(off=&btype[c].Origin;off<=&btype[c].Long[1];off++) if (*off>=head->StrSize) break;
+      if (off<=&btype[c].Long[1]) break;
+   }
+   for(m=0;m<head->NCode && c==head->NType;m++) {
+      if (bcode[m].Meaning[0]>=head->StrSize || bcode[m].Meaning[1]>=head->StrSize) break;
+   }
+   if (n<head->NVar || c<head->NType || m<head->NCode) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Corrupted binary dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+
+   if ((head->NVar && !(vars=(TDictVar*)calloc(head->NVar,sizeof(TDictVar)))) ||
+       (head->NType && !(types=(TDictType*)calloc(head->NType,sizeof(TDictType)))) ||
+       !(nodes=(TList*)calloc(head->NVar+head->NType+1,sizeof(TList)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for dictionary %s\n",__func__,Filename);
+      goto end;
+   }
+
+   // Expand the variables
+   for(n=0;n<head->NVar;n++,bvar++) {
+      vars[n].Date=bvar->Date;
+      vars[n].Min=bvar->Min;
+      vars[n].Max=bvar->Max;
+      vars[n].Magnitude=bvar->Magnitude;
+      vars[n].Factor=bvar->Factor;
+      vars[n].Delta=bvar->Delta;
+      vars[n].Precision=bvar->Precision;
+      vars[n].Level=bvar->Level;
+      vars[n].Nature=bvar->Nature;
+      vars[n].Pack=bvar->Pack;
+      vars[n].Kind=bvar->Kind;
+      vars[n].IP1=bvar->IP1;
+      vars[n].IP2=bvar->IP2;
+      vars[n].IP3=bvar->IP3;
+      vars[n].NCodes=bvar->NCodes;
+      Dict_BinStr(vars[n].Origin,str,bvar->Origin,32);
+      Dict_BinStr(vars[n].Name,str,bvar->Name,8);
+      Dict_BinStr(vars[n].Short[0],str,bvar->Short[0],256);
+      Dict_BinStr(vars[n].Short[1],str,bvar->Short[1],256);
+      Dict_BinStr(vars[n].Long[0],str,bvar->Long[0],DICT_MAXLEN);
+      Dict_BinStr(vars[n].Long[1],str,bvar->Long[1],DICT_MAXLEN);
+      Dict_BinStr(vars[n].Units,str,bvar->Units,32);
+      Dict_BinStr(vars[n].ETIKET,str,bvar->ETIKET,13);
+      for(m=0;m<bvar->NMeanings;m++) {
+         vars[n].Codes[m]=bcode[bvar->Code+m].Value;
+         Dict_BinStr(vars[n].Meanings[m][0],str,bcode[bvar->Code+m].Meaning[0],DICT_LEN_MEANING);
+         Dict_BinStr(vars[n].Meanings[m][1],str,bcode[bvar->Code+m].Meaning[1],DICT_LEN_MEANING);
+      }
+      nodes[n].Data=&vars[n];
+      nodes[n].Next=n+1<head->NVar?&nodes[n+1]:NULL;
+      nodes[n].Prev=n?&nodes[n-1]:NULL;
+   }
+
+   // Expand the types
+   list=&nodes[head->NVar];
+   for(n=0;n<head->NType;n++,btype++) {
+      types[n].Date=btype->Date;
+      types[n].Nature=btype->Nature;
+      Dict_BinStr(types[n].Origin,str,btype->Origin,32);
+      Dict_BinStr(types[n].Name,str,btype->Name,3);
+      Dict_BinStr(types[n].Short[0],str,btype->Short[0],128);
+      Dict_BinStr(types[n].Short[1],str,btype->Short[1],128);
+      Dict_BinStr(types[n].Long[0],str,btype->Long[0],DICT_MAXLEN);
+      Dict_BinStr(types[n].Long[1],str,btype->Long[1],DICT_MAXLEN);
+      list[n].Data=&types[n];
+      list[n].Next=n+1<head->NType?&list[n+1]:NULL;
+      list[n].Prev=n?&list[n-1]:NULL;
+   }
+
+   // Records are stored sorted, merge them into the current dictionary
+   Dict.Vars=Dict_Merge(Dict.Vars,head->NVar?nodes:NULL,Dict_SortVar);
+   Dict.Types=Dict_Merge(Dict.Types,head->NType?list:NULL,Dict_SortType);
+   OMP_ATOMIC_WRITE(Dict.VarIdx.Built=0);
+   OMP_ATOMIC_WRITE(Dict.TypeIdx.Built=0);
+
+   APP_FREE(Dict.Name);
+   APP_FREE(Dict.Date);
+   APP_FREE(Dict.Version);
+   Dict.Name=head->Name<head->StrSize?strdup(str+head->Name):NULL;
+   Dict.Date=head->Date<head->StrSize?strdup(str+head->Date):NULL;
+   Dict.Version=head->Ver<head->StrSize?strdup(str+head->Ver):NULL;
+   Dict.String[0]='\0';
+   if (head->String<head->StrSize) {
+      strncpy0(Dict.String,(char*)(str+head->String),64);
+   }
+
+   vars=NULL;
+   types=NULL;
+   nodes=NULL;
+   code=1;
+
+end:
+   if (addr!=MAP_FAILED) munmap(addr,statbuf.st_size);
+   if (fd>=0) close(fd);
+   APP_FREE(vars);
+   APP_FREE(types);
+   APP_FREE(nodes);
+
+   return(code);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_StrAdd>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Add a string to a binary dictionary string table.
+ *
+ * Parametres  :
+ *  <Tbl>      : String table
+ *  <Str>      : String to add (NULL is stored as DICT_BINNULL)
+ *
+ * Retour:
+ *  <Offset>   : Offset of the string in the table (DICT_BINNULL on error)
+ *
+ * Remarques :
+ *    - Identical strings are stored only once
+ *----------------------------------------------------------------------------
+*/
+static uint32_t Dict_StrAdd(TDictStrTable *Tbl,const char *Str) {
+
+   uint32_t *slots,h,o;
+   unsigned  s,n;
+   size_t    len;
+   char     *buf;
+
+   if (!Str || Tbl->Error) {
+      return(DICT_BINNULL);
+   }
+
+   // Grow the deduplication slots, keeping them at most half full
+   if ((Tbl->N+1)*2>Tbl->NSlot) {
+      n=Tbl->NSlot?Tbl->NSlot*2:1024;
+      if (!(slots=(uint32_t*)calloc(n,sizeof(uint32_t)))) {
+         Tbl->Error=1;
+         return(DICT_BINNULL);
+      }
+      for(s=0;s<Tbl->NSlot;s++) {
+         if ((o=Tbl->Slots[s])) {
+            h=Dict_Hash(Tbl->Buf+o-1,0)&(n-1);
+            while(slots[h]) h=(h+1)&(n-1);
+            slots[h]=o;
+         }
+      }
+      APP_FREE(Tbl->Slots);
+      Tbl->Slots=slots;
+      Tbl->NSlot=n;
+   }
+
+   h=Dict_Hash(Str,0)&(Tbl->NSlot-1);
+   while((o=Tbl->Slots[h])) {
+      if (!strcmp(Tbl->Buf+o-1,Str)) {
+         return(o-1);
+      }
+      h=(h+1)&(Tbl->NSlot-1);
+   }
+
+   len=strlen(Str)+1;
+   if (Tbl->Len+len>Tbl->Size) {
+      if (!(buf=(char*)realloc(Tbl->Buf,(Tbl->Len+len)*2))) {
+         Tbl->Error=1;
+         return(DICT_BINNULL);
+      }
+      Tbl->Buf=buf;
+      Tbl->Size=(Tbl->Len+len)*2;
+   }
+   memcpy(Tbl->Buf+Tbl->Len,Str,len);
+   Tbl->Slots[h]=Tbl->Len+1;
+   Tbl->Len+=len;
+   Tbl->N++;
+
+   return(Tbl->Slots[h]-1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_Save>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Write the loaded dictionary(ies) to a compiled binary file.
+ *
+ * Parametres  :
+ *  <Filename> : Binary dictionary file
+ *
+ * Retour:
+ *  <Ok>       : (1=Ok,0=Erreur)
+ *
+ * Remarques :
+ *    - The file holds a header, fixed size variable, type and code records in
+ *      dictionary order and a deduplicated string table
+ *    - The file is in native byte order, it is meant to be produced on the
+ *      architecture that uses it (util/Dict -w)
+ *    - Dict_Parse recognizes the binary files and loads them through Dict_Load
+ *----------------------------------------------------------------------------
+*/
+int Dict_Save(char *Filename) {
+
+   TDictBinHeader head;
+   TDictBinVar   *bvar=NULL;
+   TDictBinType  *btype=NULL;
+   TDictBinCode  *bcode=NULL;
+   TDictStrTable  tbl;
+   TDictVar      *var;
+   TDictType     *type;
+   TList         *list;
+   FILE          *fp=NULL;
+   int            n,m,c,nc,code=0;
+
+   memset(&head,0x0,sizeof(head));
+   memset(&tbl,0x0,sizeof(tbl));
+
+   // Count the records
+   for(list=Dict.Vars;list;list=list->Next) {
+      var=(TDictVar*)list->Data;
+      for(m=63;m>=var->NCodes && !var->Meanings[m][0][0] && !var->Meanings[m][1][0];m--);
+      head.NVar++;
+      head.NCode+=m+1;
+   }
+   for(list=Dict.Types;list;list=list->Next) {
+      head.NType++;
+   }
+
+   APP_MEM_ASRT_END(bvar,calloc(head.NVar+1,sizeof(TDictBinVar)));
+   APP_MEM_ASRT_END(btype,calloc(head.NType+1,sizeof(TDictBinType)));
+   APP_MEM_ASRT_END(bcode,calloc(head.NCode+1,sizeof(TDictBinCode)));
+
+   // The empty string is at offset 0
+   Dict_StrAdd(&tbl,"");
+
+   for(n=0,nc=0,list=Dict.Vars;list;list=list->Next,n++) {
+      var=(TDictVar*)list->Data;
+      bvar[n].Date=var->Date;
+      bvar[n].Min=var->Min;
+      bvar[n].Max=var->Max;
+      bvar[n].Magnitude=var->Magnitude;
+      bvar[n].Factor=var->Factor;
+      bvar[n].Delta=var->Delta;
+      bvar[n].Precision=var->Precision;
+      bvar[n].Level=var->Level;
+      bvar[n].Nature=var->Nature;
+      bvar[n].Pack=var->Pack;
+      bvar[n].Kind=var->Kind;
+      bvar[n].IP1=var->IP1;
+      bvar[n].IP2=var->IP2;
+      bvar[n].IP3=var->IP3;
+      bvar[n].NCodes=var->NCodes;
+      bvar[n].Origin=Dict_StrAdd(&tbl,var->Origin);
+      bvar[n].Name=Dict_StrAdd(&tbl,var->Name);
+      bvar[n].Short[0]=Dict_StrAdd(&tbl,var->Short[0]);
+      bvar[n].Short[1]=Dict_StrAdd(&tbl,var->Short[1]);
+      bvar[n].Long[0]=Dict_StrAdd(&tbl,var->Long[0]);
+      bvar[n].Long[1]=Dict_StrAdd(&tbl,var->Long[1]);
+      bvar[n].Units=Dict_StrAdd(&tbl,var->Units);
+      bvar[n].ETIKET=Dict_StrAdd(&tbl,var->ETIKET);
+
+      // Logical variables have meanings without codes, keep up to the last meaning
+      for(m=63;m>=var->NCodes && !var->Meanings[m][0][0] && !var->Meanings[m][1][0];m--);
+      bvar[n].NMeanings=m+1;
+      bvar[n].Code=nc;
+      for(c=0;c<=m;c++,nc++) {
+         bcode[nc].Value=var->Codes[c];
+         bcode[nc].Meaning[0]=Dict_StrAdd(&tbl,var->Meanings[c][0]);
+         bcode[nc].Meaning[1]=Dict_StrAdd(&tbl,var->Meanings[c][1]);
+      }
+   }
+
+   for(n=0,list=Dict.Types;list;list=list->Next,n++) {
+      type=(TDictType*)list->Data;
+      btype[n].Date=type->Date;
+      btype[n].Nature=type->Nature;
+      btype[n].Origin=Dict_StrAdd(&tbl,type->Origin);
+      btype[n].Name=Dict_StrAdd(&tbl,type->Name);
+      btype[n].Short[0]=Dict_StrAdd(&tbl,type->Short[0]);
+      btype[n].Short[1]=Dict_StrAdd(&tbl,type->Short[1]);
+      btype[n].Long[0]=Dict_StrAdd(&tbl,type->Long[0]);
+      btype[n].Long[1]=Dict_StrAdd(&tbl,type->Long[1]);
+   }
+
+   head.Magic=DICT_BINMAGIC;
+   head.Version=DICT_BINVERSION;
+   head.Name=Dict_StrAdd(&tbl,Dict.Name);
+   head.Date=Dict_StrAdd(&tbl,Dict.Date);
+   head.Ver=Dict_StrAdd(&tbl,Dict.Version);
+   head.String=Dict_StrAdd(&tbl,Dict.String);
+
+   if (tbl.Error) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for the string table\n",__func__);
+      goto end;
+   }
+   head.StrSize=tbl.Len;
+
+   if (!(fp=fopen(Filename,"w"))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not open dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+
+   if (fwrite(&head,sizeof(head),1,fp)!=1 ||
+       fwrite(bvar,sizeof(TDictBinVar),head.NVar,fp)!=head.NVar ||
+       fwrite(btype,sizeof(TDictBinType),head.NType,fp)!=head.NType ||
+       fwrite(bcode,sizeof(TDictBinCode),head.NCode,fp)!=head.NCode ||
+       fwrite(tbl.Buf,1,tbl.Len,fp)!=tbl.Len) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Problem writing dictionary file %s\n",__func__,Filename);
+      goto end;
+   }
+   code=1;
+
+end:
+   if (fp && fclose(fp)) code=0;
+   APP_FREE(bvar);
+   APP_FREE(btype);
+   APP_FREE(bcode);
+   APP_FREE(tbl.Buf);
+   APP_FREE(tbl.Slots);
+
+   return(code);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_VarKeys>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the index keys of a variable.
+ *
+ * Parametres  :
+ *  <Data>     : Variable (TDictVar)
+ *  <Keys>     : Keys to fill
+ *
+ * Retour:
+ *  <N>        : Number of keys
+ *
+ * Remarques :
+ *    - The keys are "<dimension>:<value>", N for the NOMVAR and one for each
+ *      search context dimension (O for origin, E for ETIKET, 1, 2 and 3 for the
+ *      specific IPs and S for each state bit)
+ *----------------------------------------------------------------------------
+*/
+static int Dict_VarKeys(void *Data,char Keys[][DICT_KEYLEN]) {
+
+   TDictVar *var=(TDictVar*)Data;
+   int       n=0,b;
+
+   snprintf(Keys[n++],DICT_KEYLEN,"N:%s",var->Name);
+   snprintf(Keys[n++],DICT_KEYLEN,"O:%s",var->Origin);
+   snprintf(Keys[n++],DICT_KEYLEN,"E:%s",var->ETIKET);
+   if (var->IP1>0) snprintf(Keys[n++],DICT_KEYLEN,"1:%i",var->IP1);
+   if (var->IP2>0) snprintf(Keys[n++],DICT_KEYLEN,"2:%i",var->IP2);
+   if (var->IP3>0) snprintf(Keys[n++],DICT_KEYLEN,"3:%i",var->IP3);
+   for(b=0x01;b<=DICT_STATE;b<<=1) {
+      if (var->Nature&b) snprintf(Keys[n++],DICT_KEYLEN,"S:%i",b);
+   }
+   return(n);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_TypeKeys>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the index keys of a type.
+ *
+ * Parametres  :
+ *  <Data>     : Type (TDictType)
+ *  <Keys>     : Keys to fill
+ *
+ * Retour:
+ *  <N>        : Number of keys
+ *
+ * Remarques :
+ *    - The name is indexed with and without its first character, as matched
+ *      by Dict_CheckType
+ *----------------------------------------------------------------------------
+*/
+static int Dict_TypeKeys(void *Data,char Keys[][DICT_KEYLEN]) {
+
+   TDictType *type=(TDictType*)Data;
+
+   snprintf(Keys[0],DICT_KEYLEN,"N:%s",type->Name);
+   if (!type->Name[0]) {
+      return(1);
+   }
+   snprintf(Keys[1],DICT_KEYLEN,"N:%s",&type->Name[1]);
+   return(2);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_IndexGrow>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Double the number of slots of an index being built.
+ *
+ * Parametres  :
+ *  <Idx>      : Index being built
+ *  <NK>       : Number of keys already in the index
+ *
+ * Retour:
+ *  <Ok>       : (1=Ok,0=Erreur)
+ *
+ * Remarques :
+ *    - The key storage follows the slots, at half their number
+ *----------------------------------------------------------------------------
+*/
+static int Dict_IndexGrow(TDictIndex *Idx,int NK) {
+
+   char    (*keys)[DICT_KEYLEN];
+   int      *slots,k;
+   unsigned  size,h;
+
+   size=Idx->Size?Idx->Size<<1:16;
+   if (!(slots=malloc(size*sizeof(int)))) {
+      return(0);
+   }
+   if (!(keys=realloc(Idx->Keys,(size>>1)*DICT_KEYLEN))) {
+      free(slots);
+      return(0);
+   }
+   Idx->Keys=keys;
+
+   // Rehash the keys already found
+   memset(slots,0xFF,size*sizeof(int));
+   for(k=0;k<NK;k++) {
+      h=Dict_Hash(Idx->Keys[k],1)&(size-1);
+      while(slots[h]>=0) h=(h+1)&(size-1);
+      slots[h]=k;
+   }
+   APP_FREE(Idx->Slots);
+   Idx->Slots=slots;
+   Idx->Size=size;
 
    return(1);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_IndexBuild>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Build the index of a dictionary list.
+ *
+ * Parametres  :
+ *  <Idx>      : Index to (re)build
+ *  <List>     : Dictionary list (TDictVar or TDictType)
+ *  <KeyProc>  : Procedure giving the keys of an element (Dict_VarKeys,Dict_TypeKeys)
+ *
+ * Retour:
+ *  <Ok>       : (1=Ok,0=Erreur)
+ *
+ * Remarques :
+ *    - Keys are case insensitive, as are the searches (Dict_CheckVar/Dict_CheckType)
+ *    - The positions of a key are kept in list order so that the first one satisfying
+ *      the search parameters is the same as with a list walk
+ *    - The slots and keys grow with the number of distinct keys found (at most half
+ *      the slots used), the pairs with the number of keys given by KeyProc
+ *----------------------------------------------------------------------------
+*/
+static int Dict_IndexBuild(TDictIndex *Idx,TList *List,TDictKeyProc *KeyProc) {
+
+   TList    *list;
+   char      keys[DICT_MAXKEY][DICT_KEYLEN];
+   int      *pair=NULL,*pos=NULL,*buf,n,nk,np,p,i,k,code=0;
+   unsigned  h;
+
+   APP_FREE(Idx->Nodes);
+   APP_FREE(Idx->Pos);
+   APP_FREE(Idx->Keys);
+   APP_FREE(Idx->Start);
+   APP_FREE(Idx->Count);
+   APP_FREE(Idx->Slots);
+   Idx->Size=Idx->N=0;
+
+   for(n=0,list=List;list;list=list->Next) n++;
+   np=n*4+DICT_MAXKEY;
+
+   APP_MEM_ASRT_END(Idx->Nodes,malloc((n+1)*sizeof(TList*)));
+   APP_MEM_ASRT_END(pair,malloc(np*sizeof(int)));
+   APP_MEM_ASRT_END(pos,malloc(np*sizeof(int)));
+   if (!Dict_IndexGrow(Idx,0)) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for index slots\n",__func__);
+      goto end;
+   }
+
+   // Find the key of every (position,key) pair
+   for(n=0,p=0,nk=0,list=List;list;list=list->Next,n++) {
+      Idx->Nodes[n]=list;
+      i=KeyProc(list->Data,keys);
+      if (p+i>np) {
+         np<<=1;
+         APP_MEM_ASRT_END(buf,realloc(pair,np*sizeof(int))); pair=buf;
+         APP_MEM_ASRT_END(buf,realloc(pos,np*sizeof(int)));  pos=buf;
+      }
+      for(i--;i>=0;i--) {
+         h=Dict_Hash(keys[i],1)&(Idx->Size-1);
+         while((k=Idx->Slots[h])>=0 && strcasecmp(Idx->Keys[k],keys[i])) {
+            h=(h+1)&(Idx->Size-1);
+         }
+         if (k<0) {
+            // Keep the slots at most half full
+            if ((unsigned)(nk+1)*2>Idx->Size) {
+               if (!Dict_IndexGrow(Idx,nk)) {
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for index slots\n",__func__);
+                  goto end;
+               }
+               h=Dict_Hash(keys[i],1)&(Idx->Size-1);
+               while(Idx->Slots[h]>=0) h=(h+1)&(Idx->Size-1);
+            }
+            k=Idx->Slots[h]=nk++;
+            strcpy(Idx->Keys[k],keys[i]);
+         }
+         pos[p]=n;
+         pair[p++]=k;
+      }
+   }
+   Idx->N=n;
+
+   // Lay out the positions of each key, in list order
+   APP_MEM_ASRT_END(Idx->Start,malloc((nk+1)*sizeof(int)));
+   APP_MEM_ASRT_END(Idx->Count,calloc(nk+1,sizeof(int)));
+   APP_MEM_ASRT_END(Idx->Pos,malloc((p+1)*sizeof(int)));
+   for(i=0;i<p;i++) {
+      Idx->Count[pair[i]]++;
+   }
+   for(k=0,n=0;k<nk;k++) {
+      Idx->Start[k]=n;
+      n+=Idx->Count[k];
+      Idx->Count[k]=0;
+   }
+   for(i=0;i<p;i++) {
+      k=pair[i];
+      Idx->Pos[Idx->Start[k]+Idx->Count[k]++]=pos[i];
+   }
+   code=1;
+
+end:
+   APP_FREE(pair);
+   APP_FREE(pos);
+
+   if (!code) {
+      APP_FREE(Idx->Nodes);
+      APP_FREE(Idx->Pos);
+      APP_FREE(Idx->Keys);
+      APP_FREE(Idx->Start);
+      APP_FREE(Idx->Count);
+      APP_FREE(Idx->Slots);
+      Idx->Size=Idx->N=0;
+   }
+   return(code);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_Index>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : (Re)build the indexes if the dictionary changed.
+ *
+ * Parametres  :
+ *
+ * Retour:
+ *
+ * Remarques :
+ *    - Changes (Dict_Parse,Dict_Load,Dict_AddVar,Dict_AddType) only invalidate the
+ *      index of the list they modify, which is rebuilt here on the next search
+ *----------------------------------------------------------------------------
+*/
+static void Dict_Index(void) {
+
+   int vars,types;
+
+   // Double-checked: the flags are only set once the indexes are complete
+   OMP_ATOMIC_READ(vars=Dict.VarIdx.Built);
+   OMP_ATOMIC_READ(types=Dict.TypeIdx.Built);
+   if (!vars || !types) {
+      pthread_mutex_lock(&DictMutex);
+      if (!Dict.VarIdx.Built) {
+         Dict_IndexBuild(&Dict.VarIdx,Dict.Vars,Dict_VarKeys);
+         Dict.Gen++;
+         OMP_ATOMIC_WRITE(Dict.VarIdx.Built=1);
+      }
+      if (!Dict.TypeIdx.Built) {
+         Dict_IndexBuild(&Dict.TypeIdx,Dict.Types,Dict_TypeKeys);
+         OMP_ATOMIC_WRITE(Dict.TypeIdx.Built=1);
+      }
+      pthread_mutex_unlock(&DictMutex);
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_IndexFind>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Find the list positions of a key.
+ *
+ * Parametres  :
+ *  <Idx>      : Index to search (Dict.VarIdx or Dict.TypeIdx)
+ *  <Dim>      : Key dimension (N,O,E,1,2,3,S)
+ *  <Value>    : Key value
+ *  <Pos>      : List positions of that key, in list order (Idx->Nodes gives the nodes)
+ *
+ * Retour:
+ *  <N>        : Number of positions (-1 if there is no index)
+ *
+ * Remarques :
+ *    - The indexes are (re)built on the first search following a change
+ *----------------------------------------------------------------------------
+*/
+static int Dict_IndexFind(TDictIndex *Idx,char Dim,const char *Value,int **Pos) {
+
+   char     key[DICT_KEYLEN];
+   unsigned h;
+   int      k;
+
+   Dict_Index();
+
+   if (!Idx->Size) {
+      return(-1);
+   }
+
+   // Values too long for a key can't be in the index
+   if (snprintf(key,DICT_KEYLEN,"%c:%s",Dim,Value)>=DICT_KEYLEN) {
+      return(0);
+   }
+
+   h=Dict_Hash(key,1)&(Idx->Size-1);
+   while((k=Idx->Slots[h])>=0) {
+      if (!strcasecmp(Idx->Keys[k],key)) {
+         *Pos=&Idx->Pos[Idx->Start[k]];
+         return(Idx->Count[k]);
+      }
+      h=(h+1)&(Idx->Size-1);
+   }
+   return(0);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_CandInit>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Select the candidate variables of a search through the index.
+ *
+ * Parametres  :
+ *  <Cand>     : Candidates to initialize
+ *  <Var>      : Variable name or pattern
+ *  <Search>   : Search parameters
+ *
+ * Retour:
+ *  <Ok>       : 1 if the candidates are usable, 0 if the whole list has to be walked
+ *
+ * Remarques :
+ *    - Exact searches use the name, otherwise the most selective of the search
+ *      context dimensions is used (origin, ETIKET, IPs or a single state)
+ *    - IP1 searches have to look at both the IP1 and its alternate encoding,
+ *      the two position lists are walked merged (Dict_CandNext)
+ *    - The candidates still have to be checked against the search parameters
+ *----------------------------------------------------------------------------
+*/
+static int Dict_CandInit(TDictCand *Cand,char *Var,const TDictSearch *Search) {
+
+   const char *val[5];
+   char        dim[5],buf[3][16];
+   int        *pos[2],n[2],nd=0,d,b;
+
+   memset(Cand,0x0,sizeof(TDictCand));
+
+   if (Search->Mode!=DICT_GLOB && Var) {
+      if ((Cand->N[0]=Dict_IndexFind(&Dict.VarIdx,'N',Var,&Cand->Pos[0]))<0) {
+         return(0);
+      }
+      Cand->Gen=Dict.Gen;
+      return(1);
+   }
+
+   if (Search->Origin) {
+      dim[nd]='O'; val[nd++]=Search->Origin;
+   }
+   if (Search->ETIKET) {
+      dim[nd]='E'; val[nd++]=Search->ETIKET;
+   }
+   if (Search->IP2>0) {
+      snprintf(buf[0],16,"%i",Search->IP2);
+      dim[nd]='2'; val[nd++]=buf[0];
+   }
+   if (Search->IP3>0) {
+      snprintf(buf[1],16,"%i",Search->IP3);
+      dim[nd]='3'; val[nd++]=buf[1];
+   }
+   // Only a single state can be selected through the index
+   for(b=0x01;b<=DICT_STATE && b!=Search->State;b<<=1);
+   if (b<=DICT_STATE) {
+      snprintf(buf[2],16,"%i",b);
+      dim[nd]='S'; val[nd++]=buf[2];
+   }
+
+   // Keep the most selective dimension
+   Cand->N[0]=-1;
+   for(d=0;d<nd;d++) {
+      if ((n[0]=Dict_IndexFind(&Dict.VarIdx,dim[d],val[d],&pos[0]))<0) {
+         return(0);
+      }
+      if (Cand->N[0]<0 || n[0]<Cand->N[0]) {
+         Cand->Pos[0]=pos[0];
+         Cand->N[0]=n[0];
+      }
+   }
+
+   if (Search->IP1>0) {
+      snprintf(buf[0],16,"%i",Search->IP1);
+      if ((n[0]=Dict_IndexFind(&Dict.VarIdx,'1',buf[0],&pos[0]))<0) {
+         return(0);
+      }
+      n[1]=0;
+      if (Search->AltIP1>0 && Search->AltIP1!=Search->IP1) {
+         snprintf(buf[0],16,"%i",Search->AltIP1);
+         n[1]=Dict_IndexFind(&Dict.VarIdx,'1',buf[0],&pos[1]);
+      }
+      if (Cand->N[0]<0 || n[0]+n[1]<Cand->N[0]) {
+         Cand->Pos[0]=pos[0]; Cand->N[0]=n[0];
+         Cand->Pos[1]=pos[1]; Cand->N[1]=n[1];
+      }
+   }
+
+   Cand->Gen=Dict.Gen;
+   return(Cand->N[0]>=0);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_CandNext>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the next candidate variable.
+ *
+ * Parametres  :
+ *  <Cand>     : Candidates (Dict_CandInit)
+ *
+ * Retour:
+ *  <Node>     : List node of the next candidate, in list order (NULL when done)
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static inline TList* Dict_CandNext(TDictCand *Cand) {
+
+   int l;
+
+   if (Cand->Cur[0]>=Cand->N[0] && Cand->Cur[1]>=Cand->N[1]) {
+      return(NULL);
+   }
+
+   // Take the lowest position of the two lists
+   l=Cand->Cur[0]>=Cand->N[0]?1:Cand->Cur[1]>=Cand->N[1]?0:Cand->Pos[1][Cand->Cur[1]]<Cand->Pos[0][Cand->Cur[0]];
+   return(Dict.VarIdx.Nodes[Cand->Pos[l][Cand->Cur[l]++]]);
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <Dict_AddVar>
  * Creation : Juin 2014 - J.P. Gauthier
@@ -775,6 +1925,7 @@ static int Dict_ParseType(xmlDocPtr Doc, xmlNsPtr NS, xmlNodePtr Node,TDict_Enco
 */
 void Dict_AddVar(TDictVar *Var) {
    Dict.Vars=TList_AddSorted(Dict.Vars,Dict_SortVar,Var);
+   OMP_ATOMIC_WRITE(Dict.VarIdx.Built=0);
 }
 
 /*----------------------------------------------------------------------------
@@ -824,39 +1975,62 @@ int Dict_SortVar(void *Data0,void *Data1){
  *----------------------------------------------------------------------------
 */
 int Dict_CheckVar(void *Data0,void *Data1){
+   return(Dict_MatchVar((TDictVar*)Data0,(char*)Data1,&DictSearch));
+}
 
-   if (!Data0) {
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_MatchVar>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Check if a var satisfies the given search parameters
+ *
+ * Parametres  :
+ *  <Var>      : Metvar to check
+ *  <Name>     : Name or pattern to look for
+ *  <Search>   : Search parameters
+ *
+ * Retour:
+ *   0 = no, 1 = yes
+ *
+ * Remarques :
+ *    - Dict_CheckVar with explicit search parameters, for use outside the
+ *      calling thread (Dict_Annotate)
+ *----------------------------------------------------------------------------
+*/
+static int Dict_MatchVar(TDictVar *Var,char *Name,const TDictSearch *Search) {
+
+   if (!Var) {
       return(0);
    }
 
-   if (DictSearch.State && !(((TDictVar*)Data0)->Nature&DictSearch.State)) {
+   if (Search->State && !(Var->Nature&Search->State)) {
       return(0);
    }
 
-   if (DictSearch.Origin && strcasecmp(((TDictVar*)Data0)->Origin,DictSearch.Origin)) {
+   if (Search->Origin && strcasecmp(Var->Origin,Search->Origin)) {
       return(0);
    }
 
-   if (DictSearch.ETIKET && strcasecmp(((TDictVar*)Data0)->ETIKET,DictSearch.ETIKET)) {
+   if (Search->ETIKET && strcasecmp(Var->ETIKET,Search->ETIKET)) {
       return(0);
    }
 
-   if (DictSearch.IP1>0 && ((TDictVar*)Data0)->IP1!=DictSearch.IP1 && ((TDictVar*)Data0)->IP1!=DictSearch.AltIP1) {
+   if (Search->IP1>0 && Var->IP1!=Search->IP1 && Var->IP1!=Search->AltIP1) {
       return(0);
    }
 
-   if (DictSearch.IP2>0 && ((TDictVar*)Data0)->IP2!=DictSearch.IP2) {
+   if (Search->IP2>0 && Var->IP2!=Search->IP2) {
       return(0);
    }
 
-   if (DictSearch.IP3>0 && ((TDictVar*)Data0)->IP3!=DictSearch.IP3) {
+   if (Search->IP3>0 && Var->IP3!=Search->IP3) {
       return(0);
    }
 
-   if (DictSearch.Mode==DICT_GLOB) {
-      return(Data1?(!strmatch(((TDictVar*)Data0)->Name,(char*)Data1)):1);
+   if (Search->Mode==DICT_GLOB) {
+      return(Name?(!strmatch(Var->Name,Name)):1);
    } else {
-      return(Data1?(!strcasecmp(((TDictVar*)Data0)->Name,(char*)Data1)):0);
+      return(Name?(!strcasecmp(Var->Name,Name)):0);
    }
 }
 
@@ -873,11 +2047,23 @@ int Dict_CheckVar(void *Data0,void *Data1){
  *  <TDictVar> : Variable info
  *
  * Remarques :
+ *    - Only the candidates of the name or of the most selective search context
+ *      dimension are checked when possible (Dict_CandInit)
  *----------------------------------------------------------------------------
 */
 TDictVar *Dict_GetVar(char *Var) {
 
-   TList *list;
+   TDictCand cand;
+   TList    *list;
+
+   if (Dict_CandInit(&cand,Var,&DictSearch)) {
+      while((list=Dict_CandNext(&cand))) {
+         if (Dict_CheckVar(list->Data,Var)) {
+            return((TDictVar*)list->Data);
+         }
+      }
+      return(NULL);
+   }
 
    list=TList_Find(Dict.Vars,Dict_CheckVar,Var);
    return(list?(TDictVar*)(list->Data):NULL);
@@ -897,21 +2083,40 @@ TDictVar *Dict_GetVar(char *Var) {
  *  <TDictVar> : Variable info
  *
  * Remarques :
+ *    - When the search can use the index (Dict_CandInit), only the candidates are
+ *      walked, the iterator then points to the next candidate. The candidates are
+ *      kept per thread for the last iteration started, other interleaved iterations
+ *      on the same thread fall back to a list walk
+ *    - An iteration has to be continued with the same Var and search parameters
  *----------------------------------------------------------------------------
 */
 TDictVar *Dict_IterateVar(TList **Iterator,char *Var) {
 
    TDictVar *var=NULL;
+   TList    *list;
 
    if (*Iterator!=(TList*)0x01) {
 
-      // If NULL as iterator, start at beginning
+      // If NULL as iterator, start at beginning (or at the first candidate)
       if (!(*Iterator)) {
-         *Iterator=Dict.Vars;
+         DictSearch.CandNext=NULL;
+         if (Dict_CandInit(&DictSearch.Cand,Var,&DictSearch)) {
+            *Iterator=DictSearch.CandNext=Dict_CandNext(&DictSearch.Cand);
+         } else {
+            *Iterator=Dict.Vars;
+         }
       }
 
-      // If a search proc and var is specified
-      if ((*Iterator=TList_Find((*Iterator),Dict_CheckVar,Var))) {
+      if (*Iterator && *Iterator==DictSearch.CandNext && DictSearch.Cand.Gen==Dict.Gen) {
+         // Walk the candidates
+         for(list=*Iterator;list && !Dict_CheckVar(list->Data,Var);list=Dict_CandNext(&DictSearch.Cand));
+         if (list) {
+            var=(TDictVar*)list->Data;
+            list=Dict_CandNext(&DictSearch.Cand);
+         }
+         *Iterator=DictSearch.CandNext=list;
+      } else if ((*Iterator=TList_Find((*Iterator),Dict_CheckVar,Var))) {
+         // If a search proc and var is specified
          var=(TDictVar*)((*Iterator)->Data);
          *Iterator=(*Iterator)->Next;
       }
@@ -920,6 +2125,108 @@ TDictVar *Dict_IterateVar(TList **Iterator,char *Var) {
    return(var);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <Dict_Annotate>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Find the variable definitions of a list of records in one call
+ *
+ * Parametres  :
+ *  <Query>    : Records to annotate (NOMVAR, ETIKET and IPs)
+ *  <N>        : Number of records
+ *  <Vars>     : Variable definition of each record (NULL if unknown)
+ *
+ * Retour:
+ *  <N>        : Number of records found in the dictionary
+ *
+ * Remarques :
+ *    - The state and origin of the current search parameters (Dict_SetSearch) apply,
+ *      the names are always matched exactly (trailing blanks of names and etikets ignored)
+ *    - A definition specific to some IPs or ETIKET is used when the record matches
+ *      all of them, otherwise the first generic definition of that name is used
+ *    - The records are processed in parallel
+ *----------------------------------------------------------------------------
+*/
+int Dict_Annotate(TDictQuery *Query,int N,TDictVar **Vars) {
+
+   TDictSearch search;
+   int         q,nf=0;
+
+   Dict_Index();
+
+   // Copy the search parameters since they are thread local
+   memset(&search,0x0,sizeof(TDictSearch));
+   search.Mode=DICT_EXACT;
+   search.State=DictSearch.State;
+   search.Origin=DictSearch.Origin;
+
+   #pragma omp parallel
+   {
+      TDictCand cand;
+      TDictVar *var,*gen;
+      TList    *list;
+      char      name[DICT_KEYLEN],etiket[13],*c;
+      int       ip1=-1,alt=-1,kind=-1,idx;
+      float     level=0.0f;
+
+      #pragma omp for schedule(dynamic,64) reduction(+:nf)
+      for(q=0;q<N;q++) {
+         Vars[q]=gen=NULL;
+
+         if (!Query[q].Var) {
+            continue;
+         }
+         strncpy0(name,Query[q].Var,DICT_KEYLEN);
+         for(c=name+strlen(name)-1;c>=name && *c==' ';c--) *c='\0';
+         strncpy0(etiket,Query[q].ETIKET?Query[q].ETIKET:"",13);
+         for(c=etiket+strlen(etiket)-1;c>=etiket && *c==' ';c--) *c='\0';
+
+         // Walk the variables of that name (or the whole list without index)
+         idx=Dict_CandInit(&cand,name,&search);
+         for(list=idx?Dict_CandNext(&cand):Dict.Vars;list;list=idx?Dict_CandNext(&cand):list->Next) {
+            var=(TDictVar*)list->Data;
+            if (!Dict_MatchVar(var,name,&search)) {
+               continue;
+            }
+
+            // Generic definition
+            if (var->IP1<=0 && var->IP2<=0 && var->IP3<=0 && !var->ETIKET[0]) {
+               if (!gen) gen=var;
+               continue;
+            }
+
+            // Specific definition, the record IP1 might be in the other encoding (OLD/NEW)
+            if (var->IP1>0 && var->IP1!=Query[q].IP1) {
+               if (Query[q].IP1<=0) continue;
+               if (Query[q].IP1!=ip1) {
+                  ip1=Query[q].IP1;
+                  #pragma omp critical(DictIP)
+                  {
+                     IPDecode(ip1,&level,&kind);
+                     alt=IPEncode(level,kind,ip1<=32767);
+                  }
+               }
+               if (var->IP1!=alt) continue;
+            }
+            if ((var->IP2>0 && var->IP2!=Query[q].IP2) || (var->IP3>0 && var->IP3!=Query[q].IP3)) {
+               continue;
+            }
+            if (var->ETIKET[0] && strcasecmp(var->ETIKET,etiket)) {
+               continue;
+            }
+            Vars[q]=var;
+            break;
+         }
+         if (!Vars[q]) {
+            Vars[q]=gen;
+         }
+         nf+=Vars[q]!=NULL;
+      }
+   }
+
+   return(nf);
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <Dict_AddType>
  * Creation : Juin 2014 - J.P. Gauthier
@@ -935,7 +2242,8 @@ TDictVar *Dict_IterateVar(TList **Iterator,char *Var) {
  *----------------------------------------------------------------------------
 */
 void Dict_AddType(TDictType *Type) {
-   Dict.Vars=TList_AddSorted(Dict.Types,Dict_SortType,Type);
+   Dict.Types=TList_AddSorted(Dict.Types,Dict_SortType,Type);
+   OMP_ATOMIC_WRITE(Dict.TypeIdx.Built=0);
 }
 
 /*----------------------------------------------------------------------------
@@ -1008,11 +2316,22 @@ int Dict_CheckType(void *Data0,void *Data1){
  *  <TDictType>: Type info
  *
  * Remarques :
+ *    - Exact searches only check the types of that name through the name index
  *----------------------------------------------------------------------------
 */
 TDictType *Dict_GetType(char *Type) {
 
    TList *list;
+   int   *pos,n;
+
+   if (DictSearch.Mode!=DICT_GLOB && Type && (n=Dict_IndexFind(&Dict.TypeIdx,'N',Type,&pos))>=0) {
+      for(;n--;pos++) {
+         if (Dict_CheckType(Dict.TypeIdx.Nodes[*pos]->Data,Type)) {
+            return((TDictType*)Dict.TypeIdx.Nodes[*pos]->Data);
+         }
+      }
+      return(NULL);
+   }
 
    list=TList_Find(Dict.Types,Dict_CheckType,Type);
    return(list?(TDictType*)(list->Data):NULL);
@@ -1074,13 +2393,11 @@ TDictType *Dict_IterateType(TList **Iterator,char *Type) {
 */
 void Dict_PrintVars(char *Var,int Format,TApp_Lang Lang) {
 
-   TList *list;
-
-   list=Dict.Vars;
+   TList    *list=NULL;
+   TDictVar *var;
 
-   while(list=TList_Find(list,Dict_CheckVar,Var)) {
-       Dict_PrintVar((TDictVar*)list->Data,Format,Lang);
-       list=list->Next;
+   while((var=Dict_IterateVar(&list,Var))) {
+       Dict_PrintVar(var,Format,Lang);
    }
 }
 
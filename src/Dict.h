@@ -91,8 +91,16 @@ typedef struct {
    char Long[2][DICT_MAXLEN];   // Long description in both language
 } TDictType;
 
+typedef struct {
+   char *Var;                   // NOMVAR
+   char *ETIKET;                // ETIKET (NULL if unknown)
+   int   IP1,IP2,IP3;           // IPs (-1 if unknown)
+} TDictQuery;
+
 char*      Dict_Version(void);
 int        Dict_Parse(char *Filename,TDict_Encoding Encoding);
+int        Dict_Load(char *Filename);
+int        Dict_Save(char *Filename);
 void       Dict_SetSearch(int SearchMode,int SearchState,char *SearchOrigin,int SearchIP1,int SearchIP2,int SearchIP3,char *SearchETIKET);
 void       Dict_SetModifier(char *Modifier);
 void       Dict_AddVar(TDictVar *Var);
@@ -100,6 +108,7 @@ void       Dict_AddType(TDictType *Type);
 TDictVar  *Dict_GetVar(char *Var);
 TDictType *Dict_GetType(char *Type);
 TDictVar  *Dict_IterateVar(TList **Iterator,char *Var);
+int        Dict_Annotate(TDictQuery *Query,int N,TDictVar **Vars);
 TDictType *Dict_IterateType(TList **Iterator,char *Type);
 void       Dict_PrintVar(TDictVar *DVar,int Format,TApp_Lang Lang);
 void       Dict_PrintVars(char *Var,int Format,TApp_Lang Lang);
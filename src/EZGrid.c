@@ -36,6 +36,7 @@
 #include "EZGrid.h"
 #include "Vertex.h"
 #include "OMP_Utils.h"
+#include "SM.h"
 
 TGridYInterpMode EZGRID_YINTERP      = EZ_BARNES;               // Type of linear interpolation for Y grids
 int              EZGRID_YLINEARCOUNT = 4;                       // Number of points to use for point cloud interpolation
@@ -45,6 +46,7 @@ int              EZGRID_MQTREEDEPTH  = 8;                       // Depth of the
 static pthread_mutex_t CacheMutex=PTHREAD_MUTEX_INITIALIZER;    // Grid cache mutex
 static TGridDef       *GridCache[EZGRID_CACHEMAX];              // Grid cache list
 static __thread int    MIdx=-1;                                 // Cached previously used mesh index
+static int             EZGridShared=0;                          // Place the data read in node shared memory (SM)
 
 // Temporary: helper functions to convert from spherical to cartesian coordinates and back (see librmn's ez_lac and ez_cal)
 #define LL2CART(Lat,Lon,X,Y,Z) { const float deg2rad=acosf(-1)/180.0f, lat=(Lat)*deg2rad, lon=(Lon)*deg2rad, coslat=cosf(lat); X=coslat*cosf(lon); Y=coslat*sinf(lon); Z=sinf(lat); }
@@ -135,6 +137,229 @@ static int EZGrid_Wrap(TGridDef* restrict const GDef) {
    return(GDef->Wrap);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <EZGrid_ReadTiles>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire les tuiles d'un niveau et les assembler dans la grille maitre
+ *
+ * Parametres :
+ *   <Grid>      : Grille
+ *   <TypVar>    : Typvar des tuiles a lire
+ *   <IP1>       : IP1 du niveau
+ *   <Data>      : Destination (grille maitre)
+ *   <Type>      : Type de la destination
+ *   <Buf>       : Tampon temporaire de la taille de la grille maitre
+ *
+ * Retour: APP_OK si OK, APP_ERR sinon
+ *
+ * Remarques :
+ *      - Les cles des tuiles sont recuperees en une seule recherche au lieu de
+ *        c_fstsui, le lock RMNLIB n'est donc tenu que pour chaque lecture et
+ *        l'assemblage se fait hors du lock
+ *----------------------------------------------------------------------------
+*/
+static int EZGrid_ReadTiles(TGrid* restrict Grid,char *TypVar,int IP1,char *Data,TDef_Type Type,void *Buf) {
+   TRPNHeader  h={0};
+   TGridDef    *gdef=Grid->GDef;
+   int         keys[RPNMAX],nkey=0,n,ni,nj,nk,sz=TDef_Size[Type];
+   int         idx,idxt;
+
+   // Find all the tiles at once
+   if( cs_fstinl(Grid->H.FID,&ni,&nj,&nk,Grid->H.DATEV,Grid->H.ETIKET,IP1,Grid->H.IP2,-1,TypVar,Grid->H.NOMVAR,keys,&nkey,RPNMAX)<0 || !nkey ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not find tiles (%s) (%i)\n",__func__,Grid->H.NOMVAR,IP1);
+      return APP_ERR;
+   }
+
+   if( nkey != gdef->NbTiles ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: The number of tiles read (%d) is different then the number of expected tiles by the master grid (%d) for field (%s)\n",__func__,nkey,gdef->NbTiles,Grid->H.NOMVAR);
+      return APP_ERR;
+   }
+
+   strcpy(h.NOMVAR,"    ");
+   strcpy(h.TYPVAR,"  ");
+   strcpy(h.ETIKET,"            ");
+   strcpy(h.GRTYP," ");
+
+   for(n=0; n<nkey; ++n) {
+      // We need IG3 and IG4 for the grid position (note that the grid position starts at 1)
+      cs_fstprm(keys[n],&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
+            h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
+
+      // Read the tile
+      if( RPN_pReadData(Buf,Type,keys[n]) != APP_OK ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read tile (%d) of field (%s) (%i)\n",__func__,h.IP3,Grid->H.NOMVAR,IP1);
+         return APP_ERR;
+      }
+
+      // Put the data in the master grid
+      idx   = (h.IG4-1)*gdef->NI + (h.IG3-1);
+      idxt  = (h.IG4==1?gdef->Halo:0)*h.NI + (h.IG3==1?gdef->Halo:0);
+      ni    = h.NI - (h.IG3==1?0:gdef->Halo) - (h.IP3%gdef->NTI?gdef->Halo:0);
+      nj    = h.NJ - (h.IG4==1?0:gdef->Halo) - (h.IP3>(gdef->NTJ-1)*gdef->NTI?0:gdef->Halo);
+      for(; nj; --nj,idx+=gdef->NI,idxt+=h.NI) {
+         memcpy(Data+(size_t)idx*sz,(char*)Buf+(size_t)idxt*sz,(size_t)ni*sz);
+      }
+   }
+
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <EZGrid_ReadLevel>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire un niveau (et son masque) dans le fichier standard
+ *
+ * Parametres :
+ *   <Grid>      : Grille
+ *   <K>         : Niveau à lire
+ *   <IP1>       : IP1 du niveau
+ *
+ * Retour: APP_OK si OK, APP_ERR sinon
+ *
+ * Remarques :
+ *      - Grid->Data[K] doit etre alloue
+ *----------------------------------------------------------------------------
+*/
+static int EZGrid_ReadLevel(TGrid* restrict Grid,int K,int IP1) {
+   TGridDef    *gdef=Grid->GDef;
+   void        *buf=NULL;
+   int         key,ni,nj,nk,idx,code=APP_ERR;
+
+      if( !gdef->NbTiles ) {
+         // Find the field
+         if( (key=cs_fstinf(Grid->H.FID,&ni,&nj,&nk,Grid->H.DATEV,Grid->H.ETIKET,IP1,Grid->H.IP2,-1,Grid->H.TYPVAR,Grid->H.NOMVAR)) < 0 ) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not find field (%s) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],IP1);
+            goto end;
+         }
+
+         // Not a tiled field, just read it
+         if( RPN_pReadData(Grid->Data[K],TD_Float32,key) != APP_OK ) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read field (%s) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],IP1);
+            goto end;
+         }
+      } else { // We have a tiled field
+         // Allocate temp buffer that will hold the tile data
+         APP_MEM_ASRT_END( buf,malloc(gdef->NIJ*sizeof(*Grid->Data[K])) );
+
+         if( EZGrid_ReadTiles(Grid,Grid->H.TYPVAR,IP1,(char*)Grid->Data[K],TD_Float32,buf) != APP_OK ) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read field (%s) tiles at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],IP1);
+            goto end;
+         }
+      }
+
+      // Apply Factor if needed
+      if( Grid->Factor!=1.0f ) {
+         for(idx=0; idx<gdef->NIJ; ++idx)
+            Grid->Data[K][idx] *= Grid->Factor;
+      }
+
+      // Check for mask (TYPVAR==@@)
+      if( Grid->H.TYPVAR[1]=='@' ) {
+         // Find the field
+         if( (key=cs_fstinf(Grid->H.FID,&ni,&nj,&nk,Grid->H.DATEV,Grid->H.ETIKET,IP1,Grid->H.IP2,-1,"@@",Grid->H.NOMVAR)) >= 0 ) {
+            // Allocate mask data levels if not already done
+            if( !Grid->Mask ) {
+               if( !(Grid->Mask=calloc(gdef->ZRef->LevelNb,sizeof(*Grid->Mask))) ) {
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for mask levels (%s)\n",__func__,Grid->H.NOMVAR);
+                  goto end;
+               }
+            }
+
+            // Allocate mask data for level K if not already done
+            if( !Grid->Mask[K] ) {
+               if( !(Grid->Mask[K]=malloc((gdef->NbTiles?gdef->NIJ:ni*nj)*sizeof(*Grid->Mask[K]))) ) {
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for mask level %d (%s)\n",__func__,K,Grid->H.NOMVAR);
+                  goto end;
+               }
+            }
+
+            if( !gdef->NbTiles ) {
+               // Not a tiled mask, just read it
+               if( RPN_pReadData(Grid->Mask[K],TD_Byte,key) != APP_OK ) {
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to read mask (%s)\n",__func__,Grid->H.NOMVAR);
+                  goto end;
+               }
+            } else { // We have a tiled mask
+               // Allocate temp buffer that will hold the tile data
+               if( !buf )
+                  APP_MEM_ASRT_END( buf,malloc(gdef->NIJ*sizeof(*Grid->Mask[K])) );
+
+               if( EZGrid_ReadTiles(Grid,"@@",IP1,(char*)Grid->Mask[K],TD_Byte,buf) != APP_OK ) {
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read mask (%s) tiles at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],IP1);
+                  goto end;
+               }
+            }
+         } else {
+            Lib_Log(APP_LIBEER,APP_WARNING,"%s: Could not find field mask (%s) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],IP1);
+         }
+      }
+
+   code = APP_OK;
+end:
+   if( buf ) {
+      free(buf);
+   }
+   return code;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <EZGrid_ReadShared>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire un niveau dans la memoire partagee du noeud
+ *
+ * Parametres :
+ *   <Grid>      : Grille
+ *   <K>         : Niveau à lire
+ *   <IP1>       : IP1 du niveau
+ *
+ * Retour: APP_OK si OK, APP_ERR sinon
+ *
+ * Remarques :
+ *      - Appel collectif: tous les process MPI doivent lire les memes niveaux
+ *        dans le meme ordre (voir SM_Alloc et SM_Sync)
+ *      - Seul le process source lit le fichier, les autres recoivent les
+ *        donnees par SM_Sync. Un echec est signale aux autres en laissant le
+ *        niveau non charge (NaN)
+ *      - L'etat charge ou non d'un niveau (EZGrid_IsLoaded) ne change qu'a
+ *        l'interieur de cet appel, entre SM_Barrier et SM_Sync, tous les process
+ *        prennent donc la meme decision de lire ou non
+ *----------------------------------------------------------------------------
+*/
+static int EZGrid_ReadShared(TGrid* restrict Grid,int K,int IP1) {
+   TGridDef    *gdef=Grid->GDef;
+   int         ni,nj,nk;
+
+   // Every process must take part in the allocation, so they all look for the mask
+   if( Grid->H.TYPVAR[1]=='@' && cs_fstinf(Grid->H.FID,&ni,&nj,&nk,Grid->H.DATEV,Grid->H.ETIKET,IP1,Grid->H.IP2,-1,"@@",Grid->H.NOMVAR)>=0 ) {
+      if( !Grid->Mask && !(Grid->Mask=calloc(gdef->ZRef->LevelNb,sizeof(*Grid->Mask))) ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for mask levels (%s)\n",__func__,Grid->H.NOMVAR);
+         return APP_ERR;
+      }
+      if( !Grid->Mask[K] && !(Grid->Mask[K]=SM_Alloc(gdef->NIJ*sizeof(*Grid->Mask[K]))) ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate shared memory for mask level %d (%s)\n",__func__,K,Grid->H.NOMVAR);
+         return APP_ERR;
+      }
+   }
+
+   // Every process must have checked whether the level is loaded before the source (re)writes it,
+   // otherwise a late process could see it loaded, skip the read and leave the others waiting in SM_Sync
+   SM_Barrier();
+
+   if( SM_IsSource(0) && EZGrid_ReadLevel(Grid,K,IP1)!=APP_OK ) {
+      Grid->Data[K][0] = nanf("NaN");
+   }
+
+   SM_Sync(Grid->Data[K],0);
+   if( Grid->Mask && Grid->Mask[K] ) {
+      SM_Sync(Grid->Mask[K],0);
+   }
+
+   return EZGrid_IsLoaded(Grid,K)?APP_OK:APP_ERR;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <EZGrid_GetData>
  * Creation : Janvier 2008 - J.P. Gauthier - CMC/CMOE
@@ -156,14 +381,9 @@ static int EZGrid_Wrap(TGridDef* restrict const GDef) {
  *----------------------------------------------------------------------------
 */
 int EZGrid_GetData(TGrid* restrict Grid,int K) {
-   TRPNHeader  h={0};
    TGridDef    *gdef=Grid->GDef;
-   void        *buf=NULL;
-   int         key,code=APP_ERR,locked=0;
-   int         i,ni,nj,nk,t=0;
-   int         *tmpi,flag=0,ip1=0,type;
-   int         idx,idxt,n,ntiles;
-   char        format;
+   int         code=APP_ERR;
+   int         i,ip1=0;
 
    if (K<0 || K>=gdef->ZRef->LevelNb) {
       Lib_Log(APP_LIBEER,APP_DEBUG,"%s: Invalid level (%s): K(%d) NK(%d)\n",__func__,Grid->H.NOMVAR,K,gdef->ZRef->LevelNb);
@@ -179,11 +399,13 @@ int EZGrid_GetData(TGrid* restrict Grid,int K) {
             Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for grid data levels (%s)\n",__func__,Grid->H.NOMVAR);
             goto end;
          }
+         // Only data read from a file can be shared among the node
+         Grid->Shared = EZGridShared && Grid->H.FID>=0;
       }
 
       // Allocate K level data if not already done
       if( !Grid->Data[K] ) {
-         if( !(Grid->Data[K]=calloc(gdef->NIJ,sizeof(*Grid->Data[K]))) ) {
+         if( !(Grid->Data[K]=Grid->Shared?SM_Alloc(gdef->NIJ*sizeof(*Grid->Data[K])):calloc(gdef->NIJ,sizeof(*Grid->Data[K]))) ) {
             Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for grid data level %d (%s)\n",__func__,K,Grid->H.NOMVAR);
             goto end;
          }
@@ -192,130 +414,12 @@ int EZGrid_GetData(TGrid* restrict Grid,int K) {
       if( Grid->H.FID>=0 ) {
          ip1 = gdef->ZRef->LevelNb>1 ? ZRef_Level2IP(gdef->ZRef->Levels[K],gdef->ZRef->Type,gdef->ZRef->Style) : -1;
 
-         RPN_FieldLock();
-         locked=1;
-
-         // Find the field
-         if( (key=c_fstinf(Grid->H.FID,&ni,&nj,&nk,Grid->H.DATEV,Grid->H.ETIKET,ip1,Grid->H.IP2,-1,Grid->H.TYPVAR,Grid->H.NOMVAR)) < 0 ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not find field (%s) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],ip1);
-            goto end;
-         }
-
-         if( !gdef->NbTiles ) {
-            // Not a tiled field, just read it
-            if( RPN_ReadData(Grid->Data[K],TD_Float32,key) != APP_OK ) {
-               Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read field (%s) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],ip1);
-               goto end;
-            }
-         } else { // We have a tiled field
-            // Allocate temp buffer that will hold the tile data
-            APP_MEM_ASRT_END( buf,malloc(gdef->NIJ*sizeof(*Grid->Data[K])) );
-
-            // Loop on the remaining fields
-            ntiles=0;
-            while( key >= 0 ) {
-               // We need IG3 and IG4 for the grid position (note that the grid position starts at 1)
-               cs_fstprm(key,&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
-                     h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
-
-               // Read the field
-               if( RPN_ReadData(buf,TD_Float32,key) != APP_OK ) {
-                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read field (%s) tile (%d) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],ip1);
-                  goto end;
-               }
-
-               // Put the data in the master grid
-               idx   = (h.IG4-1)*gdef->NI + (h.IG3-1);
-               idxt  = (h.IG4==1?gdef->Halo:0)*h.NI + (h.IG3==1?gdef->Halo:0);
-               ni    = h.NI - (h.IG3==1?0:gdef->Halo) - (h.IP3%gdef->NTI?gdef->Halo:0);
-               nj    = h.NJ - (h.IG4==1?0:gdef->Halo) - (h.IP3>(gdef->NTJ-1)*gdef->NTI?0:gdef->Halo);
-               for(; nj; --nj,idx+=gdef->NI,idxt+=h.NI) {
-                  memcpy(&Grid->Data[K][idx],(__typeof(Grid->Data[K]))buf+idxt,ni*sizeof(*Grid->Data[K]));
-               }
-
-               // Get the next tile
-               ++ntiles;
-               key = c_fstsui(Grid->H.FID,&ni,&nj,&nk);
-            }
-
-            if( ntiles != gdef->NbTiles ) {
-               Lib_Log(APP_LIBEER,APP_ERROR,"%s: The number of tiles read (%d) is different then the number of expected tiles by the master grid (%d) for field (%s)\n",__func__,ntiles,gdef->NbTiles,Grid->H.NOMVAR);
+         if( Grid->Shared ) {
+            if( EZGrid_ReadShared(Grid,K,ip1) != APP_OK ) {
                goto end;
             }
-         }
-
-         // Apply Factor if needed
-         if( Grid->Factor!=1.0f ) {
-            for(idx=0; idx<gdef->NIJ; ++idx)
-               Grid->Data[K][idx] *= Grid->Factor;
-         }
-
-         // Check for mask (TYPVAR==@@)
-         if( Grid->H.TYPVAR[1]=='@' ) {
-            // Find the field
-            if( (key=c_fstinf(Grid->H.FID,&ni,&nj,&nk,Grid->H.DATEV,Grid->H.ETIKET,ip1,Grid->H.IP2,-1,"@@",Grid->H.NOMVAR)) >= 0 ) {
-               // Allocate mask data levels if not already done
-               if( !Grid->Mask ) {
-                  if( !(Grid->Mask=calloc(gdef->ZRef->LevelNb,sizeof(*Grid->Mask))) ) {
-                     Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for mask levels (%s)\n",__func__,Grid->H.NOMVAR);
-                     goto end;
-                  }
-               }
-
-               // Allocate mask data for level K if not already done
-               if( !Grid->Mask[K] ) {
-                  if( !(Grid->Mask[K]=malloc(ni*nj*sizeof(*Grid->Mask[K]))) ) {
-                     Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate memory for mask level %d (%s)\n",__func__,K,Grid->H.NOMVAR);
-                     goto end;
-                  }
-               }
-
-               if( !gdef->NbTiles ) {
-                  // Not a tiled mask, just read it
-                  if( RPN_ReadData(Grid->Mask[K],TD_Byte,key) != APP_OK ) {
-                     Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to read mask (%s)\n",__func__,Grid->H.NOMVAR);
-                     goto end;
-                  }
-               } else { // We have a tiled mask
-                  // Allocate temp buffer that will hold the tile data
-                  if( !buf )
-                     APP_MEM_ASRT_END( buf,malloc(gdef->NIJ*sizeof(*Grid->Mask[K])) );
-
-                  // Loop on the remaining fields
-                  ntiles=0;
-                  while( key >= 0 ) {
-                     // We need IG3 and IG4 for the grid position (note that the grid position starts at 1)
-                     cs_fstprm(key,&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
-                           h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
-
-                     // Read the field
-                     if( RPN_ReadData(buf,TD_Byte,key) != APP_OK ) {
-                        Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read mask (%s) tile (%d) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],ip1);
-                        goto end;
-                     }
-
-                     // Put the data in the master grid
-                     idx   = (h.IG4-1)*gdef->NI + (h.IG3-1);
-                     idxt  = (h.IG4==1?gdef->Halo:0)*h.NI + (h.IG3==1?gdef->Halo:0);
-                     ni    = h.NI - (h.IG3==1?0:gdef->Halo) - (h.IP3%gdef->NTI?gdef->Halo:0);
-                     nj    = h.NJ - (h.IG4==1?0:gdef->Halo) - (h.IP3>(gdef->NTJ-1)*gdef->NTI?0:gdef->Halo);
-                     for(; nj; --nj,idx+=gdef->NI,idxt+=h.NI) {
-                        memcpy(&Grid->Mask[K][idx],(__typeof(Grid->Mask[K]))buf+idxt,ni*sizeof(*Grid->Mask[K]));
-                     }
-
-                     // Get the next tile
-                     ++ntiles;
-                     key = c_fstsui(Grid->H.FID,&ni,&nj,&nk);
-                  }
-
-                  if( ntiles != gdef->NbTiles ) {
-                     Lib_Log(APP_LIBEER,APP_ERROR,"%s: The number of tiles read (%d) is different then the number of expected tiles by the master grid (%d) for field (%s)\n",__func__,ntiles,gdef->NbTiles,Grid->H.NOMVAR);
-                     goto end;
-                  }
-               }
-            } else {
-               Lib_Log(APP_LIBEER,APP_WARNING,"%s: Could not find field mask (%s) at level %f (%i)\n",__func__,Grid->H.NOMVAR,gdef->ZRef->Levels[K],ip1);
-            }
+         } else if( EZGrid_ReadLevel(Grid,K,ip1) != APP_OK ) {
+            goto end;
          }
       } else if( Grid->T0 && Grid->T1 ) {  // Check for time interpolation needs
          // Make sure the data from the needed tile is loaded
@@ -344,16 +448,8 @@ int EZGrid_GetData(TGrid* restrict Grid,int K) {
 
    code = APP_OK;
 end:
-   if( locked ) {
-      RPN_FieldUnlock();
-   }
-
    pthread_mutex_unlock(&Grid->Mutex);
 
-   if( buf ) {
-      free(buf);
-   }
-
    return code;
 }
 
@@ -503,6 +599,69 @@ int EZGrid_Write(int FId,TGrid* restrict const Grid,int NBits,int Overwrite) {
    return APP_OK;
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <EZGrid_SetShared>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Activer la mise en memoire partagee du noeud (SM) des donnees
+ *            lues et des descripteurs de grille
+ *
+ * Parametres :
+ *   <Shared>    : Actif (1) ou non (0)
+ *
+ * Retour: L'etat precedent
+ *
+ * Remarques :
+ *      - Le process source (voir SM_IsSource) lit les donnees et les autres
+ *        process du noeud les partagent en lecture seule
+ *      - Les lectures deviennent collectives: tous les process MPI doivent
+ *        lire les memes grilles et niveaux dans le meme ordre
+ *      - S'applique aux grilles dont les donnees n'ont pas encore ete allouees
+ *----------------------------------------------------------------------------
+*/
+int EZGrid_SetShared(int Shared) {
+   int old=EZGridShared;
+
+   EZGridShared=Shared;
+   return(old);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <EZGrid_ReadAxis>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Allouer et lire un descripteur de grille
+ *
+ * Parametres :
+ *   <Axis>      : Descripteur (Retour)
+ *   <N>         : Nombre de valeurs
+ *   <GDef>      : Definition de grille
+ *   <FID>       : Fichier
+ *   <Var>       : Nom du descripteur
+ *   <Shared>    : Mettre en memoire partagee du noeud
+ *
+ * Retour: APP_OK si OK, APP_ERR sinon
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+static int EZGrid_ReadAxis(float **Axis,size_t N,TGridDef *GDef,int FID,char *Var,int Shared) {
+   int ni,nj,nk,code=APP_OK;
+
+   if( Shared ) {
+      if( !(*Axis=SM_Alloc(N*sizeof(**Axis))) )
+         return APP_ERR;
+      if( SM_IsSource(0) && (code=RPN_pRead(*Axis,TD_Float32,FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"",Var))!=APP_OK )
+         (*Axis)[0]=nanf("NaN");
+      SM_Sync(*Axis,0);
+      return ISNAN((*Axis)[0])?APP_ERR:APP_OK;
+   }
+
+   if( !(*Axis=malloc(N*sizeof(**Axis))) )
+      return APP_ERR;
+   return RPN_sRead(*Axis,TD_Float32,FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"",Var);
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <EZGrid_Get>
  * Creation : Janvier 2008 - J.P. Gauthier - CMC/CMOE
@@ -620,11 +779,10 @@ static int EZGrid_Get(TGridDef* restrict const GDef,const TRPNHeader *restrict H
          cs_fstinf(H->FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"","##");
          GDef->GRef->NIdx = ni*nj*nk;
          GDef->GRef->Idx = malloc(GDef->GRef->NIdx*sizeof(unsigned int));
-         GDef->GRef->AY = malloc(GDef->GRef->NX*sizeof(float));
-         GDef->GRef->AX = malloc(GDef->GRef->NX*sizeof(float));
+         GDef->GRef->SMXY = EZGridShared;
 
-         RPN_sRead(GDef->GRef->AY,TD_Float32,H->FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"","^^");
-         RPN_sRead(GDef->GRef->AX,TD_Float32,H->FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"",">>");
+         EZGrid_ReadAxis(&GDef->GRef->AY,GDef->GRef->NX,GDef,H->FID,"^^",EZGridShared);
+         EZGrid_ReadAxis(&GDef->GRef->AX,GDef->GRef->NX,GDef,H->FID,">>",EZGridShared);
          RPN_sRead(GDef->GRef->Idx,TD_UInt32,H->FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"","##");
 
          GeoRef_BuildIndex(GDef->GRef);
@@ -635,11 +793,10 @@ static int EZGrid_Get(TGridDef* restrict const GDef,const TRPNHeader *restrict H
       case 'O':
          GDef->GRef = GeoRef_RPNSetup(GDef->NI,GDef->NJ,GDef->GRTYP,GDef->IG1,GDef->IG2,GDef->IG3,GDef->IG4,H->FID);
 
-         GDef->GRef->AY = malloc(GDef->NIJ*sizeof(float));
-         GDef->GRef->AX = malloc(GDef->NIJ*sizeof(float));
+         GDef->GRef->SMXY = EZGridShared;
 
-         RPN_sRead(GDef->GRef->AY,TD_Float32,H->FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"","^^");
-         RPN_sRead(GDef->GRef->AX,TD_Float32,H->FID,&ni,&nj,&nk,-1,"",GDef->IG1,GDef->IG2,GDef->IG3,"",">>");
+         EZGrid_ReadAxis(&GDef->GRef->AY,GDef->NIJ,GDef,H->FID,"^^",EZGridShared);
+         EZGrid_ReadAxis(&GDef->GRef->AX,GDef->NIJ,GDef,H->FID,">>",EZGridShared);
 
          GeoRef_BuildIndex(GDef->GRef);
          break;
@@ -834,6 +991,7 @@ TGrid *EZGrid_New(void) {
       new->GDef=NULL;
       new->Data=NULL;
       new->Mask=NULL;
+      new->Shared=0;
       new->T0=new->T1=NULL;
       new->FT0=new->FT1=0.0f;
       new->Factor=1.0f;
@@ -912,6 +1070,7 @@ TGrid *EZGrid_CopyGrid(const TGrid *restrict Master,int Level,int Alloc) {
       pthread_mutex_init(&new->Mutex,NULL);
       new->Data=NULL;
       new->Mask=NULL;
+      new->Shared=0;
       new->T0=new->T1=NULL;
       new->FT0=new->FT1=0.0f;
       new->Factor=1.0f;
@@ -980,7 +1139,7 @@ void EZGrid_Free(TGrid* restrict const Grid) {
       if (Grid->Data) {
          for(k=0; k<Grid->GDef->ZRef->LevelNb; ++k) {
             if( Grid->Data[k] ) {
-               free(Grid->Data[k]);
+               if( Grid->Shared ) SM_Free(Grid->Data[k]); else free(Grid->Data[k]);
             }
          }
 
@@ -992,7 +1151,7 @@ void EZGrid_Free(TGrid* restrict const Grid) {
       if( Grid->Mask && !Grid->T0 ) {
          for(k=0; k<Grid->GDef->ZRef->LevelNb; ++k) {
             if( Grid->Mask[k] ) {
-               free(Grid->Mask[k]);
+               if( Grid->Shared ) SM_Free(Grid->Mask[k]); else free(Grid->Mask[k]);
             }
          }
 
@@ -1035,7 +1194,12 @@ void EZGrid_Clear(TGrid* restrict const Grid) {
    if( Grid->Data ) {
       for(k=0; k<Grid->GDef->ZRef->LevelNb; ++k) {
          if( Grid->Data[k] ) {
-            Grid->Data[k][0] = f;
+            if( Grid->Shared ) {
+               // Shared memory is read-only for most processes, release it instead
+               SM_FREE(Grid->Data[k]);
+            } else {
+               Grid->Data[k][0] = f;
+            }
          }
       }
    }
@@ -1254,13 +1418,49 @@ int EZGrid_Update(TGrid* restrict const Grid,int FId,int DateV) {
  *  <int>        : APPK_OK si ok, APP_ERR sinon
  *
  * Remarques :
+ *      - Les champs non tuiles sont lus en bloc par RPN_ReadLevels
  *----------------------------------------------------------------------------
 */
 int EZGrid_LoadAll(TGrid* restrict const Grid) {
-   int k=0;
+   TGridDef *gdef;
+   TZRef    *zref;
+   float    *cube=NULL;
+   int      *ip1s=NULL,k=0;
+   size_t    idx;
 
    if (Grid) {
-      for(k=0; k<Grid->GDef->ZRef->LevelNb; ++k) {
+      gdef=Grid->GDef;
+      zref=gdef->ZRef;
+
+      // Read all the levels with a single search and in file order when we can
+      if( Grid->H.FID>=0 && !gdef->NbTiles && Grid->H.TYPVAR[1]!='@' && zref->LevelNb>1 && !Grid->Data && !EZGridShared ) {
+         APP_MEM_ASRT_END( ip1s,malloc(zref->LevelNb*sizeof(*ip1s)) );
+         APP_MEM_ASRT_END( cube,malloc((size_t)gdef->NIJ*zref->LevelNb*sizeof(*cube)) );
+
+         for(k=0; k<zref->LevelNb; ++k) {
+            ip1s[k]=ZRef_Level2IP(zref->Levels[k],zref->Type,zref->Style);
+         }
+
+         if( RPN_ReadLevels(Grid->H.FID,Grid->H.NOMVAR,Grid->H.TYPVAR,Grid->H.DATEV,Grid->H.ETIKET,Grid->H.IP2,ip1s,zref->LevelNb,TD_Float32,cube)==APP_OK ) {
+            pthread_mutex_lock(&Grid->Mutex);
+            if( !Grid->Data && (Grid->Data=calloc(zref->LevelNb,sizeof(*Grid->Data))) ) {
+               for(k=0; k<zref->LevelNb; ++k) {
+                  if( !(Grid->Data[k]=malloc(gdef->NIJ*sizeof(*Grid->Data[k]))) )
+                     break;
+                  for(idx=0; idx<gdef->NIJ; ++idx) {
+                     Grid->Data[k][idx]=cube[(size_t)k*gdef->NIJ+idx]*Grid->Factor;
+                  }
+               }
+            }
+            pthread_mutex_unlock(&Grid->Mutex);
+         }
+      }
+end:
+      APP_FREE(ip1s);
+      APP_FREE(cube);
+
+      // Whatever was not read in bulk is read level by level
+      for(k=0; k<zref->LevelNb; ++k) {
          APP_ASRT_OK( EZGrid_GetData(Grid,k) );
       }
    }
@@ -2205,16 +2405,17 @@ int EZGrid_GetIJ(TGrid* restrict const Grid,double* Lat,double* Lon,float* I,flo
       return APP_ERR;
    }
 
-   if( Grid->GDef->GID >= 0 ) {
-  //   RPN_IntLock();
-      for(i=0; i<Nb; ++i) {
-         latf = (float)Lat[i];
-         // EZSCINT has problems with negative longitudes
-         lonf = Lon[i]<0.0 ? (float)Lon[i]+360.0f : (float)Lon[i];
-         if( Grid->GDef->GRTYP[1]=='E' ) {
-            // We have a ZE grid, temporarily override gdxyfll to speed things up and use our lookup
-            float xyz[3],xyzrot[3];
-            int ii,jj;
+   if( Grid->GDef->GID >= 0 && Grid->GDef->GRTYP[1]=='E' ) {
+      // We have a ZE grid, override gdxyfll to speed things up and use our lookups on chunks of points
+      float lat[256],lon[256],xyz[3],xyzrot[3];
+      int   b,nb;
+
+      for(b=0; b<Nb; b+=256) {
+         nb = Nb-b<256 ? Nb-b : 256;
+
+         for(i=0; i<nb; ++i) {
+            latf = (float)Lat[b+i];
+            lonf = Lon[b+i]<0.0 ? (float)Lon[b+i]+360.0f : (float)Lon[b+i];
 
             // Transfer latlon into cartesian space
             LL2CART(latf,lonf,xyz[0],xyz[1],xyz[2]);
@@ -2223,30 +2424,29 @@ int EZGrid_GetIJ(TGrid* restrict const Grid,double* Lat,double* Lon,float* I,flo
             ROTATE(Grid->GDef->Rot,xyz,xyzrot);
 
             // Transfer back the rotated coords into rotated latlon
-            CART2LL(xyzrot[0],xyzrot[1],xyzrot[2],latf,lonf);
+            CART2LL(xyzrot[0],xyzrot[1],xyzrot[2],lat[i],lon[i]);
 
             // Make sure we cover those rotated latlons in the descriptors
-            if(   lonf<Grid->GDef->AX[0] || lonf>Grid->GDef->AX[Grid->GDef->NI-1] ||
-                  latf<Grid->GDef->AY[0] || latf>Grid->GDef->AY[Grid->GDef->NJ-1] ) {
+            if(   lon[i]<Grid->GDef->AX[0] || lon[i]>Grid->GDef->AX[Grid->GDef->NI-1] ||
+                  lat[i]<Grid->GDef->AY[0] || lat[i]>Grid->GDef->AY[Grid->GDef->NJ-1] ) {
                return APP_ERR;
             }
+         }
 
-            // Find the rotated latlons in our lookup
-            ii = Grid->GDef->LUX.GetIdx(&Grid->GDef->LUX,lonf);
-            jj = Grid->GDef->LUY.GetIdx(&Grid->GDef->LUY,latf);
-
-            if( ii == Grid->GDef->NI-1 ) --ii;
-            if( jj == Grid->GDef->NJ-1 ) --jj;
-
-            I[i] = (float)ii + (lonf-Grid->GDef->AX[ii])/(Grid->GDef->AX[ii+1]-Grid->GDef->AX[ii]);
-            J[i] = (float)jj + (latf-Grid->GDef->AY[jj])/(Grid->GDef->AY[jj+1]-Grid->GDef->AY[jj]);
-         } else {
-            if( c_gdxyfll(Grid->GDef->GID,&I[i],&J[i],&latf,&lonf,1)!=0 ) {
-               return APP_ERR;
-            }
-            I[i] -= 1.0f;
-            J[i] -= 1.0f;
+         // Find the rotated latlons in our lookups
+         Lookup_GetPos2DN(&Grid->GDef->LUX,&Grid->GDef->LUY,lon,lat,&I[b],&J[b],nb);
+      }
+   } else if( Grid->GDef->GID >= 0 ) {
+  //   RPN_IntLock();
+      for(i=0; i<Nb; ++i) {
+         latf = (float)Lat[i];
+         // EZSCINT has problems with negative longitudes
+         lonf = Lon[i]<0.0 ? (float)Lon[i]+360.0f : (float)Lon[i];
+         if( c_gdxyfll(Grid->GDef->GID,&I[i],&J[i],&latf,&lonf,1)!=0 ) {
+            return APP_ERR;
          }
+         I[i] -= 1.0f;
+         J[i] -= 1.0f;
       }
    //   RPN_IntUnlock();
    } else {
@@ -110,6 +110,7 @@ typedef struct TGrid {
 
    TGrid          *T0,*T1;               // Time interpolation strat and end grid
    float           FT0,FT1;              // Time interpolation factor
+   int             Shared;               // Data and masks are in node shared memory (SM)
 
 } TGrid;
 
@@ -130,6 +131,7 @@ TGrid *EZGrid_ReadIdx(int FId,int Key,int Incr);
 int    EZGrid_Update(TGrid* restrict const Grid,int FId,int DateV);
 int    EZGrid_GetData(TGrid* restrict Grid,int K);
 int    EZGrid_LoadAll(TGrid* restrict const Grid);
+int    EZGrid_SetShared(int Shared);
 int    EZGrid_GetLevelNb(const TGrid* restrict const Grid);
 int    EZGrid_GetLevels(const TGrid* restrict const Grid,float* restrict Levels,int* restrict Type);
 int    EZGrid_GetLevelType(const TGrid* restrict const Grid);
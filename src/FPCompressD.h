@@ -43,7 +43,13 @@
 #include <inttypes.h>
 #include <string.h>
 
+#ifndef FPC_SLACK
+#define FPC_SLACK 64   // Bytes FPC_Compress may write past NI*NJ*NK (last value and final flush)
+#endif
+
 int FPC_InflateD(void *restrict CData,int FD,double *restrict Data,int NI,int NJ,int NK);
 int FPC_CompressD(void *restrict CData,int FD,double *restrict Data,int NI,int NJ,int NK,size_t *restrict CSize);
+int FPC_InflateRANSD(void *restrict CData,size_t CSize,double *restrict Data,int NI,int NJ,int NK);
+int FPC_CompressRANSD(void *restrict CData,double *restrict Data,int NI,int NJ,int NK,size_t *restrict CSize);
 
 #endif //_FPCOMPRESSD_H
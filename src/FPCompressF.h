@@ -43,7 +43,13 @@
 #include <inttypes.h>
 #include <string.h>
 
+#ifndef FPC_SLACK
+#define FPC_SLACK 64   // Bytes FPC_Compress may write past NI*NJ*NK (last value and final flush)
+#endif
+
 int FPC_InflateF(void *restrict CData,int FD,float *restrict Data,int NI,int NJ,int NK);
 int FPC_CompressF(void *restrict CData,int FD,float *restrict Data,int NI,int NJ,int NK,size_t *restrict CSize);
+int FPC_InflateRANSF(void *restrict CData,size_t CSize,float *restrict Data,int NI,int NJ,int NK);
+int FPC_CompressRANSF(void *restrict CData,float *restrict Data,int NI,int NJ,int NK,size_t *restrict CSize);
 
 #endif //_FPCOMPRESSF_H
@@ -63,6 +63,116 @@ typedef struct TFPFCBuf {
     TBufByte    Half;   // Flag indicating if there is a half byte in the storage
 } TFPFCBuf;
 
+typedef struct TFPFCTol {
+    double      Tol;    // Absolute tolerance (absolute mode)
+    int         Mode;   // 0: lossless, 1: absolute tolerance, -1: relative tolerance
+    int         E;      // Exponent (base 2) of the absolute tolerance
+    int         Z;      // Number of mantissa bits to drop (relative mode)
+} TFPFCTol;
+
+/*----------------------------------------------------------------------------
+ * Nom      : <FPFC_TolInit>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Initialise les paramètres de troncature de la mantisse
+ *
+ * Parametres :
+ *  <Tol>   : [OUT] Les paramètres de troncature
+ *  <Val>   : Tolérance (>0 absolue, <0 relative, 0 sans perte)
+ *  <MBits> : Nombre de bits de la mantisse du type (23 ou 52)
+ *
+ * Retour   :
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+static void FPFC_TolInit(TFPFCTol *restrict Tol,double Val,int MBits) {
+    *Tol = (TFPFCTol){0.0,0,0,0};
+
+    if( Val>0.0 && isfinite(Val) ) {
+        // Absolute : we need 2^(e-MBits+z-1) <= Val where e is the exponent of the value and z the number of bits dropped
+        Tol->Mode = 1;
+        Tol->Tol = Val;
+        Tol->E = ilogb(Val);
+    } else if( Val<0.0 && isfinite(Val) ) {
+        // Relative : rounding to the nearest kept bit gives an error <= |x|*2^-(MBits-z+1)
+        Tol->Mode = -1;
+        Tol->Z = MBits+1+ilogb(-Val);
+        Tol->Z = Tol->Z<0 ? 0 : Tol->Z>MBits ? MBits : Tol->Z;
+        if( !Tol->Z )
+            Tol->Mode = 0;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <FPFC_Quantize>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Arrondi la mantisse d'un float pour respecter la tolérance
+ *
+ * Parametres :
+ *  <Val>   : La valeur (bits) à arrondir
+ *  <Tol>   : Les paramètres de troncature
+ *
+ * Retour   : La valeur arrondie (bits)
+ *
+ * Remarques : Les bits de poids faible mis à 0 rendent la prédiction exacte
+ *             sur ces bits, ce qui augmente le LZC encodé
+ *
+ *----------------------------------------------------------------------------
+ */
+static inline int32_t FPFC_Quantize(int32_t Val,const TFPFCTol *restrict Tol) {
+    const uint32_t  bits=(uint32_t)Val,exp=(bits>>23)&0xffu;
+    int             z;
+
+    // Leave NaN and Inf alone
+    if( exp==0xffu )
+        return Val;
+
+    if( Tol->Mode>0 ) {
+        if( fabsf(*(float*)&Val) <= Tol->Tol )
+            return (int32_t)(bits&0x80000000u);
+        z = Tol->E-((int)(exp?exp:1u)-127)+24;
+        z = z<0 ? 0 : z>23 ? 23 : z;
+    } else {
+        z = Tol->Z;
+    }
+
+    if( !z )
+        return Val;
+
+    // Round to nearest (unless the carry would overflow to Inf), then drop the bits
+    if( exp<0xfeu )
+        return (int32_t)((bits+(1u<<(z-1)))&~((1u<<z)-1u));
+    return (int32_t)(bits&~((1u<<z)-1u));
+}
+static inline int64_t FPFC_Quantizel(int64_t Val,const TFPFCTol *restrict Tol) {
+    const uint64_t  bits=(uint64_t)Val,exp=(bits>>52)&0x7fful;
+    int             z;
+
+    // Leave NaN and Inf alone
+    if( exp==0x7fful )
+        return Val;
+
+    if( Tol->Mode>0 ) {
+        if( fabs(*(double*)&Val) <= Tol->Tol )
+            return (int64_t)(bits&0x8000000000000000ul);
+        z = Tol->E-((int)(exp?exp:1ul)-1023)+53;
+        z = z<0 ? 0 : z>52 ? 52 : z;
+    } else {
+        z = Tol->Z;
+    }
+
+    if( !z )
+        return Val;
+
+    // Round to nearest (unless the carry would overflow to Inf), then drop the bits
+    if( exp<0x7feul )
+        return (int64_t)((bits+(1ul<<(z-1)))&~((1ul<<z)-1ul));
+    return (int64_t)(bits&~((1ul<<z)-1ul));
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <FPC_BufWriteByte>
  * Creation : Octobre 2017 - E. Legault-Ouellet - CMC/CMOE
@@ -299,6 +409,37 @@ static uint64_t FPFC_BufReadHalfBytes(TFPFCBuf *restrict Buf,unsigned int NHB) {
  *----------------------------------------------------------------------------
  */
 int FPFC_Compressl(double *restrict Data,size_t N,FPFC_IO_PARAM,size_t *CSize) {
+#ifdef FPFC_USE_MEM_IO
+    return FPFC_CompresslTol(Data,N,FPFC_LOSSLESS,CData,CBufSize,CSize);
+#else //FPFC_USE_MEM_IO
+    return FPFC_CompresslTol(Data,N,FPFC_LOSSLESS,FD,CSize);
+#endif //FPFC_USE_MEM_IO
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <FPFC_CompresslTol>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Compresse des double avec une erreur bornée
+ *
+ * Parametres :
+ *  <Data>      : Les données à compresser
+ *  <N>         : Le nombre de double à compresser
+ *  <Tol>       : Tolérance (>0 absolue, <0 relative, FPFC_LOSSLESS sans perte)
+ *  <CData>     : [?] Le buffer où écrire les données compressées
+ *  <CBufSize>  : [?] La taille du buffer de données compressées
+ *  <FD>        : [?] Le handle du fichier où écrire les données compressées
+ *  <CSize>     : [OUT] La taille (Bytes) des données compressées
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques : La mantisse est arrondie avant la prédiction, les données
+ *             d'entrée ne sont pas modifiées
+ *
+ *----------------------------------------------------------------------------
+ */
+int FPFC_CompresslTol(double *restrict Data,size_t N,double Tol,FPFC_IO_PARAM,size_t *CSize) {
+    TFPFCTol        tol;
     int64_t         *htbl=NULL,*dpred;
     uint32_t        hash,delta[3]={0u},d2;
     int64_t         val,pred,prev;
@@ -313,13 +454,17 @@ int FPFC_Compressl(double *restrict Data,size_t N,FPFC_IO_PARAM,size_t *CSize) {
     TFPFCBuf buf = (TFPFCBuf){FD,0,0,0};
 #endif //FPFC_USE_MEM_IO
 
+    FPFC_TolInit(&tol,Tol,52);
+
     // Allocate the hash table's space (2*2^20)
     htbl = calloc((1l<<21),sizeof(*htbl));
 
     // Loop on the data to compress
     for(d=0,d2=0,hash=0,prev=0; N; --N) {
-        // Encode the value as an int
+        // Encode the value as an int, dropping the mantissa bits below the tolerance
         val = *(int64_t*)Data++;
+        if( tol.Mode )
+            val = FPFC_Quantizel(val,&tol);
 
         // Locate the previous differences that will help with the prediction
         dpred = &htbl[hash*2];
@@ -477,6 +622,37 @@ int FPFC_Inflatel(double *restrict Data,size_t N,FPFC_IO_PARAM) {
  *----------------------------------------------------------------------------
  */
 int FPFC_Compress(float *restrict Data,size_t N,FPFC_IO_PARAM,size_t *CSize) {
+#ifdef FPFC_USE_MEM_IO
+    return FPFC_CompressTol(Data,N,FPFC_LOSSLESS,CData,CBufSize,CSize);
+#else //FPFC_USE_MEM_IO
+    return FPFC_CompressTol(Data,N,FPFC_LOSSLESS,FD,CSize);
+#endif //FPFC_USE_MEM_IO
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <FPFC_CompressTol>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Compresse des float avec une erreur bornée
+ *
+ * Parametres :
+ *  <Data>      : Les données à compresser
+ *  <N>         : Le nombre de float à compresser
+ *  <Tol>       : Tolérance (>0 absolue, <0 relative, FPFC_LOSSLESS sans perte)
+ *  <CData>     : [?] Le buffer où écrire les données compressées
+ *  <CBufSize>  : [?] La taille du buffer de données compressées
+ *  <FD>        : [?] Le handle du fichier où écrire les données compressées
+ *  <CSize>     : [OUT] La taille (Bytes) des données compressées
+ *
+ * Retour   : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques : La mantisse est arrondie avant la prédiction, les données
+ *             d'entrée ne sont pas modifiées
+ *
+ *----------------------------------------------------------------------------
+ */
+int FPFC_CompressTol(float *restrict Data,size_t N,double Tol,FPFC_IO_PARAM,size_t *CSize) {
+    TFPFCTol        tol;
     int32_t         *htbl=NULL,*dpred;
     uint32_t        hash,delta[2]={0},d2;
     int32_t         val,pred,prev;
@@ -491,13 +667,17 @@ int FPFC_Compress(float *restrict Data,size_t N,FPFC_IO_PARAM,size_t *CSize) {
     TFPFCBuf buf = (TFPFCBuf){FD,0,0,0};
 #endif //FPFC_USE_MEM_IO
 
+    FPFC_TolInit(&tol,Tol,23);
+
     // Allocate the hash table's space (2*2^20)
     htbl = calloc((1l<<21),sizeof(*htbl));
 
     // Loop on the data to compress
     for(d=0,d2=0,hash=0,prev=0; N; --N) {
-        // Encode the value as an int
+        // Encode the value as an int, dropping the mantissa bits below the tolerance
         val = *(int32_t*)Data++;
+        if( tol.Mode )
+            val = FPFC_Quantize(val,&tol);
 
         // Locate the previous differences that will help with the prediction
         dpred = &htbl[hash*2];
@@ -52,12 +52,18 @@ typedef unsigned char TBufByte;
 #define FPFC_IO_PARAM FILE *restrict FD
 #endif //FPFC_USE_MEM_IO
 
+// Error-bounded (lossy) mode tolerance : Tol>0 is absolute, Tol<0 is relative (|Tol|), Tol==0 is lossless
+// The inflate functions do not need to know the tolerance used
+#define FPFC_LOSSLESS 0.0
+
 // Double functions
 int FPFC_Compressl(double *restrict Data,size_t N,FPFC_IO_PARAM,size_t *CSize);
+int FPFC_CompresslTol(double *restrict Data,size_t N,double Tol,FPFC_IO_PARAM,size_t *CSize);
 int FPFC_Inflatel(double *restrict Data,size_t N,FPFC_IO_PARAM);
 
 // Float functions
 int FPFC_Compress(float *restrict Data,size_t N,FPFC_IO_PARAM,size_t *CSize);
+int FPFC_CompressTol(float *restrict Data,size_t N,double Tol,FPFC_IO_PARAM,size_t *CSize);
 int FPFC_Inflate(float *restrict Data,size_t N,FPFC_IO_PARAM);
 
 #endif // _FPFC_H
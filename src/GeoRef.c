@@ -35,6 +35,7 @@
 #include "App.h"
 #include "Def.h"
 #include "RPN.h"
+#include "SM.h"
 
 /*--------------------------------------------------------------------------------------------------------------
  * Nom          : <GeoScan_Clear>
@@ -689,6 +690,11 @@ void GeoRef_Clear(TGeoRef *Ref,int New) {
       if (Ref->Hgt)          free(Ref->Hgt);          Ref->Hgt=NULL;
       if (Ref->Wght)         free(Ref->Wght);         Ref->Wght=NULL;
       if (Ref->Idx)          free(Ref->Idx);          Ref->Idx=NULL; Ref->NIdx=0;
+      if (Ref->SMXY) {
+         SM_FREE(Ref->AX);
+         SM_FREE(Ref->AY);
+         Ref->SMXY=0;
+      }
       if (Ref->AX)           free(Ref->AX);           Ref->AX=NULL;
       if (Ref->AY)           free(Ref->AY);           Ref->AY=NULL;
 
@@ -1052,6 +1058,7 @@ TGeoRef* GeoRef_New() {
    ref->Idx=NULL;
    ref->AX=NULL;
    ref->AY=NULL;
+   ref->SMXY=0;
    ref->RefFrom=NULL;
    ref->QTree=NULL;
    ref->Grid[0]='X';
@@ -1830,6 +1837,11 @@ int GeoRef_Positional(TGeoRef *Ref,TDef *XDef,TDef *YDef) {
    }
 
    /*Clear arrays*/
+   if (Ref->SMXY) {
+      SM_FREE(Ref->AX);
+      SM_FREE(Ref->AY);
+      Ref->SMXY=0;
+   }
    if (Ref->AX) free(Ref->AX);
    if (Ref->AY) free(Ref->AY);
 
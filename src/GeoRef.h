@@ -146,6 +146,7 @@ typedef struct TGeoRef {
    unsigned int NIdx,*Idx;                                // Index dans les positions
    float        *Lat,*Lon;                                // Coordonnees des points de grilles (Spherical)
    float        *AX,*AY,*Hgt;                             // Axes de positionnement / deformation
+   int          SMXY;                                     // AX et AY sont en memoire partagee du noeud (SM_Alloc)
    double       *Wght;                                    // Barycentric weight array for TIN  (M grids)
 
    char                         *String;                  // OpenGIS WKT String description
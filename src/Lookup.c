@@ -33,12 +33,18 @@
 #include <math.h>
 #include <float.h>
 #include <stdio.h>
+#include <limits.h>
 
 #include "App.h"
 #include "Lookup.h"
 
 const TLookup LookupNULL = DLookupNULL;
 
+#define LOOKUP_LUTMAX (1<<22)    // Maximum size of a lookup table
+
+// Value I of the lookup values, whatever their precision (LU->Dbl must be set)
+#define LUVAL(LU,V,I) ((LU)->Dbl?((const double*)(V))[I]:(double)((const float*)(V))[I])
+
 /*----------------------------------------------------------------------------
  * Nom      : <Lookup_PLU_GetIdxf>
  * Creation : Juillet 2024 - E. Legault-Ouellet - CMC/CMOE
@@ -92,8 +98,34 @@ static int Lookup_PLU_GetIdxf(TLookup *restrict LU,float Val) {
 }
 
 
+static int Lookup_PLU_GetIdxd(TLookup *restrict LU,double Val) {
+   double *f = LU->LData.PLU.F;
+   double *vals=LU->Vals;
+   int i,imax=LU->NV-1;
+
+   switch( LU->LData.PLU.N ) {
+      case 1:  i = (int)round(f[0] + f[1]*Val);              break;
+      case 2:  i = (int)round(f[0] + f[1]*Val + f[2]*Val*Val); break;
+      default: return -2;
+   }
+
+   if( i <= 0 ) {
+      return Val<vals[0] ? -1 : 0;
+   } else if( i >= imax ) {
+      return Val>=vals[imax] ? imax : imax-1;
+   }
+
+   if( LU->Asc ) {
+      i += (i<imax&&Val>=vals[i+1]) - (i>0&&Val<vals[i]);
+   } else {
+      i += (i<imax&&Val<=vals[i+1]) - (i>0&&Val>vals[i]);
+   }
+
+   return i;
+}
+
 /*----------------------------------------------------------------------------
- * Nom      : <Lookup_PLU_Init1f>
+ * Nom      : <Lookup_PLU_Init1>
  * Creation : Juillet 2024 - E. Legault-Ouellet - CMC/CMOE
  *
  * But      : Initialize a 1st-order polynomial lookup (PLU)
@@ -106,12 +138,13 @@ static int Lookup_PLU_GetIdxf(TLookup *restrict LU,float Val) {
  * Retour:     APP_OK if ok, APP_ERR otherwise
  *
  * Remarques : This function needs at least 2 values. The values MUST be unique and sorted.
+ *             The values are float or double depending on LU->Dbl.
  *
  *----------------------------------------------------------------------------
  */
-static int Lookup_PLU_Init1f(TLookup *restrict LU,float *restrict Vals,int N) {
+static int Lookup_PLU_Init1(TLookup *restrict LU,const void *restrict Vals,int N) {
    TPLU *plu = &LU->LData.PLU;
-   double v,vx,sx[3],syx[2],det,inv[3];
+   double v,vx,sx[3]={0.0},syx[2]={0.0},det,inv[3];
    int i;
 
    if( N < 2 ) {
@@ -130,7 +163,7 @@ static int Lookup_PLU_Init1f(TLookup *restrict LU,float *restrict Vals,int N) {
    //    └         ┘└    ┘   └      ┘
    // Where x are the values (Vals), y are the indexes and F are the polynomial factors
    for(i=0; i<N; ++i) {
-      v = Vals[i];
+      v = LUVAL(LU,Vals,i);
 
       vx = v;  sx[1] += vx; syx[1] += i*vx;
       vx *= v; sx[2] += vx;
@@ -162,7 +195,7 @@ static int Lookup_PLU_Init1f(TLookup *restrict LU,float *restrict Vals,int N) {
 
    // Make sure none of the residuals are over 1 (to guaranty that we'll never be further that 1 index either direction)
    for(i=0; i<N; ++i) {
-      v = Vals[i];
+      v = LUVAL(LU,Vals,i);
       if( fabs(i - (plu->F[0] + plu->F[1]*v)) >= 1.0 ) {
          return APP_ERR;
       }
@@ -171,14 +204,16 @@ static int Lookup_PLU_Init1f(TLookup *restrict LU,float *restrict Vals,int N) {
    // Mark as first order
    plu->N = 1;
 
+   LU->Type    = LU_PLU;
    LU->GetIdx  = &Lookup_PLU_GetIdxf;
+   LU->GetIdxd = &Lookup_PLU_GetIdxd;
    LU->Free    = NULL;
 
    return APP_OK;
 }
 
 /*----------------------------------------------------------------------------
- * Nom      : <Lookup_PLU_Init2f>
+ * Nom      : <Lookup_PLU_Init2>
  * Creation : Juillet 2024 - E. Legault-Ouellet - CMC/CMOE
  *
  * But      : Initialize a 2nd-order polynomial lookup (PLU)
@@ -191,12 +226,13 @@ static int Lookup_PLU_Init1f(TLookup *restrict LU,float *restrict Vals,int N) {
  * Retour:     APP_OK if ok, APP_ERR otherwise
  *
  * Remarques : This function needs at least 3 values. The values MUST be unique and sorted.
+ *             The values are float or double depending on LU->Dbl.
  *
  *----------------------------------------------------------------------------
  */
-static int Lookup_PLU_Init2f(TLookup *restrict LU,float *restrict Vals,int N) {
+static int Lookup_PLU_Init2(TLookup *restrict LU,const void *restrict Vals,int N) {
    TPLU *plu = &LU->LData.PLU;
-   double v,vx,sx[5],syx[3],det,inv[6];
+   double v,vx,sx[5]={0.0},syx[3]={0.0},det,inv[6];
    int i;
 
    if( N < 3 ) {
@@ -216,7 +252,7 @@ static int Lookup_PLU_Init2f(TLookup *restrict LU,float *restrict Vals,int N) {
    //    └             ┘└    ┘   └      ┘
    // Where x are the values (Vals), y are the indexes and F are the polynomial factors
    for(i=0; i<N; ++i) {
-      v = Vals[i];
+      v = LUVAL(LU,Vals,i);
 
       vx = v;  sx[1] += vx; syx[1] += i*vx;
       vx *= v; sx[2] += vx; syx[2] += i*vx;
@@ -230,7 +266,7 @@ static int Lookup_PLU_Init2f(TLookup *restrict LU,float *restrict Vals,int N) {
    //    │ sx1 sx2 sx3 │
    //    │ sx2 sx3 sx4 │
    //    └             ┘
-   det = sx[0]*(sx[2]*sx[4] - sx[3]*sx[3]) - sx[2]*(sx[2]*sx[4] - sx[2]*sx[3]) + sx[2]*(sx[2]*sx[3] - sx[2]*sx[2]);
+   det = sx[0]*(sx[2]*sx[4] - sx[3]*sx[3]) - sx[1]*(sx[1]*sx[4] - sx[2]*sx[3]) + sx[2]*(sx[1]*sx[3] - sx[2]*sx[2]);
 
    // Calculate the inverse of the matrix using it's adjugate
    // Note: since the original matrix is symmetric, so is this one, therefore we can skip calculations for 3 values)
@@ -256,7 +292,7 @@ static int Lookup_PLU_Init2f(TLookup *restrict LU,float *restrict Vals,int N) {
 
    // Make sure none of the residuals are over 1 (to guaranty that we'll never be further that 1 index either direction)
    for(i=0; i<N; ++i) {
-      v = Vals[i];
+      v = LUVAL(LU,Vals,i);
       if( fabs(i - (plu->F[0] + plu->F[1]*v + plu->F[2]*v*v)) >= 1.0 ) {
          return APP_ERR;
       }
@@ -265,7 +301,9 @@ static int Lookup_PLU_Init2f(TLookup *restrict LU,float *restrict Vals,int N) {
    // Mark as second order
    plu->N = 2;
 
+   LU->Type    = LU_PLU;
    LU->GetIdx  = &Lookup_PLU_GetIdxf;
+   LU->GetIdxd = &Lookup_PLU_GetIdxd;
    LU->Free    = NULL;
 
    return APP_OK;
@@ -325,6 +363,33 @@ static int Lookup_LUT_GetIdxf(TLookup *restrict LU,float Val) {
 }
 
 
+static int Lookup_LUT_GetIdxd(TLookup *restrict LU,double Val) {
+   TLUT *lut=&LU->LData.LUT;
+   double *vals=LU->Vals,lui;
+   int i,imax=LU->NV-1;
+
+   lui = (Val-vals[0])*lut->FacD;
+
+   if( lui <= 0.0 ) {
+      return lui==0.0 ? 0 : -1;
+   }
+
+   i = (int)lui;
+   if( i >= lut->NL ) {
+      return imax;
+   }
+
+   i = lut->Table[i];
+
+   if( LU->Asc ) {
+      i += (i<imax&&Val>=vals[i+1]) - (i&&Val<vals[i]);
+   } else {
+      i += (i<imax&&Val<=vals[i+1]) - (i&&Val>vals[i]);
+   }
+
+   return i;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <LUT_Free>
  * Creation : Juillet 2024 - E. Legault-Ouellet - CMC/CMOE
@@ -363,6 +428,7 @@ static void Lookup_LUT_Free(TLookup *LU) {
  * Retour:     APP_OK if ok, APP_ERR otherwise
  *
  * Remarques : This function needs at least 2 values. The values MUST be unique and sorted.
+ *             Lookup_LUT_Initd is the double precision version.
  *
  *----------------------------------------------------------------------------
  */
@@ -380,7 +446,8 @@ static int Lookup_LUT_Initf(TLookup *restrict LU,float *restrict Vals,int N) {
       dvmin = fminf(fabsf(Vals[i]-Vals[i-1]),dvmin);
    }
 
-   if( dvmin <= 0.0f ) {
+   // Avoid huge tables for very uneven values, the binary search will do
+   if( dvmin <= 0.0f || fabsf(Vals[N-1]-Vals[0])/dvmin > LOOKUP_LUTMAX ) {
       return APP_ERR;
    }
 
@@ -409,12 +476,57 @@ static int Lookup_LUT_Initf(TLookup *restrict LU,float *restrict Vals,int N) {
       lut->Table[i] = idx;
    }
 
+   LU->Type    = LU_LUT;
    LU->GetIdx  = &Lookup_LUT_GetIdxf;
    LU->Free    = &Lookup_LUT_Free;
 
    return APP_OK;
 }
 
+static int Lookup_LUT_Initd(TLookup *restrict LU,double *restrict Vals,int N) {
+   TLUT *lut=&LU->LData.LUT;
+   double dvmin=DBL_MAX,dv0,val;
+   int i,idx;
+
+   if( N < 2 ) {
+      return APP_ERR;
+   }
+
+   for(i=1; i<N; ++i) {
+      dvmin = fmin(fabs(Vals[i]-Vals[i-1]),dvmin);
+   }
+
+   // Avoid huge tables for very uneven values, the binary search will do
+   if( dvmin <= 0.0 || fabs(Vals[N-1]-Vals[0])/dvmin > LOOKUP_LUTMAX ) {
+      return APP_ERR;
+   }
+
+   lut->NL = (int)(fabs(Vals[N-1]-Vals[0])/dvmin)+1;
+   if( !(lut->Table=malloc(lut->NL*sizeof(*lut->Table))) ) {
+      return APP_ERR;
+   }
+
+   lut->FacD = 1.0/dvmin;
+   if( Vals[0] > Vals[N-1] )
+      lut->FacD = -lut->FacD;
+
+   dv0 = fabs(Vals[1]-Vals[0]);
+   for(i=0,idx=0; i<lut->NL; ++i) {
+      val = i*dvmin;
+      if( val >= dv0 ) {
+         ++idx;
+         dv0 = idx<N-1 ? fabs(Vals[idx+1]-Vals[0]) : DBL_MAX;
+      }
+      lut->Table[i] = idx;
+   }
+
+   LU->Type    = LU_LUT;
+   LU->GetIdxd = &Lookup_LUT_GetIdxd;
+   LU->Free    = &Lookup_LUT_Free;
+
+   return APP_OK;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <Lookup_BiS_GetIdxf>
  * Creation : Juillet 2024 - E. Legault-Ouellet - CMC/CMOE
@@ -441,16 +553,39 @@ static int Lookup_BiS_GetIdxf(TLookup *restrict LU,float Val) {
    const int inv = !LU->Asc;
 
    // Corner cases
-   if( inv&&Val>=vals[0] || !inv&&Val<=vals[0] ) return Val==vals[0]?0:-1;
-   if( inv&&Val<=vals[max] || !inv&&Val>=vals[max] ) return max;
+   if( (inv&&Val>=vals[0]) || (!inv&&Val<=vals[0]) ) return Val==vals[0]?0:-1;
+   if( (inv&&Val<=vals[max]) || (!inv&&Val>=vals[max]) ) return max;
 
    // Binary search
    while( min <= max ) {
       idx = (max+min)>>1;
 
-      if( inv&&Val>vals[idx] || !inv&&Val<vals[idx] ) {
+      if( (inv&&Val>vals[idx]) || (!inv&&Val<vals[idx]) ) {
+         max = idx-1;
+      } else if( (inv&&Val<vals[idx]) || (!inv&&Val>vals[idx]) ) {
+         min = idx+1;
+      } else {
+         return idx;
+      }
+   }
+
+   return max;
+}
+
+static int Lookup_BiS_GetIdxd(TLookup *restrict LU,double Val) {
+   double *vals=LU->Vals;
+   int idx=0,min=0,max=LU->NV-1;
+   const int inv = !LU->Asc;
+
+   if( (inv&&Val>=vals[0]) || (!inv&&Val<=vals[0]) ) return Val==vals[0]?0:-1;
+   if( (inv&&Val<=vals[max]) || (!inv&&Val>=vals[max]) ) return max;
+
+   while( min <= max ) {
+      idx = (max+min)>>1;
+
+      if( (inv&&Val>vals[idx]) || (!inv&&Val<vals[idx]) ) {
          max = idx-1;
-      } else if( inv&&Val<vals[idx] || !inv&&Val>vals[idx] ) {
+      } else if( (inv&&Val<vals[idx]) || (!inv&&Val>vals[idx]) ) {
          min = idx+1;
       } else {
          return idx;
@@ -461,7 +596,7 @@ static int Lookup_BiS_GetIdxf(TLookup *restrict LU,float Val) {
 }
 
 /*----------------------------------------------------------------------------
- * Nom      : <Lookup_BiS_Initf>
+ * Nom      : <Lookup_BiS_Init>
  * Creation : Juillet 2024 - E. Legault-Ouellet - CMC/CMOE
  *
  * But      : Initialize a binary search (BiS) lookup
@@ -477,13 +612,24 @@ static int Lookup_BiS_GetIdxf(TLookup *restrict LU,float Val) {
  *
  *----------------------------------------------------------------------------
  */
-static int Lookup_BiS_Initf(TLookup *restrict LU,float *restrict Vals,int N) {
+static int Lookup_BiS_Init(TLookup *restrict LU,const void *restrict Vals,int N) {
+   LU->Type    = LU_BIS;
    LU->GetIdx  = &Lookup_BiS_GetIdxf;
+   LU->GetIdxd = &Lookup_BiS_GetIdxd;
    LU->Free    = NULL;
 
    return APP_OK;
 }
 
+// Cross precision queries
+static int Lookup_Wrap_GetIdxf(TLookup *restrict LU,float Val) {
+   return LU->GetIdxd(LU,(double)Val);
+}
+
+static int Lookup_Wrap_GetIdxd(TLookup *restrict LU,double Val) {
+   return LU->GetIdx(LU,(float)Val);
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <Lookup_Init1Df>
  * Creation : Juillet 2024 - E. Legault-Ouellet - CMC/CMOE
@@ -502,10 +648,50 @@ static int Lookup_BiS_Initf(TLookup *restrict LU,float *restrict Vals,int N) {
  *----------------------------------------------------------------------------
  */
 int Lookup_Init1Df(TLookup *restrict LU,float *restrict Vals,int N) {
-   if( Lookup_PLU_Init1f(LU,Vals,N)!=APP_OK
-         && Lookup_PLU_Init2f(LU,Vals,N)!=APP_OK
+   LU->Dbl = 0;
+   if( Lookup_PLU_Init1(LU,Vals,N)!=APP_OK
+         && Lookup_PLU_Init2(LU,Vals,N)!=APP_OK
          && Lookup_LUT_Initf(LU,Vals,N)!=APP_OK
-         && Lookup_BiS_Initf(LU,Vals,N)!=APP_OK
+         && Lookup_BiS_Init(LU,Vals,N)!=APP_OK
+         ) {
+      *LU = LookupNULL;
+      return APP_ERR;
+   }
+
+   LU->Vals   = Vals;
+   LU->NV     = N;
+   LU->Asc    = Vals[0]<Vals[1];
+
+   // Double precision queries go through the float version
+   LU->GetIdxd = &Lookup_Wrap_GetIdxd;
+
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Lookup_Init1Dd>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Initialize a 1D lookup on the given double precision array
+ *
+ * Parametres  :
+ *  <LU>       : The lookup structure to initialize
+ *  <Vals>     : Sorted list of unique values to build the lookup for
+ *  <N>        : Number of values
+ *
+ * Retour:     APP_OK if ok, APP_ERR otherwise
+ *
+ * Remarques : This function needs at least 2 values. The values MUST be unique and sorted.
+ *             Use LU->GetIdxd for the queries (LU->GetIdx converts its argument to double).
+ *
+ *----------------------------------------------------------------------------
+ */
+int Lookup_Init1Dd(TLookup *restrict LU,double *restrict Vals,int N) {
+   LU->Dbl = 1;
+   if( Lookup_PLU_Init1(LU,Vals,N)!=APP_OK
+         && Lookup_PLU_Init2(LU,Vals,N)!=APP_OK
+         && Lookup_LUT_Initd(LU,Vals,N)!=APP_OK
+         && Lookup_BiS_Init(LU,Vals,N)!=APP_OK
          ) {
       *LU = LookupNULL;
       return APP_ERR;
@@ -514,6 +700,201 @@ int Lookup_Init1Df(TLookup *restrict LU,float *restrict Vals,int N) {
    LU->Vals   = Vals;
    LU->NV     = N;
    LU->Asc    = Vals[0]<Vals[1];
+   LU->GetIdx = &Lookup_Wrap_GetIdxf;
 
    return APP_OK;
 }
+
+/*----------------------------------------------------------------------------
+ * Batch queries
+ *
+ * Les versions vectorielles calculent l'index approximatif (polynome ou
+ * table) et l'ajustement d'au plus un index sans branchement pour tous les
+ * points interieurs. Les points pres des extremites sont repris par la
+ * version scalaire, ce qui donne des resultats identiques a GetIdx.
+ *----------------------------------------------------------------------------
+ */
+#define LOOKUP_EDGE INT_MIN
+
+#define LOOKUP_PLU_N(SUF,T) \
+static int Lookup_PLU_GetIdxN##SUF(TLookup *restrict LU,const T *restrict Vals,int *restrict Idx,int N) { \
+   const double   f0=LU->LData.PLU.F[0],f1=LU->LData.PLU.F[1],f2=LU->LData.PLU.N==2?LU->LData.PLU.F[2]:0.0; \
+   const T       *restrict v=LU->Vals; \
+   const int      imax=LU->NV-1,asc=LU->Asc; \
+   int            n,i,e,up,dn,edge=0; \
+   double         x; \
+   \
+   _Pragma("omp simd private(x,i,e,up,dn) reduction(|:edge)") \
+   for(n=0; n<N; ++n) { \
+      x  = Vals[n]; \
+      i  = (int)floor(f0+f1*x+f2*x*x+0.5); \
+      e  = i<=0 || i>=imax; \
+      i  = i<1 ? 1 : (i>imax-1 ? imax-1 : i); \
+      up = asc ? Vals[n]>=v[i+1] : Vals[n]<=v[i+1]; \
+      dn = asc ? Vals[n]<v[i]    : Vals[n]>v[i]; \
+      Idx[n] = e ? LOOKUP_EDGE : i+up-dn; \
+      edge |= e; \
+   } \
+   return edge; \
+}
+
+#define LOOKUP_LUT_N(SUF,T,FAC) \
+static int Lookup_LUT_GetIdxN##SUF(TLookup *restrict LU,const T *restrict Vals,int *restrict Idx,int N) { \
+   const int     *restrict tbl=LU->LData.LUT.Table; \
+   const T        fac=LU->LData.LUT.FAC; \
+   const T       *restrict v=LU->Vals; \
+   const int      imax=LU->NV-1,nl=LU->LData.LUT.NL,asc=LU->Asc; \
+   int            n,i,e,up,dn,edge=0; \
+   T              lui; \
+   \
+   _Pragma("omp simd private(lui,i,e,up,dn) reduction(|:edge)") \
+   for(n=0; n<N; ++n) { \
+      lui = (Vals[n]-v[0])*fac; \
+      e   = !(lui>0) || lui>=nl; \
+      i   = tbl[e ? 0 : (int)lui]; \
+      up  = i<imax && (asc ? Vals[n]>=v[i<imax?i+1:imax] : Vals[n]<=v[i<imax?i+1:imax]); \
+      dn  = i>0    && (asc ? Vals[n]<v[i] : Vals[n]>v[i]); \
+      Idx[n] = e ? LOOKUP_EDGE : i+up-dn; \
+      edge |= e; \
+   } \
+   return edge; \
+}
+
+LOOKUP_PLU_N(f,float)
+LOOKUP_PLU_N(d,double)
+LOOKUP_LUT_N(f,float,Fac)
+LOOKUP_LUT_N(d,double,FacD)
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Lookup_GetIdxN>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the indexes of an array of values (see GetIdx)
+ *
+ * Parametres  :
+ *  <LU>       : The lookup structure
+ *  <Vals>     : Values to get the index of
+ *  <Idx>      : Indexes so that each value is contained in [idx,idx+1[, or -1
+ *               or NbVals-1 if outside the values one way or the other
+ *  <N>        : Number of values
+ *
+ * Retour:
+ *
+ * Remarques : The polynomial and table lookups are vectorized, the binary search
+ *             and queries of a different precision than the lookup are not.
+ *             Lookup_GetIdxNd is the double precision version.
+ *
+ *----------------------------------------------------------------------------
+ */
+void Lookup_GetIdxN(TLookup *restrict LU,const float *restrict Vals,int *restrict Idx,int N) {
+   int n,edge=1;
+
+   if( !LU->Dbl && LU->NV>2 ) {
+      switch( LU->Type ) {
+         case LU_PLU: edge=Lookup_PLU_GetIdxNf(LU,Vals,Idx,N); break;
+         case LU_LUT: edge=Lookup_LUT_GetIdxNf(LU,Vals,Idx,N); break;
+         default:     for(n=0; n<N; ++n) Idx[n]=LOOKUP_EDGE;
+      }
+   } else {
+      for(n=0; n<N; ++n) Idx[n]=LOOKUP_EDGE;
+   }
+
+   // Values the vector versions could not handle
+   if( edge ) {
+      for(n=0; n<N; ++n) {
+         if( Idx[n] == LOOKUP_EDGE )
+            Idx[n] = LU->GetIdx(LU,Vals[n]);
+      }
+   }
+}
+
+void Lookup_GetIdxNd(TLookup *restrict LU,const double *restrict Vals,int *restrict Idx,int N) {
+   int n,edge=1;
+
+   if( LU->Dbl && LU->NV>2 ) {
+      switch( LU->Type ) {
+         case LU_PLU: edge=Lookup_PLU_GetIdxNd(LU,Vals,Idx,N); break;
+         case LU_LUT: edge=Lookup_LUT_GetIdxNd(LU,Vals,Idx,N); break;
+         default:     for(n=0; n<N; ++n) Idx[n]=LOOKUP_EDGE;
+      }
+   } else {
+      for(n=0; n<N; ++n) Idx[n]=LOOKUP_EDGE;
+   }
+
+   if( edge ) {
+      for(n=0; n<N; ++n) {
+         if( Idx[n] == LOOKUP_EDGE )
+            Idx[n] = LU->GetIdxd(LU,Vals[n]);
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Lookup_GetPosN>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the fractional positions of an array of values
+ *
+ * Parametres  :
+ *  <LU>       : The lookup structure
+ *  <Vals>     : Values to get the position of
+ *  <Pos>      : Positions (index of the value interval plus the linear fraction within it)
+ *  <N>        : Number of values
+ *
+ * Retour:
+ *
+ * Remarques : Values outside of the lookup values are linearly extrapolated from
+ *             the first or last interval. Needs at least 2 values.
+ *
+ *----------------------------------------------------------------------------
+ */
+void Lookup_GetPosN(TLookup *restrict LU,const float *restrict Vals,float *restrict Pos,int N) {
+   int idx[256],b,n,nb,i,imax=LU->NV-2;
+
+   for(b=0; b<N; b+=256) {
+      nb = N-b<256 ? N-b : 256;
+      Lookup_GetIdxN(LU,Vals+b,idx,nb);
+
+      if( LU->Dbl ) {
+         const double *restrict v=LU->Vals;
+         for(n=0; n<nb; ++n) {
+            i = idx[n]<0 ? 0 : (idx[n]>imax ? imax : idx[n]);
+            Pos[b+n] = (float)(i + (Vals[b+n]-v[i])/(v[i+1]-v[i]));
+         }
+      } else {
+         const float *restrict v=LU->Vals;
+         #pragma omp simd private(i)
+         for(n=0; n<nb; ++n) {
+            i = idx[n]<0 ? 0 : (idx[n]>imax ? imax : idx[n]);
+            Pos[b+n] = (float)i + (Vals[b+n]-v[i])/(v[i+1]-v[i]);
+         }
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <Lookup_GetPos2DN>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the fractional grid positions of an array of points on a
+ *            separable 2D grid (X and Y axes)
+ *
+ * Parametres  :
+ *  <LUX>      : Lookup of the X axis
+ *  <LUY>      : Lookup of the Y axis
+ *  <X>        : X coordinates of the points
+ *  <Y>        : Y coordinates of the points
+ *  <PX>       : X positions (fractional index)
+ *  <PY>       : Y positions (fractional index)
+ *  <N>        : Number of points
+ *
+ * Retour:
+ *
+ * Remarques : See Lookup_GetPosN
+ *
+ *----------------------------------------------------------------------------
+ */
+void Lookup_GetPos2DN(TLookup *restrict LUX,TLookup *restrict LUY,const float *restrict X,const float *restrict Y,float *restrict PX,float *restrict PY,int N) {
+   Lookup_GetPosN(LUX,X,PX,N);
+   Lookup_GetPosN(LUY,Y,PY,N);
+}
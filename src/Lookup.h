@@ -38,23 +38,30 @@ typedef struct TPLU {
 } TPLU;
 
 typedef struct TLUT {
-   int   *Table;     // Lookup table
-   int   NL;         // Size of the lookup table and of the value array
-   float Fac;        // Lookup table factor
+   int    *Table;    // Lookup table
+   int    NL;        // Size of the lookup table and of the value array
+   float  Fac;       // Lookup table factor
+   double FacD;      // Lookup table factor (double precision values)
 } TLUT;
 
+typedef enum TLookupType { LU_NONE=0,LU_PLU,LU_LUT,LU_BIS } TLookupType;
+
 typedef struct TLookup TLookup;
 
 typedef int (*TLookupFct_GetIdxf)(TLookup*,float);
+typedef int (*TLookupFct_GetIdxd)(TLookup*,double);
 typedef void (*TLookupFct_Free)(TLookup*);
 
 typedef struct TLookup {
-   TLookupFct_GetIdxf   GetIdx; // Function to get the index
+   TLookupFct_GetIdxf   GetIdx;  // Function to get the index
    TLookupFct_Free      Free;
+   TLookupFct_GetIdxd   GetIdxd; // Function to get the index of a double precision value
 
    void  *Vals;      // Values on which to build the lookup (just a reference, not owned)
    int   NV;         // Number of values
    int   Asc;        // Whether the values are in ascending or descending order
+   int   Type;       // Lookup strategy (TLookupType)
+   int   Dbl;        // Whether the values are double (1) or float (0)
 
    // Type-specific data
    union {
@@ -63,9 +70,15 @@ typedef struct TLookup {
    } LData;
 } TLookup;
 
-#define DLookupNULL (TLookup){NULL,NULL,NULL,0,0,{0}}
+#define DLookupNULL (TLookup){.GetIdx=NULL,.Free=NULL,.GetIdxd=NULL,.Vals=NULL,.Type=LU_NONE}
 extern const TLookup LookupNULL;
 
 int Lookup_Init1Df(TLookup *LU,float *Vals,int N);
+int Lookup_Init1Dd(TLookup *LU,double *Vals,int N);
+
+void Lookup_GetIdxN(TLookup *LU,const float *Vals,int *Idx,int N);
+void Lookup_GetIdxNd(TLookup *LU,const double *Vals,int *Idx,int N);
+void Lookup_GetPosN(TLookup *LU,const float *Vals,float *Pos,int N);
+void Lookup_GetPos2DN(TLookup *LUX,TLookup *LUY,const float *X,const float *Y,float *PX,float *PY,int N);
 
 #endif // _Lookup_h
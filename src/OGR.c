@@ -33,11 +33,186 @@
 #include "App.h"
 #include "OGR.h"
 #include "DynArray.h"
+#include "OMP_Utils.h"
+
+// Scratch arena block, the data follows the header
+typedef struct OGM_ArenaBlock {
+   struct OGM_ArenaBlock *Prev;          // Previous block in the arena (or next spare block)
+   size_t                 Size,Used;     // Size and used bytes of the block
+   size_t                 Base;          // Arena offset of the start of the block
+} OGM_ArenaBlock;
+
+static __thread OGM_ArenaBlock *OGM_ArenaCur=NULL;    // Current arena block of the thread
+static __thread OGM_ArenaBlock *OGM_ArenaSpare=NULL;  // Released blocks kept for reuse
 
 static  __thread Vect3d*  OGM_Geom[2];
 static  __thread Vect3d** OGM_Ptr;
 static  __thread unsigned int OGM_GeomNb=0;
 
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_ArenaAlloc>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Allouer de l'espace de travail dans l'arene du thread courant
+ *
+ * Parametres   :
+ *   <Size>     : Taille en bytes
+ *
+ * Retour       : Pointeur sur l'espace alloue (NULL si erreur)
+ *
+ * Remarques    :
+ *    - L'espace reste valide jusqu'a OGM_ArenaRelease d'une marque anterieure ou OGM_ArenaReset,
+ *      les allocations suivantes ne le deplacent jamais (contrairement a OGM_GetVect3d)
+ *    - Chaque thread a sa propre arene, aucune synchronisation n'est necessaire
+ *---------------------------------------------------------------------------------------------------------------
+*/
+void* OGM_ArenaAlloc(size_t Size) {
+
+   OGM_ArenaBlock *blk;
+   size_t          size;
+   void           *ptr;
+
+   // Keep 16 bytes alignment
+   Size=(Size+15)&~(size_t)15;
+
+   if (!OGM_ArenaCur || OGM_ArenaCur->Used+Size>OGM_ArenaCur->Size) {
+      // Use a spare block if big enough, otherwise allocate a new one
+      if ((blk=OGM_ArenaSpare) && blk->Size>=Size) {
+         OGM_ArenaSpare=blk->Prev;
+      } else {
+         if (blk) {
+            OGM_ArenaSpare=blk->Prev;
+            free(blk);
+         }
+         size=OGM_ArenaCur?OGM_ArenaCur->Size*2:OGR_BUFFER*2*sizeof(Vect3d);
+         size=size<Size?Size:size;
+         if (!(blk=(OGM_ArenaBlock*)malloc(sizeof(OGM_ArenaBlock)+size))) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not allocate scratch arena (%zu bytes)\n",__func__,size);
+            return(NULL);
+         }
+         blk->Size=size;
+#ifdef DEBUG
+         Lib_Log(APP_LIBEER,APP_DEBUG,"%s: Increasing size by %zu\n",__func__,size);
+#endif
+      }
+      blk->Used=0;
+      blk->Base=OGM_ArenaCur?OGM_ArenaCur->Base+OGM_ArenaCur->Used:0;
+      blk->Prev=OGM_ArenaCur;
+      OGM_ArenaCur=blk;
+   }
+
+   ptr=(char*)(OGM_ArenaCur+1)+OGM_ArenaCur->Used;
+   OGM_ArenaCur->Used+=Size;
+
+   return(ptr);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_ArenaMark>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Retourne la position courante de l'arene du thread courant
+ *
+ * Parametres   :
+ *
+ * Retour       : Marque a passer a OGM_ArenaRelease
+ *
+ * Remarques    :
+ *---------------------------------------------------------------------------------------------------------------
+*/
+size_t OGM_ArenaMark(void) {
+
+   return(OGM_ArenaCur?OGM_ArenaCur->Base+OGM_ArenaCur->Used:0);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_ArenaRelease>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Liberer tout ce qui a ete alloue dans l'arene depuis une marque
+ *
+ * Parametres   :
+ *   <Mark>     : Marque obtenue par OGM_ArenaMark
+ *
+ * Retour       :
+ *
+ * Remarques    :
+ *    - Les marques doivent etre liberees dans l'ordre inverse de leur creation (pile)
+ *    - Les blocs liberes sont gardes pour reutilisation jusqu'au prochain OGM_ArenaReset
+ *---------------------------------------------------------------------------------------------------------------
+*/
+void OGM_ArenaRelease(size_t Mark) {
+
+   OGM_ArenaBlock *blk;
+
+   while((blk=OGM_ArenaCur) && blk->Base>Mark) {
+      OGM_ArenaCur=blk->Prev;
+      blk->Prev=OGM_ArenaSpare;
+      OGM_ArenaSpare=blk;
+   }
+   if (OGM_ArenaCur) {
+      OGM_ArenaCur->Used=Mark-OGM_ArenaCur->Base;
+   }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_ArenaReset>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Vider l'arene du thread courant
+ *
+ * Parametres   :
+ *
+ * Retour       :
+ *
+ * Remarques    :
+ *    - Seul le premier bloc est conserve afin de ne pas garder la memoire d'une tres grosse
+ *      geometrie
+ *    - Tout ce qui est dans l'arene est libere, y compris l'espace des appelants. Dans une
+ *      boucle parallele, ou le thread maitre peut avoir des donnees dans son arene, utiliser
+ *      plutot OGM_ArenaMark/OGM_ArenaRelease autour de chaque iteration
+ *---------------------------------------------------------------------------------------------------------------
+*/
+void OGM_ArenaReset(void) {
+
+   OGM_ArenaBlock *blk;
+
+   OGM_ArenaRelease(0);
+
+   // Only keep a default sized first block
+   while((blk=OGM_ArenaCur) && (blk->Prev || blk->Size>OGR_BUFFER*2*sizeof(Vect3d))) {
+      OGM_ArenaCur=blk->Prev;
+      free(blk);
+   }
+   while((blk=OGM_ArenaSpare)) {
+      OGM_ArenaSpare=blk->Prev;
+      free(blk);
+   }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_ArenaFree>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Liberer toute la memoire de l'arene du thread courant
+ *
+ * Parametres   :
+ *
+ * Retour       :
+ *
+ * Remarques    :
+ *---------------------------------------------------------------------------------------------------------------
+*/
+void OGM_ArenaFree(void) {
+
+   OGM_ArenaReset();
+
+   if (OGM_ArenaCur) {
+      free(OGM_ArenaCur);
+      OGM_ArenaCur=NULL;
+   }
+}
+
 #ifdef HAVE_GDAL
 
 void OGM_ClearVect3d(void) {
@@ -47,6 +222,7 @@ void OGM_ClearVect3d(void) {
       if (OGM_Ptr)  free(OGM_Ptr); OGM_Ptr=NULL;
       OGM_GeomNb=0;
    }
+   OGM_ArenaReset();
 }
 
 Vect3d* OGM_GetVect3d(unsigned int Size,unsigned int No) {
@@ -68,16 +244,19 @@ Vect3d* OGM_GetVect3d(unsigned int Size,unsigned int No) {
    return(No==2?(Vect3d*)OGM_Ptr:OGM_Geom[No]);
 }
 
-static inline int OGM_ToVect3d(OGRGeometryH Geom,unsigned int No) {
+// Copy the points of a geometry in the thread arena (release with OGM_ArenaRelease)
+static inline Vect3d* OGM_ToVect3d(OGRGeometryH Geom,unsigned int *N) {
 
-   unsigned int n;
+   Vect3d *v=NULL;
 
-   n=OGR_G_GetPointCount(Geom);
-   if (OGM_GetVect3d(n,No)) {
-      OGR_G_GetPoints(Geom,&OGM_Geom[No][0][0],sizeof(Vect3d),&OGM_Geom[No][0][1],sizeof(Vect3d),&OGM_Geom[No][0][2],sizeof(Vect3d));
-      return(n);
+   if ((*N=OGR_G_GetPointCount(Geom))) {
+      if ((v=(Vect3d*)OGM_ArenaAlloc(*N*sizeof(Vect3d)))) {
+         OGR_G_GetPoints(Geom,&v[0][0],sizeof(Vect3d),&v[0][1],sizeof(Vect3d),&v[0][2],sizeof(Vect3d));
+      } else {
+         *N=0;
+      }
    }
-   return(0);
+   return(v);
 }
 
 int OGM_QSortInter(const void *A,const void *B){
@@ -376,7 +555,7 @@ OGRGeometryH OGM_GPCOnOGR(gpc_op Op,OGRGeometryH Geom0,OGRGeometryH Geom1) {
    OGM_GPCFromOGR(&poly0,Geom0);
    OGM_GPCFromOGR(&poly1,Geom1);
 
-   gpc_polygon_clip(Op,&poly0,&poly1,&poly);
+   gpce_polygon_clip(Op,&poly0,NULL,&poly1,NULL,&poly);
 
    OGM_GPCToOGR(&poly,&geom);
 
@@ -390,42 +569,36 @@ OGRGeometryH OGM_GPCOnOGR(gpc_op Op,OGRGeometryH Geom0,OGRGeometryH Geom1) {
 #endif
 }
 
+// Combine the selected features of a layer, each feature is converted once and the
+// polygons are merged by tree reduction (gpce_polygon_cascade) before going back to OGR
 OGRGeometryH OGM_GPCOnOGRLayer(gpc_op Op,OGR_Layer *Layer) {
 
 #ifdef HAVE_GPC
-   gpc_polygon  poly0,poly1,result,*r,*p,*t;
+   gpc_polygon  *polys,result;
    OGRGeometryH geom=NULL;
-   unsigned int f;
+   unsigned int f,n=0;
 
-   OGM_GPCNew(&poly0);
-   OGM_GPCNew(&poly1);
    OGM_GPCNew(&result);
 
-   p=&poly0;
-   r=&result;
-   t=NULL;
+   if (!(polys=(gpc_polygon*)malloc((Layer->NFeature+1)*sizeof(gpc_polygon)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate polygon list\n",__func__);
+      return(NULL);
+   }
 
    for(f=0;f<Layer->NFeature;f++) {
       if (Layer->Select[f] && Layer->Feature[f]) {
          if ((geom=OGR_F_GetGeometryRef(Layer->Feature[f]))) {
-
-            OGM_GPCFromOGR((t?&poly1:&result),geom);
-            if (t) {
-               gpc_polygon_clip(Op,p,&poly1,r);
-               gpc_free_polygon(p);
-            }
-            t=p; p=r; r=t;
-
-            gpc_free_polygon(&poly1);
+            OGM_GPCNew(&polys[n]);
+            OGM_GPCFromOGR(&polys[n++],geom);
          }
       }
    }
 
-   OGM_GPCToOGR(p,&geom);
+   gpce_polygon_cascade(Op,polys,n,&result,0);
+   OGM_GPCToOGR(&result,&geom);
 
    gpc_free_polygon(&result);
-   gpc_free_polygon(&poly0);
-   gpc_free_polygon(&poly1);
+   free(polys);
 
    return(geom);
 #else
@@ -433,39 +606,33 @@ OGRGeometryH OGM_GPCOnOGRLayer(gpc_op Op,OGR_Layer *Layer) {
 #endif
 }
 
+// Combine the sub-geometries of a geometry (see OGM_GPCOnOGRLayer)
 OGRGeometryH OGM_GPCOnOGRGeometry(gpc_op Op,OGRGeometryH *Geom) {
 
 #ifdef HAVE_GPC
-   gpc_polygon  poly0,poly1,result,*r,*p,*t;
+   gpc_polygon  *polys,result;
    OGRGeometryH geom=NULL;
-   unsigned int g;
+   unsigned int g,n=0;
 
-   OGM_GPCNew(&poly0);
-   OGM_GPCNew(&poly1);
    OGM_GPCNew(&result);
 
-   p=&poly0;
-   r=&result;
-   t=NULL;
- 
+   if (!(polys=(gpc_polygon*)malloc((OGR_G_GetGeometryCount(Geom)+1)*sizeof(gpc_polygon)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate polygon list\n",__func__);
+      return(NULL);
+   }
+
    for(g=0;g<OGR_G_GetGeometryCount(Geom);g++) {
       if ((geom=OGR_G_GetGeometryRef(Geom,g))) {
-         OGM_GPCFromOGR((t?&poly1:&result),geom);
-         if (t) {
-            gpc_polygon_clip(Op,p,&poly1,r);
-            gpc_free_polygon(p);
-         }
-         t=p; p=r; r=t;
-
-         gpc_free_polygon(&poly1);
+         OGM_GPCNew(&polys[n]);
+         OGM_GPCFromOGR(&polys[n++],geom);
       }
    }
 
-   OGM_GPCToOGR(p,&geom);
+   gpce_polygon_cascade(Op,polys,n,&result,0);
+   OGM_GPCToOGR(&result,&geom);
 
    gpc_free_polygon(&result);
-   gpc_free_polygon(&poly0);
-   gpc_free_polygon(&poly1);
+   free(polys);
 
    return(geom);
 #else
@@ -579,10 +746,12 @@ static int OGM_QSortSegIntersectionPts(const void *A,const void *B){
       return 0;
 }
 static int OGM_SegIntersectionPts_(OGRGeometryH Geom,double X0,double Y0,double X1,double Y1,DynArray *restrict Pts) {
-   int n,i,npt=0;
+   int          i,npt=0;
+   unsigned int n;
+   size_t       mark=OGM_ArenaMark();
 
    // Loop on the points in the current geometry
-   if( (n=OGR_G_GetPointCount(Geom)) > 1 ) {
+   if( OGR_G_GetPointCount(Geom) > 1 ) {
       Vect3d *restrict  v;
       double            s12x,s13x,s34x,s12y,s13y,s34y,a,b,c;
 
@@ -591,8 +760,7 @@ static int OGM_SegIntersectionPts_(OGRGeometryH Geom,double X0,double Y0,double
       s12y = Y1-Y0;
 
       // Loop on the segments
-      OGM_ToVect3d(Geom,0);
-      v = OGM_Geom[0];
+      v = OGM_ToVect3d(Geom,&n);
       for(i=1; i<n; ++i) {
          // Calculate the intersection point of the two segments
          s34x = v[i][0]-v[i-1][0];
@@ -619,6 +787,7 @@ static int OGM_SegIntersectionPts_(OGRGeometryH Geom,double X0,double Y0,double
             }
          }
       }
+      OGM_ArenaRelease(mark);
    }
 
    // Recursive loop in all the sub-geometry
@@ -787,45 +956,54 @@ int OGM_Intersect(OGRGeometryH Geom0,OGRGeometryH Geom1,OGREnvelope *Env0,OGREnv
 int OGM_PointPointIntersect(OGRGeometryH Geom0,OGRGeometryH Geom1,int All) {
 
    unsigned int n0,n1,g0,g1,t=0;
+   size_t       mark=OGM_ArenaMark();
+   Vect3d      *v0,*v1;
 
-   g0=OGM_ToVect3d(Geom0,OGM_ARRAY0);
-   g1=OGM_ToVect3d(Geom1,OGM_ARRAY1);
+   v0=OGM_ToVect3d(Geom0,&g0);
+   v1=OGM_ToVect3d(Geom1,&g1);
 
    for(n0=0;n0<g0;n0++) {
       for(n1=0;n1<g1;n1++) {
-         if (Vect_Equal(OGM_Geom[0][n0],OGM_Geom[1][n1])) {
+         if (Vect_Equal(v0[n0],v1[n1])) {
             t++;
-            if (!All)
+            if (!All) {
+               OGM_ArenaRelease(mark);
                return(1);
+            }
          }
       }
    }
+   OGM_ArenaRelease(mark);
    return(All?t==g0:t);
 }
 
 int OGM_PointLineIntersect(OGRGeometryH Geom0,OGRGeometryH Geom1,int All) {
 
    unsigned int n0,n1,g0,g1,t=0,i;
-   Vect3d       v0,v1[2];
+   size_t       mark=OGM_ArenaMark();
+   Vect3d       v0,v1[2],*p0,*p1;
 
-   g0=OGM_ToVect3d(Geom0,OGM_ARRAY0);
-   g1=OGM_ToVect3d(Geom1,OGM_ARRAY1);
+   p0=OGM_ToVect3d(Geom0,&g0);
+   p1=OGM_ToVect3d(Geom1,&g1);
 
    for(n0=0;n0<g0;n0++) {
-      Vect_Assign(v0,OGM_Geom[0][n0]);
+      Vect_Assign(v0,p0[n0]);
 
       for(n1=0;n1<g1-1;n1++) {
-         Vect_Assign(v1[0],OGM_Geom[1][n1]);
-         Vect_Assign(v1[1],OGM_Geom[1][n1+1]);
+         Vect_Assign(v1[0],p1[n1]);
+         Vect_Assign(v1[1],p1[n1+1]);
 
          i=OGM_SegmentIntersect(v0,v0,v1[0],v1[1],NULL);
          if (i==1 || i==4 || i==5) {
             t++;
-            if (!All)
+            if (!All) {
+               OGM_ArenaRelease(mark);
                return(1);
+            }
          }
       }
    }
+   OGM_ArenaRelease(mark);
    return(All?t==g0:t);
 }
 
@@ -833,22 +1011,25 @@ int OGM_PointPolyIntersect(OGRGeometryH Geom0,OGRGeometryH Geom1,int All) {
 
    unsigned int n0,n1,g0,g1,n11,t=0;
    int          c=0;
-   Vect3d       v0,v1[2];
+   size_t       mark=OGM_ArenaMark();
+   Vect3d       v0,v1[2],*p0,*p1;
 
-   g0=OGM_ToVect3d(Geom0,OGM_ARRAY0);
-   g1=OGM_ToVect3d(Geom1,OGM_ARRAY1);
+   p0=OGM_ToVect3d(Geom0,&g0);
+   p1=OGM_ToVect3d(Geom1,&g1);
 
-   if (!g0 || !g1)
+   if (!g0 || !g1) {
+      OGM_ArenaRelease(mark);
       return(0);
+   }
 
    for(n0=0;n0<g0;n0++) {
-      Vect_Assign(v0,OGM_Geom[0][n0]);
+      Vect_Assign(v0,p0[n0]);
 
       c=0;
 
       for(n1=0,n11=g1-1;n1<g1;n11=n1++) {
-         Vect_Assign(v1[0],OGM_Geom[1][n1]);
-         Vect_Assign(v1[1],OGM_Geom[1][n11]);
+         Vect_Assign(v1[0],p1[n1]);
+         Vect_Assign(v1[1],p1[n11]);
 
          /*Check for point insidness*/
          if (OGR_PointInside(v0,v1[0],v1[1])) {
@@ -862,82 +1043,90 @@ int OGM_PointPolyIntersect(OGRGeometryH Geom0,OGRGeometryH Geom1,int All) {
          }
       }
    }
+   OGM_ArenaRelease(mark);
    return(All?t==g0:t);
 }
 
 int OGM_PolyPolyIntersect(OGRGeometryH Geom0,OGRGeometryH Geom1) {
 
    unsigned int n0,n1,g0,g1,n11;
-   int          c;
-   Vect3d       v0[2],v1[2];
+   int          c,r=0;
+   size_t       mark=OGM_ArenaMark();
+   Vect3d       v0[2],v1[2],*p0,*p1;
 
-   g0=OGM_ToVect3d(Geom0,OGM_ARRAY0);
-   g1=OGM_ToVect3d(Geom1,OGM_ARRAY1);
+   p0=OGM_ToVect3d(Geom0,&g0);
+   p1=OGM_ToVect3d(Geom1,&g1);
 
-   if (!g0 || !g1)
-      return(0);
+   if (g0 && g1) {
+      for(n0=0;n0<(g0-1) && !r;n0++) {
 
-   for(n0=0;n0<(g0-1);n0++) {
+         Vect_Assign(v0[0],p0[n0]);
+         Vect_Assign(v0[1],p0[n0+1]);
+         c=0;
 
-      Vect_Assign(v0[0],OGM_Geom[0][n0]);
-      Vect_Assign(v0[1],OGM_Geom[0][n0+1]);
-      c=0;
+         for(n1=0,n11=g1-2;n1<(g1-1);n11=n1++) {
 
-      for(n1=0,n11=g1-2;n1<(g1-1);n11=n1++) {
+            Vect_Assign(v1[0],p1[n1]);
+            Vect_Assign(v1[1],p1[n11]);
 
-         Vect_Assign(v1[0],OGM_Geom[1][n1]);
-         Vect_Assign(v1[1],OGM_Geom[1][n11]);
+            /*Check for segment intersection*/
+            if ((OGM_SegmentIntersect(v0[0],v0[1],v1[0],v1[1],NULL)==1)) {
+               r=1;
+               break;
+            }
 
-         /*Check for segment intersection*/
-         if ((OGM_SegmentIntersect(v0[0],v0[1],v1[0],v1[1],NULL)==1)) {
-            return(1);
+            /*Check for point insidness*/
+            if (OGR_PointInside(v0[0],v1[0],v1[1])) {
+               c=!c;
+            }
          }
-
-         /*Check for point insidness*/
-         if (OGR_PointInside(v0[0],v1[0],v1[1])) {
-            c=!c;
+         if (c) {
+            r=1;
          }
       }
-      if (c) {
-         return(1);
-      }
    }
-   return(0);
+   OGM_ArenaRelease(mark);
+   return(r);
 }
 
 int OGM_LinePolyIntersect(OGRGeometryH Geom0,OGRGeometryH Geom1) {
 
    unsigned int n0,n1,g0,g1;
-   Vect3d       v0[2],v1[2];
-
-   g0=OGM_ToVect3d(Geom0,OGM_ARRAY0);
-   g1=OGM_ToVect3d(Geom1,OGM_ARRAY1);
-
-   if (!g0 || !g1)
-      return(0);
-
-   for(n0=0;n0<g0-1;n0++) {
-      Vect_Assign(v0[0],OGM_Geom[0][n0]);
-      Vect_Assign(v0[1],OGM_Geom[0][n0+1]);
-
-      for(n1=0;n1<g1-1;n1++) {
-         Vect_Assign(v1[0],OGM_Geom[1][n1]);
-         Vect_Assign(v1[1],OGM_Geom[1][n1+1]);
-
-         /*Check for segment intersection*/
-         if ((OGM_SegmentIntersect(v0[0],v0[1],v1[0],v1[1],NULL)==1)) {
-            return(1);
+   int          r=0;
+   size_t       mark=OGM_ArenaMark();
+   Vect3d       v0[2],v1[2],*p0,*p1;
+
+   p0=OGM_ToVect3d(Geom0,&g0);
+   p1=OGM_ToVect3d(Geom1,&g1);
+
+   if (g0 && g1) {
+      for(n0=0;n0<g0-1 && !r;n0++) {
+         Vect_Assign(v0[0],p0[n0]);
+         Vect_Assign(v0[1],p0[n0+1]);
+
+         for(n1=0;n1<g1-1;n1++) {
+            Vect_Assign(v1[0],p1[n1]);
+            Vect_Assign(v1[1],p1[n1+1]);
+
+            /*Check for segment intersection*/
+            if ((OGM_SegmentIntersect(v0[0],v0[1],v1[0],v1[1],NULL)==1)) {
+               r=1;
+               break;
+            }
          }
       }
    }
-   return(0);
+   OGM_ArenaRelease(mark);
+   return(r);
 }
 
 double OGM_CoordLimit(OGRGeometryH Geom,int Coord,int Mode) {
 
-   register unsigned int n=0;
-   int                   g=0;
-   double                val=0,valg;
+   unsigned int n=0,nv;
+   int          g=0;
+   double       val=0,valg;
+   size_t       mark;
+   Vect3d      *v;
 
    if (Coord>=0 && Coord<=2) {
 
@@ -961,15 +1150,18 @@ double OGM_CoordLimit(OGRGeometryH Geom,int Coord,int Mode) {
          }
       }
 
-      for(n=0;n<OGM_ToVect3d(Geom,OGM_ARRAY0);n++) {
+      mark=OGM_ArenaMark();
+      v=OGM_ToVect3d(Geom,&nv);
+      for(n=0;n<nv;n++) {
          if (Mode==0) {
-            val=OGM_Geom[0][n][Coord]<val?OGM_Geom[0][n][Coord]:val;
+            val=v[n][Coord]<val?v[n][Coord]:val;
          } else if (Mode==1) {
-            val=OGM_Geom[0][n][Coord]>val?OGM_Geom[0][n][Coord]:val;
+            val=v[n][Coord]>val?v[n][Coord]:val;
          } else {
-            val+=OGM_Geom[0][n][Coord];
+            val+=v[n][Coord];
          }
       }
+      OGM_ArenaRelease(mark);
    }
    return(Mode==2?val/(n+g):val);
 }
@@ -989,21 +1181,26 @@ double OGM_Length(OGRGeometryH Geom) {
 
 double OGM_SegmentLength(OGRGeometryH Geom) {
 
-   register int n;
+   unsigned int n,nv;
    double       length=0;
+   size_t       mark=OGM_ArenaMark();
+   Vect3d      *v;
 
-   for(n=0;n<OGM_ToVect3d(Geom,OGM_ARRAY0)-1;n++) {
-      Vect_Substract(OGM_Geom[0][n],OGM_Geom[0][n+1],OGM_Geom[0][n]);
-      length+=Vect_Norm(OGM_Geom[0][n]);
+   v=OGM_ToVect3d(Geom,&nv);
+   for(n=0;n+1<nv;n++) {
+      Vect_Substract(v[n],v[n+1],v[n]);
+      length+=Vect_Norm(v[n]);
    }
+   OGM_ArenaRelease(mark);
    return(length);
 }
 
 double OGM_PointClosest(OGRGeometryH Geom,OGRGeometryH Pick,Vect3d Vr) {
 
-   Vect3d vr;
-   double d,dist=1e32;
-   int    n,g;
+   Vect3d       vr,*v0,*v1;
+   double       d,dist=1e32;
+   unsigned int n,g,n0,n1;
+   size_t       mark;
 
    /*Boucle recursive sur les sous geometrie*/
    for(g=0;g<OGR_G_GetGeometryCount(Geom);g++) {
@@ -1014,15 +1211,19 @@ double OGM_PointClosest(OGRGeometryH Geom,OGRGeometryH Pick,Vect3d Vr) {
       }
    }
 
-   for(g=0;g<OGM_ToVect3d(Geom,OGM_ARRAY1);g++) {
-      for(n=0;n<OGM_ToVect3d(Pick,OGM_ARRAY0);n++) {
-         d=hypot(OGM_Geom[1][g][0]-OGM_Geom[0][n][0],OGM_Geom[1][g][1]-OGM_Geom[0][n][1]);
+   mark=OGM_ArenaMark();
+   v1=OGM_ToVect3d(Geom,&n1);
+   v0=OGM_ToVect3d(Pick,&n0);
+   for(g=0;g<n1;g++) {
+      for(n=0;n<n0;n++) {
+         d=hypot(v1[g][0]-v0[n][0],v1[g][1]-v0[n][1]);
          if (d<dist) {
             dist=d;
-            Vect_Assign(Vr,OGM_Geom[1][g]);
+            Vect_Assign(Vr,v1[g]);
          }
       }
    }
+   OGM_ArenaRelease(mark);
 
    return(dist);
 }
@@ -1164,23 +1365,28 @@ double OGM_SegmentDist(Vect3d SegA,Vect3d SegB,Vect3d Point) {
 
 double OGM_Centroid2DProcess(OGRGeometryH Geom,double *X,double *Y) {
 
-   int    i,g,n,i1;
-   double area=0,mid;
+   unsigned int i,n,i1;
+   int          g;
+   double       area=0,mid;
+   size_t       mark=OGM_ArenaMark();
+   Vect3d      *v;
 
    /* Process current geometry */
-   n=OGM_ToVect3d(Geom,OGM_ARRAY0);
+   v=OGM_ToVect3d(Geom,&n);
 
    if (n==1) {
       /* Proccess point */
-      *X=OGM_Geom[0][0][0];
-      *Y=OGM_Geom[0][0][1];
+      *X=v[0][0];
+      *Y=v[0][1];
+      OGM_ArenaRelease(mark);
       return(0.0);
    } else if (n==2) {
       /* Process line */
-      *X=OGM_Geom[0][0][0];
-      *Y=OGM_Geom[0][0][1];
-      *X+=(OGM_Geom[0][1][0]-*X)/2.0;
-      *Y+=(OGM_Geom[0][1][1]-*Y)/2.0;
+      *X=v[0][0];
+      *Y=v[0][1];
+      *X+=(v[1][0]-*X)/2.0;
+      *Y+=(v[1][1]-*Y)/2.0;
+      OGM_ArenaRelease(mark);
       return(0.0);
    }
 
@@ -1188,11 +1394,12 @@ double OGM_Centroid2DProcess(OGRGeometryH Geom,double *X,double *Y) {
    for(i=0;i<n;i++) {
       i1=(i+1)%n;
 
-      area+=mid=OGM_Geom[0][i][0]*OGM_Geom[0][i1][1]-OGM_Geom[0][i][1]*OGM_Geom[0][i1][0];
-      *X+=(OGM_Geom[0][i][0]+OGM_Geom[0][i1][0])*mid;
-      *Y+=(OGM_Geom[0][i][1]+OGM_Geom[0][i1][1])*mid;
+      area+=mid=v[i][0]*v[i1][1]-v[i][1]*v[i1][0];
+      *X+=(v[i][0]+v[i1][0])*mid;
+      *Y+=(v[i][1]+v[i1][1])*mid;
    }
    area*=0.5;
+   OGM_ArenaRelease(mark);
 
    /* Process sub geometry */
    for(g=0;g<OGR_G_GetGeometryCount(Geom);g++) {
@@ -1309,58 +1516,65 @@ int OGM_SimplifyDP(double Tolerance,Vect3d *Pt,int J,int K,int *Markers) {
 //    Return: m   = the number of points in sV[]
 int OGM_Simplify(double Tolerance,OGRGeometryH Geom) {
 
-   int    i,k,pv,n=-1,m=0;         // Misc counters
+   unsigned int n;                   // Number of vertices
+   int    i,k,pv,m=0;                // Misc counters
    double tol2=Tolerance*Tolerance;  // Tolerance squared
    int    *mk;                       // Marker buffer
+   size_t mark;                      // Scratch arena mark
+   Vect3d *v,*sv;                    // Vertices and reduced vertices
 
    /*Simplify sub-geometry*/
    for(i=0;i<OGR_G_GetGeometryCount(Geom);i++) {
       m=OGM_Simplify(Tolerance,OGR_G_GetGeometryRef(Geom,i));
    }
 
-   if ((n=OGM_ToVect3d(Geom,OGM_ARRAY0))>2) {
-      mk=(int*)calloc(n,sizeof(int));
-      if (!mk) {
+   mark=OGM_ArenaMark();
+   if ((v=OGM_ToVect3d(Geom,&n)) && n>2) {
+      sv=(Vect3d*)OGM_ArenaAlloc((n+1)*sizeof(Vect3d));
+      mk=(int*)OGM_ArenaAlloc((n+1)*sizeof(int));
+      if (!sv || !mk) {
          Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate buffers\n",__func__);
+         OGM_ArenaRelease(mark);
          return(0);
       }
+      memset(mk,0x0,(n+1)*sizeof(int));
 
       /*STAGE 1: Vertex Reduction within tolerance of prior vertex cluster*/
       for(i=k=1,pv=0;i<n;i++) {
-         if (Vect_Dist2(OGM_Geom[0][i],OGM_Geom[0][pv])<tol2)
+         if (Vect_Dist2(v[i],v[pv])<tol2)
             continue;
-         Vect_Assign(OGM_Geom[1][k],OGM_Geom[0][i]);
+         Vect_Assign(sv[k],v[i]);
          k++;
          pv=i;
       }
 
       /*Start at beginning and finish at the end*/
-      OGR_G_GetPoint(Geom,0,&OGM_Geom[1][0][0],&OGM_Geom[1][0][1],&OGM_Geom[1][0][2]);
+      Vect_Assign(sv[0],v[0]);
       if (pv<n-1) {
-         OGR_G_GetPoint(Geom,n-1,&OGM_Geom[1][k][0],&OGM_Geom[1][k][1],&OGM_Geom[1][k][2]);
+         Vect_Assign(sv[k],v[n-1]);
          k++;
       }
 
       /*STAGE 2: Douglas-Peucker polyline simplification*/
       mk[0]=mk[k-1]=1;       // mark the first and last vertices
       m=2;
-      if (k>2) m=OGM_SimplifyDP(Tolerance,OGM_Geom[1],0,k-1,mk);
+      if (k>2) m=OGM_SimplifyDP(Tolerance,sv,0,k-1,mk);
 
       // copy marked vertices to the output simplified polyline
       OGR_G_Empty(Geom);
       if (m>=2) {
          for (i=m=0;i<k;i++) {
             if (mk[i]) {
-               OGR_G_AddPoint_2D(Geom,OGM_Geom[1][i][0],OGM_Geom[1][i][1]);
+               OGR_G_AddPoint_2D(Geom,sv[i][0],sv[i][1]);
                m++;
             }
          }
       } else {
-         OGR_G_AddPoint_2D(Geom,OGM_Geom[1][0][0],OGM_Geom[1][0][1]);
-         OGR_G_AddPoint_2D(Geom,OGM_Geom[1][k-1][0],OGM_Geom[1][k-1][1]);
+         OGR_G_AddPoint_2D(Geom,sv[0][0],sv[0][1]);
+         OGR_G_AddPoint_2D(Geom,sv[k-1][0],sv[k-1][1]);
       }
-      free(mk);
    }
+   OGM_ArenaRelease(mark);
    return(m); // m vertices in simplified polyline
 }
 
@@ -1398,15 +1612,17 @@ int OGM_Clean(OGRGeometryH Geom) {
 
    unsigned int g;
    int    i,v,r=0;
+   size_t mark=OGM_ArenaMark();
+   Vect3d *pt;
    
    // Get vertices into a temporary vector array
-   g=OGM_ToVect3d(Geom,OGM_ARRAY0);
+   pt=OGM_ToVect3d(Geom,&g);
 
    // Check for contiguous vextex repeat
-   for(i=0;i<g-1;i++) {
-      if (Vect_Equal(OGM_Geom[0][i],OGM_Geom[0][i+1])) {
+   for(i=0;i<(int)g-1;i++) {
+      if (Vect_Equal(pt[i],pt[i+1])) {
          for(v=i;v<g-1;v++) {
-            Vect_Assign(OGM_Geom[0][v],OGM_Geom[0][v+1]);
+            Vect_Assign(pt[v],pt[v+1]);
             r=1;
          }
          g--;
@@ -1417,9 +1633,10 @@ int OGM_Clean(OGRGeometryH Geom) {
    // If found any, rebuild geometry without the repeats
    if (r) {
       v=OGR_G_GetCoordinateDimension(Geom);
-      OGR_G_SetPoints(Geom,g,&OGM_Geom[0][0][0],sizeof(Vect3d),&OGM_Geom[0][0][1],sizeof(Vect3d),&OGM_Geom[0][0][2],sizeof(Vect3d));
+      OGR_G_SetPoints(Geom,g,&pt[0][0],sizeof(Vect3d),&pt[0][1],sizeof(Vect3d),&pt[0][2],sizeof(Vect3d));
       OGR_G_SetCoordinateDimension(Geom,v);
    }
+   OGM_ArenaRelease(mark);
    
    // Parse subgeometry
    for(i=0;i<OGR_G_GetGeometryCount(Geom);i++) {
@@ -1546,6 +1763,153 @@ err:
    return NULL;
 }
 
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_PolySplitTileMT>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Version parallele (taches OpenMP) de OGM_PolySplitTile
+ *
+ * Parametres   :
+ *   <Poly>     : (Multi)polygone a decouper
+ *   <MaxPoints>: Nombre maximal de points par polygone
+ *   <NThreads> : Nombre de threads (0 pour le defaut OpenMP)
+ *
+ * Retour       : Polygone ou multi-polygone resultant (NULL si erreur)
+ *
+ * Remarques    :
+ *    - Chaque moitie d'un decoupage et chaque sous-polygone d'un multi-polygone est une tache
+ *    - Les polygones sont retournes dans le meme ordre que OGM_PolySplitTile
+ *---------------------------------------------------------------------------------------------------------------
+*/
+static void OGM_PolySplitGather(DynArray *Sub,unsigned int N,DynArray *Res,int *Ok) {
+   OGRGeometryH *geom;
+   unsigned int  i;
+   size_t        g;
+
+   for(i=0;i<N;i++) {
+      if (*Ok && !(*Ok=DynArray_Push(Res,Sub[i].Arr,Sub[i].N))) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate result list\n",__func__);
+      }
+      if (!*Ok) {
+         for(g=0,geom=(OGRGeometryH*)Sub[i].Arr;g<Sub[i].N/sizeof(OGRGeometryH);g++) {
+            OGR_G_DestroyGeometry(geom[g]);
+         }
+      }
+      DynArray_Free(&Sub[i]);
+   }
+}
+
+static int OGM_PolySplitTileTask(OGRGeometryH Poly,int Own,const unsigned int MaxPoints,DynArray *Res) {
+   DynArray     *sub,half[2];
+   OGRGeometryH  clip[2];
+   OGREnvelope   penv;
+   unsigned int  i,n,np;
+   int           ok=1;
+
+   switch(Poly?OGR_G_GetGeometryType(Poly):wkbUnknown) {
+      case wkbMultiPolygon:
+         // Sub-polygons are split independently
+         n=OGR_G_GetGeometryCount(Poly);
+         if (!(sub=(DynArray*)calloc(n,sizeof(DynArray)))) {
+            ok=0;
+            break;
+         }
+         for(i=0;i<n;i++) {
+            DynArray_Init(&sub[i],0);
+            #pragma omp task firstprivate(i) shared(sub,ok)
+            if (!OGM_PolySplitTileTask(OGR_G_GetGeometryRef(Poly,i),0,MaxPoints,&sub[i])) {
+               OMP_ATOMIC_WRITE(ok=0);
+            }
+         }
+         #pragma omp taskwait
+         OGM_PolySplitGather(sub,n,Res,&ok);
+         free(sub);
+         break;
+
+      case wkbPolygon:
+         for(i=0,np=0,n=OGR_G_GetGeometryCount(Poly);i<n;i++) {
+            np+=OGR_G_GetPointCount(OGR_G_GetGeometryRef(Poly,i));
+         }
+
+         if (np>MaxPoints) {
+            // Split on the biggest extent, both halves are clipped in parallel
+            OGR_G_GetEnvelope(Poly,&penv);
+            if (penv.MaxX-penv.MinX>=penv.MaxY-penv.MinY) {
+               clip[0]=OGM_MkClipPoly(penv.MinX,penv.MinY,(penv.MinX+penv.MaxX)/2.0,penv.MaxY);
+               clip[1]=OGM_MkClipPoly((penv.MinX+penv.MaxX)/2.0,penv.MinY,penv.MaxX,penv.MaxY);
+            } else {
+               clip[0]=OGM_MkClipPoly(penv.MinX,penv.MinY,penv.MaxX,(penv.MinY+penv.MaxY)/2.0);
+               clip[1]=OGM_MkClipPoly(penv.MinX,(penv.MinY+penv.MaxY)/2.0,penv.MaxX,penv.MaxY);
+            }
+
+            for(i=0;i<2;i++) {
+               DynArray_Init(&half[i],0);
+               #pragma omp task firstprivate(i) shared(clip,half,ok)
+               if (!clip[i] || !OGM_PolySplitTileTask(OGR_G_Intersection(Poly,clip[i]),1,MaxPoints,&half[i])) {
+                  OMP_ATOMIC_WRITE(ok=0);
+               }
+            }
+            #pragma omp taskwait
+            OGM_PolySplitGather(half,2,Res,&ok);
+            OGR_G_DestroyGeometry(clip[0]);
+            OGR_G_DestroyGeometry(clip[1]);
+         } else {
+            // Small enough, the polygon goes in the result (taking it over if we own it)
+            if (!Own) {
+               Poly=OGR_G_Clone(Poly);
+            }
+            Own=0;
+            if (!DynArray_Push(Res,&Poly,sizeof(OGRGeometryH))) {
+               Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate result list\n",__func__);
+               OGR_G_DestroyGeometry(Poly);
+               ok=0;
+            }
+         }
+         break;
+
+      default:
+         // This should never happen with proper polygons
+         ok=0;
+   }
+
+   if (Own && Poly) {
+      OGR_G_DestroyGeometry(Poly);
+   }
+   return(ok);
+}
+
+OGRGeometryH OGM_PolySplitTileMT(OGRGeometryH Poly,const unsigned int MaxPoints,int NThreads) {
+   DynArray      res;
+   OGRGeometryH  geom=NULL,*list;
+   size_t        g,n;
+   int           ok=1;
+
+   DynArray_Init(&res,0);
+
+   #pragma omp parallel num_threads(NThreads>0?NThreads:omp_get_max_threads()) if(NThreads!=1)
+   #pragma omp single
+   ok=OGM_PolySplitTileTask(Poly,0,MaxPoints,&res);
+
+   list=(OGRGeometryH*)res.Arr;
+   n=res.N/sizeof(OGRGeometryH);
+   if (!ok) {
+      for(g=0;g<n;g++) {
+         OGR_G_DestroyGeometry(list[g]);
+      }
+   } else if (n==1) {
+      // A single polygon is returned as is
+      geom=list[0];
+   } else {
+      geom=OGR_G_CreateGeometry(wkbMultiPolygon);
+      for(g=0;g<n;g++) {
+         OGR_G_AddGeometryDirectly(geom,list[g]);
+      }
+   }
+   DynArray_Free(&res);
+
+   return(geom);
+}
+
 OGRGeometryH OGM_ClipLonWrap(OGRGeometryH Poly) {
    gpc_polygon    poly,clip;
    OGRGeometryH   res=NULL;
@@ -1573,4 +1937,329 @@ OGRGeometryH OGM_ClipLonWrap(OGRGeometryH Poly) {
    return res;
 }
 
+// R-tree entry used while packing a level
+typedef struct OGM_RTreeEntry {
+   OGREnvelope  Env;
+   unsigned int Idx;
+} OGM_RTreeEntry;
+
+static int OGM_QSortRTreeX(const void *A,const void *B) {
+   const OGREnvelope *a=&((const OGM_RTreeEntry*)A)->Env,*b=&((const OGM_RTreeEntry*)B)->Env;
+   double ca=a->MinX+a->MaxX,cb=b->MinX+b->MaxX;
+
+   return(ca<cb?-1:(ca>cb?1:0));
+}
+
+static int OGM_QSortRTreeY(const void *A,const void *B) {
+   const OGREnvelope *a=&((const OGM_RTreeEntry*)A)->Env,*b=&((const OGM_RTreeEntry*)B)->Env;
+   double ca=a->MinY+a->MaxY,cb=b->MinY+b->MaxY;
+
+   return(ca<cb?-1:(ca>cb?1:0));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_RTreeNew>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Construire un R-tree statique sur une liste d'enveloppes (Sort-Tile-Recursive)
+ *
+ * Parametres   :
+ *   <Env>      : Enveloppes des items
+ *   <Idx>      : Index retourne pour chaque item (NULL pour la position dans Env)
+ *   <N>        : Nombre d'items
+ *   <Fanout>   : Nombre d'entrees par noeud (0 pour OGM_RTREE_FANOUT)
+ *
+ * Retour       : R-tree (NULL si erreur)
+ *
+ * Remarques    :
+ *    - A chaque niveau, les entrees sont triees en X, coupees en tranches verticales de
+ *      sqrt(noeuds) noeuds, chaque tranche est triee en Y puis groupee par Fanout entrees
+ *    - L'arbre est en lecture seule et peut etre interroge par plusieurs threads a la fois
+ *---------------------------------------------------------------------------------------------------------------
+*/
+OGM_RTree* OGM_RTreeNew(const OGREnvelope *Env,const unsigned int *Idx,unsigned int N,unsigned int Fanout) {
+
+   OGM_RTree      *tree=NULL;
+   OGM_RTreeEntry *ent=NULL;
+   OGREnvelope    *env;
+   unsigned int    i,j,l,nn,np,ns,ss,start,total;
+
+   Fanout=Fanout<2?OGM_RTREE_FANOUT:(Fanout>OGM_RTREE_MAXFANOUT?OGM_RTREE_MAXFANOUT:Fanout);
+
+   // Count the entries of all levels
+   for(total=0,nn=N;;nn=(nn+Fanout-1)/Fanout) {
+      total+=nn;
+      if (nn<=Fanout) break;
+   }
+
+   if (!(tree=(OGM_RTree*)calloc(1,sizeof(OGM_RTree))) ||
+       !(tree->Env=(OGREnvelope*)malloc((total+1)*sizeof(OGREnvelope))) ||
+       !(tree->Idx=(unsigned int*)malloc((total+1)*sizeof(unsigned int))) ||
+       !(ent=(OGM_RTreeEntry*)malloc((N+1)*sizeof(OGM_RTreeEntry)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate R-tree (%u items)\n",__func__,N);
+      OGM_RTreeFree(tree);
+      return(NULL);
+   }
+   tree->Fanout=Fanout;
+
+   for(i=0;i<N;i++) {
+      ent[i].Env=Env[i];
+      ent[i].Idx=Idx?Idx[i]:i;
+   }
+
+   for(l=0,nn=N,start=0;;l++) {
+      tree->Level[l]=start;
+      np=(nn+Fanout-1)/Fanout;
+
+      // Pack the level unless it is the top one
+      if (nn>Fanout) {
+         ns=(unsigned int)ceil(sqrt((double)np));
+         ss=((np+ns-1)/ns)*Fanout;
+         qsort(ent,nn,sizeof(OGM_RTreeEntry),OGM_QSortRTreeX);
+         for(i=0;i<nn;i+=ss) {
+            qsort(&ent[i],(nn-i)<ss?(nn-i):ss,sizeof(OGM_RTreeEntry),OGM_QSortRTreeY);
+         }
+      }
+      for(i=0;i<nn;i++) {
+         tree->Env[start+i]=ent[i].Env;
+         tree->Idx[start+i]=ent[i].Idx;
+      }
+      if (nn<=Fanout) break;
+
+      // Parent entries cover Fanout consecutive entries of this level
+      for(j=0;j<np;j++) {
+         env=&tree->Env[start+j*Fanout];
+         ent[j].Env=*env;
+         ent[j].Idx=start+j*Fanout;
+         for(i=1;i<Fanout && j*Fanout+i<nn;i++) {
+            env++;
+            ent[j].Env.MinX=fmin(ent[j].Env.MinX,env->MinX);
+            ent[j].Env.MaxX=fmax(ent[j].Env.MaxX,env->MaxX);
+            ent[j].Env.MinY=fmin(ent[j].Env.MinY,env->MinY);
+            ent[j].Env.MaxY=fmax(ent[j].Env.MaxY,env->MaxY);
+         }
+      }
+      start+=nn;
+      nn=np;
+   }
+   tree->NLevel=l+1;
+   tree->Level[tree->NLevel]=start+nn;
+
+   free(ent);
+   return(tree);
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_RTreeFree>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Liberer un R-tree
+ *
+ * Parametres   :
+ *   <Tree>     : R-tree
+ *
+ * Retour       :
+ *
+ * Remarques    :
+ *---------------------------------------------------------------------------------------------------------------
+*/
+void OGM_RTreeFree(OGM_RTree *Tree) {
+
+   if (Tree) {
+      if (Tree->Env) free(Tree->Env);
+      if (Tree->Idx) free(Tree->Idx);
+      free(Tree);
+   }
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_RTreeSearch>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Trouver les items dont l'enveloppe touche une enveloppe
+ *
+ * Parametres   :
+ *   <Tree>     : R-tree
+ *   <Env>      : Enveloppe recherchee
+ *   <Res>      : Tableau dynamique auquel sont ajoutes les index (unsigned int) des items trouves
+ *
+ * Retour       : Nombre d'items trouves (-1 si erreur)
+ *
+ * Remarques    :
+ *---------------------------------------------------------------------------------------------------------------
+*/
+int OGM_RTreeSearch(const OGM_RTree *Tree,const OGREnvelope *Env,DynArray *Res) {
+
+   unsigned int  stack[OGM_RTREE_MAXLEVEL*OGM_RTREE_MAXFANOUT];
+   unsigned char lvl[OGM_RTREE_MAXLEVEL*OGM_RTREE_MAXFANOUT];
+   unsigned int  e,c,ce,ns=0;
+   int           l,n=0;
+
+   if (!Tree || Tree->Level[Tree->NLevel]==0) {
+      return(0);
+   }
+
+   for(e=Tree->Level[Tree->NLevel],l=Tree->NLevel-1;e>Tree->Level[l];) {
+      stack[ns]=--e;
+      lvl[ns++]=l;
+   }
+
+   while(ns) {
+      e=stack[--ns];
+      l=lvl[ns];
+
+      if (!OGR_G_EnvelopeIntersect(Tree->Env[e],(*Env))) {
+         continue;
+      }
+
+      if (l==0) {
+         if (!DynArray_Push(Res,&Tree->Idx[e],sizeof(unsigned int))) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate result array\n",__func__);
+            return(-1);
+         }
+         n++;
+      } else {
+         // Push the childs in reverse so that they come out in order
+         c=Tree->Idx[e];
+         ce=c+Tree->Fanout<Tree->Level[l]?c+Tree->Fanout:Tree->Level[l];
+         while(ce>c) {
+            stack[ns]=--ce;
+            lvl[ns++]=l-1;
+         }
+      }
+   }
+   return(n);
+}
+
+static int OGM_QSortPair(const void *A,const void *B) {
+   const unsigned int *a=A,*b=B;
+
+   return(a[0]!=b[0]?(a[0]<b[0]?-1:1):(a[1]<b[1]?-1:(a[1]>b[1])));
+}
+
+/*--------------------------------------------------------------------------------------------------------------
+ * Nom          : <OGM_LayerJoin>
+ * Creation     : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But          : Jointure spatiale entre les features selectionnees de deux couches
+ *
+ * Parametres   :
+ *   <Layer0>   : Couche interrogee (ex: points)
+ *   <Layer1>   : Couche indexee (ex: regions)
+ *   <Mode>     : Predicat ('I': intersection (OGM_Intersect), 'W': Layer0 a l'interieur de Layer1 (OGM_Within))
+ *   <Pairs>    : Paires d'index de features (Layer0,Layer1), triees, a liberer par l'appelant
+ *   <NThreads> : Nombre de threads (0 pour le defaut OpenMP)
+ *
+ * Retour       : Nombre de paires (-1 si erreur)
+ *
+ * Remarques    :
+ *    - Un R-tree est construit sur les enveloppes de Layer1, chaque feature de Layer1 est ensuite
+ *      cherchee par son enveloppe et le predicat exact n'est applique qu'aux candidats
+ *    - Layer1 devrait etre la plus petite des deux couches
+ *---------------------------------------------------------------------------------------------------------------
+*/
+int OGM_LayerJoin(OGR_Layer *Layer0,OGR_Layer *Layer1,char Mode,unsigned int **Pairs,int NThreads) {
+
+   OGM_RTree    *tree=NULL;
+   OGREnvelope  *env=NULL;
+   OGRGeometryH  geom;
+   unsigned int *idx=NULL,f,n=0;
+   DynArray      pairs;
+   int           np=-1,error=0;
+
+   *Pairs=NULL;
+   DynArray_Init(&pairs,0);
+
+   if (Mode!='I' && Mode!='W') {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Invalid join mode (%c)\n",__func__,Mode);
+      goto end;
+   }
+
+   // Index the envelopes of the selected features of Layer1
+   if (!(env=(OGREnvelope*)malloc((Layer1->NFeature+1)*sizeof(OGREnvelope))) || !(idx=(unsigned int*)malloc((Layer1->NFeature+1)*sizeof(unsigned int)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate envelopes\n",__func__);
+      goto end;
+   }
+   for(f=0;f<Layer1->NFeature;f++) {
+      if (Layer1->Select[f] && Layer1->Feature[f] && (geom=OGR_F_GetGeometryRef(Layer1->Feature[f]))) {
+         OGR_G_GetEnvelope(geom,&env[n]);
+         idx[n++]=f;
+      }
+   }
+   if (!(tree=OGM_RTreeNew(env,NULL,n,OGM_RTREE_FANOUT))) {
+      goto end;
+   }
+
+   #pragma omp parallel num_threads(NThreads>0?NThreads:omp_get_max_threads()) if(NThreads!=1)
+   {
+      OGRGeometryH  geom0,geom1;
+      OGREnvelope   env0;
+      DynArray      cand,res;
+      unsigned int  f0,c,*p,pair[2];
+      size_t        mark;
+      int           nc;
+
+      DynArray_Init(&cand,0);
+      DynArray_Init(&res,0);
+
+      #pragma omp for schedule(dynamic,256)
+      for(f0=0;f0<Layer0->NFeature;f0++) {
+         if (error || !Layer0->Select[f0] || !Layer0->Feature[f0] || !(geom0=OGR_F_GetGeometryRef(Layer0->Feature[f0]))) {
+            continue;
+         }
+         OGR_G_GetEnvelope(geom0,&env0);
+
+         // Exact predicate on the candidates only
+         cand.N=0;
+         if ((nc=OGM_RTreeSearch(tree,&env0,&cand))<0) {
+            error=1;
+            continue;
+         }
+         mark=OGM_ArenaMark();
+         for(c=0,p=(unsigned int*)cand.Arr;c<nc;c++,p++) {
+            geom1=OGR_F_GetGeometryRef(Layer1->Feature[idx[*p]]);
+            if (Mode=='W'?OGM_Within(geom0,geom1,&env0,&env[*p]):OGM_Intersect(geom0,geom1,&env0,&env[*p])) {
+               pair[0]=f0;
+               pair[1]=idx[*p];
+               if (!DynArray_Push(&res,pair,sizeof(pair))) {
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate result array\n",__func__);
+                  error=1;
+                  break;
+               }
+            }
+         }
+         // Only release this feature's scratch space, the master thread's arena may hold its caller's data
+         OGM_ArenaRelease(mark);
+      }
+
+      #pragma omp critical
+      {
+         if (!error && res.N && !DynArray_Push(&pairs,res.Arr,res.N)) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate result array\n",__func__);
+            error=1;
+         }
+      }
+      DynArray_Free(&cand);
+      DynArray_Free(&res);
+   }
+
+   if (!error) {
+      // Threads finish in any order, sort to get a reproducible result
+      np=pairs.N/(2*sizeof(unsigned int));
+      qsort(pairs.Arr,np,2*sizeof(unsigned int),OGM_QSortPair);
+      if (np) {
+         *Pairs=(unsigned int*)pairs.Arr;
+         pairs.Arr=NULL;
+      }
+   }
+
+end:
+   DynArray_Free(&pairs);
+   OGM_RTreeFree(tree);
+   if (env) free(env);
+   if (idx) free(idx);
+
+   return(np);
+}
+
 #endif
@@ -35,6 +35,7 @@
 #define _OGR_h
 
 #include "GeoRef.h"
+#include "DynArray.h"
 
 #define OGR_G_EnvelopeIntersect(ENV0,ENV1) (!(ENV0.MaxX<ENV1.MinX || ENV0.MinX>ENV1.MaxX || ENV0.MaxY<ENV1.MinY || ENV0.MinY>ENV1.MaxY))
 #define OGR_PointInside(V,V0,V1)           (((V0[1]<=V[1] && V[1]<V1[1]) || (V1[1]<=V[1] && V[1]<V0[1])) && (V[0]<((V1[0]-V0[0])*(V[1]-V0[1])/(V1[1]-V0[1])+V0[0])))
@@ -87,6 +88,17 @@ typedef struct OGR_Layer {
    char             Changed;             // Is the layer changed
 } OGR_Layer;
 
+#define OGM_RTREE_FANOUT   16         // Default number of entries per R-tree node
+#define OGM_RTREE_MAXFANOUT 64
+#define OGM_RTREE_MAXLEVEL  32
+
+typedef struct OGM_RTree {
+   OGREnvelope   *Env;                                // Envelopes of the entries, level by level from the leaves up
+   unsigned int  *Idx;                                // Item index for the leaves, first child entry for the nodes
+   unsigned int   Level[OGM_RTREE_MAXLEVEL+1];        // First entry of each level (Level[NLevel]=number of entries)
+   unsigned int   NLevel,Fanout;                      // Number of levels and number of entries per node
+} OGM_RTree;
+
 #define OGM_ARRAY0   0
 #define OGM_ARRAY1   1
 #define OGM_ARRAYPTR 2
@@ -109,6 +121,11 @@ void         OGM_GPCNew(gpc_polygon *Poly);
 
 Vect3d*      OGM_GetVect3d(unsigned int Size,unsigned int No);
 void         OGM_ClearVect3d(void);
+void*        OGM_ArenaAlloc(size_t Size);
+size_t       OGM_ArenaMark(void);
+void         OGM_ArenaRelease(size_t Mark);
+void         OGM_ArenaReset(void);
+void         OGM_ArenaFree(void);
 void         OGM_OGRProject(OGRGeometryH Geom,TGeoRef *FromRef,TGeoRef *ToRef);
 int          OGM_QSortInter(const void *A,const void *B);
 int          OGM_Within(OGRGeometryH Geom0,OGRGeometryH Geom1,OGREnvelope *Env0,OGREnvelope *Env1);
@@ -135,6 +152,12 @@ int          OGM_SimplifyDP(double Tolerance,Vect3d *Pt,int J,int K,int *Markers
 double       OGM_AngleMin(OGRGeometryH Geom);
 int          OGM_Clean(OGRGeometryH Geom);
 OGRGeometryH OGM_PolySplitTile(OGRGeometryH Poly,const unsigned int MaxPoints,OGRGeometryH Res);
+OGRGeometryH OGM_PolySplitTileMT(OGRGeometryH Poly,const unsigned int MaxPoints,int NThreads);
 OGRGeometryH OGM_ClipLonWrap(OGRGeometryH Poly);
 
+OGM_RTree*   OGM_RTreeNew(const OGREnvelope *Env,const unsigned int *Idx,unsigned int N,unsigned int Fanout);
+void         OGM_RTreeFree(OGM_RTree *Tree);
+int          OGM_RTreeSearch(const OGM_RTree *Tree,const OGREnvelope *Env,DynArray *Res);
+int          OGM_LayerJoin(OGR_Layer *Layer0,OGR_Layer *Layer1,char Mode,unsigned int **Pairs,int NThreads);
+
 #endif
@@ -26,11 +26,18 @@
     const size_t OMP_START=_OMP_GMIN+_OMP_TNUM*_OMP_PN+(_OMP_TNUM<=_OMP_R?_OMP_TNUM:_OMP_R); \
     const size_t OMP_END=OMP_START+OMP_N;
 
+// Check for OpenMP 4.0 or greater (sequentially consistent read/write, usable to publish data)
+#if _OPENMP >= 201307
+#define OMP_ATOMIC_READ(Code) _Pragma("omp atomic read seq_cst") Code
+#define OMP_ATOMIC_WRITE(Code) _Pragma("omp atomic write seq_cst") Code
+#define OMP_ATOMIC_CAPTURE(Code) _Pragma("omp atomic capture") Code
 // Check for OpenMP 3.1 or greater
-#if _OPENMP >= 201107
+#elif _OPENMP >= 201107
+#define OMP_ATOMIC_READ(Code) _Pragma("omp atomic read") Code
 #define OMP_ATOMIC_WRITE(Code) _Pragma("omp atomic write") Code
 #define OMP_ATOMIC_CAPTURE(Code) _Pragma("omp atomic capture") Code
 #else
+#define OMP_ATOMIC_READ(Code) _Pragma("omp critical") { Code; }
 #define OMP_ATOMIC_WRITE(Code) _Pragma("omp critical") { Code; }
 #define OMP_ATOMIC_CAPTURE(Code) _Pragma("omp critical") { Code; }
 #endif
@@ -64,6 +71,7 @@
 
 #define OMP_PARALLEL_FOR_GUIDED(Min,Max,Fac,Id,BlckCntr) OMP_PARALLEL_FOR_DECL(Min,Max)
 #define OMP_PARALLEL_FOR_GUIDED_NEXT(Id,BlckCntr)
+#define OMP_ATOMIC_READ(Code)    Code
 #define OMP_ATOMIC_WRITE(Code)   Code
 #define OMP_ATOMIC_CAPTURE(Code) Code
 
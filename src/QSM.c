@@ -39,7 +39,37 @@
 #include <stdlib.h>
 
 /*----------------------------------------------------------------------------
- * Nom      : <QSM_New>
+ * Nom      : <QSM_BuildLUT>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Construit la table de recherche des symboles à partir de la CDF
+ *
+ * Parametres :
+ *  <QSM>   : Modèle
+ *
+ * Retour   :
+ *
+ * Remarques :
+ *    Chaque entrée contient le symbole qui contient la plus petite fréquence
+ *    cumulée de l'entrée, la recherche n'a donc qu'à avancer à partir de là
+ *
+ *----------------------------------------------------------------------------
+ */
+static void QSM_BuildLUT(TQSM *restrict QSM) {
+    TQSMFreq *restrict cdf = QSM->CDF;
+    TQSMSym  *restrict lut = QSM->LUT;
+    TQSMFreq i;
+    TQSMSym  s=0;
+
+    for(i=0; i<QSM->LUTSize; ++i) {
+        while( s+1<QSM->Size && cdf[s+1]<=i<<QSM->LUTShift )
+            ++s;
+        lut[i] = s;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <QSM_Init>
  * Creation : Mars 2017 - E. Legault-Ouellet - CMC/CMOE
  *
  * But      : Retourne une structure TQSM initialisée
@@ -47,6 +77,7 @@
  * Parametres :
  *  <Size>  : Maximum number of different symbols
  *  <UpFreq>: Target update frequency
+ *  <Exact> : Keep the total frequency exactly constant
  *
  * Retour   : Une structure TQSM initialisée ou NULL en cas d'erreur
  *
@@ -54,7 +85,7 @@
  *
  *----------------------------------------------------------------------------
  */
-TQSM* QSM_New(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq) {
+static TQSM* QSM_Init(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq,int Exact) {
     TQSM *qsm = malloc(sizeof(*qsm));
 
     if( qsm ) {
@@ -68,6 +99,10 @@ TQSM* QSM_New(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq) {
             return NULL;
         }
         qsm->Size = Size;
+        qsm->LUT = NULL;
+        qsm->LUTSize = 0;
+        qsm->LUTShift = 0;
+        qsm->Exact = Exact;
 
         // Since the total cumulative frequency is fixed, distribute that total frequency over
         // all the symbols (note that the integer division is taken into account here)
@@ -85,6 +120,90 @@ TQSM* QSM_New(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq) {
     return qsm;
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <QSM_New>
+ * Creation : Mars 2017 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne une structure TQSM initialisée
+ *
+ * Parametres :
+ *  <Size>  : Maximum number of different symbols
+ *  <UpFreq>: Target update frequency
+ *
+ * Retour   : Une structure TQSM initialisée ou NULL en cas d'erreur
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+TQSM* QSM_New(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq) {
+    return QSM_Init(Size,TotFreq,UpFreq,0);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <QSM_NewExact>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne une structure TQSM initialisée dont la fréquence totale
+ *            reste exactement TotFreq
+ *
+ * Parametres :
+ *  <Size>  : Maximum number of different symbols
+ *  <UpFreq>: Target update frequency
+ *
+ * Retour   : Une structure TQSM initialisée ou NULL en cas d'erreur
+ *
+ * Remarques :
+ *    - Nécessaire aux codeurs (rANS) pour lesquels la somme des fréquences
+ *      doit être exactement une puissance de 2
+ *    - Le modèle de QSM_New conserve la cédule de mise à jour originale afin
+ *      de rester compatible avec les données déjà compressées
+ *
+ *----------------------------------------------------------------------------
+ */
+TQSM* QSM_NewExact(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq) {
+    return QSM_Init(Size,TotFreq,UpFreq,1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <QSM_SetLUT>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Active la table de recherche des symboles utilisée par QSM_GetSym
+ *
+ * Parametres :
+ *  <QSM>   : Modèle
+ *  <Bits>  : Nombre de bits de poids fort de la fréquence cumulée à utiliser
+ *            comme index
+ *
+ * Retour   : 1 si ok, 0 sinon
+ *
+ * Remarques :
+ *    - Seulement utile au décodage, la table est reconstruite à chaque
+ *      reconstruction de la CDF
+ *
+ *----------------------------------------------------------------------------
+ */
+int QSM_SetLUT(TQSM *restrict QSM,int Bits) {
+    TQSMFreq tot=QSM->CDF[QSM->Size];
+    int      shift=0;
+
+    // Find the shift that brings the total frequency under 2^Bits
+    while( (tot-1)>>shift >= (1u<<Bits) )
+        ++shift;
+
+    free(QSM->LUT);
+    QSM->LUTSize = ((tot-1)>>shift)+1;
+    QSM->LUTShift = shift;
+    if( !(QSM->LUT=malloc(QSM->LUTSize*sizeof(*QSM->LUT))) ) {
+        QSM->LUTSize = 0;
+        return 0;
+    }
+
+    QSM_BuildLUT(QSM);
+    return 1;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <QSM_Free>
  * Creation : Mars 2017 - E. Legault-Ouellet - CMC/CMOE
@@ -104,6 +223,7 @@ void QSM_Free(TQSM *QSM) {
     if( QSM ) {
         free(QSM->Freq);
         free(QSM->CDF);
+        free(QSM->LUT);
         free(QSM);
     }
 }
@@ -162,8 +282,13 @@ void QSM_Update(TQSM *restrict QSM) {
     // Given the number of steps we have until the next update, calculate the increment to add to the frequency
     QSM->Incr = newfreq/QSM->NextUp;
     // Number of values to add until the next update, but with an incremented Incr (due to integer division)
-    QSM->NextIncr = newfreq*QSM->NextUp;
+    // Note that the original model multiplies instead of taking the remainder, which (almost) freezes the model after
+    // the first update. This is kept as is, unless exact mode is asked for, so that existing streams can still be decoded
+    QSM->NextIncr = QSM->Exact ? newfreq%QSM->NextUp : newfreq*QSM->NextUp;
     QSM->NextUp -= QSM->NextIncr;
+
+    if( QSM->LUT )
+        QSM_BuildLUT(QSM);
 }
 
 /*----------------------------------------------------------------------------
@@ -232,6 +357,15 @@ void QSM_GetFreq(TQSM *restrict QSM,TQSMSym Sym,TQSMFreq *restrict Freq,TQSMFreq
 TQSMSym QSM_GetSym(TQSM *restrict QSM,TQSMFreq *restrict LTFreq,TQSMFreq *restrict Freq) {
     TQSMFreq *restrict cdf = QSM->CDF;
     TQSMSym from=0,to=QSM->Size,mid;
+    TQSMFreq idx;
+
+    // Use the lookup table to find the first candidate, then walk up to the symbol
+    if( QSM->LUT && (idx=*LTFreq>>QSM->LUTShift)<QSM->LUTSize ) {
+        from = QSM->LUT[idx];
+        while( from+1<to && cdf[from+1]<=*LTFreq )
+            ++from;
+        to = from+1;
+    }
 
     // Binary search to find the cumulative frequency
     while( from+1 < to ) {
@@ -50,6 +50,10 @@ typedef uint32_t TQSMUpF;   // Update freqency type. This should be fairly small
 typedef struct TQSM {
     TQSMFreq    *Freq;      // Frequencies
     TQSMFreq    *CDF;       // Cumulative Distribution Function table
+    TQSMSym     *LUT;       // Symbol lookup table indexed by the high bits of the cumulative frequency (NULL if not used)
+    TQSMFreq    LUTSize;    // Size of the symbol lookup table
+    int         LUTShift;   // Shift to get from a cumulative frequency to an index in the symbol lookup table
+    int         Exact;      // Keep the total frequency exactly constant (see QSM_NewExact)
     TQSMSym     Size;       // Size of the tables
     TQSMFreq    Incr;       // Increment to add to the frequency (since our total frequency is stable, the frequencies must be proportional to the number of items in the model)
     TQSMUpF     NextIncr;   // Number of values to add until the next update, but with an incremented Incr (due to integer division)
@@ -60,6 +64,8 @@ typedef struct TQSM {
 
 
 TQSM* QSM_New(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq);
+TQSM* QSM_NewExact(TQSMSym Size,TQSMFreq TotFreq,TQSMUpF UpFreq);
+int QSM_SetLUT(TQSM *restrict QSM,int Bits);
 void QSM_Free(TQSM *QSM);
 void QSM_Update(TQSM *restrict QSM);
 void QSM_Add(TQSM *restrict QSM,TQSMSym Sym);
@@ -37,10 +37,19 @@
 #include "Def.h"
 #include "EZGrid.h"
 #include <glob.h>
+#include <limits.h>
 
 static int **LNK_FID = NULL;
 static int LNK_NB = 0;
 
+typedef struct TRPNLinkCat {
+    int      FID;   // FID des fichiers liés
+    TCatalog *Cat;  // Catalogue des fichiers liés
+} TRPNLinkCat;
+
+static TRPNLinkCat *LNK_CAT = NULL;
+static int LNK_NCAT = 0;
+
 static const char *RPN_Desc[]={ ">>","^^","^>","!!","##","HY","PROJ","MTRX",NULL };
 
 static char FGFDTLock[1000];
@@ -381,9 +390,13 @@ TRPNField* RPN_FieldReadIndex(int FileId,int Index,TRPNField *Fld) {
       }
    }
 
-   // Recuperer les donnees du champs
-   c_fst_data_length(TDef_Size[fld->Def->Type]);
-   if ((ok=cs_fstlukt(fld->Def->Data[0],h.FID,h.KEY,h.GRTYP,&h.NI,&h.NJ,&h.NK))<0) {
+   // Recuperer les donnees du champs, les champs tuiles passent par EZGrid qui relit chaque tuile par RPN_pReadData
+   if (h.GRTYP[0]=='#') {
+      ok=cs_fstlukt(fld->Def->Data[0],h.FID,h.KEY,h.GRTYP,&h.NI,&h.NJ,&h.NK);
+   } else {
+      ok=RPN_pReadData(fld->Def->Data[0],fld->Def->Type,h.KEY)==APP_OK?0:-1;
+   }
+   if (ok<0) {
       Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read field data (c_fstluk failed)\n",__func__);
       return(NULL);
    }
@@ -575,8 +588,8 @@ int RPN_IsDesc(const char* restrict Var) {
 */
 int RPN_FieldTile(int FID,TDef *Def,TRPNHeader *Head,TGeoRef *GRef,TZRef *ZRef,int Comp,int NI,int NJ,int Halo,int DATYP,int NPack,int Rewrite,int Compress) {
 
-   char        *tile=NULL,*data=NULL;;
-   int          i,j,k,ip1,ni,nj,di,dj,pj,no,sz,key=0;
+   char        *tile=NULL,*data=NULL;
+   int          i,j,k,ip1,ni,nj,di,dj,pj,no,sz,key,ok=1;
    unsigned int idx;
 
    // Allocate temp tile
@@ -585,8 +598,7 @@ int RPN_FieldTile(int FID,TDef *Def,TRPNHeader *Head,TGeoRef *GRef,TZRef *ZRef,i
       return(0);
    }
 
-   pthread_mutex_lock(&RPNFieldMutex);
-
+   // Only the writes need the lock, the tiles are built outside of it
    for(k=0;k<Def->NK;k++) {
       idx=k*FSIZE2D(Def);
 
@@ -599,9 +611,12 @@ int RPN_FieldTile(int FID,TDef *Def,TRPNHeader *Head,TGeoRef *GRef,TZRef *ZRef,i
 
       // Check if tiling asked and if dimensions allow tiling
       if (!NI || !NJ || (Def->NI<NI && Def->NJ<NJ)) {
+         pthread_mutex_lock(&RPNFieldMutex);
          c_fst_data_length(TDef_Size[Def->Type]);
          key=c_fstecr(data,NULL,NPack,FID,Head->DATEO,Head->DEET,Head->NPAS,Def->NI,Def->NJ,1,ip1,Head->IP2,Head->IP3,Head->TYPVAR,
             Head->NOMVAR,Head->ETIKET,(GRef?GRef->Grid:"X"),Head->IG1,Head->IG2,Head->IG3,Head->IG4,DATYP,Rewrite);
+         pthread_mutex_unlock(&RPNFieldMutex);
+         ok=ok && key>=0;
       } else {
 
          // Build and save the tiles, we adjust the tile size if it is too big
@@ -622,23 +637,74 @@ int RPN_FieldTile(int FID,TDef *Def,TRPNHeader *Head,TGeoRef *GRef,TZRef *ZRef,i
                if (di+ni>Def->NI) { ni-=Halo; }
 
                for(pj=0;pj<nj;pj++) {
-                  memcpy(tile+(pj*ni*sz),data+((dj+pj)*Def->NI+di)*sz,ni*sz);
+                  memcpy(tile+(pj*ni*sz),data+((size_t)(dj+pj)*Def->NI+di)*sz,ni*sz);
                }
+               pthread_mutex_lock(&RPNFieldMutex);
                c_fst_data_length(TDef_Size[Def->Type]);
                key=c_fstecr(tile,NULL,NPack,FID,Head->DATEO,Head->DEET,Head->NPAS,ni,nj,1,ip1,Head->IP2,no,Head->TYPVAR,
                   Head->NOMVAR,Head->ETIKET,"#",Head->IG1,Head->IG2,di+1,dj+1,DATYP,Rewrite);
+               pthread_mutex_unlock(&RPNFieldMutex);
+               ok=ok && key>=0;
             }
          }
       }
    }
 
-   pthread_mutex_unlock(&RPNFieldMutex);
-
    free(tile);
 
-   return(key>=0);
+   return(ok);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_LinkCatalog>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne le catalogue complet associé à des fichiers liés
+ *
+ * Parametres :
+ *  <FID>   : Le FID des fichiers liés (voir RPN_LinkPatternCatalog)
+ *
+ * Retour   : Le catalogue ou NULL s'il n'y en a pas
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+static TCatalog* RPN_LinkCatalog(int FID) {
+    int i;
+
+    for(i=0; i<LNK_NCAT; ++i) {
+        if( LNK_CAT[i].FID == FID )
+            return LNK_CAT[i].Cat->Complete ? LNK_CAT[i].Cat : NULL;
+    }
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_LinkCatalogField>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Retourne l'entête cataloguée d'un champ de fichiers liés
+ *
+ * Parametres :
+ *  <Key>   : Le handle du champ
+ *
+ * Retour   : L'entête ou NULL si le champ n'est dans aucun catalogue
+ *
+ * Remarques :
+ *
+ *----------------------------------------------------------------------------
+ */
+static TCatalogField* RPN_LinkCatalogField(int Key) {
+    TCatalogField *f;
+    int i;
+
+    for(i=0; i<LNK_NCAT; ++i) {
+        if( (f=Catalog_FindKey(LNK_CAT[i].Cat,Key)) )
+            return f;
+    }
+    return NULL;
+}
 
 /*----------------------------------------------------------------------------
  * Nom      : <RPN_GetAllFields>
@@ -663,17 +729,35 @@ int RPN_FieldTile(int FID,TDef *Def,TRPNHeader *Head,TGeoRef *GRef,TZRef *ZRef,i
  * Remarques :
  *  La mémoire est allouée dans la fonction et a besoin d'être libérée par la
  *  fonction appelante. En cas d'erreur, le pointeur retourné sera NULL.
+ *  Si les fichiers ont été liés avec un catalogue (RPN_LinkPatternCatalog),
+ *  la recherche sans critère d'IP se fait dans le catalogue.
  *
  *----------------------------------------------------------------------------
  */
 int RPN_GetAllFields(int FID,int DateV,char *Etiket,int Ip1,int Ip2,int Ip3,char *Typvar,char *Nomvar,int **Arr,int *Size) {
-    int ni,nj,nk,err;
+    TCatalog *cat;
+    TCatalogField **flds;
+    int ni,nj,nk,err,i;
     int n=32768; // ~128kiB
     int *arr=NULL,s;
 
     *Arr    = NULL;
     *Size   = 0;
 
+    // Use the catalogue of the linked files if there is one. IP criteria go through fstinl since it matches the equivalent IP encodings
+    if( Ip1==-1 && Ip2==-1 && Ip3==-1 && (cat=RPN_LinkCatalog(FID)) && Catalog_Find(cat,DateV,Etiket,-1,-1,-1,Typvar,Nomvar,&flds,&s)==APP_OK ) {
+        if( (arr=malloc((s?s:1)*sizeof(*arr))) ) {
+            for(i=0; i<s && (arr[i]=flds[i]->Key)>=0; ++i);
+        }
+        free(flds);
+        if( arr && i==s ) {
+            *Size   = s;
+            *Arr    = arr;
+            return(APP_OK);
+        }
+        APP_FREE(arr);
+    }
+
     do {
         APP_MEM_ASRT(arr,realloc(arr,(n*=2)*sizeof(*arr)));
         if( (err=cs_fstinl(FID,&ni,&nj,&nk,DateV,Etiket,Ip1,Ip2,Ip3,Typvar,Nomvar,arr,&s,n)) && err!=-4762 ) {
@@ -717,6 +801,7 @@ int RPN_GetAllFields(int FID,int DateV,char *Etiket,int Ip1,int Ip2,int Ip3,char
  */
 int RPN_GetAllDates(int *Flds,int NbFlds,int Uniq,int **DateV,int *NbDateV) {
     TRPNHeader  h;
+    TCatalogField *f;
     int         i,err,*dates;
     double      deltat;
 
@@ -725,6 +810,12 @@ int RPN_GetAllDates(int *Flds,int NbFlds,int Uniq,int **DateV,int *NbDateV) {
     APP_MEM_ASRT(dates,malloc(NbFlds*sizeof(*dates)));
 
     for(i=0; i<NbFlds; ++i) {
+        // The catalogue of the linked files already has the date
+        if( (f=RPN_LinkCatalogField(Flds[i])) && f->DATEV ) {
+            dates[i] = f->DATEV;
+            continue;
+        }
+
         err=cs_fstprm(Flds[i],&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
                 h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
         if( err ) {
@@ -780,6 +871,7 @@ int RPN_GetAllDates(int *Flds,int NbFlds,int Uniq,int **DateV,int *NbDateV) {
  */
 int RPN_GetAllIps(int *Flds,int NbFlds,int IpN,int Uniq,int **Ips,int *NbIp) {
     TRPNHeader  h;
+    TCatalogField *f;
     int         i,err,*ips;
     double      deltat;
 
@@ -788,12 +880,19 @@ int RPN_GetAllIps(int *Flds,int NbFlds,int IpN,int Uniq,int **Ips,int *NbIp) {
     APP_MEM_ASRT(ips,malloc(NbFlds*sizeof(*ips)));
 
     for(i=0; i<NbFlds; ++i) {
-        err=cs_fstprm(Flds[i],&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
-                h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
-        if( err ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"(RPN_GetAllIps) Couldn't get info on field (cs_fstprm)\n");
-            APP_FREE(ips);
-            return(APP_ERR);
+        // The catalogue of the linked files already has the IPs
+        if( (f=RPN_LinkCatalogField(Flds[i])) ) {
+            h.IP1 = f->IP1;
+            h.IP2 = f->IP2;
+            h.IP3 = f->IP3;
+        } else {
+            err=cs_fstprm(Flds[i],&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
+                    h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
+            if( err ) {
+                Lib_Log(APP_LIBEER,APP_ERROR,"(RPN_GetAllIps) Couldn't get info on field (cs_fstprm)\n");
+                APP_FREE(ips);
+                return(APP_ERR);
+            }
         }
 
         switch( IpN ) {
@@ -848,6 +947,94 @@ int RPN_GenerateIG(int *IG1,int *IG2,int *IG3) {
     return(APP_OK);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_OpenUnits>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Ouvre plusieurs fichiers standards en lecture seulement
+ *
+ * Parametres :
+ *  <Files> : Liste des fichiers standards à ouvrir
+ *  <N>     : Nombre de fichiers
+ *
+ * Retour   : La liste des unités (taille en premier) ou NULL si erreur.
+ *
+ * Remarques :
+ *  Si un fichier ne peut être ouvert, les fichiers déjà ouverts sont fermés.
+ *
+ *----------------------------------------------------------------------------
+ */
+static int* RPN_OpenUnits(char **Files,int N) {
+    int i,*lst;
+
+    // Allocate the memory
+    if( !(lst=malloc((N+1)*sizeof(*lst))) ) {
+        Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not allocate memory for the FIDs array\n",__func__);
+        return NULL;
+    }
+
+    // Put the size first
+    lst[0] = N;
+
+    // Open all the files
+    for(i=0; i<N; ++i) {
+        if( (lst[i+1]=cs_fstouv(Files[i],"STD+RND+R/O")) < 0 ) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Problem opening input file \"%s\"\n",__func__,Files[i]);
+            while( i-- )
+                cs_fstfrm(lst[i+1]);
+            free(lst);
+            return NULL;
+        }
+    }
+
+    return lst;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_LinkUnits>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lie des fichiers standards déjà ouverts
+ *
+ * Parametres :
+ *  <Lst>   : La liste des unités (taille en premier, voir RPN_OpenUnits)
+ *
+ * Retour   : Le FID à utiliser ou un nombre négatif si erreur.
+ *
+ * Remarques : Cette fonction N'EST PAS thread safe
+ *  La liste appartient ensuite aux fichiers liés (libérée par RPN_UnLinkFiles)
+ *
+ *----------------------------------------------------------------------------
+ */
+static int RPN_LinkUnits(int *Lst) {
+    int fid=Lst[1],**ptr;
+
+    // Only apply the special treatment if there actually is more than one file
+    if( Lst[0]==1 ) {
+        free(Lst);
+        return fid;
+    }
+
+    // Link all files
+    if( f77name(fstlnk)(Lst+1,Lst) != 0 ) {
+        Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not link the %d input files together\n",__func__,Lst[0]);
+        free(Lst);
+        return -1;
+    }
+
+    // Add the list of FIDs to the global list
+    if( !(ptr=realloc(LNK_FID,(LNK_NB+1)*sizeof(*LNK_FID))) ) {
+        Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not allocate memory for the global FIDs array\n",__func__);
+        free(Lst);
+        return -1;
+    }
+    LNK_FID = ptr;
+    LNK_FID[LNK_NB++] = Lst;
+
+    // Return the file handle
+    return fid;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <RPN_LinkFiles>
  * Creation : Octobre 2016 - E. Legault-Ouellet - CMC/CMOE
@@ -865,6 +1052,8 @@ int RPN_GenerateIG(int *IG1,int *IG2,int *IG3) {
  *----------------------------------------------------------------------------
  */
 int RPN_LinkFiles(char **Files,int N) {
+    int *lst;
+
     // Make sure there is at least one file
     if( !Files || N==0 || !*Files )
         return -1;
@@ -874,53 +1063,11 @@ int RPN_LinkFiles(char **Files,int N) {
         for(N=1; Files[N]; ++N);
     }
 
-    // Only apply the special treatment if there actually is more than one file
-    if( N>1 ) {
-        int i,*lst,**ptr;
-
-        // Allocate the memory
-        lst = malloc((N+1)*sizeof(*lst));
-
-        // Put the size first
-        lst[0] = N;
-
-        // Open all the files
-        for(i=0; Files[i]; ++i) {
-            if( (lst[i+1]=cs_fstouv(Files[i],"STD+RND+R/O")) < 0 ) {
-                Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Problem opening input file \"%s\"\n",__func__,Files[i]);
-                free(lst);
-                return -1;
-            }
-        }
-
-        // Link all files
-        if( f77name(fstlnk)(lst+1,lst) != 0 ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not link the %d input files together\n",__func__,N);
-            free(lst);
-            return -1;
-        }
-
-        // Add the list of FIDs to the global list
-        if( !(ptr=realloc(LNK_FID,(LNK_NB+1)*sizeof(*LNK_FID))) ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not allocate memory for the global FIDs array\n",__func__);
-            free(lst);
-            return -1;
-        }
-        LNK_FID = ptr;
-        LNK_FID[LNK_NB++] = lst;
-
-        // Return the file handle
-        return lst[1];
-    } else {
-        int h;
-
-        // Only one file, no need to link anything
-        if( (h=cs_fstouv(Files[0],"STD+RND+R/O")) < 0 ) {
-            Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Problem opening input file %s\n",__func__,Files[0]);
-        }
+    // Open all the files and link them
+    if( !(lst=RPN_OpenUnits(Files,N)) )
+        return -1;
 
-        return h;
-    }
+    return RPN_LinkUnits(lst);
 }
 
 /*----------------------------------------------------------------------------
@@ -943,6 +1090,17 @@ int RPN_UnLinkFiles(int FID) {
     if( FID >= 0 ) {
         int i,j,**ptr;
 
+        // Free the catalogue of the linked files
+        for(i=0; i<LNK_NCAT; ++i) {
+            if( LNK_CAT[i].FID == FID ) {
+                Catalog_Free(LNK_CAT[i].Cat);
+                LNK_CAT[i] = LNK_CAT[--LNK_NCAT];
+                if( !LNK_NCAT )
+                    APP_FREE(LNK_CAT);
+                break;
+            }
+        }
+
         // Find the list containing that FID in the first position
         for(i=0; i<LNK_NB; ++i) {
             if( LNK_FID[i][1] == FID ) {
@@ -1010,15 +1168,100 @@ int RPN_LinkPattern(const char* Pattern) {
    return fid;
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_LinkPatternCatalog>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Ouvre et lie les fichiers correspondant au pattern donné en
+ *            mode lecture seulement et retourne leur catalogue
+ *
+ * Parametres :
+ *    <Pattern>   : Le pattern des fichiers à ouvrir et lier.
+ *    <Cat>       : [OUT] Le catalogue des fichiers liés (voir Catalog_Get)
+ *
+ * Retour   : Le FID à utiliser ou un nombre négatif si erreur.
+ *
+ * Remarques : Cette fonction N'EST PAS thread safe
+ *    - Les fichiers sont catalogués sur leurs unités déjà ouvertes, avant
+ *      d'être liés; seuls les fichiers nouveaux ou modifiés sont relus
+ *    - RPN_GetAllFields, RPN_GetAllDates et RPN_GetAllIps répondent à partir
+ *      du catalogue pour ces fichiers, sans relire les entêtes. Les requêtes
+ *      peuvent aussi être faites directement sur le catalogue (Catalog_Find,
+ *      Catalog_GetDates, ...)
+ *    - Le catalogue appartient aux fichiers liés et est libéré par
+ *      RPN_UnLinkFiles
+ *
+ *----------------------------------------------------------------------------
+ */
+int RPN_LinkPatternCatalog(const char* Pattern,TCatalog **Cat) {
+   TCatalog    *cat;
+   TRPNLinkCat *ptr;
+   int         *lst,fid;
 
+   // Expand the pattern into a list of files
+   glob_t gfiles = (glob_t){0,NULL,0};
 
-int RPN_ReadData(void *Data,TDef_Type Type,int Key) {
+   *Cat = NULL;
+   if( glob(Pattern,0,NULL,&gfiles) || !gfiles.gl_pathc ) {
+      return -1;
+   }
+
+   if( !(lst=RPN_OpenUnits(gfiles.gl_pathv,(int)gfiles.gl_pathc)) ) {
+      globfree(&gfiles);
+      return -1;
+   }
+
+   // Catalog the opened units before linking them, since a search on a linked unit goes through the following files
+   cat = Catalog_Get((const char**)gfiles.gl_pathv,(int)gfiles.gl_pathc,lst+1,NULL);
+   globfree(&gfiles);
+
+   if( (fid=RPN_LinkUnits(lst))<0 ) {
+      Catalog_Free(cat);
+      return fid;
+   }
+
+   // Associate the catalogue to the linked files
+   if( cat ) {
+      if( !(ptr=realloc(LNK_CAT,(LNK_NCAT+1)*sizeof(*LNK_CAT))) ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not allocate memory for the global catalogues array\n",__func__);
+         Catalog_Free(cat);
+         return fid;
+      }
+      LNK_CAT = ptr;
+      LNK_CAT[LNK_NCAT++] = (TRPNLinkCat){fid,cat};
+   }
+
+   *Cat = cat;
+   return fid;
+}
+
+
+
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_ReadType>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Determiner le type natif d'un enregistrement et s'il doit etre
+ *            lu dans un tampon intermediaire pour etre converti
+ *
+ * Parametres :
+ *  <Key>     : Cle de l'enregistrement
+ *  <Type>    : Type demande
+ *  <NIJK>    : Nombre de valeurs de l'enregistrement (Retour)
+ *  <DaTyp>   : Type natif de l'enregistrement (Retour)
+ *  <UseBuf>  : Conversion necessaire (Retour)
+ *
+ * Retour:
+ *  <APP_OK|APP_ERR> : Code de reussite
+ *
+ * Remarques :
+ *    - Doit etre appele en possession du lock RPN_FieldLock
+ *----------------------------------------------------------------------------
+ */
+static int RPN_ReadType(int Key,TDef_Type Type,size_t *NIJK,int *DaTyp,int *UseBuf) {
    int ni,nj,nk,itmp,nbits,datyp,usebuf=0;
    char cbuf[13];
 
-   if( !Data || Key<0 )
-      return APP_ERR;
-
    // Get the type and dimensions of the field
    strcpy(cbuf,"            ");
    APP_FST_ASRT(c_fstprm(Key,&itmp,&itmp,&itmp,&ni,&nj,&nk,&nbits,&datyp,
@@ -1076,11 +1319,148 @@ int RPN_ReadData(void *Data,TDef_Type Type,int Key) {
          return APP_ERR;
    }
 
+   *NIJK=(size_t)ni*(size_t)nj*(size_t)nk;
+   *DaTyp=datyp;
+   *UseBuf=usebuf;
+
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_ConvertData>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Convertir un enregistrement lu dans son type natif vers le type
+ *            demande
+ *
+ * Parametres :
+ *  <Data>    : Destination
+ *  <Type>    : Type de la destination
+ *  <buf>     : Donnees lues
+ *  <datyp>   : Type des donnees lues
+ *  <nijk>    : Nombre de valeurs
+ *
+ * Retour:
+ *  <APP_OK|APP_ERR> : Code de reussite
+ *
+ * Remarques :
+ *    - Ne touche pas a RMNLIB et peut donc etre appele hors du lock
+ *----------------------------------------------------------------------------
+ */
+static int RPN_ConvertData(void *Data,TDef_Type Type,void *buf,int datyp,size_t nijk) {
+   size_t idx;
+
+   // Copy and convert what we've read into the desired format
+   for(idx=0; idx<nijk; ++idx) {
+      switch( datyp ) {
+         case TD_Int32:
+            {
+               switch( Type ) {
+                  case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((int32_t*)buf)[idx];    break;
+                  case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((int32_t*)buf)[idx];   break;
+                  case TD_Float32:  ((float*)Data)[idx]           = (float)((int32_t*)buf)[idx];      break;
+                  case TD_Float64:  ((double*)Data)[idx]          = (double)((int32_t*)buf)[idx];     break;
+                  default: goto converr;
+               }
+            }
+            break;
+         case TD_UInt32:
+            {
+               switch( Type ) {
+                  case TD_Byte:     ((uint8_t*)Data)[idx]         = (uint8_t)((uint32_t*)buf)[idx];   break;
+                  case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((uint32_t*)buf)[idx];   break;
+                  case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((uint32_t*)buf)[idx];  break;
+                  case TD_Float32:  ((float*)Data)[idx]           = (float)((uint32_t*)buf)[idx];     break;
+                  case TD_Float64:  ((double*)Data)[idx]          = (double)((uint32_t*)buf)[idx];    break;
+                  default: goto converr;
+               }
+            }
+            break;
+         case TD_Int64:
+            {
+               switch( Type ) {
+                  case TD_Byte:     ((char*)Data)[idx]            = (char)((int64_t*)buf)[idx];          break;
+                  case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((int64_t*)buf)[idx]; break;
+                  case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((int64_t*)buf)[idx];       break;
+                  case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((int64_t*)buf)[idx];      break;
+                  case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((int64_t*)buf)[idx];       break;
+                  case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((int64_t*)buf)[idx];      break;
+                  case TD_Float32:  ((float*)Data)[idx]           = (float)((int64_t*)buf)[idx];         break;
+                  case TD_Float64:  ((double*)Data)[idx]          = (double)((int64_t*)buf)[idx];        break;
+                  default: goto converr;
+               }
+            }
+            break;
+         case TD_UInt64:
+            {
+               switch( Type ) {
+                  case TD_Byte:     ((char*)Data)[idx]            = (char)((uint64_t*)buf)[idx];            break;
+                  case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((uint64_t*)buf)[idx];   break;
+                  case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((uint64_t*)buf)[idx];         break;
+                  case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((uint64_t*)buf)[idx];        break;
+                  case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((uint64_t*)buf)[idx];         break;
+                  case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((uint64_t*)buf)[idx];        break;
+                  case TD_Float32:  ((float*)Data)[idx]           = (float)((uint64_t*)buf)[idx];           break;
+                  case TD_Float64:  ((double*)Data)[idx]          = (double)((uint64_t*)buf)[idx];          break;
+                  default: goto converr;
+               }
+            }
+            break;
+         case TD_Float32:
+            {
+               switch( Type ) {
+                  case TD_Byte:     ((char*)Data)[idx]            = (char)((float*)buf)[idx];            break;
+                  case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((float*)buf)[idx];   break;
+                  case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((float*)buf)[idx];         break;
+                  case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((float*)buf)[idx];        break;
+                  case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((float*)buf)[idx];         break;
+                  case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((float*)buf)[idx];        break;
+                  case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((float*)buf)[idx];         break;
+                  case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((float*)buf)[idx];        break;
+                  case TD_Float64:  ((double*)Data)[idx]          = (double)((float*)buf)[idx];          break;
+                  default: goto converr;
+               }
+            }
+            break;
+         case TD_Float64:
+            {
+               switch( Type ) {
+                  case TD_Byte:     ((char*)Data)[idx]            = (char)((double*)buf)[idx];           break;
+                  case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((double*)buf)[idx];  break;
+                  case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((double*)buf)[idx];        break;
+                  case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((double*)buf)[idx];       break;
+                  case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((double*)buf)[idx];        break;
+                  case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((double*)buf)[idx];       break;
+                  case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((double*)buf)[idx];        break;
+                  case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((double*)buf)[idx];       break;
+                  case TD_Float32:  ((float*)Data)[idx]           = (float)((double*)buf)[idx];          break;
+                  default: goto converr;
+               }
+            }
+            break;
+         default: goto converr;
+      }
+   }
+
+   return APP_OK;
+converr:
+   Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Unsupported conversion %d->%d\n",__func__,datyp,Type);
+   return APP_ERR;
+}
+
+int RPN_ReadData(void *Data,TDef_Type Type,int Key) {
+   size_t nijk;
+   int    ni,nj,nk,datyp,usebuf,code;
+   void  *buf=NULL;
+
+   if( !Data || Key<0 )
+      return APP_ERR;
+
+   if( RPN_ReadType(Key,Type,&nijk,&datyp,&usebuf)!=APP_OK )
+      return APP_ERR;
+
    // Check if the input field are floats and, if so, if we have a size mismatch
    if( usebuf ) {
-      size_t idx,nijk=(size_t)ni*(size_t)nj*(size_t)nk;
-      void *buf=NULL;
-
       // Allocate a temporary buffer into which we'll read the field into
       APP_MEM_ASRT( buf,malloc(nijk*TDef_Size[datyp]) );
 
@@ -1093,103 +1473,9 @@ int RPN_ReadData(void *Data,TDef_Type Type,int Key) {
       }
 
       // Copy and convert what we've read into the desired format
-      for(idx=0; idx<nijk; ++idx) {
-         switch( datyp ) {
-            case TD_Int32:
-               {
-                  switch( Type ) {
-                     case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((int32_t*)buf)[idx];    break;
-                     case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((int32_t*)buf)[idx];   break;
-                     case TD_Float32:  ((float*)Data)[idx]           = (float)((int32_t*)buf)[idx];      break;
-                     case TD_Float64:  ((double*)Data)[idx]          = (double)((int32_t*)buf)[idx];     break;
-                     default: goto converr;
-                  }
-               }
-               break;
-            case TD_UInt32:
-               {
-                  switch( Type ) {
-                     case TD_Byte:     ((uint8_t*)Data)[idx]         = (uint8_t)((uint32_t*)buf)[idx];   break;
-                     case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((uint32_t*)buf)[idx];   break;
-                     case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((uint32_t*)buf)[idx];  break;
-                     case TD_Float32:  ((float*)Data)[idx]           = (float)((uint32_t*)buf)[idx];     break;
-                     case TD_Float64:  ((double*)Data)[idx]          = (double)((uint32_t*)buf)[idx];    break;
-                     default: goto converr;
-                  }
-               }
-               break;
-            case TD_Int64:
-               {
-                  switch( Type ) {
-                     case TD_Byte:     ((char*)Data)[idx]            = (char)((int64_t*)buf)[idx];          break;
-                     case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((int64_t*)buf)[idx]; break;
-                     case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((int64_t*)buf)[idx];       break;
-                     case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((int64_t*)buf)[idx];      break;
-                     case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((int64_t*)buf)[idx];       break;
-                     case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((int64_t*)buf)[idx];      break;
-                     case TD_Float32:  ((float*)Data)[idx]           = (float)((int64_t*)buf)[idx];         break;
-                     case TD_Float64:  ((double*)Data)[idx]          = (double)((int64_t*)buf)[idx];        break;
-                     default: goto converr;
-                  }
-               }
-               break;
-            case TD_UInt64:
-               {
-                  switch( Type ) {
-                     case TD_Byte:     ((char*)Data)[idx]            = (char)((uint64_t*)buf)[idx];            break;
-                     case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((uint64_t*)buf)[idx];   break;
-                     case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((uint64_t*)buf)[idx];         break;
-                     case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((uint64_t*)buf)[idx];        break;
-                     case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((uint64_t*)buf)[idx];         break;
-                     case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((uint64_t*)buf)[idx];        break;
-                     case TD_Float32:  ((float*)Data)[idx]           = (float)((uint64_t*)buf)[idx];           break;
-                     case TD_Float64:  ((double*)Data)[idx]          = (double)((uint64_t*)buf)[idx];          break;
-                     default: goto converr;
-                  }
-               }
-               break;
-            case TD_Float32:
-               {
-                  switch( Type ) {
-                     case TD_Byte:     ((char*)Data)[idx]            = (char)((float*)buf)[idx];            break;
-                     case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((float*)buf)[idx];   break;
-                     case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((float*)buf)[idx];         break;
-                     case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((float*)buf)[idx];        break;
-                     case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((float*)buf)[idx];         break;
-                     case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((float*)buf)[idx];        break;
-                     case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((float*)buf)[idx];         break;
-                     case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((float*)buf)[idx];        break;
-                     case TD_Float64:  ((double*)Data)[idx]          = (double)((float*)buf)[idx];          break;
-                     default: goto converr;
-                  }
-               }
-               break;
-            case TD_Float64:
-               {
-                  switch( Type ) {
-                     case TD_Byte:     ((char*)Data)[idx]            = (char)((double*)buf)[idx];           break;
-                     case TD_UByte:    ((unsigned char*)Data)[idx]   = (unsigned char)((double*)buf)[idx];  break;
-                     case TD_Int16:    ((int16_t*)Data)[idx]         = (int16_t)((double*)buf)[idx];        break;
-                     case TD_UInt16:   ((uint16_t*)Data)[idx]        = (uint16_t)((double*)buf)[idx];       break;
-                     case TD_Int32:    ((int32_t*)Data)[idx]         = (int32_t)((double*)buf)[idx];        break;
-                     case TD_UInt32:   ((uint32_t*)Data)[idx]        = (uint32_t)((double*)buf)[idx];       break;
-                     case TD_Int64:    ((int64_t*)Data)[idx]         = (int64_t)((double*)buf)[idx];        break;
-                     case TD_UInt64:   ((uint64_t*)Data)[idx]        = (uint64_t)((double*)buf)[idx];       break;
-                     case TD_Float32:  ((float*)Data)[idx]           = (float)((double*)buf)[idx];          break;
-                     default: goto converr;
-                  }
-               }
-               break;
-            default: goto converr;
-         }
-      }
-
-      free(buf);
-      return APP_OK;
-converr:
+      code=RPN_ConvertData(Data,Type,buf,datyp,nijk);
       free(buf);
-      Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Unsupported conversion %d->%d\n",__func__,datyp,Type);
-      return APP_ERR;
+      return code;
    } else {
       c_fst_data_length(TDef_Size[Type]);
       if( c_fstluk(Data,Key,&ni,&nj,&nk)<0 ) {
@@ -1227,4 +1513,251 @@ int RPN_sRead(void *Data,TDef_Type Type,int Unit,int *NI,int *NJ,int *NK,int Dat
    return code;
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_pReadData>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire un enregistrement en ne serialisant que les appels a RMNLIB
+ *
+ * Parametres :
+ *  <Data>    : Destination
+ *  <Type>    : Type de la destination
+ *  <Key>     : Cle de l'enregistrement
+ *
+ * Retour:
+ *  <APP_OK|APP_ERR> : Code de reussite
+ *
+ * Remarques :
+ *    - Contrairement a RPN_sReadData, l'allocation du tampon intermediaire et
+ *      la conversion de type se font hors du lock
+ *    - Ce n'est pas une lecture sans lock. c_fstluk lit et decompacte
+ *      l'enregistrement en un seul appel et RMNLIB n'offre pas de
+ *      decompactage separe de la lecture. Cet appel utilise des etats globaux
+ *      (table des fichiers xdf, c_fst_data_length, type xdf courant) qu'un
+ *      lock par unite ne protegerait pas, c_fstluk reste donc sous
+ *      RPNFieldMutex pour tous les fichiers
+ *----------------------------------------------------------------------------
+ */
+int RPN_pReadData(void *Data,TDef_Type Type,int Key) {
+   size_t nijk;
+   int    ni,nj,nk,datyp,usebuf,code;
+   void  *buf=NULL;
+
+   if( !Data || Key<0 )
+      return APP_ERR;
+
+   pthread_mutex_lock(&RPNFieldMutex);
+   code=RPN_ReadType(Key,Type,&nijk,&datyp,&usebuf);
+
+   if( code==APP_OK && !usebuf ) {
+      // Same type, read directly into the caller's buffer
+      c_fst_data_length(TDef_Size[Type]);
+      if( c_fstluk(Data,Key,&ni,&nj,&nk)<0 ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not read field\n",__func__);
+         code=APP_ERR;
+      }
+   }
+   pthread_mutex_unlock(&RPNFieldMutex);
+
+   if( code!=APP_OK || !usebuf )
+      return code;
+
+   // Allocate the temporary buffer outside the lock
+   APP_MEM_ASRT( buf,malloc(nijk*TDef_Size[datyp]) );
+
+   pthread_mutex_lock(&RPNFieldMutex);
+   c_fst_data_length(TDef_Size[datyp]);
+   if( c_fstluk(buf,Key,&ni,&nj,&nk)<0 ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not read field\n",__func__);
+      code=APP_ERR;
+   }
+   pthread_mutex_unlock(&RPNFieldMutex);
+
+   // Convert without holding the lock
+   if( code==APP_OK ) {
+      code=RPN_ConvertData(Data,Type,buf,datyp,nijk);
+   }
+   free(buf);
+
+   return code;
+}
+
+int RPN_pRead(void *Data,TDef_Type Type,int Unit,int *NI,int *NJ,int *NK,int DateO,char *Etiket,int IP1,int IP2,int IP3,char* TypVar,char *NomVar) {
+   int key;
+
+   if( (key=cs_fstinf(Unit,NI,NJ,NK,DateO,Etiket,IP1,IP2,IP3,TypVar,NomVar)) < 0 ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"(%s) Could not find field\n",__func__);
+      return APP_ERR;
+   }
+   return RPN_pReadData(Data,Type,key);
+}
+
+typedef struct TRPNLevelKey {
+   int Key;        // Cle de l'enregistrement
+   int K;          // Niveau dans le cube
+   int SWA;        // Adresse de l'enregistrement dans son fichier
+} TRPNLevelKey;
+
+static int RPN_LevelKeyCmp(const void *A,const void *B) {
+   const TRPNLevelKey *a=(const TRPNLevelKey*)A,*b=(const TRPNLevelKey*)B;
+
+   // The file index lives in the lower 10 bits of the key, then sort by address within the file
+   if( (a->Key&0x3FF)!=(b->Key&0x3FF) )
+      return (a->Key&0x3FF)<(b->Key&0x3FF)?-1:1;
+   return a->SWA<b->SWA?-1:(a->SWA>b->SWA?1:0);
+}
+
+// Bring IP1s to a common encoding so that old and new style IP1s of the same level match
+static inline int RPN_IP1Norm(int IP1) {
+   int type;
+   float lvl=(float)ZRef_IP2Level(IP1,&type);
+
+   return ZRef_Level2IP(lvl,type,NEW);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <RPN_ReadLevels>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Lire plusieurs niveaux d'un champ dans un cube contigu
+ *
+ * Parametres :
+ *  <FID>     : Fichier (ou liens)
+ *  <NomVar>  : Nom de la variable
+ *  <TypVar>  : Type de la variable
+ *  <DateV>   : Date de validite
+ *  <Etiket>  : Etiquette
+ *  <IP2>     : IP2
+ *  <IP1s>    : IP1 des niveaux a lire
+ *  <NK>      : Nombre de niveaux
+ *  <Type>    : Type du cube
+ *  <Cube>    : Cube de destination (NI*NJ*NK)
+ *
+ * Retour:
+ *  <APP_OK|APP_ERR> : Code de reussite
+ *
+ * Remarques :
+ *    - Une seule recherche (c_fstinl) pour tous les niveaux, les IP1 sont
+ *      associes a leur niveau par une table de hachage
+ *    - Les enregistrements sont lus dans l'ordre de leur adresse dans le
+ *      fichier afin de garder les acces disque sequentiels
+ *    - Si plusieurs enregistrements correspondent au meme niveau, le premier
+ *      trouve est utilise (comme c_fstinf)
+ *    - Les champs tuiles (#) ne sont pas supportes, utiliser EZGrid
+ *    - Chaque enregistrement doit contenir un seul niveau (NK=1)
+ *----------------------------------------------------------------------------
+ */
+int RPN_ReadLevels(int FID,char *NomVar,char *TypVar,int DateV,char *Etiket,int IP2,const int *IP1s,int NK,TDef_Type Type,void *Cube) {
+
+   TRPNHeader    h;
+   TRPNLevelKey *lvls=NULL;
+   int          *keys=NULL,*hash=NULL,*ips=NULL,*buf;
+   int           n,nkey=0,nmax,k,hn,hk,ip,ni,nj,nk,nij=-1,code=APP_ERR;
+
+   if( !Cube || !IP1s || NK<=0 )
+      return APP_ERR;
+
+   APP_MEM_ASRT_END( lvls,malloc(NK*sizeof(*lvls)) );
+   APP_MEM_ASRT_END( ips,malloc(NK*sizeof(*ips)) );
+
+   // Open addressing IP1 -> K table, at most half full
+   for(hn=16; hn<NK*2; hn<<=1);
+   APP_MEM_ASRT_END( hash,malloc(hn*sizeof(*hash)) );
+   for(n=0; n<hn; ++n) hash[n]=-1;
+
+   for(k=0; k<NK; ++k) {
+      lvls[k].Key=-1;
+      ips[k]=RPN_IP1Norm(IP1s[k]);
+      for(hk=((unsigned int)ips[k]*2654435761u)&(hn-1); hash[hk]>=0 && ips[hash[hk]]!=ips[k]; hk=(hk+1)&(hn-1));
+      if( hash[hk]<0 ) hash[hk]=k;
+   }
+
+   // List every candidate record in one search, growing the key list if it was filled
+   for(nmax=RPNMAX; ; nmax<<=1) {
+      APP_MEM_ASRT_END( buf,realloc(keys,nmax*sizeof(*keys)) );
+      keys=buf;
+      if( cs_fstinl(FID,&ni,&nj,&nk,DateV,Etiket,-1,IP2,-1,TypVar,NomVar,keys,&nkey,nmax)<0 ) {
+         nkey=0;
+         break;
+      }
+      if( nkey<nmax )
+         break;
+      if( nmax>INT_MAX/2 ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Too many records for field (%s)\n",__func__,NomVar);
+         goto end;
+      }
+   }
+   if( !nkey ) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not find field (%s)\n",__func__,NomVar);
+      goto end;
+   }
+
+   strcpy(h.NOMVAR,"    ");
+   strcpy(h.TYPVAR,"  ");
+   strcpy(h.ETIKET,"            ");
+   strcpy(h.GRTYP," ");
+
+   RPN_FieldLock();
+   for(n=0; n<nkey; ++n) {
+      c_fstprm(keys[n],&h.DATEO,&h.DEET,&h.NPAS,&h.NI,&h.NJ,&h.NK,&h.NBITS,&h.DATYP,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
+            h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
+
+      ip=RPN_IP1Norm(h.IP1);
+      for(hk=((unsigned int)ip*2654435761u)&(hn-1); hash[hk]>=0 && ips[hash[hk]]!=ip; hk=(hk+1)&(hn-1));
+
+      // Each IP1 may be requested more than once
+      if( (k=hash[hk])>=0 ) {
+         for(; k<NK; ++k) {
+            if( ips[k]==ip && lvls[k].Key<0 ) {
+               if( h.GRTYP[0]=='#' ) {
+                  RPN_FieldUnlock();
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Tiled fields are not supported (%s)\n",__func__,NomVar);
+                  goto end;
+               }
+               if( h.NK!=1 ) {
+                  RPN_FieldUnlock();
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Records of field (%s) must have a single level (NK=%d at IP1 %d)\n",__func__,NomVar,h.NK,h.IP1);
+                  goto end;
+               }
+               if( nij<0 ) nij=h.NI*h.NJ;
+               if( h.NI*h.NJ!=nij ) {
+                  RPN_FieldUnlock();
+                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Levels of field (%s) have different dimensions\n",__func__,NomVar);
+                  goto end;
+               }
+               lvls[k].Key=keys[n];
+               lvls[k].K=k;
+               lvls[k].SWA=h.SWA;
+            }
+         }
+      }
+   }
+   RPN_FieldUnlock();
+
+   for(k=0; k<NK; ++k) {
+      if( lvls[k].Key<0 ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not find field (%s) at IP1 %d\n",__func__,NomVar,IP1s[k]);
+         goto end;
+      }
+   }
+
+   // Read in file order
+   qsort(lvls,NK,sizeof(*lvls),RPN_LevelKeyCmp);
+   for(n=0; n<NK; ++n) {
+      if( RPN_pReadData((char*)Cube+(size_t)lvls[n].K*nij*TDef_Size[Type],Type,lvls[n].Key)!=APP_OK ) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Could not read field (%s) at IP1 %d\n",__func__,NomVar,IP1s[lvls[n].K]);
+         goto end;
+      }
+   }
+
+   code=APP_OK;
+end:
+   APP_FREE(keys);
+   APP_FREE(lvls);
+   APP_FREE(hash);
+   APP_FREE(ips);
+
+   return code;
+}
+
 #endif
@@ -32,6 +32,7 @@
 #define _RPN_h
 
 #include "Def.h"
+#include "Catalog.h"
 
 #define RPNMAX 2048
 
@@ -106,10 +107,14 @@ int RPN_GenerateIG(int *IG1,int *IG2,int *IG3);
 int RPN_LinkFiles(char **Files,int N);
 int RPN_UnLinkFiles(int FID);
 int RPN_LinkPattern(const char* Pattern);
+int RPN_LinkPatternCatalog(const char* Pattern,TCatalog **Cat);
 int RPN_ReadData(void *Data,TDef_Type Type,int Key);
 int RPN_sReadData(void *Data,TDef_Type Type,int Key);
 int RPN_Read(void *Data,TDef_Type Type,int Unit,int *NI,int *NJ,int *NK,int DateO,char *Etiket,int IP1,int IP2,int IP3,char* TypVar,char *NomVar);
 int RPN_sRead(void *Data,TDef_Type Type,int Unit,int *NI,int *NJ,int *NK,int DateO,char *Etiket,int IP1,int IP2,int IP3,char* TypVar,char *NomVar);
+int RPN_pReadData(void *Data,TDef_Type Type,int Key);
+int RPN_ReadLevels(int FID,char *NomVar,char *TypVar,int DateV,char *Etiket,int IP2,const int *IP1s,int NK,TDef_Type Type,void *Cube);
+int RPN_pRead(void *Data,TDef_Type Type,int Unit,int *NI,int *NJ,int *NK,int DateO,char *Etiket,int IP1,int IP2,int IP3,char* TypVar,char *NomVar);
 
 #ifdef HAVE_RMN
 #include "rmn.h"
@@ -65,6 +65,32 @@ static size_t SM_GetSize(void *Addr) {
    return *((size_t*)Addr-1);
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <SM_AllocLocal>
+ * Creation : Octobre 2026 - E. Legault-Ouellet
+ *
+ * But      : Allouer de la mémoire locale avec le même header de taille que
+ *            la mémoire partagée
+ *
+ * Parametres :
+ *  <Size>    : Taille de l'espace mémoire allouée
+ *
+ * Retour     : Un pointeur vers l'adresse mémoire ou NULL si erreur.
+ *
+ * Remarques  :
+ *      - SM_GetSize (et donc SM_Sync) fonctionne ainsi pour toute mémoire
+ *        obtenue de SM_Alloc
+ *----------------------------------------------------------------------------
+ */
+static void* SM_AllocLocal(size_t Size) {
+   size_t *addr;
+
+   if( !(addr=calloc(Size+sizeof(size_t),1)) )
+      return NULL;
+   *addr = Size;
+   return addr+1;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <SM_RoundPageSize>
  * Creation : Août 2017 - E. Legault-Ouellet
@@ -103,6 +129,8 @@ size_t SM_RoundPageSize(size_t Size) {
  *      - La mémoire est toujours initialisée à 0
  *      - S'il n'y a qu'un seul process MPI ou si le proces MPI est seul sur
  *        son noeud, alors ceci est équivalent à faire un calloc
+ *      - La taille est toujours conservée dans un header (voir SM_GetSize),
+ *        la mémoire doit donc être libérée par SM_Free
  *      - Seul les headnodes de chaque noeuds peuvent modifier la mémoire
  *        partagée, les autres noeuds map la mémoire en R/O
  *----------------------------------------------------------------------------
@@ -111,7 +139,7 @@ void* SM_Alloc(size_t Size) {
 #ifdef HAVE_MPI
    if( App_IsAloneNode() ) {
       // No sharing possibilities, just allocate normal memory
-      return calloc(Size,1);
+      return SM_AllocLocal(Size);
    } else {
       void *addr = NULL;
       char fn[SM_FILENAME] = {0};
@@ -204,7 +232,7 @@ void* SM_Alloc(size_t Size) {
    }
 #else //not HAVE_MPI
    // No MPI, behave like a normal calloc
-   return calloc(Size,1);
+   return SM_AllocLocal(Size);
 #endif //HAVE_MPI
 }
 
@@ -249,7 +277,10 @@ void* SM_Calloc(size_t Num,size_t Size) {
  *----------------------------------------------------------------------------
  */
 int SM_Sync(void *Addr,int NodeHeadRank) {
-#ifdef HAVE_MPI
+#ifndef HAVE_MPI
+   (void)Addr;
+   (void)NodeHeadRank;
+#else //HAVE_MPI
    if( App_IsMPI() ) {
       // If there is more than one node, the head of each node must exchange the data
       if( !App_IsSingleNode() && !App->NodeRankMPI ) {
@@ -264,6 +295,70 @@ int SM_Sync(void *Addr,int NodeHeadRank) {
    return APP_OK;
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <SM_Barrier>
+ * Creation : Octobre 2026 - E. Legault-Ouellet
+ *
+ * But      : Attendre que tous les process MPI du noeud soient rendus
+ *
+ * Parametres :
+ *
+ * Retour     : APP_OK si ok, APP_ERR sinon
+ *
+ * Remarques  :
+ *      - À appeler avant de modifier une mémoire partagée déjà allouée (une
+ *        relecture par exemple) pour que chaque process ait fini de la
+ *        consulter avant que la source ne la modifie
+ *----------------------------------------------------------------------------
+ */
+int SM_Barrier(void) {
+#ifdef HAVE_MPI
+   if( App_IsMPI() && !App_IsAloneNode() ) {
+      APP_MPI_ASRT( MPI_Barrier(App->NodeComm) );
+   }
+#endif //HAVE_MPI
+   return APP_OK;
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <SM_IsSource>
+ * Creation : Octobre 2026 - E. Legault-Ouellet
+ *
+ * But      : Indique si ce process est celui qui doit remplir la mémoire
+ *            partagée avant un appel à SM_Sync
+ *
+ * Parametres :
+ *  <NodeHeadRank> : Rank du NodeHead (NodeHeadComm) du noeud envoyant les données
+ *
+ * Retour     : Vrai si ce process fournit les données
+ *
+ * Remarques  :
+ *      - Un seul process de l'ensemble des noeuds est source, SM_Sync se
+ *        charge de distribuer les données aux autres noeuds
+ *      - Sans MPI, le process est toujours source
+ *----------------------------------------------------------------------------
+ */
+int SM_IsSource(int NodeHeadRank) {
+#ifndef HAVE_MPI
+   (void)NodeHeadRank;
+#else //HAVE_MPI
+   if( App_IsMPI() ) {
+      int rank=0;
+
+      // Only the node head can write into the shared memory
+      if( App->NodeRankMPI )
+         return 0;
+
+      // Only one of the node heads reads the data when there is more than one node
+      if( !App_IsSingleNode() && MPI_Comm_rank(App->NodeHeadComm,&rank)!=MPI_SUCCESS )
+         return 0;
+
+      return rank==NodeHeadRank;
+   }
+#endif //HAVE_MPI
+   return 1;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <SM_Free>
  * Creation : Août 2017 - E. Legault-Ouellet
@@ -279,11 +374,15 @@ int SM_Sync(void *Addr,int NodeHeadRank) {
  *----------------------------------------------------------------------------
  */
 void SM_Free(void *Addr) {
+   if( !Addr )
+      return;
+
+   // Go back to the size header
+   Addr = (size_t*)Addr-1;
 #ifdef HAVE_MPI
    if( App_IsAloneNode() ) {
       free(Addr);
    } else {
-      Addr = (size_t*)Addr-1;
       munmap(Addr,*(size_t*)Addr+sizeof(size_t));
    }
 #else //not HAVE_MPI
@@ -42,6 +42,8 @@ size_t SM_RoundPageSize(size_t Size);
 void* SM_Alloc(size_t Size);
 void* SM_Calloc(size_t Num,size_t Size);
 int SM_Sync(void *Addr,int NodeHeadRank);
+int SM_Barrier(void);
+int SM_IsSource(int NodeHeadRank);
 void SM_Free(void *Addr);
 
 #endif // _SM_H
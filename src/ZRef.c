@@ -36,6 +36,8 @@
 #include "eerUtils.h"
 #include "ZRef.h"
 
+#include <pthread.h>
+
 #ifdef HAVE_VGRID
 #include "vgrid.h"
 #endif
@@ -94,6 +96,7 @@ TZRef* ZRef_New(void) {
    zref->POff=zref->PTop=zref->PRef=zref->ETop=0.0;
    zref->RCoef[0]=zref->RCoef[1]=1.0;
    zref->P0=zref->P0LS=zref->PCube=zref->A=zref->B=NULL;
+   zref->AB=0;
    zref->Version=-1;
    zref->NRef=1;
    zref->LU=LookupNULL;
@@ -175,6 +178,7 @@ int ZRef_Free(TZRef *ZRef) {
 //      if (ZRef->P0)     free(ZRef->P0);     ZRef->P0=NULL;
 //      if (ZRef->P0LS)   free(ZRef->P0LS);   ZRef->P0LS=NULL;
       if (ZRef->PCube)  free(ZRef->PCube);      ZRef->PCube=NULL;
+      ZRef_CubeFlush(ZRef);
 
       if (ZRef->LU.Free) ZRef->LU.Free(&ZRef->LU); ZRef->LU=LookupNULL;
 
@@ -275,6 +279,7 @@ TZRef *ZRef_HardCopy(TZRef *ZRef) {
       zref->RCoef[0]=ZRef->RCoef[0];
       zref->RCoef[1]=ZRef->RCoef[1];
       zref->P0=zref->P0LS=zref->A=zref->B=NULL;
+      zref->AB=0;
       zref->Version=-1;
       zref->NRef=1;
       zref->Style=ZRef->Style;
@@ -318,6 +323,7 @@ int ZRef_DecodeRPN(TZRef *ZRef,int Unit) {
 
    memset(&h,0,sizeof(TRPNHeader));
    ZRef->SLEVE=0;
+   ZRef->AB=0;
 
 #ifdef HAVE_RMN
 
@@ -337,8 +343,8 @@ int ZRef_DecodeRPN(TZRef *ZRef,int Unit) {
          ZRef->RCoef[1]=0.0f;
 
          buf=(double*)malloc(h.NI*h.NJ*sizeof(double));
-         if (!ZRef->A) ZRef->A=(float*)malloc(ZRef->LevelNb*sizeof(float));
-         if (!ZRef->B) ZRef->B=(float*)malloc(ZRef->LevelNb*sizeof(float));
+         if (!ZRef->A) ZRef->A=(float*)calloc(ZRef->LevelNb,sizeof(float));
+         if (!ZRef->B) ZRef->B=(float*)calloc(ZRef->LevelNb,sizeof(float));
 
 #ifdef HAVE_VGRID
          if (Cvgd_new_read((vgrid_descriptor**)&ZRef->VGD,Unit,-1,-1,-1,-1)==VGD_ERROR) {
@@ -351,8 +357,9 @@ int ZRef_DecodeRPN(TZRef *ZRef,int Unit) {
             ZRef->SLEVE=1;
          }
 #endif                  
-         cd=c_fstluk(buf,key,&h.NI,&h.NJ,&h.NK);
+         cd=(buf && ZRef->A && ZRef->B)?c_fstluk(buf,key,&h.NI,&h.NJ,&h.NK):-1;
          if (cd>=0) {
+            int nf=0;
 
             /* Read in header info*/
             switch(ZRef->Version) {
@@ -376,6 +383,7 @@ int ZRef_DecodeRPN(TZRef *ZRef,int Unit) {
                   if (buf[j*h.NI]==ip) {
                      ZRef->A[k]=buf[j*h.NI+1];
                      ZRef->B[k]=buf[j*h.NI+2];
+                     nf++;
                      break;
                   }
                }
@@ -383,6 +391,8 @@ int ZRef_DecodeRPN(TZRef *ZRef,int Unit) {
                   Lib_Log(APP_LIBEER,APP_WARNING,"%s: Could not find level definition for %i.\n",__func__,ip);
                }
             }
+            // Pressures can only be computed from A and B if every level was found, otherwise vgrid is used
+            ZRef->AB=(nf==ZRef->LevelNb);
          } else {
             Lib_Log(APP_LIBEER,APP_WARNING,"%s: Could not read !! field (c_fstluk).\n",__func__);
          }
@@ -624,6 +634,81 @@ double ZRef_K2Pressure(TZRef* restrict const ZRef,double P0,double P0LS, int K)
   return(ZRef_Level2Pressure(ZRef,P0,P0LS,ZRef->Levels[K]));
 }
 
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRef_PressureCoef>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Reduce the pressure calculation of a vertical reference to per
+ *            level coefficients.
+ *
+ * Parametres  :
+ *  <ZRef>     : Vertical reference
+ *  <A>        : Per level constant term (mb, or ln(Pa) for ZREF_PLOG)
+ *  <B>        : Per level factor of the surface term
+ *
+ * Retour:
+ *  <Mode>     : ZREF_PLIN  : P=A+B*P0 (mb)
+ *               ZREF_PLOG  : ln(P)=A+B*ln(P0/PRef) (P in Pa)
+ *               ZREF_PCVGD : Needs the vgrid descriptor (SLEVE or unknown versions)
+ *
+ * Remarques :
+ *    - The hybrid coordinates from the !! record (5001,5002-5005) only need the
+ *      A/B coefficients decoded by ZRef_DecodeRPN, vgrid is not needed for those
+ *      unless some level was missing from the !! record (ZRef->AB)
+ *    - SLEVE (5100) needs a third coefficient not kept in TZRef
+ *----------------------------------------------------------------------------
+ */
+#define ZREF_PLIN  1
+#define ZREF_PLOG  2
+#define ZREF_PCVGD 3
+
+static int ZRef_PressureCoef(TZRef* restrict const ZRef,float *A,float *B) {
+
+   double rtop;
+   int    k;
+
+   switch(ZRef->Type) {
+      case LVL_PRES:
+         for(k=0;k<ZRef->LevelNb;k++) { A[k]=ZRef->Levels[k]; B[k]=0.0f; }
+         return(ZREF_PLIN);
+
+      case LVL_SIGMA:
+         for(k=0;k<ZRef->LevelNb;k++) { A[k]=0.0f; B[k]=ZRef->Levels[k]; }
+         return(ZREF_PLIN);
+
+      case LVL_ETA:
+         for(k=0;k<ZRef->LevelNb;k++) { A[k]=ZRef->PTop*(1.0f-ZRef->Levels[k]); B[k]=ZRef->Levels[k]; }
+         return(ZREF_PLIN);
+
+      case LVL_HYBRID:
+         if (ZRef->Version<=0) {
+            // Normalized hybrid: P=PRef*L+(P0-PRef)*((L-rtop)/(1-rtop))^RCoef
+            rtop=ZRef->PTop/ZRef->PRef;
+            for(k=0;k<ZRef->LevelNb;k++) {
+               B[k]=pow((ZRef->Levels[k]-rtop)/(1.0-rtop),ZRef->RCoef[0]);
+               A[k]=ZRef->PRef*(ZRef->Levels[k]-B[k]);
+            }
+            return(ZREF_PLIN);
+         }
+         if (!ZRef->SLEVE && ZRef->AB && ZRef->A && ZRef->B) {
+            switch(ZRef->Version) {
+               case 5001:
+                  // P(Pa)=A+B*P0(Pa)
+                  for(k=0;k<ZRef->LevelNb;k++) { A[k]=ZRef->A[k]*PA2MB; B[k]=ZRef->B[k]; }
+                  return(ZREF_PLIN);
+               case 5002:
+               case 5003:
+               case 5004:
+               case 5005:
+                  for(k=0;k<ZRef->LevelNb;k++) { A[k]=ZRef->A[k]; B[k]=ZRef->B[k]; }
+                  return(ZREF_PLOG);
+            }
+         }
+         return(ZREF_PCVGD);
+   }
+   return(0);
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <ZRef_KCube2Pressure>
  * Creation : Octobre 2011 - J.P. Gauthier - CMC/CMOE
@@ -641,108 +726,148 @@ double ZRef_K2Pressure(TZRef* restrict const ZRef,double P0,double P0LS, int K)
  * Retour:
  *
  * Remarques :
+ *    - Apart from SLEVE, the pressure, offset and log are computed from per level
+ *      coefficients in a single pass over the cube (OpenMP over levels, SIMD over
+ *      the grid points)
  *
  *----------------------------------------------------------------------------
  */
 int ZRef_KCube2Pressure(TZRef* restrict const ZRef,float *P0,float *P0LS,int NIJ,int Log,float *Pres) {
 
-   int   k,idxk=0,ij;
+   int   k,ij,mode,nk=ZRef->LevelNb,ok=1;
+   float *a=NULL,*b=NULL,*s=NULL,poff=ZRef->POff,lpa;
+#ifdef HAVE_VGRID
    int   *ips;
-   float pref,ptop,*p0,*p0ls;
+   float *p0,*p0ls;
+#endif
 
    if (!P0 && ZRef->Type!=LVL_PRES) {
       Lib_Log(APP_LIBEER,APP_ERROR,"%s: Surface pressure is required\n",__func__);
       return(0);
    }
 
-   pref=ZRef->PRef;
-   ptop=ZRef->PTop;
+   if (ZRef->Type==LVL_UNDEF) {
+      // The pressure cube is given
+      for (ij=0;ij<NIJ*nk;ij++) {
+         Pres[ij]=Log?logf(P0[ij]+poff):P0[ij]+poff;
+      }
+      return(1);
+   }
 
-   switch(ZRef->Type) {
-      case LVL_PRES:
-         for (k=0;k<ZRef->LevelNb;k++,idxk+=NIJ) {
-            for (ij=0;ij<NIJ;ij++) {
-               Pres[idxk+ij]=ZRef->Levels[k];
+   if (!(a=(float*)malloc(2*nk*sizeof(float)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate coefficients\n",__func__);
+      return(0);
+   }
+   b=a+nk;
+
+   switch((mode=ZRef_PressureCoef(ZRef,a,b))) {
+      case ZREF_PLIN:
+         #pragma omp parallel for private(ij)
+         for (k=0;k<nk;k++) {
+            const float ak=a[k]+poff,bk=b[k];
+            float *restrict pk=&Pres[(size_t)k*NIJ];
+            const float *restrict ps=P0;
+
+            if (!ps || bk==0.0f) {
+               // Constant level (pressure levels)
+               const float c=Log?logf(ak):ak;
+               #pragma omp simd
+               for (ij=0;ij<NIJ;ij++) pk[ij]=c;
+            } else if (Log) {
+               #pragma omp simd
+               for (ij=0;ij<NIJ;ij++) pk[ij]=logf(ak+bk*ps[ij]);
+            } else {
+               #pragma omp simd
+               for (ij=0;ij<NIJ;ij++) pk[ij]=ak+bk*ps[ij];
             }
          }
          break;
 
-      case LVL_SIGMA:
-         for (k=0;k<ZRef->LevelNb;k++,idxk+=NIJ) {
-            for (ij=0;ij<NIJ;ij++) {
-               Pres[idxk+ij]=P0[ij]*ZRef->Levels[k];
-            }
+      case ZREF_PLOG:
+         // ln(P0/PRef) is shared by all the levels
+         if (!(s=(float*)malloc(NIJ*sizeof(float)))) {
+            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate surface term\n",__func__);
+            ok=0;
+            break;
          }
-         break;
-
-      case LVL_ETA:
-         for (k=0;k<ZRef->LevelNb;k++,idxk+=NIJ) {
-            for (ij=0;ij<NIJ;ij++) {
-               Pres[idxk+ij]=ptop+(P0[ij]-ptop)*ZRef->Levels[k];
+         #pragma omp parallel for simd
+         for (ij=0;ij<NIJ;ij++) s[ij]=logf(P0[ij]/ZRef->PRef);
+
+         lpa=logf(PA2MB);
+         #pragma omp parallel for private(ij)
+         for (k=0;k<nk;k++) {
+            const float ak=a[k],bk=b[k];
+            float *restrict pk=&Pres[(size_t)k*NIJ];
+            const float *restrict sk=s;
+
+            if (Log && poff==0.0f) {
+               // Stay in log space
+               #pragma omp simd
+               for (ij=0;ij<NIJ;ij++) pk[ij]=ak+lpa+bk*sk[ij];
+            } else if (Log) {
+               #pragma omp simd
+               for (ij=0;ij<NIJ;ij++) pk[ij]=logf(expf(ak+bk*sk[ij])*PA2MB+poff);
+            } else {
+               #pragma omp simd
+               for (ij=0;ij<NIJ;ij++) pk[ij]=expf(ak+bk*sk[ij])*PA2MB+poff;
             }
          }
          break;
 
-      case LVL_UNDEF:
-         for (k=0;k<ZRef->LevelNb;k++,idxk+=NIJ) {
-            for (ij=0;ij<NIJ;ij++) {
-               Pres[idxk+ij]=P0[idxk+ij];
-            }
+      case ZREF_PCVGD:
+#ifdef HAVE_VGRID
+         ips=malloc(nk*sizeof(int));
+         for (k=0;k<nk;k++) {
+            ips[k]=ZRef_Level2IP(ZRef->Levels[k],ZRef->Type,ZRef->Style);
+         }
+            
+         // Cvgd needs pascals
+         p0=(float*)malloc(NIJ*sizeof(float));
+         for (ij=0;ij<NIJ;ij++) {
+            p0[ij]=P0[ij]*MB2PA;
          }
-         break;
-         
-      case LVL_HYBRID:
-#ifdef HAVE_RMN         
-         if (ZRef->Version<=0) {
-            ij=1;
-            f77name(hyb_to_pres)(Pres,ZRef->Levels,&ptop,&ZRef->RCoef[0],&pref,&ij,P0,&NIJ,&ij,&ZRef->LevelNb);
-         } else {
-            ips=malloc(ZRef->LevelNb*sizeof(int));
-            for (k=0;k<ZRef->LevelNb;k++) {
-               ips[k]=ZRef_Level2IP(ZRef->Levels[k],ZRef->Type,ZRef->Style);
-            }
             
-            // Really not optimal but Cvgd needs pascals
-            p0=(float*)malloc(NIJ*sizeof(float));
+         if(ZRef->SLEVE){
+            p0ls=(float*)malloc(NIJ*sizeof(float));
             for (ij=0;ij<NIJ;ij++) {
-               p0[ij]=P0[ij]*MB2PA;
+               p0ls[ij]=P0LS[ij]*MB2PA;
             }
-            
-#ifdef HAVE_VGRID	    
-            if(ZRef->SLEVE){
-               p0ls=(float*)malloc(NIJ*sizeof(float));
-               for (ij=0;ij<NIJ;ij++) {
-                  p0ls[ij]=P0LS[ij]*MB2PA;
-               }
-               if (Cvgd_levels_2ref((vgrid_descriptor*)ZRef->VGD,NIJ,1,ZRef->LevelNb,ips,Pres,p0,p0ls,0)) {
-                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Problems in Cvgd_levels_2ref\n",__func__);
-                  return(0);
-               }	      
-            } else {
-               if (Cvgd_levels((vgrid_descriptor*)ZRef->VGD,NIJ,1,ZRef->LevelNb,ips,Pres,p0,0)) {
-                  Lib_Log(APP_LIBEER,APP_ERROR,"%s: Problems in Cvgd_levels\n",__func__);
-                  return(0);
-               }    
+            if (Cvgd_levels_2ref((vgrid_descriptor*)ZRef->VGD,NIJ,1,nk,ips,Pres,p0,p0ls,0)) {
+               Lib_Log(APP_LIBEER,APP_ERROR,"%s: Problems in Cvgd_levels_2ref\n",__func__);
+               ok=0;
+            }	      
+            free(p0ls);
+         } else {
+            if (Cvgd_levels((vgrid_descriptor*)ZRef->VGD,NIJ,1,nk,ips,Pres,p0,0)) {
+               Lib_Log(APP_LIBEER,APP_ERROR,"%s: Problems in Cvgd_levels\n",__func__);
+               ok=0;
+            }    
+         }
+         free(ips);
+         free(p0);            
+
+         // Units, offset and log in a single pass
+         if (ok) {
+            #pragma omp parallel for simd
+            for (ij=0;ij<NIJ*nk;ij++) {
+               Pres[ij]=Log?logf(Pres[ij]*PA2MB+poff):Pres[ij]*PA2MB+poff;
             }
-#else
-            Lib_Log(APP_LIBEER,APP_ERROR,"%s: Library not built with VGRID\n",__func__);
-#endif
-            for (ij=0;ij<NIJ*ZRef->LevelNb;ij++) Pres[ij]*=PA2MB;
-            free(ips);
-            free(p0);            
          }
+#else
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Library not built with VGRID\n",__func__);
+         ok=0;
 #endif
          break;
          
       default:
          Lib_Log(APP_LIBEER,APP_ERROR,"%s: Invalid level type (%i)\n",__func__,ZRef->Type);
-         return(0);
+         ok=0;
    }
+
+   free(a);
+   free(s);
    
-   if (ZRef->POff!=0.0) for (ij=0;ij<NIJ*ZRef->LevelNb;ij++) Pres[ij]+=ZRef->POff;
-   if (Log)             for (ij=0;ij<NIJ*ZRef->LevelNb;ij++) Pres[ij]=log(Pres[ij]);
-   
-   return(1);
+   return(ok);
 }
 
 /*----------------------------------------------------------------------------
@@ -1270,3 +1395,307 @@ int ZRef_GetLevelIdx(TZRef *ZRef,float Lvl,int *Kb,int *Kn) {
 
    return APP_OK;
 }
+
+/*----------------------------------------------------------------------------
+ * Cache of 3D level cubes
+ *
+ * Les cubes de niveaux (log(p) ou metres) sont partages entre tous les
+ * interpolateurs et toutes les variables d'un meme pas de temps. Une entree
+ * est identifiee par la reference verticale, la dimension 2D, le type de cube
+ * et un hash du contenu des champs de surface (P0, P0LS) et des coefficients.
+ * Un changement de P0 d'un pas de temps a l'autre donne donc une nouvelle
+ * entree. Les entrees inutilisees sont liberees (LRU) des que la memoire
+ * totale depasse la limite (ZRef_CubeLimit).
+ *----------------------------------------------------------------------------
+*/
+typedef struct TZRefCube {
+   TZRef   *ZRef;         // Vertical reference (identity only, NULL if orphaned)
+   uint64_t Hash;         // Hash of the surface fields and coefficients
+   uint64_t Stamp;        // Last use (LRU)
+   size_t   Size;         // Size of the cube (bytes)
+   float   *Cube;         // Cube of levels
+   int      NIJ;          // 2D dimension
+   int      Magl;         // Meter cube (TRUE) or log(p) cube (FALSE)
+   int      NRef;         // Number of users
+   int      Ready;        // Cube is computed
+} TZRefCube;
+
+static pthread_mutex_t ZRef_CubeMutex=PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  ZRef_CubeCond=PTHREAD_COND_INITIALIZER;
+static TZRefCube       ZRef_Cubes[ZREF_CUBEMAX];
+static size_t          ZRef_CubeSize=0;                          // Memory used by the cached cubes (bytes)
+static size_t          ZRef_CubeMax=ZREF_CUBEMEM;                // Memory limit (bytes)
+static uint64_t        ZRef_CubeStamp=0;
+
+static inline uint64_t ZRef_Hash(uint64_t H,const void *Data,size_t N) {
+
+   const unsigned char *c=(const unsigned char*)Data;
+   uint64_t             w;
+   size_t               n;
+
+   // Word at a time FNV-1a style mixing
+   for(n=0;n+8<=N;n+=8) {
+      memcpy(&w,c+n,8);
+      H=(H^w)*0x100000001b3ULL;
+      H^=H>>29;
+   }
+   for(;n<N;n++) {
+      H=(H^c[n])*0x100000001b3ULL;
+   }
+   return(H);
+}
+
+static uint64_t ZRef_CubeHash(TZRef *ZRef,int NIJ,int Magl) {
+
+   uint64_t h=0xcbf29ce484222325ULL;
+
+   h=ZRef_Hash(h,&ZRef->Type,sizeof(ZRef->Type));
+   h=ZRef_Hash(h,&ZRef->LevelNb,sizeof(ZRef->LevelNb));
+   h=ZRef_Hash(h,&ZRef->POff,sizeof(ZRef->POff));
+   h=ZRef_Hash(h,&ZRef->PTop,sizeof(ZRef->PTop));
+   h=ZRef_Hash(h,&ZRef->PRef,sizeof(ZRef->PRef));
+   h=ZRef_Hash(h,&ZRef->ETop,sizeof(ZRef->ETop));
+   h=ZRef_Hash(h,ZRef->RCoef,sizeof(ZRef->RCoef));
+   h=ZRef_Hash(h,&Magl,sizeof(Magl));
+   h=ZRef_Hash(h,ZRef->Levels,ZRef->LevelNb*sizeof(float));
+   if (ZRef->A)    h=ZRef_Hash(h,ZRef->A,ZRef->LevelNb*sizeof(float));
+   if (ZRef->B)    h=ZRef_Hash(h,ZRef->B,ZRef->LevelNb*sizeof(float));
+   if (ZRef->P0)   h=ZRef_Hash(h,ZRef->P0,(size_t)NIJ*sizeof(float));
+   if (ZRef->P0LS) h=ZRef_Hash(h,ZRef->P0LS,(size_t)NIJ*sizeof(float));
+
+   return(h);
+}
+
+// Drop a cache entry (call with the mutex locked)
+static void ZRef_CubeDrop(TZRefCube *Ent) {
+
+   ZRef_CubeSize-=Ent->Size;
+   free(Ent->Cube);
+   memset(Ent,0,sizeof(TZRefCube));
+}
+
+// Drop unused cubes, least recently used first, until Need more bytes fit in the limit (call with the mutex locked)
+static void ZRef_CubeEvict(size_t Need) {
+
+   TZRefCube *old;
+   int        n;
+
+   while(ZRef_CubeSize+Need>ZRef_CubeMax) {
+      old=NULL;
+      for(n=0;n<ZREF_CUBEMAX;n++) {
+         if (ZRef_Cubes[n].Cube && !ZRef_Cubes[n].NRef && (!old || ZRef_Cubes[n].Stamp<old->Stamp)) {
+            old=&ZRef_Cubes[n];
+         }
+      }
+      if (!old)
+         break;
+      ZRef_CubeDrop(old);
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRef_CubeGet>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the 3D cube of levels of a vertical reference from the cache,
+ *            computing it if needed
+ *
+ * Parametres :
+ *  <ZRef>    : Vertical reference
+ *  <NIJ>     : 2D dimension
+ *  <Magl>    : Meter cube (TRUE, ZRef_KCube2Meter) or log(p) cube (FALSE, ZRef_KCube2Pressure)
+ *
+ * Retour     : Cube of levels (NULL on error)
+ *
+ * Remarques :
+ *   - The cube must be released with ZRef_CubeRelease and must not be modified
+ *   - A single thread computes a given cube, the others wait for it
+ *   - If the cache is full of cubes in use, the cube is computed for the caller only
+ *----------------------------------------------------------------------------
+ */
+float* ZRef_CubeGet(TZRef *ZRef,int NIJ,int Magl) {
+
+   TZRefCube *ent=NULL;
+   uint64_t   hash;
+   size_t     size;
+   float     *cube=NULL;
+   int        n,ok;
+
+   if (!ZRef || NIJ<=0 || ZRef->LevelNb<=0) {
+      return(NULL);
+   }
+
+   hash=ZRef_CubeHash(ZRef,NIJ,Magl);
+   size=(size_t)NIJ*ZRef->LevelNb*sizeof(float);
+
+   pthread_mutex_lock(&ZRef_CubeMutex);
+   for(n=0;n<ZREF_CUBEMAX;n++) {
+      if (ZRef_Cubes[n].Cube && ZRef_Cubes[n].ZRef==ZRef && ZRef_Cubes[n].Hash==hash && ZRef_Cubes[n].NIJ==NIJ && ZRef_Cubes[n].Magl==Magl) {
+         ent=&ZRef_Cubes[n];
+         ent->NRef++;
+         ent->Stamp=++ZRef_CubeStamp;
+
+         // Wait for the thread computing it
+         while(!ent->Ready) {
+            pthread_cond_wait(&ZRef_CubeCond,&ZRef_CubeMutex);
+         }
+         if (ent->ZRef) {
+            cube=ent->Cube;
+         } else if (!--ent->NRef) {
+            // Computation failed
+            ZRef_CubeDrop(ent);
+         }
+         pthread_mutex_unlock(&ZRef_CubeMutex);
+         return(cube);
+      }
+   }
+
+   // Reserve an entry
+   ZRef_CubeEvict(size);
+   for(n=0;n<ZREF_CUBEMAX;n++) {
+      if (!ZRef_Cubes[n].Cube) {
+         break;
+      }
+   }
+   if (!(cube=(float*)malloc(size))) {
+      pthread_mutex_unlock(&ZRef_CubeMutex);
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unable to allocate cube\n",__func__);
+      return(NULL);
+   }
+   if (n<ZREF_CUBEMAX) {
+      ent=&ZRef_Cubes[n];
+      ent->ZRef=ZRef;
+      ent->Hash=hash;
+      ent->Stamp=++ZRef_CubeStamp;
+      ent->Size=size;
+      ent->Cube=cube;
+      ent->NIJ=NIJ;
+      ent->Magl=Magl;
+      ent->NRef=1;
+      ent->Ready=0;
+      ZRef_CubeSize+=size;
+   }
+   pthread_mutex_unlock(&ZRef_CubeMutex);
+
+   if (Magl) {
+      ok=ZRef_KCube2Meter(ZRef,ZRef->P0,NIJ,cube);
+   } else {
+      ok=ZRef_KCube2Pressure(ZRef,ZRef->P0,ZRef->P0LS,NIJ,TRUE,cube);
+   }
+
+   if (ent) {
+      pthread_mutex_lock(&ZRef_CubeMutex);
+      ent->Ready=1;
+      if (!ok) {
+         // Waiting threads see the failure through the orphaned entry
+         ent->ZRef=NULL;
+         if (!--ent->NRef) {
+            ZRef_CubeDrop(ent);
+         }
+         cube=NULL;
+      }
+      pthread_cond_broadcast(&ZRef_CubeCond);
+      pthread_mutex_unlock(&ZRef_CubeMutex);
+   } else if (!ok) {
+      free(cube);
+      cube=NULL;
+   }
+
+   return(cube);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRef_CubeRelease>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Release a cube obtained with ZRef_CubeGet
+ *
+ * Parametres :
+ *  <Cube>    : Cube of levels
+ *
+ * Retour     :
+ *
+ * Remarques : The cube stays in the cache until evicted or its vertical reference freed
+ *----------------------------------------------------------------------------
+ */
+void ZRef_CubeRelease(float *Cube) {
+
+   int n;
+
+   if (!Cube)
+      return;
+
+   pthread_mutex_lock(&ZRef_CubeMutex);
+   for(n=0;n<ZREF_CUBEMAX;n++) {
+      if (ZRef_Cubes[n].Cube==Cube) {
+         if (!--ZRef_Cubes[n].NRef && !ZRef_Cubes[n].ZRef) {
+            ZRef_CubeDrop(&ZRef_Cubes[n]);
+         }
+         ZRef_CubeEvict(0);
+         pthread_mutex_unlock(&ZRef_CubeMutex);
+         return;
+      }
+   }
+   pthread_mutex_unlock(&ZRef_CubeMutex);
+
+   // Not cached (the cache was full)
+   free(Cube);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRef_CubeFlush>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Remove the cubes of a vertical reference from the cache
+ *
+ * Parametres :
+ *  <ZRef>    : Vertical reference (NULL for all)
+ *
+ * Retour     :
+ *
+ * Remarques : Cubes still in use are orphaned and freed on their last release
+ *----------------------------------------------------------------------------
+ */
+void ZRef_CubeFlush(TZRef *ZRef) {
+
+   int n;
+
+   pthread_mutex_lock(&ZRef_CubeMutex);
+   for(n=0;n<ZREF_CUBEMAX;n++) {
+      if (ZRef_Cubes[n].Cube && ZRef_Cubes[n].Ready && (!ZRef || ZRef_Cubes[n].ZRef==ZRef)) {
+         if (ZRef_Cubes[n].NRef) {
+            ZRef_Cubes[n].ZRef=NULL;
+         } else {
+            ZRef_CubeDrop(&ZRef_Cubes[n]);
+         }
+      }
+   }
+   pthread_mutex_unlock(&ZRef_CubeMutex);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRef_CubeLimit>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Set the memory limit of the cube cache
+ *
+ * Parametres :
+ *  <Bytes>   : Memory limit in bytes (0 to disable caching of unused cubes)
+ *
+ * Retour     : Previous limit
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+ */
+size_t ZRef_CubeLimit(size_t Bytes) {
+
+   size_t old;
+
+   pthread_mutex_lock(&ZRef_CubeMutex);
+   old=ZRef_CubeMax;
+   ZRef_CubeMax=Bytes;
+   ZRef_CubeEvict(0);
+   pthread_mutex_unlock(&ZRef_CubeMutex);
+
+   return(old);
+}
@@ -85,6 +85,7 @@ typedef struct TZRef {
    int    Version;        // Version
    int    Type;           // Type of levels
    int    SLEVE;          // Is SLEVE type (boolean 0/1)
+   int    AB;             // Are A and B defined for every level (boolean 0/1)
    float  POff;           // Pressure offset from level
    float  PTop;           // Pressure at top of atmosphere
    float  PRef;           // Reference pressure
@@ -99,6 +100,9 @@ typedef struct TZRef {
 #endif
 } TZRef;
 
+#define ZREF_CUBEMAX 64                    // Maximum number of cached level cubes
+#define ZREF_CUBEMEM  (1024UL*1024*1024)   // Default memory limit of the level cube cache (bytes)
+
 #define ZRef_Incr(ZREF) __sync_add_and_fetch(&ZREF->NRef,1)
 #define ZRef_Decr(ZREF) __sync_sub_and_fetch(&ZREF->NRef,1)
 
@@ -115,6 +119,10 @@ int    ZRef_GetLevels(TZRef *ZRef,const struct TRPNHeader* restrict const H,int
 double ZRef_K2Pressure(TZRef* restrict const ZRef,double P0,double P0LS,int K);
 int    ZRef_KCube2Pressure(TZRef* restrict const ZRef,float *P0,float *P0LS,int NIJ,int Log,float *Pres);
 int    ZRef_KCube2Meter(TZRef* restrict const ZRef,float *GZ,const int NIJ,float *Height);
+float* ZRef_CubeGet(TZRef *ZRef,int NIJ,int Magl);
+void   ZRef_CubeRelease(float *Cube);
+void   ZRef_CubeFlush(TZRef *ZRef);
+size_t ZRef_CubeLimit(size_t Bytes);
 double ZRef_Level2Pressure(TZRef* restrict const ZRef,double P0,double P0LS,double Level);
 double ZRef_Pressure2Level(TZRef* restrict const ZRef,double P0,double Pressure);
 double ZRef_IP2Meter(int IP);
@@ -47,13 +47,19 @@
    #include <fpxcp.h>
 #endif
 
-static TZRefInterp *FInterp;
-static unsigned char ZRefInterp_Options=0x0000;
+// Legacy interface (ZRefInterp_Define, ZRefInterp_SetOption, ZRefInterp_SetOptioni): global options,
+// only used by these wrappers
+static unsigned int ZRefInterp_Options=ZRDEFAULT;
 
 /* Fortran Interface */
 /*
+// The Fortran interface has no handle, it works on its own interpolator
+static TZRefInterp *FInterp=NULL;
+
 int32_t f77name(zrefinterp_free)(void) {
-   return(ZRefInterp_Free(FInterp));
+   int32_t ok=ZRefInterp_Free(FInterp);
+   FInterp=NULL;
+   return(ok);
 }
 
 int32_t f77name(viqkdef)(int32_t *numLevel,int32_t *gridType,float *levelList,float *top,float *pRef,float *rCoef,float *zcoord,float *a,float *b) {
@@ -73,15 +79,18 @@ int32_t f77name(viqkdef)(int32_t *numLevel,int32_t *gridType,float *levelList,fl
 }
 
 int32_t f77name(videfset)(int32_t *ni,int32_t *nj,int32_t *idGrdDest,int32_t *idGrdSrc) {
-   return ZRefInterp_Define(FInterp,*ni,*nj,*idGrdDest,*idGrdSrc);
+   unsigned int opt=FInterp?FInterp->Options:ZRDEFAULT;
+
+   ZRefInterp_Free(FInterp);
+   return((FInterp=ZRefInterp_DefineOpt(*idGrdDest,*idGrdSrc,*ni,*nj,opt))!=NULL);
 }
 
 int32_t f77name(visetopt)(int32_t *option,int32_t *value) {
-   return ZRefInterp_SetOption(FInterp,(const char*)option,(const char*)value);
+   return ZRefInterp_SetOptionOf(FInterp,(const char*)option,(const char*)value);
 }
 
 int32_t f77name (visint)(float *stateOut,float *stateIn,float *derivOut,float *derivIn,float *extrapGuideDown,float *extrapGuideUp) {
-   return c_visint(FInterp,stateOut,stateIn,derivOut,derivIn,*extrapGuideDown,*extrapGuideUp);
+   return ZRefInterp(FInterp,stateOut,stateIn,derivOut,derivIn,*extrapGuideDown,*extrapGuideUp);
 }
 */
 /*----------------------------------------------------------------------------
@@ -103,6 +112,11 @@ int ZRefInterp_Free(TZRefInterp *Interp) {
 
    if (Interp) {
       if (Interp->Indexes) free(Interp->Indexes); Interp->Indexes=NULL;
+      ZRefLocator_Free(Interp->Loc); Interp->Loc=NULL;
+
+      // Release the cubes that come from the cache
+      if (Interp->PSrc && Interp->PSrc!=Interp->ZRefSrc->PCube)    ZRef_CubeRelease(Interp->PSrc);
+      if (Interp->PDest && Interp->PDest!=Interp->ZRefDest->PCube) ZRef_CubeRelease(Interp->PDest);
       
       ZRef_Free(Interp->ZRefSrc);
       ZRef_Free(Interp->ZRefDest);
@@ -113,7 +127,335 @@ int ZRefInterp_Free(TZRefInterp *Interp) {
 }
 
 /*----------------------------------------------------------------------------
- * Nom      : <ZRefInterp_Define>
+ * Native vertical interpolation
+ *
+ * Les cubes sont stockés niveau par niveau (index k*NIJ+ij), comme pour les
+ * routines interp1d de RMNLIB. Les colonnes sont traitées par blocs de
+ * ZRBLOCK (parallélisés avec OpenMP) et, à l'intérieur d'un bloc, chaque
+ * niveau est vectorisé sur les colonnes.
+ *
+ * La position des niveaux cibles est calculée une seule fois par un
+ * localisateur (TZRefLocator) qui garde, pour chaque point, le niveau source
+ * inférieur de l'intervalle et le poids linéaire. Comme les niveaux cibles
+ * d'une colonne sont habituellement monotones, la recherche est un parcours
+ * fusionné des deux colonnes: la position d'un niveau part de celle du
+ * niveau précédent.
+ *----------------------------------------------------------------------------
+ */
+#define ZRBLOCK 256
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefLocator_New>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Locate target levels within the source levels of every column
+ *
+ * Parametres :
+ *  <Src>     : Source level cube (NS levels, monotone in each column)
+ *  <NS>      : Number of source levels
+ *  <Dest>    : Target level cube (ND levels, any order)
+ *  <ND>      : Number of target levels
+ *  <NIJ>     : Number of columns
+ *
+ * Retour     : Locator (NULL on error)
+ *
+ * Remarques :
+ *   - Idx is the lower source level of the bracketing interval (0 based, in [0,NS-2])
+ *   - W is the linear weight of the upper level, clamped to [0,1] outside of the column
+ *   - Cost is O(NS+ND) per column for monotone targets
+ *----------------------------------------------------------------------------
+*/
+TZRefLocator* ZRefLocator_New(const float *restrict Src,int NS,const float *restrict Dest,int ND,int NIJ) {
+
+   TZRefLocator *loc;
+   int           b,e,n,j,k,i,c,lo[ZRBLOCK];
+   float         s[ZRBLOCK],x,x1,x2,t;
+
+   if (!Src || !Dest || NS<1 || ND<1 || NIJ<1) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Invalid level cubes\n",__func__);
+      return(NULL);
+   }
+
+   if (!(loc=(TZRefLocator*)malloc(sizeof(TZRefLocator)))) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: malloc failed for locator\n",__func__);
+      return(NULL);
+   }
+   loc->NS=NS;
+   loc->ND=ND;
+   loc->NIJ=NIJ;
+   loc->Idx=(int*)malloc((size_t)NIJ*ND*sizeof(int));
+   loc->W=(float*)malloc((size_t)NIJ*ND*sizeof(float));
+   if (!loc->Idx || !loc->W) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: malloc failed for locator arrays\n",__func__);
+      ZRefLocator_Free(loc);
+      return(NULL);
+   }
+
+   if (NS<2) {
+      // Single source level, everything is clamped to it
+      memset(loc->Idx,0,(size_t)NIJ*ND*sizeof(int));
+      memset(loc->W,0,(size_t)NIJ*ND*sizeof(float));
+      return(loc);
+   }
+
+   #pragma omp parallel for private(b,e,n,j,k,i,c,lo,s,x,x1,x2,t)
+   for(b=0;b<NIJ;b+=ZRBLOCK) {
+      e=b+ZRBLOCK<NIJ?b+ZRBLOCK:NIJ;
+      n=e-b;
+
+      // Direction of each column
+      for(j=0;j<n;j++) {
+         s[j]=Src[(size_t)(NS-1)*NIJ+b+j]>=Src[b+j]?1.0f:-1.0f;
+         lo[j]=0;
+      }
+
+      for(k=0;k<ND;k++) {
+         for(j=0;j<n;j++) {
+            c=b+j;
+            x=s[j]*Dest[(size_t)k*NIJ+c];
+
+            // Walk from the previous position
+            i=lo[j];
+            while(i<NS-2 && x>=s[j]*Src[(size_t)(i+1)*NIJ+c]) i++;
+            while(i>0 && x<s[j]*Src[(size_t)i*NIJ+c]) i--;
+            lo[j]=i;
+
+            x1=Src[(size_t)i*NIJ+c];
+            x2=Src[(size_t)(i+1)*NIJ+c];
+            t=x2!=x1?(Dest[(size_t)k*NIJ+c]-x1)/(x2-x1):0.0f;
+
+            loc->Idx[(size_t)k*NIJ+c]=i;
+            loc->W[(size_t)k*NIJ+c]=t<0.0f?0.0f:(t>1.0f?1.0f:t);
+         }
+      }
+   }
+
+   return(loc);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefLocator_Free>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Free a vertical locator
+ *
+ * Parametres :
+ *  <Loc>     : Locator
+ *
+ * Retour     :
+ *
+ * Remarques :
+ *----------------------------------------------------------------------------
+*/
+void ZRefLocator_Free(TZRefLocator *Loc) {
+
+   if (Loc) {
+      free(Loc->Idx);
+      free(Loc->W);
+      free(Loc);
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefLocator_Apply>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Linear vertical interpolation of variables with a locator
+ *
+ * Parametres :
+ *  <Loc>     : Locator
+ *  <Out>     : Output cubes (ND levels)
+ *  <In>      : Input cubes (NS levels)
+ *  <NVar>    : Number of variables
+ *
+ * Retour     : APP_OK or APP_ERR
+ *
+ * Remarques :
+ *   - The values are clamped to the end levels outside of the columns
+ *   - The variables are processed together so that the locator is read once
+ *----------------------------------------------------------------------------
+*/
+int ZRefLocator_Apply(const TZRefLocator *Loc,float **Out,const float **In,int NVar) {
+
+   size_t p,n,nij;
+   int    v;
+
+   if (!Loc || !Out || !In || NVar<1) {
+      return(APP_ERR);
+   }
+   n=(size_t)Loc->NIJ*Loc->ND;
+   nij=Loc->NIJ;
+
+   if (Loc->NS<2) {
+      for(v=0;v<NVar;v++) {
+         for(p=0;p<(size_t)Loc->ND;p++) memcpy(&Out[v][p*nij],In[v],nij*sizeof(float));
+      }
+      return(APP_OK);
+   }
+
+   #pragma omp parallel for private(p,v)
+   for(p=0;p<n;p+=ZRBLOCK) {
+      size_t e=p+ZRBLOCK<n?p+ZRBLOCK:n,q,o;
+      float  w;
+
+      for(v=0;v<NVar;v++) {
+         const float *restrict in=In[v];
+         float       *restrict out=Out[v];
+
+         #pragma omp simd private(o,w)
+         for(q=p;q<e;q++) {
+            o=(size_t)Loc->Idx[q]*nij+q%nij;
+            w=Loc->W[q];
+            out[q]=in[o]+(in[o+nij]-in[o])*w;
+         }
+      }
+   }
+   return(APP_OK);
+}
+
+static int ZRefInterp_Native(TZRefInterp *Interp,unsigned int Options,float *restrict StateOut,const float *restrict StateIn,float *restrict DerivOut,const float *restrict DerivIn,float ExtrapGuideDown,float ExtrapGuideUp) {
+
+   const float *restrict src=Interp->PSrc;
+   const float *restrict dst=Interp->PDest;
+   const int   *restrict idx=Interp->Loc->Idx;
+   const float *restrict w=Interp->Loc->W;
+   int   ns=Interp->ZRefSrc->LevelNb,nd=Interp->ZRefDest->LevelNb,nij=Interp->NIJ;
+   int   lapse=(Options&ZRLAPSERATE) && !(Options&ZRCLAMPED);
+   int   b,e,n,j,k,i,p,o[ZRBLOCK];
+   float t[ZRBLOCK],h[ZRBLOCK];
+   float x,x0,x1,x2,x3,y0,y1,y2,y3,tt,t2,t3,v,l,xlo,xhi,ylo,yhi;
+
+   if (ns<2) {
+      // Single source level, everything is clamped to it
+      for(k=0;k<nd;k++) memcpy(&StateOut[k*nij],StateIn,nij*sizeof(float));
+      return(1);
+   }
+
+   #pragma omp parallel for private(b,e,n,j,k,i,p,o,t,h,x,x0,x1,x2,x3,y0,y1,y2,y3,tt,t2,t3,v,l,xlo,xhi,ylo,yhi)
+   for(b=0;b<nij;b+=ZRBLOCK) {
+      e=b+ZRBLOCK<nij?b+ZRBLOCK:nij;
+      n=e-b;
+
+      for(k=0;k<nd;k++) {
+         p=k*nij+b;
+
+         // Position of the destination level in its source interval (clamped weights clamp the result to the end levels)
+         #pragma omp simd
+         for(j=0;j<n;j++) {
+            o[j]=idx[p+j]*nij+b+j;
+            h[j]=src[o[j]+nij]-src[o[j]];
+            t[j]=w[p+j];
+         }
+
+         if (Options&ZRNEAREST_NEIGHBOUR) {
+            #pragma omp simd
+            for(j=0;j<n;j++) StateOut[p+j]=t[j]<0.5f?StateIn[o[j]]:StateIn[o[j]+nij];
+
+         } else if (Options&ZRLINEAR) {
+            #pragma omp simd private(y1,y2)
+            for(j=0;j<n;j++) {
+               y1=StateIn[o[j]]; y2=StateIn[o[j]+nij];
+               StateOut[p+j]=y1+(y2-y1)*t[j];
+            }
+
+         } else if (Options&ZRCUBIC_WITH_DERIV) {
+            // Cubic Hermite
+            #pragma omp simd private(y0,y1,y2,y3,tt,t2,t3)
+            for(j=0;j<n;j++) {
+               y1=StateIn[o[j]]; y2=StateIn[o[j]+nij];
+               y0=DerivIn[o[j]]; y3=DerivIn[o[j]+nij];
+               tt=t[j]; t2=tt*tt; t3=t2*tt;
+               StateOut[p+j]=(2.0f*t3-3.0f*t2+1.0f)*y1+(t3-2.0f*t2+tt)*h[j]*y0+(-2.0f*t3+3.0f*t2)*y2+(t3-t2)*h[j]*y3;
+            }
+            if (DerivOut) {
+               #pragma omp simd private(y0,y1,y2,y3,tt,t2)
+               for(j=0;j<n;j++) {
+                  y1=StateIn[o[j]]; y2=StateIn[o[j]+nij];
+                  y0=DerivIn[o[j]]; y3=DerivIn[o[j]+nij];
+                  tt=t[j]; t2=tt*tt;
+                  DerivOut[p+j]=h[j]!=0.0f?((6.0f*t2-6.0f*tt)*(y1-y2)/h[j]+(3.0f*t2-4.0f*tt+1.0f)*y0+(3.0f*t2-2.0f*tt)*y3):y0;
+               }
+            }
+
+         } else {
+            // Cubic Lagrange on 4 levels, linear on the end intervals
+            #pragma omp simd private(i,x,x0,x1,x2,x3,y0,y1,y2,y3,v,l)
+            for(j=0;j<n;j++) {
+               i=idx[p+j];
+               x1=src[o[j]]; x2=src[o[j]+nij];
+               y1=StateIn[o[j]]; y2=StateIn[o[j]+nij];
+               l=y1+(y2-y1)*t[j];
+
+               x0=src[o[j]-(i>0?nij:0)]; x3=src[o[j]+(i<ns-2?2*nij:nij)];
+               y0=StateIn[o[j]-(i>0?nij:0)]; y3=StateIn[o[j]+(i<ns-2?2*nij:nij)];
+               x=x1+t[j]*h[j];
+               v=y0*((x-x1)*(x-x2)*(x-x3))/((x0-x1)*(x0-x2)*(x0-x3))
+                +y1*((x-x0)*(x-x2)*(x-x3))/((x1-x0)*(x1-x2)*(x1-x3))
+                +y2*((x-x0)*(x-x1)*(x-x3))/((x2-x0)*(x2-x1)*(x2-x3))
+                +y3*((x-x0)*(x-x1)*(x-x2))/((x3-x0)*(x3-x1)*(x3-x2));
+               StateOut[p+j]=i>0 && i<ns-2?v:l;
+            }
+         }
+
+         if (lapse) {
+            // Extrapolate with the lapse rates beyond the column values
+            #pragma omp simd private(x,x0,x3,xlo,xhi,ylo,yhi,v)
+            for(j=0;j<n;j++) {
+               x=dst[p+j];
+               x0=src[b+j]; x3=src[(ns-1)*nij+b+j];
+               xlo=x0<x3?x0:x3;
+               xhi=x0<x3?x3:x0;
+               ylo=x0<x3?StateIn[b+j]:StateIn[(ns-1)*nij+b+j];
+               yhi=x0<x3?StateIn[(ns-1)*nij+b+j]:StateIn[b+j];
+               v=StateOut[p+j];
+               StateOut[p+j]=x<xlo?ylo+ExtrapGuideDown*(x-xlo):(x>xhi?yhi+ExtrapGuideUp*(x-xhi):v);
+            }
+            if (DerivOut) {
+               #pragma omp simd private(x,x0,x3,xlo,xhi)
+               for(j=0;j<n;j++) {
+                  x=dst[p+j];
+                  x0=src[b+j]; x3=src[(ns-1)*nij+b+j];
+                  xlo=x0<x3?x0:x3;
+                  xhi=x0<x3?x3:x0;
+                  DerivOut[p+j]=x<xlo?ExtrapGuideDown:(x>xhi?ExtrapGuideUp:DerivOut[p+j]);
+               }
+            }
+         }
+      }
+   }
+   return(1);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefInterp_Cube>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * But      : Get the cube of vertical levels of a vertical reference
+ *
+ * Parametres :
+ *  <ZRef>    : Vertical reference
+ *  <NIJ>     : 2D dimension
+ *  <Magl>    : Meter cube (TRUE) or log(p) cube (FALSE)
+ *  <Options> : Interpolator options
+ *
+ * Retour     : Cube of levels or NULL on error
+ *
+ * Remarques : A cube already provided in ZRef->PCube is used as is, otherwise
+ *             it comes from the shared cube cache (ZRef_CubeGet)
+ *
+ *----------------------------------------------------------------------------
+*/
+static float* ZRefInterp_Cube(TZRef *ZRef,int NIJ,int Magl,unsigned int Options) {
+
+   if (ZRef->PCube)
+      return(ZRef->PCube);
+
+   if (Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Getting %s cube\n",__func__,Magl?"meter":"pressure");
+   return(ZRef_CubeGet(ZRef,NIJ,Magl));
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefInterp_DefineOpt>
  * Creation : Janvier 2013 - J.P. Gauthier - CMC/CMOE
  *
  * But      : Define the set of grids to be used for the vertical interpolation.
@@ -123,6 +465,7 @@ int ZRefInterp_Free(TZRefInterp *Interp) {
  *  <ZRefSrc>    : Vertical grid of input points
  *  <NI>         : dimension of the horizontal grid in the Interpolation
  *  <NJ>         : other dimension of the horizontal grid in the Interpolation
+ *  <Options>    : Initial options of the interpolator (ZR*, ZRDEFAULT)
  *
  * Retour        :  ZRefInterp or NULL for Error
  *
@@ -133,9 +476,12 @@ int ZRefInterp_Free(TZRefInterp *Interp) {
  *             The determination of the location of each target level is completely
  *             independent of all the others.
  *
+ *             The interpolator holds its own options and does not use any global
+ *             state, so that many interpolators can be defined and used concurrently.
+ *
  *----------------------------------------------------------------------------
 */
-TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const int NJ) {
+TZRefInterp *ZRefInterp_DefineOpt(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const int NJ,const unsigned int Options) {
 
    TZRefInterp *interp;
    int          magl=0;
@@ -161,21 +507,21 @@ TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const
    interp->ZRefSrc=ZRefSrc;
    interp->ZRefDest=ZRefDest;
    interp->Indexes=NULL;
+   interp->Loc=NULL;
+   interp->PSrc=interp->PDest=NULL;
    interp->NIJ=NI*NJ;
-    
-   // Fortran default to global
-   FInterp=interp;
+   interp->Options=Options;
 
    // Check if source and destination are the same
    if (ZRefSrc->Type==ZRefDest->Type && ZRefSrc->LevelNb==ZRefDest->LevelNb && memcmp(ZRefSrc->Levels,ZRefDest->Levels,ZRefSrc->LevelNb*sizeof(float))==0) {
       interp->Same=1;
-      if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Same vertical reference\n",__func__);
+      if (Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Same vertical reference\n",__func__);
 
       return(interp);
    }
    interp->Same=0;
 
-   if (ZRefInterp_Options & ZRCHECKFLOAT) {
+   if (Options & ZRCHECKFLOAT) {
       // clear exception flags (plateforme specific) 
 #if defined(__GNUC__) || defined(IRIX)
       feclearexcept(FE_ALL_EXCEPT);
@@ -189,51 +535,12 @@ TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const
        (ZRefSrc->Type == LVL_GALCHEN)  || (ZRefSrc->Type == LVL_MASL)  || (ZRefSrc->Type == LVL_MAGL));
 
    // Create cubes of vertical levels ...
-   if (!ZRefSrc->PCube) {
-      ZRefSrc->PCube=(float*)malloc(interp->NIJ*ZRefSrc->LevelNb*sizeof(float));
-      if (!ZRefSrc->PCube) {
-         Lib_Log(APP_LIBEER,APP_ERROR,"%s: malloc failed for ZRefSrc->PCube\n",__func__);
-         ZRefInterp_Free(interp);
-         return(NULL);
-      }
-      if (magl) {
-         if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Calculating meter cube for ZRefSrc\n",__func__);
-         if (!ZRef_KCube2Meter(ZRefSrc,ZRefSrc->P0,interp->NIJ,ZRefSrc->PCube)) {
-            ZRefInterp_Free(interp);
-            return(NULL);
-         }
-      } else {
-         if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Calculating pressure cube for ZRefSrc\n",__func__);
-         if (!ZRef_KCube2Pressure(ZRefSrc,ZRefSrc->P0,ZRefSrc->P0LS,interp->NIJ,TRUE,ZRefSrc->PCube)) {
-            ZRefInterp_Free(interp);
-            return(NULL);
-         }
-      }
-   }
-   
-   if (!ZRefDest->PCube) {
-      ZRefDest->PCube=(float*)malloc(interp->NIJ*ZRefDest->LevelNb*sizeof(float));
-      if (!ZRefDest->PCube) {
-         Lib_Log(APP_LIBEER,APP_ERROR,"%s: malloc failed for ZRefDest->PCube\n",__func__);
-         ZRefInterp_Free(interp);
-         return(NULL);
-      }
-      if (magl) {
-         if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Calculating meter cube for ZRefDest\n",__func__);
-         if (!ZRef_KCube2Meter(ZRefDest,ZRefDest->P0,interp->NIJ,ZRefDest->PCube)) {
-            ZRefInterp_Free(interp);
-            return(NULL);
-         }
-      } else {
-         if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Calculating pressure cube for ZRefDest\n",__func__);
-         if (!ZRef_KCube2Pressure(ZRefDest,ZRefDest->P0,ZRefDest->P0LS,interp->NIJ,TRUE,ZRefDest->PCube)) {
-            ZRefInterp_Free(interp);
-            return(NULL);
-         }
-      }
+   if (!(interp->PSrc=ZRefInterp_Cube(ZRefSrc,interp->NIJ,magl,Options)) || !(interp->PDest=ZRefInterp_Cube(ZRefDest,interp->NIJ,magl,Options))) {
+      ZRefInterp_Free(interp);
+      return(NULL);
    }
    
-   if (ZRefInterp_Options & ZRCHECKFLOAT) {
+   if (Options & ZRCHECKFLOAT) {
       // Check for exception in the conversion (plateforme specific)
 #if defined(__GNUC__)  || defined(SGI)
       if (fetestexcept(FE_DIVBYZERO)) {
@@ -267,6 +574,15 @@ TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const
 #endif
    }
 
+   // Locate the destination levels once for all the variables
+   if (Options & ZRNATIVE) {
+      if (!(interp->Loc=ZRefLocator_New(interp->PSrc,ZRefSrc->LevelNb,interp->PDest,ZRefDest->LevelNb,interp->NIJ))) {
+         ZRefInterp_Free(interp);
+         return(NULL);
+      }
+      return(interp);
+   }
+
    // Calculate interpolation indexes
    interp->Indexes=(int*)malloc(interp->NIJ*ZRefDest->LevelNb*sizeof(int));
    if (!interp->Indexes) {
@@ -280,7 +596,7 @@ TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const
     * routines. The output is in Indexes.
     */
 #ifdef HAVE_RMN
-   (void)f77name(interp1d_findpos)(&interp->NIJ,&ZRefSrc->LevelNb,&ZRefDest->LevelNb,&interp->NIJ,&interp->NIJ,ZRefSrc->PCube,interp->Indexes,ZRefDest->PCube);
+   (void)f77name(interp1d_findpos)(&interp->NIJ,&ZRefSrc->LevelNb,&ZRefDest->LevelNb,&interp->NIJ,&interp->NIJ,interp->PSrc,interp->Indexes,interp->PDest);
 #else
    Lib_Log(APP_LIBEER,APP_ERROR,"%s: Need RMNLIB\n",__func__);
 #endif
@@ -289,7 +605,32 @@ TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const
 }
 
 /*----------------------------------------------------------------------------
- * Nom      : <ZRefInterp_SetOption>
+ * Nom      : <ZRefInterp_Define>
+ * Creation : Janvier 2013 - J.P. Gauthier - CMC/CMOE
+ *
+ * But      : Define the set of grids to be used for the vertical interpolation
+ *            with the global options (legacy interface).
+ *
+ * Parametres    :
+ *  <ZRefDest>   : Vertical grid of output points
+ *  <ZRefSrc>    : Vertical grid of input points
+ *  <NI>         : dimension of the horizontal grid in the Interpolation
+ *  <NJ>         : other dimension of the horizontal grid in the Interpolation
+ *
+ * Retour        :  ZRefInterp or NULL for Error
+ *
+ * Remarques : Wrapper over ZRefInterp_DefineOpt with the options set by
+ *             ZRefInterp_SetOption/ZRefInterp_SetOptioni. Not thread safe,
+ *             use ZRefInterp_DefineOpt for concurrent interpolators.
+ *----------------------------------------------------------------------------
+*/
+TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const int NJ) {
+
+   return(ZRefInterp_DefineOpt(ZRefDest,ZRefSrc,NI,NJ,ZRefInterp_Options));
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefInterp_SetOptionOf>
  * Creation : mai 2003 - S. Gaudreault - CMC/CMOE
  *
  * But      :  set options in for the Interpolation / extrapolation algorithms.
@@ -298,6 +639,7 @@ TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const
  *
  *
  * Parametres     :
+ *  <Interp>      : Interpolator
  *  <Option>      : string representing the option to be set:
  *                  "INTERP_DEGREE", "EXTRAP_DEGREE" or "VERBOSE"
  *  <Value>       : string representing the value to which the option is to
@@ -308,57 +650,127 @@ TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const
  *                  "CLAMPED" or "LAPSERATE"
  *                  Possible values for the option, "VERBOSE", are:
  *                  YES or NO
+ *                  Possible values for the option, "NATIVE", are:
+ *                  YES (C/OpenMP engine) or NO (RMNLIB interp1d routines), must
+ *                  match the engine of the interpolator definition
  *
- * Remarques :
+ * Retour         : Options of the interpolator
+ *
+ * Remarques : The options only apply to this interpolator
+ *             Setting INTERP_DEGREE or EXTRAP_DEGREE replaces the previous value
  *----------------------------------------------------------------------------
 */
-int ZRefInterp_SetOption (const char *Option, const char *Value) {
+int ZRefInterp_SetOptionOf(TZRefInterp *Interp,const char *Option,const char *Value) {
+
+   if (!Interp)
+      return(0);
 
    if (strncmp (Option, "INTERP_DEGREE", 13) == 0) {
       if (strncmp (Value, "NEAREST", 7) == 0) {
-         ZRefInterp_Options |= ZRNEAREST_NEIGHBOUR;
+         Interp->Options = (Interp->Options & ~ZRINTERP_MASK) | ZRNEAREST_NEIGHBOUR;
       } else if (strncmp (Value, "LINEAR", 6) == 0) {
-         ZRefInterp_Options |= ZRLINEAR;
+         Interp->Options = (Interp->Options & ~ZRINTERP_MASK) | ZRLINEAR;
       } else if (strncmp (Value, "CUBICWITHDERIVS", 15) == 0) {
-         ZRefInterp_Options |= ZRCUBIC_WITH_DERIV;
+         Interp->Options = (Interp->Options & ~ZRINTERP_MASK) | ZRCUBIC_WITH_DERIV;
       } else if (strncmp (Value, "CUBIC", 5) == 0) {
-         ZRefInterp_Options |= ZRCUBIC_LAGRANGE;
+         Interp->Options = (Interp->Options & ~ZRINTERP_MASK) | ZRCUBIC_LAGRANGE;
       }
    } else if (strncmp (Option, "EXTRAP_DEGREE" ,13) == 0) {
       if (strncmp (Value, "CLAMPED", 7) == 0) {
-         ZRefInterp_Options |= ZRCLAMPED;
+         Interp->Options = (Interp->Options & ~ZREXTRAP_MASK) | ZRCLAMPED;
       } else if (strncmp (Value, "LAPSERATE", 9) == 0) {
-         ZRefInterp_Options |= ZRLAPSERATE;
+         Interp->Options = (Interp->Options & ~ZREXTRAP_MASK) | ZRLAPSERATE;
       }
    } else if (strncmp (Option, "VERBOSE", 7) == 0) {
       if (strncmp (Value, "YES", 3)  == 0) {
-         ZRefInterp_Options |= ZRVERBOSE;
+         Interp->Options |= ZRVERBOSE;
       } else {
-         ZRefInterp_Options &= ~ZRVERBOSE;
+         Interp->Options &= ~ZRVERBOSE;
       }
    } else if (strncmp (Option, "CHECKFLOAT", 10) == 0) {
-      ZRefInterp_Options |= ZRCHECKFLOAT;
+      Interp->Options |= ZRCHECKFLOAT;
+   } else if (strncmp (Option, "NATIVE", 6) == 0) {
+      if (strncmp (Value, "YES", 3)  == 0) {
+         Interp->Options |= ZRNATIVE;
+      } else {
+         Interp->Options &= ~ZRNATIVE;
+      }
    }
 
-   return (ZRefInterp_Options);
+   return(Interp->Options);
 }
 
 /*----------------------------------------------------------------------------
- * Nom      : <ZRefInterp_SetOptioni>
+ * Nom      : <ZRefInterp_SetOptioniOf>
  * Creation : mai 2003 - S. Gaudreault - CMC/CMOE
  *
  * But      :  set options in for the Interpolation / extrapolation algorithms.
- * The option and the value to which it is to be set are passed as 8 bits
+ * The option and the value to which it is to be set are passed as 
  * unsigned integer.
  *
  * Parametres     :
- *  <Option>      : 8 bit unsigned integer representing the value to
- *                  which the option is to be set.
+ *  <Interp>      : Interpolator
+ *  <Option>      : unsigned integer representing the value to
+ *                  which the option is to be set (ZR*).
+ *
+ * Retour         : Options of the interpolator
  *
  * Remarques :
  *----------------------------------------------------------------------------
 */
-int ZRefInterp_SetOptioni (const unsigned char Option) {
+int ZRefInterp_SetOptioniOf(TZRefInterp *Interp,const unsigned int Option) {
+
+   if (!Interp)
+      return(0);
+
+   return(Interp->Options|=Option);
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefInterp_SetOption>
+ * Creation : mai 2003 - S. Gaudreault - CMC/CMOE
+ *
+ * But      :  set the global options for the Interpolation / extrapolation
+ * algorithms (legacy interface).
+ *
+ * Parametres     :
+ *  <Option>      : string representing the option to be set (see ZRefInterp_SetOptionOf)
+ *  <Value>       : string representing the value to which the option is to
+ *                  be set (see ZRefInterp_SetOptionOf)
+ *
+ * Retour         : Global options
+ *
+ * Remarques : The options apply to the following ZRefInterp_Define, use
+ *             ZRefInterp_SetOptionOf for an interpolator already defined.
+ *             Not thread safe.
+ *----------------------------------------------------------------------------
+*/
+int ZRefInterp_SetOption(const char *Option,const char *Value) {
+
+   TZRefInterp interp={ .Options=ZRefInterp_Options };
+
+   return(ZRefInterp_Options=ZRefInterp_SetOptionOf(&interp,Option,Value));
+}
+
+/*----------------------------------------------------------------------------
+ * Nom      : <ZRefInterp_SetOptioni>
+ * Creation : mai 2003 - S. Gaudreault - CMC/CMOE
+ *
+ * But      :  set the global options for the Interpolation / extrapolation
+ * algorithms, passed as unsigned integer (legacy interface).
+ *
+ * Parametres     :
+ *  <Option>      : option to add (ZR*)
+ *
+ * Retour         : Global options
+ *
+ * Remarques : The options apply to the following ZRefInterp_Define, use
+ *             ZRefInterp_SetOptioniOf for an interpolator already defined.
+ *             Not thread safe.
+ *----------------------------------------------------------------------------
+*/
+int ZRefInterp_SetOptioni(const unsigned int Option) {
+
    return(ZRefInterp_Options|=Option);
 }
 
@@ -374,88 +786,113 @@ int ZRefInterp_SetOptioni (const unsigned char Option) {
  *  <derivOut>          : output array of the derivative
  *  <derivIn>           : input array of the derivative
  *  <extrapGuideDown>   : value used for extrapolating below the values of
- *                        the source grid (set in ZRefInterp_Define). The meaning
+ *                        the source grid (set in ZRefInterp_DefineOpt). The meaning
  *                        of these values depends on the selected
  *                        extrapolation method.
  *  <extrapGuideUp>     : value used for extrapolating above the values of
- *                        the source grid (set in ZRefInterp_Define). The meaning
+ *                        the source grid (set in ZRefInterp_DefineOpt). The meaning
  *                        of these values depends on the selected
  *                        extrapolation method.
  *
  * Retour         :  -1 : Error
  *
  * Remarques :
+ *    - Both engines return the same codes: 1 when done, 0 on error and also
+ *      with ZRCLAMPED (for compatibility with EzInterpv)
  *----------------------------------------------------------------------------
 */
 int ZRefInterp(TZRefInterp *Interp,float *stateOut,float *stateIn,float *derivOut,float *derivIn,float extrapGuideDown,float extrapGuideUp) {
 
-   int surf = Interp->NIJ;
-   int extrapEnable = 0;
+   unsigned int options;
+   int          surf,extrapEnable=0;
+
+   if (!Interp)
+      return(0);
+
+   options=Interp->Options;
+   surf=Interp->NIJ;
 
    if (Interp->Same) {
       memcpy(stateOut,stateIn,Interp->NIJ*Interp->ZRefDest->LevelNb*sizeof(float));
-      if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Same vertical reference, copying data (%ix%i)\n",__func__,Interp->NIJ,Interp->ZRefDest->LevelNb);
+      if (options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Same vertical reference, copying data (%ix%i)\n",__func__,Interp->NIJ,Interp->ZRefDest->LevelNb);
       return(1);
    }
 
    /* Assume that everything is set correctly */
-   if (!Interp->ZRefSrc || !Interp->ZRefDest || !Interp->ZRefSrc->PCube || !Interp->ZRefDest->PCube || !Interp->Indexes || (ZRefInterp_Options == 0x000)) {
+   if (!Interp->ZRefSrc || !Interp->ZRefDest || !Interp->PSrc || !Interp->PDest || !(options & (ZRNEAREST_NEIGHBOUR|ZRLINEAR|ZRCUBIC_WITH_DERIV|ZRCUBIC_LAGRANGE))) {
+      return(0);
+   }
+
+   // The positions are kept for the engine selected at definition
+   if ((options & ZRNATIVE)?!Interp->Loc:!Interp->Indexes) {
+      Lib_Log(APP_LIBEER,APP_ERROR,"%s: Interpolator was defined for the other engine (NATIVE option)\n",__func__);
       return(0);
    }
 
+   if (options & ZRNATIVE) {
+      if ((options & ZRCUBIC_WITH_DERIV) && !(options & (ZRNEAREST_NEIGHBOUR|ZRLINEAR)) && !derivIn) {
+         Lib_Log(APP_LIBEER,APP_ERROR,"%s: Cubic Interpolation with derivatives requested\n",__func__);
+         return(0);
+      }
+      ZRefInterp_Native(Interp,options,stateOut,stateIn,derivOut,derivIn,extrapGuideDown,extrapGuideUp);
+      if (options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Native interpolation completed\n",__func__);
+      // Same return code as the RMNLIB engine, which returns 0 for clamped extrapolation
+      return((options & ZRCLAMPED)?0:1);
+   }
+
 #ifdef HAVE_RMN
    /*
     * Interpolation
     * Setting extrapEnableDown andextrapEnableUp to .false.
     * yields 'clamped'
     */
-   if (ZRefInterp_Options & ZRNEAREST_NEIGHBOUR) {
+   if (options & ZRNEAREST_NEIGHBOUR) {
       (void)f77name(interp1d_nearestneighbour)(&surf,&Interp->ZRefSrc->LevelNb,&Interp->ZRefDest->LevelNb,&surf,&surf,
-         Interp->ZRefSrc->PCube,stateIn,derivIn,Interp->Indexes,Interp->ZRefDest->PCube,stateOut,derivOut,
+         Interp->PSrc,stateIn,derivIn,Interp->Indexes,Interp->PDest,stateOut,derivOut,
          &extrapEnable,&extrapEnable,&extrapGuideDown,&extrapGuideUp);
 
-   } else if (ZRefInterp_Options & ZRLINEAR) {
+   } else if (options & ZRLINEAR) {
       (void)f77name(interp1d_linear)(&surf,&Interp->ZRefSrc->LevelNb,&Interp->ZRefDest->LevelNb,&surf,&surf,
-         Interp->ZRefSrc->PCube,stateIn,derivIn,Interp->Indexes,Interp->ZRefDest->PCube,stateOut,derivOut,
+         Interp->PSrc,stateIn,derivIn,Interp->Indexes,Interp->PDest,stateOut,derivOut,
          &extrapEnable,&extrapEnable,&extrapGuideDown,&extrapGuideUp);
 
-   } else if (ZRefInterp_Options & ZRCUBIC_WITH_DERIV) {
+   } else if (options & ZRCUBIC_WITH_DERIV) {
       if ((derivIn == NULL) && (derivOut == NULL)) {
          Lib_Log(APP_LIBEER,APP_ERROR,"%s: Cubic Interpolation with derivatives requested\n",__func__);
          return(0);
       }
 
       (void)f77name(interp1d_cubicwithderivs)(&surf,&Interp->ZRefSrc->LevelNb,&Interp->ZRefDest->LevelNb,&surf,&surf,
-         Interp->ZRefSrc->PCube,stateIn,derivIn,Interp->Indexes,Interp->ZRefDest->PCube,stateOut,derivOut,
+         Interp->PSrc,stateIn,derivIn,Interp->Indexes,Interp->PDest,stateOut,derivOut,
          &extrapEnable,&extrapEnable,&extrapGuideDown,&extrapGuideUp);
 
-   } else if (ZRefInterp_Options & ZRCUBIC_LAGRANGE) {
+   } else if (options & ZRCUBIC_LAGRANGE) {
       (void)f77name(interp1d_cubiclagrange)(&surf,&Interp->ZRefSrc->LevelNb,&Interp->ZRefDest->LevelNb,&surf,&surf,
-         Interp->ZRefSrc->PCube,stateIn,derivIn,Interp->Indexes,Interp->ZRefDest->PCube,stateOut,derivOut,
+         Interp->PSrc,stateIn,derivIn,Interp->Indexes,Interp->PDest,stateOut,derivOut,
          &extrapEnable,&extrapEnable,&extrapGuideDown,&extrapGuideUp);
    } else {
       Lib_Log(APP_LIBEER,APP_ERROR,"%s: Unknown Interpolation algorithm\n",__func__);
       return(0);
    }
 
-   if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Interpolation completed\n",__func__);
+   if (options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Interpolation completed\n",__func__);
 
    /* Extrapolation */
-   if (ZRefInterp_Options & ZRCLAMPED) {
+   if (options & ZRCLAMPED) {
       /*
        * Do nothing. It has already been done during Interpolation.
        * This option exist for compatibility with EzInterpv
        */
       return 0;
 
-   } else if (ZRefInterp_Options & ZRLAPSERATE) {
+   } else if (options & ZRLAPSERATE) {
       extrapEnable = 1;
 
       (void)f77name(extrap1d_lapserate)(&surf,&Interp->ZRefSrc->LevelNb,&Interp->ZRefDest->LevelNb,&surf,&surf,
-         Interp->ZRefSrc->PCube,stateIn,derivIn,Interp->Indexes,Interp->ZRefDest->PCube,stateOut,derivOut,
+         Interp->PSrc,stateIn,derivIn,Interp->Indexes,Interp->PDest,stateOut,derivOut,
          &extrapEnable,&extrapEnable,&extrapGuideDown,&extrapGuideUp);
 
-      if (ZRefInterp_Options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Lapserate extrapolation completed\n",__func__);
+      if (options & ZRVERBOSE) Lib_Log(APP_LIBEER,APP_INFO,"%s: Lapserate extrapolation completed\n",__func__);
    }
 #else
    Lib_Log(APP_LIBEER,APP_ERROR,"%s: Need RMNLIB\n",__func__);
@@ -62,18 +62,50 @@
 //  check for float exception (will do nothing on SX6) 
 #define ZRCHECKFLOAT 0x080
 
+//  Use the native C/OpenMP engine instead of RMNLIB's interp1d
+#define ZRNATIVE     0x100
+
+//  Option masks and defaults
+#define ZRINTERP_MASK (ZRNEAREST_NEIGHBOUR|ZRLINEAR|ZRCUBIC_WITH_DERIV|ZRCUBIC_LAGRANGE)
+#define ZREXTRAP_MASK (ZRCLAMPED|ZRLAPSERATE)
+#ifdef HAVE_RMN
+#define ZRDEFAULT    0x000
+#else
+#define ZRDEFAULT    ZRNATIVE
+#endif
+
+// Vertical locator, bracketing source levels and weights of target levels for every column
+typedef struct TZRefLocator {
+   int           *Idx;                     // Lower source level of the interval (0 based, [k*NIJ+ij])
+   float         *W;                       // Linear weight of the upper source level (clamped to [0,1])
+   int           NS,ND;                    // Number of source and target levels
+   int           NIJ;                      // Number of columns
+} TZRefLocator;
+
 typedef struct TZRefInterp {
    TZRef         *ZRefSrc,*ZRefDest;       // Source and destination vertical references
-   int           *Indexes;                 // Interpolation array indices
+   int           *Indexes;                 // Interpolation array indices (RMNLIB engine)
+   TZRefLocator  *Loc;                     // Vertical locator (native engine)
+   float         *PSrc,*PDest;             // Cubes of levels (ZRef->PCube or shared cube cache)
    int           NIJ;                      // 2D dimensions
    int           Same;                     // Flag indicating source and destination are the same
+   unsigned int  Options;                  // Interpolation/extrapolation options (ZR*)
 } TZRefInterp;
 
+TZRefLocator *ZRefLocator_New(const float *restrict Src,int NS,const float *restrict Dest,int ND,int NIJ);
+void          ZRefLocator_Free(TZRefLocator *Loc);
+int           ZRefLocator_Apply(const TZRefLocator *Loc,float **Out,const float **In,int NVar);
+
 int          ZRefInterp_Free(TZRefInterp *Interp);
 void         ZRefInterp_Clear(TZRefInterp *Interp);
-TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const int NJ);
+TZRefInterp *ZRefInterp_DefineOpt(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const int NJ,const unsigned int Options);
 int          ZRefInterp(TZRefInterp *Interp,float *stateOut,float *stateIn,float *derivOut,float *derivIn,float extrapGuideDown,float extrapGuideUp);
+int          ZRefInterp_SetOptionOf(TZRefInterp *Interp,const char *Option,const char *Value);
+int          ZRefInterp_SetOptioniOf(TZRefInterp *Interp,const unsigned int Option);
+
+// Legacy interface, global options (not thread safe)
+TZRefInterp *ZRefInterp_Define(TZRef *ZRefDest,TZRef *ZRefSrc,const int NI,const int NJ);
 int          ZRefInterp_SetOption(const char *Option,const char *Value);
-int          ZRefInterp_SetOptioni(const unsigned char option);
+int          ZRefInterp_SetOptioni(const unsigned int Option);
 
 #endif
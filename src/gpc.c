@@ -38,6 +38,7 @@ Copyright: (C) 1997-2004, Advanced Interfaces Group,
 */
 
 #include "gpc.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <float.h>
 #include <math.h>
@@ -65,6 +66,8 @@ Copyright: (C) 1997-2004, Advanced Interfaces Group,
 
 #define INVERT_TRISTRIPS   FALSE
 
+#define POOL_CHUNK_SIZE    65536
+
 
 /*
 ===========================================================================
@@ -90,8 +93,8 @@ Copyright: (C) 1997-2004, Advanced Interfaces Group,
 
 #define NOT_RMAX(v, i, n)   (v[PREV_INDEX(i, n)].vertex.y > v[i].vertex.y)
 
-#define VERTEX(e,p,s,x,y)  {add_vertex(&((e)->outp[(p)]->v[(s)]), x, y); \
-                            (e)->outp[(p)]->active++;}
+#define VERTEX(l,e,p,s,x,y) {add_vertex(l, &((e)->outp[(p)]->v[(s)]), x, y); \
+                             (e)->outp[(p)]->active++;}
 
 #define P_EDGE(d,e,p,i,j)  {(d)= (e); \
                             do {(d)= (d)->prev;} while (!(d)->outp[(p)]); \
@@ -192,12 +195,42 @@ typedef struct lmt_shape            /* Local minima table                */
   struct lmt_shape   *next;         /* Pointer to next local minimum     */
 } lmt_node;
 
-typedef struct sbt_t_shape          /* Scanbeam tree                     */
+typedef struct sbt_e_shape          /* Scanbeam table entry              */
+{
+  double              y;            /* Scanbeam y value                  */
+  int                 order;        /* Insertion rank of the value       */
+} sb_entry;
+
+typedef struct sbt_t_shape          /* Unsorted scanbeam table           */
 {
-  double              y;            /* Scanbeam node y value             */
-  struct sbt_t_shape *less;         /* Pointer to nodes with lower y     */
-  struct sbt_t_shape *more;         /* Pointer to nodes with higher y    */
-} sb_tree;
+  sb_entry           *entry;        /* Recorded scanbeam values          */
+  int                 entries;      /* Number of recorded values         */
+  int                 size;         /* Allocated number of entries       */
+} sb_table;
+
+typedef enum                        /* Pooled node classes               */
+{
+  POOL_LMT,                         /* Local minima table nodes          */
+  POOL_IT,                          /* Intersection table nodes          */
+  POOL_ST,                          /* Sorted edge table nodes           */
+  POOL_POLYGON,                     /* Output contour / tristrip nodes   */
+  POOL_VERTEX,                      /* Output vertex nodes               */
+  POOL_CLASSES
+} pool_class;
+
+typedef union pc_shape              /* Node pool memory chunk header     */
+{
+  union pc_shape     *next;         /* Previously allocated chunk        */
+  double              align;        /* Force double alignment of nodes   */
+} pool_chunk;
+
+typedef struct pool_shape           /* Node pool of a clipping operation */
+{
+  pool_chunk         *chunk;        /* Chunks owned by the pool          */
+  char               *top;          /* Next free byte of current chunk   */
+  char               *end;          /* End of the current chunk          */
+  void               *free[POOL_CLASSES]; /* Released nodes per class    */
+} node_pool;
 
 typedef struct it_shape             /* Intersection table                */
 {
@@ -247,28 +280,66 @@ const h_state next_h_state[3][6]=
 ===========================================================================
 */
 
-static void reset_it(it_node **it)
+static void *pool_alloc(node_pool *pool, size_t size, pool_class pc)
 {
-  it_node *itn;
+  pool_chunk *chunk;
+  void       *node;
 
-  while (*it)
+  /* Recycle a released node of the same class first */
+  if ((node= pool->free[pc]))
   {
-    itn= (*it)->next;
-    FREE(*it);
-    *it= itn;
+    pool->free[pc]= *(void **)node;
+    return node;
+  }
+
+  /* Keep every node double aligned */
+  size= (size + sizeof(double) - 1) & ~(sizeof(double) - 1);
+  if (pool->top + size > pool->end)
+  {
+    /* Chain a new chunk in front of the previous ones */
+    MALLOC(chunk, POOL_CHUNK_SIZE, "pool chunk creation", pool_chunk);
+    chunk->next= pool->chunk;
+    pool->chunk= chunk;
+    pool->top= (char *)(chunk + 1);
+    pool->end= (char *)chunk + POOL_CHUNK_SIZE;
   }
+  node= pool->top;
+  pool->top+= size;
+  return node;
 }
 
 
-static void reset_lmt(lmt_node **lmt)
+static void pool_release(node_pool *pool, void *node, pool_class pc)
 {
-  lmt_node *lmtn;
+  /* Push the node on the free list of its class */
+  *(void **)node= pool->free[pc];
+  pool->free[pc]= node;
+}
+
 
-  while (*lmt)
+static void pool_destroy(node_pool *pool)
+{
+  pool_chunk *chunk;
+
+  while (pool->chunk)
+  {
+    chunk= pool->chunk->next;
+    FREE(pool->chunk);
+    pool->chunk= chunk;
+  }
+  pool->top= pool->end= NULL;
+}
+
+
+static void reset_it(node_pool *pool, it_node **it)
+{
+  it_node *itn;
+
+  while (*it)
   {
-    lmtn= (*lmt)->next;
-    FREE(*lmt);
-    *lmt= lmtn;
+    itn= (*it)->next;
+    pool_release(pool, *it, POOL_IT);
+    *it= itn;
   }
 }
 
@@ -320,14 +391,14 @@ static void insert_bound(edge_node **b, edge_node *e)
 }
 
 
-static edge_node **bound_list(lmt_node **lmt, double y)
+static edge_node **bound_list(node_pool *pool, lmt_node **lmt, double y)
 {
   lmt_node *existing_node;
 
   if (!*lmt)
   {
     /* Add node onto the tail end of the LMT */
-    MALLOC(*lmt, sizeof(lmt_node), "LMT insertion", lmt_node);
+    *lmt= (lmt_node *)pool_alloc(pool, sizeof(lmt_node), POOL_LMT);
     (*lmt)->y= y;
     (*lmt)->first_bound= NULL;
     (*lmt)->next= NULL;
@@ -338,7 +409,7 @@ static edge_node **bound_list(lmt_node **lmt, double y)
     {
       /* Insert a new LMT node before the current node */
       existing_node= *lmt;
-      MALLOC(*lmt, sizeof(lmt_node), "LMT insertion", lmt_node);
+      *lmt= (lmt_node *)pool_alloc(pool, sizeof(lmt_node), POOL_LMT);
       (*lmt)->y= y;
       (*lmt)->first_bound= NULL;
       (*lmt)->next= existing_node;
@@ -347,62 +418,50 @@ static edge_node **bound_list(lmt_node **lmt, double y)
     else
       if (y > (*lmt)->y)
         /* Head further up the LMT */
-        return bound_list(&((*lmt)->next), y);
+        return bound_list(pool, &((*lmt)->next), y);
       else
         /* Use this existing LMT node */
         return &((*lmt)->first_bound);
 }
 
 
-static void add_to_sbtree(int *entries, sb_tree **sbtree, double y)
+static void add_to_sbt(sb_table *sbt, double y)
 {
-  if (!*sbtree)
-  {
-    /* Add a new tree node here */
-    MALLOC(*sbtree, sizeof(sb_tree), "scanbeam tree insertion", sb_tree);
-    (*sbtree)->y= y;
-    (*sbtree)->less= NULL;
-    (*sbtree)->more= NULL;
-    (*entries)++;
-  }
-  else
-  {
-    if ((*sbtree)->y > y)
-    {
-    /* Head into the 'less' sub-tree */
-      add_to_sbtree(entries, &((*sbtree)->less), y);
-    }
-    else
-    {
-      if ((*sbtree)->y < y)
-      {
-        /* Head into the 'more' sub-tree */
-        add_to_sbtree(entries, &((*sbtree)->more), y);
-      }
-    }
-  }
+  /* Append the value, duplicates are removed once the table is sorted */
+  sbt->entry[sbt->entries].y= y;
+  sbt->entry[sbt->entries].order= sbt->entries;
+  sbt->entries++;
 }
 
 
-static void build_sbt(int *entries, double *sbt, sb_tree *sbtree)
+static int sbt_compare(const void *a, const void *b)
 {
-  if (sbtree->less)
-    build_sbt(entries, sbt, sbtree->less);
-  sbt[*entries]= sbtree->y;
-  (*entries)++;
-  if (sbtree->more)
-    build_sbt(entries, sbt, sbtree->more);
+  const sb_entry *ea= (const sb_entry *)a, *eb= (const sb_entry *)b;
+
+  /* Sort on y, equal values keep their insertion order */
+  if (ea->y < eb->y)
+    return -1;
+  if (ea->y > eb->y)
+    return 1;
+  return (ea->order > eb->order) - (ea->order < eb->order);
 }
 
 
-static void free_sbtree(sb_tree **sbtree)
+static int build_sbt(sb_table *sbt, double **table)
 {
-  if (*sbtree)
-  {
-    free_sbtree(&((*sbtree)->less));
-    free_sbtree(&((*sbtree)->more));
-    FREE(*sbtree);
-  }
+  int i, entries= 0;
+
+  qsort(sbt->entry, sbt->entries, sizeof(sb_entry), sbt_compare);
+
+  /* Keep the first recorded value of each run of equal values */
+  MALLOC(*table, sbt->entries * sizeof(double), "sbt creation", double);
+  for (i= 0; i < sbt->entries; i++)
+    if ((entries == 0) || ((*table)[entries - 1] < sbt->entry[i].y))
+      (*table)[entries++]= sbt->entry[i].y;
+
+  FREE(sbt->entry);
+  sbt->entries= sbt->size= 0;
+  return entries;
 }
 
 
@@ -422,9 +481,8 @@ static int count_optimal_vertices(gpc_vertex_list c)
 }
 
 
-static edge_node *build_lmt(lmt_node **lmt, sb_tree **sbtree,
-                            int *sbt_entries, gpc_polygon *p, int type,
-                            gpc_op op)
+static edge_node *build_lmt(node_pool *pool, lmt_node **lmt, sb_table *sbt,
+                            gpc_polygon *p, int type, gpc_op op)
 {
   int          c, i, min, max, num_edges, v, num_vertices;
   int          total_vertices= 0, e_index=0;
@@ -437,6 +495,18 @@ static edge_node *build_lmt(lmt_node **lmt, sb_tree **sbtree,
   MALLOC(edge_table, total_vertices * sizeof(edge_node),
          "edge table creation", edge_node);
 
+  /* Make room in the scanbeam table for every vertex in one go */
+  if (sbt->entries + total_vertices > sbt->size)
+  {
+    sbt->size= sbt->entries + total_vertices;
+    sbt->entry= (sb_entry *)realloc(sbt->entry, sbt->size * sizeof(sb_entry));
+    if (!sbt->entry)
+    {
+      fprintf(stderr, "gpc malloc failure: %s\n", "sbt creation");
+      exit(0);
+    }
+  }
+
   for (c= 0; c < p->num_contours; c++)
   {
     if (p->contour[c].num_vertices < 0)
@@ -455,8 +525,7 @@ static edge_node *build_lmt(lmt_node **lmt, sb_tree **sbtree,
           edge_table[num_vertices].vertex.y= p->contour[c].vertex[i].y;
 
           /* Record vertex in the scanbeam table */
-          add_to_sbtree(sbt_entries, sbtree,
-                        edge_table[num_vertices].vertex.y);
+          add_to_sbt(sbt, edge_table[num_vertices].vertex.y);
 
           num_vertices++;
         }
@@ -507,7 +576,7 @@ static edge_node *build_lmt(lmt_node **lmt, sb_tree **sbtree,
             e[i].bside[CLIP]= (op == GPC_DIFF) ? RIGHT : LEFT;
             e[i].bside[SUBJ]= LEFT;
           }
-          insert_bound(bound_list(lmt, edge_table[min].vertex.y), e);
+          insert_bound(bound_list(pool, lmt, edge_table[min].vertex.y), e);
         }
       }
 
@@ -557,7 +626,7 @@ static edge_node *build_lmt(lmt_node **lmt, sb_tree **sbtree,
             e[i].bside[CLIP]= (op == GPC_DIFF) ? RIGHT : LEFT;
             e[i].bside[SUBJ]= LEFT;
           }
-          insert_bound(bound_list(lmt, edge_table[min].vertex.y), e);
+          insert_bound(bound_list(pool, lmt, edge_table[min].vertex.y), e);
         }
       }
     }
@@ -615,7 +684,8 @@ static void add_edge_to_aet(edge_node **aet, edge_node *edge, edge_node *prev)
 }
 
 
-static void add_intersection(it_node **it, edge_node *edge0, edge_node *edge1,
+static void add_intersection(node_pool *pool, it_node **it,
+                             edge_node *edge0, edge_node *edge1,
                              double x, double y)
 {
   it_node *existing_node;
@@ -623,7 +693,7 @@ static void add_intersection(it_node **it, edge_node *edge0, edge_node *edge1,
   if (!*it)
   {
     /* Append a new node to the tail of the list */
-    MALLOC(*it, sizeof(it_node), "IT insertion", it_node);
+    *it= (it_node *)pool_alloc(pool, sizeof(it_node), POOL_IT);
     (*it)->ie[0]= edge0;
     (*it)->ie[1]= edge1;
     (*it)->point.x= x;
@@ -636,7 +706,7 @@ static void add_intersection(it_node **it, edge_node *edge0, edge_node *edge1,
     {
       /* Insert a new node mid-list */
       existing_node= *it;
-      MALLOC(*it, sizeof(it_node), "IT insertion", it_node);
+      *it= (it_node *)pool_alloc(pool, sizeof(it_node), POOL_IT);
       (*it)->ie[0]= edge0;
       (*it)->ie[1]= edge1;
       (*it)->point.x= x;
@@ -645,13 +715,13 @@ static void add_intersection(it_node **it, edge_node *edge0, edge_node *edge1,
     }
     else
       /* Head further down the list */
-      add_intersection(&((*it)->next), edge0, edge1, x, y);
+      add_intersection(pool, &((*it)->next), edge0, edge1, x, y);
   }
 }
 
 
-static void add_st_edge(st_node **st, it_node **it, edge_node *edge,
-                        double dy)
+static void add_st_edge(node_pool *pool, st_node **st, it_node **it,
+                        edge_node *edge, double dy)
 {
   st_node *existing_node;
   double   den, r, x, y;
@@ -659,7 +729,7 @@ static void add_st_edge(st_node **st, it_node **it, edge_node *edge,
   if (!*st)
   {
     /* Append edge onto the tail end of the ST */
-    MALLOC(*st, sizeof(st_node), "ST insertion", st_node);
+    *st= (st_node *)pool_alloc(pool, sizeof(st_node), POOL_ST);
     (*st)->edge= edge;
     (*st)->xb= edge->xb;
     (*st)->xt= edge->xt;
@@ -676,7 +746,7 @@ static void add_st_edge(st_node **st, it_node **it, edge_node *edge,
     {
       /* No intersection - insert edge here (before the ST edge) */
       existing_node= *st;
-      MALLOC(*st, sizeof(st_node), "ST insertion", st_node);
+      *st= (st_node *)pool_alloc(pool, sizeof(st_node), POOL_ST);
       (*st)->edge= edge;
       (*st)->xb= edge->xb;
       (*st)->xt= edge->xt;
@@ -691,22 +761,23 @@ static void add_st_edge(st_node **st, it_node **it, edge_node *edge,
       y= r * dy;
 
       /* Insert the edge pointers and the intersection point in the IT */
-      add_intersection(it, (*st)->edge, edge, x, y);
+      add_intersection(pool, it, (*st)->edge, edge, x, y);
 
       /* Head further into the ST */
-      add_st_edge(&((*st)->prev), it, edge, dy);
+      add_st_edge(pool, &((*st)->prev), it, edge, dy);
     }
   }
 }
 
 
-static void build_intersection_table(it_node **it, edge_node *aet, double dy)
+static void build_intersection_table(node_pool *pool, it_node **it,
+                                     edge_node *aet, double dy)
 {
   st_node   *st, *stp;
   edge_node *edge;
 
   /* Build intersection table for the current scanbeam */
-  reset_it(it);
+  reset_it(pool, it);
   st= NULL;
 
   /* Process each AET edge */
@@ -714,19 +785,19 @@ static void build_intersection_table(it_node **it, edge_node *aet, double dy)
   {
     if ((edge->bstate[ABOVE] == BUNDLE_HEAD) ||
          edge->bundle[ABOVE][CLIP] || edge->bundle[ABOVE][SUBJ])
-      add_st_edge(&st, it, edge, dy);
+      add_st_edge(pool, &st, it, edge, dy);
   }
 
   /* Free the sorted edge table */
   while (st)
   {
     stp= st->prev;
-    FREE(st);
+    pool_release(pool, st, POOL_ST);
     st= stp;
   }
 }
 
-static int count_contours(polygon_node *polygon)
+static int count_contours(node_pool *pool, polygon_node *polygon)
 {
   int          nc, nv;
   vertex_node *v, *nextv;
@@ -751,7 +822,7 @@ static int count_contours(polygon_node *polygon)
         for (v= polygon->proxy->v[LEFT]; v; v= nextv)
         {
           nextv= v->next;
-          FREE(v);
+          pool_release(pool, v, POOL_VERTEX);
         }
         polygon->active= 0;
       }
@@ -760,12 +831,12 @@ static int count_contours(polygon_node *polygon)
 }
 
 
-static void add_left(polygon_node *p, double x, double y)
+static void add_left(node_pool *pool, polygon_node *p, double x, double y)
 {
   vertex_node *nv;
 
   /* Create a new vertex node and set its fields */
-  MALLOC(nv, sizeof(vertex_node), "vertex node creation", vertex_node);
+  nv= (vertex_node *)pool_alloc(pool, sizeof(vertex_node), POOL_VERTEX);
   nv->x= x;
   nv->y= y;
 
@@ -804,12 +875,12 @@ static void merge_left(polygon_node *p, polygon_node *q, polygon_node *list)
 }
 
 
-static void add_right(polygon_node *p, double x, double y)
+static void add_right(node_pool *pool, polygon_node *p, double x, double y)
 {
   vertex_node *nv;
 
   /* Create a new vertex node and set its fields */
-  MALLOC(nv, sizeof(vertex_node), "vertex node creation", vertex_node);
+  nv= (vertex_node *)pool_alloc(pool, sizeof(vertex_node), POOL_VERTEX);
   nv->x= x;
   nv->y= y;
   nv->next= NULL;
@@ -848,7 +919,7 @@ static void merge_right(polygon_node *p, polygon_node *q, polygon_node *list)
 }
 
 
-static void add_local_min(polygon_node **p, edge_node *edge,
+static void add_local_min(node_pool *pool, polygon_node **p, edge_node *edge,
                           double x, double y)
 {
   polygon_node *existing_min;
@@ -856,10 +927,10 @@ static void add_local_min(polygon_node **p, edge_node *edge,
 
   existing_min= *p;
 
-  MALLOC(*p, sizeof(polygon_node), "polygon node creation", polygon_node);
+  *p= (polygon_node *)pool_alloc(pool, sizeof(polygon_node), POOL_POLYGON);
 
   /* Create a new vertex node and set its fields */
-  MALLOC(nv, sizeof(vertex_node), "vertex node creation", vertex_node);
+  nv= (vertex_node *)pool_alloc(pool, sizeof(vertex_node), POOL_VERTEX);
   nv->x= x;
   nv->y= y;
   nv->next= NULL;
@@ -889,37 +960,37 @@ static int count_tristrips(polygon_node *tn)
 }
 
 
-static void add_vertex(vertex_node **t, double x, double y)
+static void add_vertex(node_pool *pool, vertex_node **t, double x, double y)
 {
   if (!(*t))
   {
-    MALLOC(*t, sizeof(vertex_node), "tristrip vertex creation", vertex_node);
+    *t= (vertex_node *)pool_alloc(pool, sizeof(vertex_node), POOL_VERTEX);
     (*t)->x= x;
     (*t)->y= y;
     (*t)->next= NULL;
   }
   else
     /* Head further down the list */
-    add_vertex(&((*t)->next), x, y);
+    add_vertex(pool, &((*t)->next), x, y);
 }
 
 
-static void new_tristrip(polygon_node **tn, edge_node *edge,
+static void new_tristrip(node_pool *pool, polygon_node **tn, edge_node *edge,
                          double x, double y)
 {
   if (!(*tn))
   {
-    MALLOC(*tn, sizeof(polygon_node), "tristrip node creation", polygon_node);
+    *tn= (polygon_node *)pool_alloc(pool, sizeof(polygon_node), POOL_POLYGON);
     (*tn)->next= NULL;
     (*tn)->v[LEFT]= NULL;
     (*tn)->v[RIGHT]= NULL;
     (*tn)->active= 1;
-    add_vertex(&((*tn)->v[LEFT]), x, y);
+    add_vertex(pool, &((*tn)->v[LEFT]), x, y);
     edge->outp[ABOVE]= *tn;
   }
   else
     /* Head further down the list */
-    new_tristrip(&((*tn)->next), edge, x, y);
+    new_tristrip(pool, &((*tn)->next), edge, x, y);
 }
 
 
@@ -1117,13 +1188,14 @@ void gpc_add_contour(gpc_polygon *p, gpc_vertex_list *new_contour, int hole)
 void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
                       gpc_polygon *result)
 {
-  sb_tree       *sbtree= NULL;
+  node_pool      pool= {NULL, NULL, NULL, {NULL}};
+  sb_table       sbtable= {NULL, 0, 0};
   it_node       *it= NULL, *intersect;
   edge_node     *edge, *prev_edge, *next_edge, *succ_edge, *e0, *e1;
   edge_node     *aet= NULL, *c_heap= NULL, *s_heap= NULL;
   lmt_node      *lmt= NULL, *local_min;
-  polygon_node  *out_poly= NULL, *p, *q, *poly, *npoly, *cf= NULL;
-  vertex_node   *vtx, *nv;
+  polygon_node  *out_poly= NULL, *p, *q, *poly, *cf= NULL;
+  vertex_node   *vtx;
   h_state        horiz[2];
   int            in[2], exists[2], parity[2]= {LEFT, LEFT};
   int            c, v, contributing, search, scanbeam= 0, sbt_entries= 0;
@@ -1148,9 +1220,9 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
 
   /* Build LMT */
   if (subj->num_contours > 0)
-    s_heap= build_lmt(&lmt, &sbtree, &sbt_entries, subj, SUBJ, op);
+    s_heap= build_lmt(&pool, &lmt, &sbtable, subj, SUBJ, op);
   if (clip->num_contours > 0)
-    c_heap= build_lmt(&lmt, &sbtree, &sbt_entries, clip, CLIP, op);
+    c_heap= build_lmt(&pool, &lmt, &sbtable, clip, CLIP, op);
 
   /* Return a NULL result if no contours contribute */
   if (lmt == NULL)
@@ -1158,17 +1230,15 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
     result->num_contours= 0;
     result->hole= NULL;
     result->contour= NULL;
-    reset_lmt(&lmt);
+    pool_destroy(&pool);
+    FREE(sbtable.entry);
     FREE(s_heap);
     FREE(c_heap);
     return;
   }
 
-  /* Build scanbeam table from scanbeam tree */
-  MALLOC(sbt, sbt_entries * sizeof(double), "sbt creation", double);
-  build_sbt(&scanbeam, sbt, sbtree);
-  scanbeam= 0;
-  free_sbtree(&sbtree);
+  /* Sort the scanbeam table and drop its duplicate values */
+  sbt_entries= build_sbt(&sbtable, &sbt);
 
   /* Allow pointer re-use without causing memory leak */
   if (subj == result)
@@ -1332,28 +1402,28 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           {
           case EMN:
           case IMN:
-            add_local_min(&out_poly, edge, xb, yb);
+            add_local_min(&pool, &out_poly, edge, xb, yb);
             px= xb;
             cf= edge->outp[ABOVE];
             break;
           case ERI:
             if (xb != px)
             {
-              add_right(cf, xb, yb);
+              add_right(&pool, cf, xb, yb);
               px= xb;
             }
             edge->outp[ABOVE]= cf;
             cf= NULL;
             break;
           case ELI:
-            add_left(edge->outp[BELOW], xb, yb);
+            add_left(&pool, edge->outp[BELOW], xb, yb);
             px= xb;
             cf= edge->outp[BELOW];
             break;
           case EMX:
             if (xb != px)
             {
-              add_left(cf, xb, yb);
+              add_left(&pool, cf, xb, yb);
               px= xb;
             }
             merge_right(cf, edge->outp[BELOW], out_poly);
@@ -1362,14 +1432,14 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case ILI:
             if (xb != px)
             {
-              add_left(cf, xb, yb);
+              add_left(&pool, cf, xb, yb);
               px= xb;
             }
             edge->outp[ABOVE]= cf;
             cf= NULL;
             break;
           case IRI:
-            add_right(edge->outp[BELOW], xb, yb);
+            add_right(&pool, edge->outp[BELOW], xb, yb);
             px= xb;
             cf= edge->outp[BELOW];
             edge->outp[BELOW]= NULL;
@@ -1377,7 +1447,7 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case IMX:
             if (xb != px)
             {
-              add_right(cf, xb, yb);
+              add_right(&pool, cf, xb, yb);
               px= xb;
             }
             merge_left(cf, edge->outp[BELOW], out_poly);
@@ -1387,34 +1457,34 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case IMM:
             if (xb != px)
 	    {
-              add_right(cf, xb, yb);
+              add_right(&pool, cf, xb, yb);
               px= xb;
 	    }
             merge_left(cf, edge->outp[BELOW], out_poly);
             edge->outp[BELOW]= NULL;
-            add_local_min(&out_poly, edge, xb, yb);
+            add_local_min(&pool, &out_poly, edge, xb, yb);
             cf= edge->outp[ABOVE];
             break;
           case EMM:
             if (xb != px)
 	    {
-              add_left(cf, xb, yb);
+              add_left(&pool, cf, xb, yb);
               px= xb;
 	    }
             merge_right(cf, edge->outp[BELOW], out_poly);
             edge->outp[BELOW]= NULL;
-            add_local_min(&out_poly, edge, xb, yb);
+            add_local_min(&pool, &out_poly, edge, xb, yb);
             cf= edge->outp[ABOVE];
             break;
           case LED:
             if (edge->bot.y == yb)
-              add_left(edge->outp[BELOW], xb, yb);
+              add_left(&pool, edge->outp[BELOW], xb, yb);
             edge->outp[ABOVE]= edge->outp[BELOW];
             px= xb;
             break;
           case RED:
             if (edge->bot.y == yb)
-              add_right(edge->outp[BELOW], xb, yb);
+              add_right(&pool, edge->outp[BELOW], xb, yb);
             edge->outp[ABOVE]= edge->outp[BELOW];
             px= xb;
             break;
@@ -1465,7 +1535,7 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
     {
       /* === SCANBEAM INTERIOR PROCESSING ============================== */
 
-      build_intersection_table(&it, aet, dy);
+      build_intersection_table(&pool, &it, aet, dy);
 
       /* Process each node in the intersection table */
       for (intersect= it; intersect; intersect= intersect->next)
@@ -1532,13 +1602,13 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           switch (vclass)
           {
           case EMN:
-            add_local_min(&out_poly, e0, ix, iy);
+            add_local_min(&pool, &out_poly, e0, ix, iy);
             e1->outp[ABOVE]= e0->outp[ABOVE];
             break;
           case ERI:
             if (p)
             {
-              add_right(p, ix, iy);
+              add_right(&pool, p, ix, iy);
               e1->outp[ABOVE]= p;
               e0->outp[ABOVE]= NULL;
             }
@@ -1546,7 +1616,7 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case ELI:
             if (q)
             {
-              add_left(q, ix, iy);
+              add_left(&pool, q, ix, iy);
               e0->outp[ABOVE]= q;
               e1->outp[ABOVE]= NULL;
             }
@@ -1554,20 +1624,20 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case EMX:
             if (p && q)
             {
-              add_left(p, ix, iy);
+              add_left(&pool, p, ix, iy);
               merge_right(p, q, out_poly);
               e0->outp[ABOVE]= NULL;
               e1->outp[ABOVE]= NULL;
             }
             break;
           case IMN:
-            add_local_min(&out_poly, e0, ix, iy);
+            add_local_min(&pool, &out_poly, e0, ix, iy);
             e1->outp[ABOVE]= e0->outp[ABOVE];
             break;
           case ILI:
             if (p)
             {
-              add_left(p, ix, iy);
+              add_left(&pool, p, ix, iy);
               e1->outp[ABOVE]= p;
               e0->outp[ABOVE]= NULL;
             }
@@ -1575,7 +1645,7 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case IRI:
             if (q)
             {
-              add_right(q, ix, iy);
+              add_right(&pool, q, ix, iy);
               e0->outp[ABOVE]= q;
               e1->outp[ABOVE]= NULL;
             }
@@ -1583,7 +1653,7 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case IMX:
             if (p && q)
             {
-              add_right(p, ix, iy);
+              add_right(&pool, p, ix, iy);
               merge_left(p, q, out_poly);
               e0->outp[ABOVE]= NULL;
               e1->outp[ABOVE]= NULL;
@@ -1592,18 +1662,18 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case IMM:
             if (p && q)
             {
-              add_right(p, ix, iy);
+              add_right(&pool, p, ix, iy);
               merge_left(p, q, out_poly);
-              add_local_min(&out_poly, e0, ix, iy);
+              add_local_min(&pool, &out_poly, e0, ix, iy);
               e1->outp[ABOVE]= e0->outp[ABOVE];
             }
             break;
           case EMM:
             if (p && q)
             {
-              add_left(p, ix, iy);
+              add_left(&pool, p, ix, iy);
               merge_right(p, q, out_poly);
-              add_local_min(&out_poly, e0, ix, iy);
+              add_local_min(&pool, &out_poly, e0, ix, iy);
               e1->outp[ABOVE]= e0->outp[ABOVE];
             }
             break;
@@ -1700,7 +1770,7 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
   /* Generate result polygon from out_poly */
   result->contour= NULL;
   result->hole= NULL;
-  result->num_contours= count_contours(out_poly);
+  result->num_contours= count_contours(&pool, out_poly);
   if (result->num_contours > 0)
   {
     MALLOC(result->hole, result->num_contours
@@ -1708,10 +1778,10 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
     MALLOC(result->contour, result->num_contours
            * sizeof(gpc_vertex_list), "contour creation", gpc_vertex_list);
 
+    /* Contour and vertex nodes are reclaimed along with the pool */
     c= 0;
-    for (poly= out_poly; poly; poly= npoly)
+    for (poly= out_poly; poly; poly= poly->next)
     {
-      npoly= poly->next;
       if (poly->active)
       {
         result->hole[c]= poly->proxy->hole;
@@ -1721,31 +1791,19 @@ void gpc_polygon_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           "vertex creation", gpc_vertex);
 
         v= result->contour[c].num_vertices - 1;
-        for (vtx= poly->proxy->v[LEFT]; vtx; vtx= nv)
+        for (vtx= poly->proxy->v[LEFT]; vtx; vtx= vtx->next)
         {
-          nv= vtx->next;
           result->contour[c].vertex[v].x= vtx->x;
           result->contour[c].vertex[v].y= vtx->y;
-          FREE(vtx);
           v--;
         }
         c++;
       }
-      FREE(poly);
-    }
-  }
-  else
-  {
-    for (poly= out_poly; poly; poly= npoly)
-    {
-      npoly= poly->next;
-      FREE(poly);
     }
   }
 
   /* Tidy up */
-  reset_it(&it);
-  reset_lmt(&lmt);
+  pool_destroy(&pool);
   FREE(c_heap);
   FREE(s_heap);
   FREE(sbt);
@@ -1777,13 +1835,14 @@ void gpc_polygon_to_tristrip(gpc_polygon *s, gpc_tristrip *t)
 void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
                        gpc_tristrip *result)
 {
-  sb_tree       *sbtree= NULL;
+  node_pool      pool= {NULL, NULL, NULL, {NULL}};
+  sb_table       sbtable= {NULL, 0, 0};
   it_node       *it= NULL, *intersect;
   edge_node     *edge, *prev_edge, *next_edge, *succ_edge, *e0, *e1;
   edge_node     *aet= NULL, *c_heap= NULL, *s_heap= NULL, *cf;
   lmt_node      *lmt= NULL, *local_min;
-  polygon_node  *tlist= NULL, *tn, *tnn, *p, *q;
-  vertex_node   *lt, *ltn, *rt, *rtn;
+  polygon_node  *tlist= NULL, *tn, *p, *q;
+  vertex_node   *lt, *rt;
   h_state        horiz[2];
   vertex_type    cft;
   int            in[2], exists[2], parity[2]= {LEFT, LEFT};
@@ -1808,26 +1867,24 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
 
   /* Build LMT */
   if (subj->num_contours > 0)
-    s_heap= build_lmt(&lmt, &sbtree, &sbt_entries, subj, SUBJ, op);
+    s_heap= build_lmt(&pool, &lmt, &sbtable, subj, SUBJ, op);
   if (clip->num_contours > 0)
-    c_heap= build_lmt(&lmt, &sbtree, &sbt_entries, clip, CLIP, op);
+    c_heap= build_lmt(&pool, &lmt, &sbtable, clip, CLIP, op);
 
   /* Return a NULL result if no contours contribute */
   if (lmt == NULL)
   {
     result->num_strips= 0;
     result->strip= NULL;
-    reset_lmt(&lmt);
+    pool_destroy(&pool);
+    FREE(sbtable.entry);
     FREE(s_heap);
     FREE(c_heap);
     return;
   }
 
-  /* Build scanbeam table from scanbeam tree */
-  MALLOC(sbt, sbt_entries * sizeof(double), "sbt creation", double);
-  build_sbt(&scanbeam, sbt, sbtree);
-  scanbeam= 0;
-  free_sbtree(&sbtree);
+  /* Sort the scanbeam table and drop its duplicate values */
+  sbt_entries= build_sbt(&sbtable, &sbt);
 
   /* Invert clip polygon for difference operation */
   if (op == GPC_DIFF)
@@ -1984,23 +2041,23 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           switch (vclass)
           {
           case EMN:
-            new_tristrip(&tlist, edge, xb, yb);
+            new_tristrip(&pool, &tlist, edge, xb, yb);
             cf= edge;
             break;
           case ERI:
             edge->outp[ABOVE]= cf->outp[ABOVE];
             if (xb != cf->xb)
-              VERTEX(edge, ABOVE, RIGHT, xb, yb);
+              VERTEX(&pool, edge, ABOVE, RIGHT, xb, yb);
             cf= NULL;
             break;
           case ELI:
-            VERTEX(edge, BELOW, LEFT, xb, yb);
+            VERTEX(&pool, edge, BELOW, LEFT, xb, yb);
             edge->outp[ABOVE]= NULL;
             cf= edge;
             break;
           case EMX:
             if (xb != cf->xb)
-              VERTEX(edge, BELOW, RIGHT, xb, yb);
+              VERTEX(&pool, edge, BELOW, RIGHT, xb, yb);
             edge->outp[ABOVE]= NULL;
             cf= NULL;
             break;
@@ -2008,14 +2065,14 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
             if (cft == LED)
 	    {
               if (cf->bot.y != yb)
-                VERTEX(cf, BELOW, LEFT, cf->xb, yb);
-              new_tristrip(&tlist, cf, cf->xb, yb);
+                VERTEX(&pool, cf, BELOW, LEFT, cf->xb, yb);
+              new_tristrip(&pool, &tlist, cf, cf->xb, yb);
 	    }
             edge->outp[ABOVE]= cf->outp[ABOVE];
-            VERTEX(edge, ABOVE, RIGHT, xb, yb);
+            VERTEX(&pool, edge, ABOVE, RIGHT, xb, yb);
             break;
           case ILI:
-            new_tristrip(&tlist, edge, xb, yb);
+            new_tristrip(&pool, &tlist, edge, xb, yb);
             cf= edge;
             cft= ILI;
             break;
@@ -2023,33 +2080,33 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
             if (cft == LED)
 	    {
               if (cf->bot.y != yb)
-                VERTEX(cf, BELOW, LEFT, cf->xb, yb);
-              new_tristrip(&tlist, cf, cf->xb, yb);
+                VERTEX(&pool, cf, BELOW, LEFT, cf->xb, yb);
+              new_tristrip(&pool, &tlist, cf, cf->xb, yb);
 	    }
-            VERTEX(edge, BELOW, RIGHT, xb, yb);
+            VERTEX(&pool, edge, BELOW, RIGHT, xb, yb);
             edge->outp[ABOVE]= NULL;
             break;
           case IMX:
-            VERTEX(edge, BELOW, LEFT, xb, yb);
+            VERTEX(&pool, edge, BELOW, LEFT, xb, yb);
             edge->outp[ABOVE]= NULL;
             cft= IMX;
             break;
 	  case IMM:
-            VERTEX(edge, BELOW, LEFT, xb, yb);
+            VERTEX(&pool, edge, BELOW, LEFT, xb, yb);
             edge->outp[ABOVE]= cf->outp[ABOVE];
             if (xb != cf->xb)
-              VERTEX(cf, ABOVE, RIGHT, xb, yb);
+              VERTEX(&pool, cf, ABOVE, RIGHT, xb, yb);
             cf= edge;
             break;
           case EMM:
-            VERTEX(edge, BELOW, RIGHT, xb, yb);
+            VERTEX(&pool, edge, BELOW, RIGHT, xb, yb);
             edge->outp[ABOVE]= NULL;
-            new_tristrip(&tlist, edge, xb, yb);
+            new_tristrip(&pool, &tlist, edge, xb, yb);
             cf= edge;
             break;
           case LED:
             if (edge->bot.y == yb)
-              VERTEX(edge, BELOW, LEFT, xb, yb);
+              VERTEX(&pool, edge, BELOW, LEFT, xb, yb);
             edge->outp[ABOVE]= edge->outp[BELOW];
             cf= edge;
             cft= LED;
@@ -2060,21 +2117,21 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
 	    {
               if (cf->bot.y == yb)
 	      {
-                VERTEX(edge, BELOW, RIGHT, xb, yb);
+                VERTEX(&pool, edge, BELOW, RIGHT, xb, yb);
 	      }
               else
 	      {
                 if (edge->bot.y == yb)
 		{
-                  VERTEX(cf, BELOW, LEFT, cf->xb, yb);
-                  VERTEX(edge, BELOW, RIGHT, xb, yb);
+                  VERTEX(&pool, cf, BELOW, LEFT, cf->xb, yb);
+                  VERTEX(&pool, edge, BELOW, RIGHT, xb, yb);
 		}
 	      }
 	    }
             else
 	    {
-              VERTEX(edge, BELOW, RIGHT, xb, yb);
-              VERTEX(edge, ABOVE, RIGHT, xb, yb);
+              VERTEX(&pool, edge, BELOW, RIGHT, xb, yb);
+              VERTEX(&pool, edge, ABOVE, RIGHT, xb, yb);
 	    }
             cf= NULL;
             break;
@@ -2125,7 +2182,7 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
     {
       /* === SCANBEAM INTERIOR PROCESSING ============================== */
 
-      build_intersection_table(&it, aet, dy);
+      build_intersection_table(&pool, &it, aet, dy);
 
       /* Process each node in the intersection table */
       for (intersect= it; intersect; intersect= intersect->next)
@@ -2192,15 +2249,15 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           switch (vclass)
           {
           case EMN:
-            new_tristrip(&tlist, e1, ix, iy);
+            new_tristrip(&pool, &tlist, e1, ix, iy);
             e0->outp[ABOVE]= e1->outp[ABOVE];
             break;
           case ERI:
             if (p)
             {
               P_EDGE(prev_edge, e0, ABOVE, px, iy);
-              VERTEX(prev_edge, ABOVE, LEFT, px, iy);
-              VERTEX(e0, ABOVE, RIGHT, ix, iy);
+              VERTEX(&pool, prev_edge, ABOVE, LEFT, px, iy);
+              VERTEX(&pool, e0, ABOVE, RIGHT, ix, iy);
               e1->outp[ABOVE]= e0->outp[ABOVE];
               e0->outp[ABOVE]= NULL;
             }
@@ -2209,8 +2266,8 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
             if (q)
             {
               N_EDGE(next_edge, e1, ABOVE, nx, iy);
-              VERTEX(e1, ABOVE, LEFT, ix, iy);
-              VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
+              VERTEX(&pool, e1, ABOVE, LEFT, ix, iy);
+              VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
               e0->outp[ABOVE]= e1->outp[ABOVE];
               e1->outp[ABOVE]= NULL;
             }
@@ -2218,29 +2275,29 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case EMX:
             if (p && q)
             {
-              VERTEX(e0, ABOVE, LEFT, ix, iy);
+              VERTEX(&pool, e0, ABOVE, LEFT, ix, iy);
               e0->outp[ABOVE]= NULL;
               e1->outp[ABOVE]= NULL;
             }
             break;
           case IMN:
             P_EDGE(prev_edge, e0, ABOVE, px, iy);
-            VERTEX(prev_edge, ABOVE, LEFT, px, iy);
+            VERTEX(&pool, prev_edge, ABOVE, LEFT, px, iy);
             N_EDGE(next_edge, e1, ABOVE, nx, iy);
-            VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
-            new_tristrip(&tlist, prev_edge, px, iy);
+            VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
+            new_tristrip(&pool, &tlist, prev_edge, px, iy);
             e1->outp[ABOVE]= prev_edge->outp[ABOVE];
-            VERTEX(e1, ABOVE, RIGHT, ix, iy);
-            new_tristrip(&tlist, e0, ix, iy);
+            VERTEX(&pool, e1, ABOVE, RIGHT, ix, iy);
+            new_tristrip(&pool, &tlist, e0, ix, iy);
             next_edge->outp[ABOVE]= e0->outp[ABOVE];
-            VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
+            VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
             break;
           case ILI:
             if (p)
             {
-              VERTEX(e0, ABOVE, LEFT, ix, iy);
+              VERTEX(&pool, e0, ABOVE, LEFT, ix, iy);
               N_EDGE(next_edge, e1, ABOVE, nx, iy);
-              VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
+              VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
               e1->outp[ABOVE]= e0->outp[ABOVE];
               e0->outp[ABOVE]= NULL;
             }
@@ -2248,9 +2305,9 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case IRI:
             if (q)
             {
-              VERTEX(e1, ABOVE, RIGHT, ix, iy);
+              VERTEX(&pool, e1, ABOVE, RIGHT, ix, iy);
               P_EDGE(prev_edge, e0, ABOVE, px, iy);
-              VERTEX(prev_edge, ABOVE, LEFT, px, iy);
+              VERTEX(&pool, prev_edge, ABOVE, LEFT, px, iy);
               e0->outp[ABOVE]= e1->outp[ABOVE];
               e1->outp[ABOVE]= NULL;
             }
@@ -2258,41 +2315,41 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
           case IMX:
             if (p && q)
             {
-              VERTEX(e0, ABOVE, RIGHT, ix, iy);
-              VERTEX(e1, ABOVE, LEFT, ix, iy);
+              VERTEX(&pool, e0, ABOVE, RIGHT, ix, iy);
+              VERTEX(&pool, e1, ABOVE, LEFT, ix, iy);
               e0->outp[ABOVE]= NULL;
               e1->outp[ABOVE]= NULL;
               P_EDGE(prev_edge, e0, ABOVE, px, iy);
-              VERTEX(prev_edge, ABOVE, LEFT, px, iy);
-              new_tristrip(&tlist, prev_edge, px, iy);
+              VERTEX(&pool, prev_edge, ABOVE, LEFT, px, iy);
+              new_tristrip(&pool, &tlist, prev_edge, px, iy);
               N_EDGE(next_edge, e1, ABOVE, nx, iy);
-              VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
+              VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
               next_edge->outp[ABOVE]= prev_edge->outp[ABOVE];
-              VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
+              VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
             }
             break;
           case IMM:
             if (p && q)
             {
-              VERTEX(e0, ABOVE, RIGHT, ix, iy);
-              VERTEX(e1, ABOVE, LEFT, ix, iy);
+              VERTEX(&pool, e0, ABOVE, RIGHT, ix, iy);
+              VERTEX(&pool, e1, ABOVE, LEFT, ix, iy);
               P_EDGE(prev_edge, e0, ABOVE, px, iy);
-              VERTEX(prev_edge, ABOVE, LEFT, px, iy);
-              new_tristrip(&tlist, prev_edge, px, iy);
+              VERTEX(&pool, prev_edge, ABOVE, LEFT, px, iy);
+              new_tristrip(&pool, &tlist, prev_edge, px, iy);
               N_EDGE(next_edge, e1, ABOVE, nx, iy);
-              VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
+              VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
               e1->outp[ABOVE]= prev_edge->outp[ABOVE];
-              VERTEX(e1, ABOVE, RIGHT, ix, iy);
-              new_tristrip(&tlist, e0, ix, iy);
+              VERTEX(&pool, e1, ABOVE, RIGHT, ix, iy);
+              new_tristrip(&pool, &tlist, e0, ix, iy);
               next_edge->outp[ABOVE]= e0->outp[ABOVE];
-              VERTEX(next_edge, ABOVE, RIGHT, nx, iy);
+              VERTEX(&pool, next_edge, ABOVE, RIGHT, nx, iy);
             }
             break;
           case EMM:
             if (p && q)
             {
-              VERTEX(e0, ABOVE, LEFT, ix, iy);
-              new_tristrip(&tlist, e1, ix, iy);
+              VERTEX(&pool, e0, ABOVE, LEFT, ix, iy);
+              new_tristrip(&pool, &tlist, e1, ix, iy);
               e0->outp[ABOVE]= e1->outp[ABOVE];
             }
             break;
@@ -2394,14 +2451,13 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
     MALLOC(result->strip, result->num_strips * sizeof(gpc_vertex_list),
            "tristrip list creation", gpc_vertex_list);
 
+    /* Tristrip and vertex nodes are reclaimed along with the pool */
     s= 0;
-    for (tn= tlist; tn; tn= tnn)
+    for (tn= tlist; tn; tn= tn->next)
     {
-      tnn= tn->next;
-
       if (tn->active > 2)
       {
-        /* Valid tristrip: copy the vertices and free the heap */
+        /* Valid tristrip: copy the vertices */
         result->strip[s].num_vertices= tn->active;
         MALLOC(result->strip[s].vertex, tn->active * sizeof(gpc_vertex),
                "tristrip creation", gpc_vertex);
@@ -2420,46 +2476,26 @@ void gpc_tristrip_clip(gpc_op op, gpc_polygon *subj, gpc_polygon *clip,
         {
           if (lt)
           {
-            ltn= lt->next;
             result->strip[s].vertex[v].x= lt->x;
             result->strip[s].vertex[v].y= lt->y;
             v++;
-            FREE(lt);
-            lt= ltn;
+            lt= lt->next;
           }
           if (rt)
           {
-            rtn= rt->next;
             result->strip[s].vertex[v].x= rt->x;
             result->strip[s].vertex[v].y= rt->y;
             v++;
-            FREE(rt);
-            rt= rtn;
+            rt= rt->next;
           }
         }
         s++;
       }
-      else
-      {
-        /* Invalid tristrip: just free the heap */
-        for (lt= tn->v[LEFT]; lt; lt= ltn)
-        {
-          ltn= lt->next;
-          FREE(lt);
-        }
-        for (rt= tn->v[RIGHT]; rt; rt=rtn)
-        {
-          rtn= rt->next;
-          FREE(rt);
-        }
-      }
-      FREE(tn);
     }
   }
 
   /* Tidy up */
-  reset_it(&it);
-  reset_lmt(&lmt);
+  pool_destroy(&pool);
   FREE(c_heap);
   FREE(s_heap);
   FREE(sbt);
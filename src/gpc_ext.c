@@ -1,6 +1,9 @@
 #include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include "gpc_ext.h"
+#include "OMP_Utils.h"
 
 /*----------------------------------------------------------------------------
  * Nom      : <gpce_vect_proj_vect>
@@ -870,24 +873,25 @@ int gpce_poly_split_tile(const gpc_polygon *restrict Poly,const int MaxPoints,gp
       free(polys);
    } else if( gpce_get_num_vertices(Poly) >= MaxPoints ) { // Check if we need to split the polygon again
       gpc_polygon    clip0,clip1,res;
-      gpce_envelope  penv;
+      gpce_envelope  penv,env0,env1;
 
       // Get the exterior envelope of the polygon
       gpce_get_envelope(Poly,&penv);
 
       // Check whether we should split the polygon vertically (X) or horizontally (Y)
+      env0 = env1 = penv;
       if( penv.max.x-penv.min.x >= penv.max.y-penv.min.y ) {
          // Bigger extent in X, split vertically
-         double x = (penv.min.x+penv.max.x)/2.0;
-         clip0 = GPCE_MK_RECT2(penv.min.x,penv.min.y,x,penv.max.y);
-         clip1 = GPCE_MK_RECT2(x,penv.min.y,penv.max.x,penv.max.y);
+         env0.max.x = env1.min.x = (penv.min.x+penv.max.x)/2.0;
       } else {
          // Bigger extent in Y, split horizontally
-         double y = (penv.min.y+penv.max.y)/2.0;
-         clip0 = GPCE_MK_RECT2(penv.min.x,penv.min.y,penv.max.x,y);
-         clip1 = GPCE_MK_RECT2(penv.min.x,y,penv.max.x,penv.max.y);
+         env0.max.y = env1.min.y = (penv.min.y+penv.max.y)/2.0;
       }
 
+      // The rectangles must live in this scope, they are compound literals
+      clip0 = GPCE_MK_RECT2(env0.min.x,env0.min.y,env0.max.x,env0.max.y);
+      clip1 = GPCE_MK_RECT2(env1.min.x,env1.min.y,env1.max.x,env1.max.y);
+
       // Clip and process the first half
       gpc_polygon_clip(GPC_INT,(gpc_polygon*)Poly,&clip0,&res);
       if( !gpce_poly_split_tile(&res,MaxPoints,Split,NbSplit,PolyIdx,Size) ) {
@@ -948,7 +952,7 @@ int gpce_poly_split_tile(const gpc_polygon *restrict Poly,const int MaxPoints,gp
 
       // Set the polygon index to 0 (will only execute if we didn't have a multi-polygon initially, which mean we need to set everything to 0)
       if( PolyIdx && pidx<*NbSplit ) {
-         memset(*PolyIdx+pidx,0,*NbSplit-pidx);
+         memset(*PolyIdx+pidx,0,(*NbSplit-pidx)*sizeof(**PolyIdx));
       }
       return *NbSplit;
    }
@@ -962,6 +966,278 @@ err:
    return 0;
 }
 
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_poly_split_tile_mt>
+ * Creation : October 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Task parallel version of gpce_poly_split_tile
+ *
+ * Args :
+ *   <Poly>    : The (multi)polygon to split
+ *   <MaxPoints: The maximum number of vertices a polygon can have (it is split otherwise)
+ *   <Split>   : [OUT] List of generated polygons
+ *   <NbSplit> : [OUT] Number of polygon generated
+ *   <PolyIdx> : [OUT/OPT] Optional index indicating which polygon each splitted polygon
+ *               came from (only useful if the initial polygon is a multi-polygon)
+ *   <NThreads>: Number of threads to use (0 for all available)
+ *
+ * Return: The number of generated polygons (0 if error)
+ *
+ * Remarks :
+ *   - The two halves of a split and the parts of a multi-polygon are processed
+ *     as independent OpenMP tasks
+ *   - The ring envelopes are computed once per clipped piece and handed down
+ *     to gpce_explode_multi_polygon and to the next split
+ *   - The polygons are returned in the same order as gpce_poly_split_tile
+ *----------------------------------------------------------------------------
+ */
+typedef struct gpce_split_list {
+   gpc_polygon  *Polys;
+   unsigned int N,Size;
+} gpce_split_list;
+
+static int gpce_split_append(gpce_split_list *restrict List,gpc_polygon *restrict Polys,unsigned int N) {
+   gpc_polygon *tmp;
+
+   if( List->N+N > List->Size ) {
+      if( !(tmp=realloc(List->Polys,(List->N+N)*sizeof(*List->Polys))) ) {
+         fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+         return 0;
+      }
+      List->Polys = tmp;
+      List->Size = List->N+N;
+   }
+   memcpy(List->Polys+List->N,Polys,N*sizeof(*Polys));
+   List->N += N;
+   return 1;
+}
+
+static void gpce_split_free(gpce_split_list *restrict List) {
+   unsigned int i;
+
+   for(i=0; i<List->N; ++i)
+      gpc_free_polygon(&List->Polys[i]);
+   free(List->Polys);
+   *List = (gpce_split_list){NULL,0,0};
+}
+
+// Split Poly (and its ring envelopes Env) into List, both are consumed
+static int gpce_split_rec(gpc_polygon *restrict Poly,gpce_envelope *restrict Env,const int MaxPoints,gpce_split_list *restrict List) {
+   int ok=1,n,i,r;
+
+   if( !Env && Poly->num_contours && !(Env=gpce_get_envelopes(Poly)) ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      gpc_free_polygon(Poly);
+      return 0;
+   }
+
+   if( (n=gpce_get_num_polygon(Poly)) > 1 ) {
+      gpc_polygon     *polys;
+      gpce_envelope   **envs;
+      gpce_split_list *lists;
+
+      // Split the multi-polygon into single polygons, reusing the ring envelopes
+      if( gpce_explode_multi_polygon(Poly,Env,&polys,&envs)!=n || !polys || !(lists=calloc(n,sizeof(*lists))) ) {
+         fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+         gpc_free_polygon(Poly);
+         free(Env);
+         return 0;
+      }
+      gpc_free_polygon(Poly);
+      free(Env);
+
+      // Process those polygons as independent tasks
+      for(i=0; i<n; ++i) {
+         #pragma omp task firstprivate(i) shared(ok)
+         if( !gpce_split_rec(&polys[i],envs[i],MaxPoints,&lists[i]) ) {
+            OMP_ATOMIC_WRITE(ok = 0);
+         }
+      }
+      #pragma omp taskwait
+
+      // Gather the pieces in order
+      for(i=0; i<n; ++i) {
+         if( ok && (ok=gpce_split_append(List,lists[i].Polys,lists[i].N)) ) {
+            free(lists[i].Polys);
+         } else {
+            gpce_split_free(&lists[i]);
+         }
+      }
+      free(polys);
+      free(envs);
+      free(lists);
+   } else if( gpce_get_num_vertices(Poly) >= MaxPoints ) {
+      gpc_polygon     halves[2],clip[2];
+      gpce_envelope   penv=GPCE_MK_ENVELOPE(DBL_MAX,DBL_MAX,-DBL_MAX,-DBL_MAX),env0,env1;
+      gpce_split_list lists[2]={{NULL,0,0},{NULL,0,0}};
+      int             copy=0;
+
+      // Get the exterior envelope of the polygon from its ring envelopes
+      for(r=0; r<Poly->num_contours; ++r) {
+         if( !Poly->hole[r] ) {
+            penv.min.x = fmin(penv.min.x,Env[r].min.x);
+            penv.min.y = fmin(penv.min.y,Env[r].min.y);
+            penv.max.x = fmax(penv.max.x,Env[r].max.x);
+            penv.max.y = fmax(penv.max.y,Env[r].max.y);
+         }
+      }
+      free(Env);
+
+      // Check whether we should split the polygon vertically (X) or horizontally (Y)
+      env0 = env1 = penv;
+      if( penv.max.x-penv.min.x >= penv.max.y-penv.min.y ) {
+         // Bigger extent in X, split vertically
+         env0.max.x = env1.min.x = (penv.min.x+penv.max.x)/2.0;
+      } else {
+         // Bigger extent in Y, split horizontally
+         env0.max.y = env1.min.y = (penv.min.y+penv.max.y)/2.0;
+      }
+
+      // The rectangles must live in this scope, they are compound literals
+      clip[0] = GPCE_MK_RECT2(env0.min.x,env0.min.y,env0.max.x,env0.max.y);
+      clip[1] = GPCE_MK_RECT2(env1.min.x,env1.min.y,env1.max.x,env1.max.y);
+
+      // The clipper flags the contours of its operands while it runs, so concurrent halves get their own copy
+#ifdef _OPENMP
+      copy = omp_get_num_threads()>1;
+#endif
+      halves[0] = halves[1] = *Poly;
+      if( copy )
+         gpce_copy_polygon(&halves[1],Poly);
+
+      // Clip and process both halves
+      for(i=0; i<2; ++i) {
+         #pragma omp task firstprivate(i) shared(halves,clip,lists,ok,copy)
+         {
+            gpc_polygon res;
+
+            gpc_polygon_clip(GPC_INT,&halves[i],&clip[i],&res);
+            if( copy )
+               gpc_free_polygon(&halves[i]);
+            if( !gpce_split_rec(&res,NULL,MaxPoints,&lists[i]) ) {
+               OMP_ATOMIC_WRITE(ok = 0);
+            }
+         }
+      }
+      #pragma omp taskwait
+      if( !copy )
+         gpc_free_polygon(Poly);
+
+      for(i=0; i<2; ++i) {
+         if( ok && (ok=gpce_split_append(List,lists[i].Polys,lists[i].N)) ) {
+            free(lists[i].Polys);
+         } else {
+            gpce_split_free(&lists[i]);
+         }
+      }
+   } else if( Poly->num_contours ) {
+      free(Env);
+
+      // Make sure the outer ring is the first ring int the list
+      // Note: we are sure to have a polygon and not a multi-polygon, so there can only be one exterior ring
+      if( Poly->hole[0] ) {
+         gpc_vertex_list swp;
+
+         for(r=1; r<Poly->num_contours; ++r) {
+            if( !Poly->hole[r] ) {
+               swp = Poly->contour[0];
+               Poly->contour[0] = Poly->contour[r];
+               Poly->contour[r] = swp;
+               Poly->hole[0] = 0;
+               Poly->hole[r] = 1;
+               break;
+            }
+         }
+      }
+
+      // Hand the polygon over to the list
+      if( !(ok=gpce_split_append(List,Poly,1)) )
+         gpc_free_polygon(Poly);
+   } else {
+      free(Env);
+      gpc_free_polygon(Poly);
+   }
+
+   return ok;
+}
+
+int gpce_poly_split_tile_mt(const gpc_polygon *restrict Poly,const int MaxPoints,gpc_polygon **restrict Split,unsigned int *restrict NbSplit,unsigned int **restrict PolyIdx,int NThreads) {
+   gpc_polygon     *polys=NULL;
+   gpce_envelope   **envs=NULL;
+   gpce_split_list *lists=NULL,list={NULL,0,0};
+   unsigned int    j,k;
+   int             i,n,ok=1;
+
+   *Split = NULL;
+   *NbSplit = 0;
+   if( PolyIdx )
+      *PolyIdx = NULL;
+
+   // Split the multi-polygon into single polygons along with their ring envelopes
+   if( !(n=gpce_explode_multi_polygon(Poly,NULL,&polys,&envs)) || !polys )
+      return 0;
+
+   if( !(lists=calloc(n,sizeof(*lists))) ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      for(i=0; i<n; ++i) {
+         gpc_free_polygon(&polys[i]);
+         free(envs[i]);
+      }
+      free(polys);
+      free(envs);
+      return 0;
+   }
+
+   // Every part and every half is a task, any thread of the team can pick them up
+   #pragma omp parallel num_threads(NThreads>0?NThreads:omp_get_max_threads()) if(NThreads!=1)
+   #pragma omp single
+   {
+      for(i=0; i<n; ++i) {
+         #pragma omp task firstprivate(i) shared(ok)
+         if( !gpce_split_rec(&polys[i],envs[i],MaxPoints,&lists[i]) ) {
+            OMP_ATOMIC_WRITE(ok = 0);
+         }
+      }
+   }
+
+   // Gather the pieces in order, remembering which part they came from
+   for(i=0,k=0; i<n; ++i)
+      k += lists[i].N;
+   if( ok && k && (!(list.Polys=malloc(k*sizeof(*list.Polys))) || (PolyIdx && !(*PolyIdx=malloc(k*sizeof(**PolyIdx))))) ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      ok = 0;
+   }
+   for(i=0; i<n; ++i) {
+      if( ok ) {
+         if( PolyIdx ) {
+            for(j=0; j<lists[i].N; ++j)
+               (*PolyIdx)[list.N+j] = i;
+         }
+         memcpy(list.Polys+list.N,lists[i].Polys,lists[i].N*sizeof(*list.Polys));
+         list.N += lists[i].N;
+         free(lists[i].Polys);
+      } else {
+         gpce_split_free(&lists[i]);
+      }
+   }
+   free(polys);
+   free(envs);
+   free(lists);
+
+   if( !ok ) {
+      free(list.Polys);
+      if( PolyIdx ) {
+         free(*PolyIdx);
+         *PolyIdx = NULL;
+      }
+      return 0;
+   }
+
+   *Split = list.Polys;
+   *NbSplit = list.N;
+   return list.N;
+}
+
 /*----------------------------------------------------------------------------
  * Name     : <gpce_poly_wrap_split>
  * Creation : December 2023 - E. Legault-Ouellet - CMC/CMOE
@@ -1178,6 +1454,576 @@ void gpce_poly_wrap_clamp(gpc_polygon *restrict Poly,int Dim,double R0,double R1
    }
 }
 
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_concat_polygon>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Concatenate the contours of two polygons
+ *
+ * Args :
+ *   <Dest>    : [OUT] Resulting polygon
+ *   <PolyA>   : First polygon
+ *   <PolyB>   : Second polygon
+ *
+ * Return:
+ *
+ * Remarks : Only valid as a union when the polygons do not overlap
+ *----------------------------------------------------------------------------
+ */
+static void gpce_concat_polygon(gpc_polygon *restrict Dest,const gpc_polygon *restrict PolyA,const gpc_polygon *restrict PolyB) {
+   int r,n=PolyA->num_contours+PolyB->num_contours;
+
+   *Dest = GPC_NULL_POLY;
+   if( n ) {
+      Dest->contour = malloc(n*sizeof(*Dest->contour));
+      Dest->hole = malloc(n*sizeof(*Dest->hole));
+
+      for(r=0; r<PolyA->num_contours; ++r) {
+         gpce_copy_ring(Dest->contour+r,PolyA->contour+r);
+         Dest->hole[r] = PolyA->hole[r];
+      }
+      for(r=0; r<PolyB->num_contours; ++r) {
+         gpce_copy_ring(Dest->contour+PolyA->num_contours+r,PolyB->contour+r);
+         Dest->hole[PolyA->num_contours+r] = PolyB->hole[r];
+      }
+      Dest->num_contours = n;
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_polygon_clip>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Clip two polygons, skipping the clipper when their envelopes
+ *            are disjoint
+ *
+ * Args :
+ *   <Op>      : GPC operation
+ *   <PolyA>   : Subject polygon
+ *   <EnvA>    : [Optional] Exterior envelope of PolyA (will be calculated otherwise)
+ *   <PolyB>   : Clip polygon
+ *   <EnvB>    : [Optional] Exterior envelope of PolyB (will be calculated otherwise)
+ *   <Result>  : [OUT] Resulting polygon
+ *
+ * Return:
+ *
+ * Remarks :
+ *   - With disjoint envelopes, the intersection is empty, the difference is a
+ *     copy of PolyA and the union/xor is the concatenation of both polygons
+ *----------------------------------------------------------------------------
+ */
+void gpce_polygon_clip(gpc_op Op,const gpc_polygon *restrict PolyA,const gpce_envelope *restrict EnvA,const gpc_polygon *restrict PolyB,const gpce_envelope *restrict EnvB,gpc_polygon *restrict Result) {
+   gpce_envelope enva,envb;
+
+   if( PolyA->num_contours && PolyB->num_contours ) {
+      if( !EnvA ) {
+         gpce_get_envelope(PolyA,&enva);
+         EnvA = &enva;
+      }
+      if( !EnvB ) {
+         gpce_get_envelope(PolyB,&envb);
+         EnvB = &envb;
+      }
+
+      if( GPCE_ENV_DISJOINT(*EnvA,*EnvB) ) {
+         switch( Op ) {
+            case GPC_INT:  *Result = GPC_NULL_POLY;                break;
+            case GPC_DIFF: gpce_copy_polygon(Result,PolyA);       break;
+            default:       gpce_concat_polygon(Result,PolyA,PolyB); break;
+         }
+         return;
+      }
+   }
+
+   gpc_polygon_clip(Op,(gpc_polygon*)PolyA,(gpc_polygon*)PolyB,Result);
+}
+
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_polygon_cascade>
+ * Creation : Octobre 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Apply an operation over a list of polygons by tree reduction
+ *            (cascaded union)
+ *
+ * Args :
+ *   <Op>      : GPC operation (GPC_DIFF removes all the others from the first one)
+ *   <Polys>   : [IN|Freed] List of polygons
+ *   <N>       : Number of polygons
+ *   <Result>  : [OUT] Resulting polygon
+ *   <NThreads>: Number of threads (0 for the OpenMP default)
+ *
+ * Return: 1 if ok, 0 if error
+ *
+ * Remarks :
+ *   - The polygons are ordered along a Morton curve of their envelope centers
+ *     so that neighbours get merged first, then each reduction level merges
+ *     its pairs in parallel
+ *   - Pairs with disjoint envelopes are merged without clipping (gpce_polygon_clip)
+ *   - For GPC_DIFF, only the polygons touching the envelope of the first one are
+ *     merged before being removed from it
+ *   - The polygons of the list are freed (the list itself is not)
+ *----------------------------------------------------------------------------
+ */
+struct MortonE {
+   uint64_t code;
+   int      idx;
+};
+static int QSort_MortonE(const void *A,const void *B) {
+   const struct MortonE *a=A,*b=B;
+
+   return (a->code>b->code)-(a->code<b->code);
+}
+static uint64_t gpce_morton(double X,double Y) {
+   uint64_t x=(uint64_t)(X*65535.0),y=(uint64_t)(Y*65535.0),code=0;
+   int      b;
+
+   for(b=0; b<16; ++b) {
+      code |= ((x>>b)&1)<<(2*b) | ((y>>b)&1)<<(2*b+1);
+   }
+   return code;
+}
+int gpce_polygon_cascade(gpc_op Op,gpc_polygon *restrict Polys,int N,gpc_polygon *restrict Result,int NThreads) {
+   gpc_polygon    *polys=NULL,uni;
+   gpce_envelope  *env=NULL,genv,env0;
+   struct MortonE *order=NULL;
+   int            i,n,step,empty=0;
+   double         dx,dy;
+
+   *Result = GPC_NULL_POLY;
+   if( N<=0 )
+      return 1;
+
+   // The difference is the first polygon minus the union of the others touching its envelope
+   if( Op==GPC_DIFF ) {
+      gpce_get_envelope(&Polys[0],&genv);
+      for(i=1,n=1; i<N; ++i) {
+         gpce_get_envelope(&Polys[i],&env0);
+         if( Polys[0].num_contours && Polys[i].num_contours && !GPCE_ENV_DISJOINT(genv,env0) ) {
+            Polys[n++] = Polys[i];
+         } else {
+            gpc_free_polygon(&Polys[i]);
+         }
+      }
+      if( !gpce_polygon_cascade(GPC_UNION,Polys+1,n-1,&uni,NThreads) ) {
+         gpc_free_polygon(&Polys[0]);
+         return 0;
+      }
+      gpce_polygon_clip(GPC_DIFF,&Polys[0],NULL,&uni,NULL,Result);
+      gpc_free_polygon(&Polys[0]);
+      gpc_free_polygon(&uni);
+      return 1;
+   }
+
+   if( !(polys=malloc(N*sizeof(*polys))) || !(env=malloc(N*sizeof(*env))) || !(order=malloc(N*sizeof(*order))) ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      for(i=0; i<N; ++i)
+         gpc_free_polygon(&Polys[i]);
+      free(polys); free(env); free(order);
+      return 0;
+   }
+
+   // Get the envelopes and drop the empty polygons
+   genv = GPCE_MK_ENVELOPE(DBL_MAX,DBL_MAX,-DBL_MAX,-DBL_MAX);
+   for(i=0,n=0; i<N; ++i) {
+      if( Polys[i].num_contours ) {
+         gpce_get_envelope(&Polys[i],&env[n]);
+         genv.min.x = fmin(genv.min.x,env[n].min.x);
+         genv.min.y = fmin(genv.min.y,env[n].min.y);
+         genv.max.x = fmax(genv.max.x,env[n].max.x);
+         genv.max.y = fmax(genv.max.y,env[n].max.y);
+         polys[n++] = Polys[i];
+      } else {
+         gpc_free_polygon(&Polys[i]);
+         empty = 1;
+      }
+   }
+
+   // An intersection with an empty polygon is empty
+   if( Op==GPC_INT && empty ) {
+      for(i=0; i<n; ++i)
+         gpc_free_polygon(&polys[i]);
+      n = 0;
+   }
+
+   if( n ) {
+      // Order the polygons along a Morton curve so that neighbours are merged together
+      dx = genv.max.x>genv.min.x ? 1.0/(genv.max.x-genv.min.x) : 0.0;
+      dy = genv.max.y>genv.min.y ? 1.0/(genv.max.y-genv.min.y) : 0.0;
+      for(i=0; i<n; ++i) {
+         order[i].code = gpce_morton(((env[i].min.x+env[i].max.x)*0.5-genv.min.x)*dx,((env[i].min.y+env[i].max.y)*0.5-genv.min.y)*dy);
+         order[i].idx = i;
+      }
+      qsort(order,n,sizeof(*order),QSort_MortonE);
+
+      // Put the polygons in that order and get their envelopes back
+      for(i=0; i<n; ++i)
+         Polys[i] = polys[order[i].idx];
+      for(i=0; i<n; ++i) {
+         polys[i] = Polys[i];
+         gpce_get_envelope(&polys[i],&env[i]);
+      }
+
+      // Tree reduction, the pairs of a level are independent
+      for(step=1; step<n; step*=2) {
+         #pragma omp parallel for schedule(dynamic,1) num_threads(NThreads>0?NThreads:omp_get_max_threads()) if(NThreads!=1 && n>2*step)
+         for(i=0; i<n-step; i+=2*step) {
+            gpc_polygon res;
+
+            gpce_polygon_clip(Op,&polys[i],&env[i],&polys[i+step],&env[i+step],&res);
+            gpc_free_polygon(&polys[i]);
+            gpc_free_polygon(&polys[i+step]);
+            polys[i] = res;
+            gpce_get_envelope(&polys[i],&env[i]);
+         }
+      }
+      *Result = polys[0];
+   }
+
+   free(polys);
+   free(env);
+   free(order);
+
+   return 1;
+}
+
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_prepare_polygon>
+ * Creation : October 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Prepare a polygon for repeated point in polygon tests
+ *
+ * Args :
+ *   <Poly>    : The (multi)polygon to prepare
+ *   <NSlab>   : Number of horizontal slabs (0 for automatic)
+ *
+ * Return: The prepared polygon (NULL if error), to free with gpce_prepared_free
+ *
+ * Remarks :
+ *   - The non horizontal edges are bucketed in horizontal slabs, an edge being
+ *     listed in every slab its Y range touches. A test only looks at the edges
+ *     of the slab containing the point instead of scanning every ring
+ *   - Inside a slab, the edges of a ring are contiguous (a run) and stored as
+ *     separate coordinate arrays so that the crossing tests of a run vectorize
+ *   - The crossing test is the one of gpce_ring_contains_point and the rings are
+ *     combined as in gpce_polygon_contains_point (inside an exterior ring and
+ *     outside every hole), so both give the same answer
+ *----------------------------------------------------------------------------
+ */
+static inline int gpce_prepared_slab(const gpce_prepared *restrict Prep,double Y) {
+   int s = (int)((Y-Prep->Env.min.y)*Prep->Inv);
+
+   return s<0 ? 0 : (s>=Prep->NSlab ? Prep->NSlab-1 : s);
+}
+gpce_prepared* gpce_prepare_polygon(const gpc_polygon *restrict Poly,int NSlab) {
+   gpce_prepared *prep;
+   const gpc_vertex *vi,*vj;
+   int r,i,j,s,s0,s1,ne=0,*epos=NULL,*rpos=NULL,*last=NULL;
+
+   if( !(prep=calloc(1,sizeof(*prep))) ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      return NULL;
+   }
+
+   // Envelope of every ring and number of edges that can cross an horizontal line
+   prep->Env = GPCE_MK_ENVELOPE(DBL_MAX,DBL_MAX,-DBL_MAX,-DBL_MAX);
+   for(r=0; r<Poly->num_contours; ++r) {
+      for(i=Poly->contour[r].num_vertices-1,j=0; j<Poly->contour[r].num_vertices; i=j++) {
+         vj = &Poly->contour[r].vertex[j];
+         prep->Env.min.x = fmin(prep->Env.min.x,vj->x);
+         prep->Env.min.y = fmin(prep->Env.min.y,vj->y);
+         prep->Env.max.x = fmax(prep->Env.max.x,vj->x);
+         prep->Env.max.y = fmax(prep->Env.max.y,vj->y);
+         ne += Poly->contour[r].vertex[i].y!=vj->y;
+      }
+   }
+
+   // About 2 slabs per square root of the edges keeps both the slabs and the edge duplication small
+   prep->NSlab = NSlab>0 ? NSlab : (int)fmin(65536.0,fmax(1.0,2.0*sqrt(ne)));
+   prep->Inv = prep->Env.max.y>prep->Env.min.y ? prep->NSlab/(prep->Env.max.y-prep->Env.min.y) : 0.0;
+   prep->NRing = Poly->num_contours;
+
+   // Count the edges and the runs of each slab
+   prep->Slab = calloc(prep->NSlab+1,sizeof(*prep->Slab));
+   prep->Hole = malloc((prep->NRing?prep->NRing:1)*sizeof(*prep->Hole));
+   epos = calloc(prep->NSlab+1,sizeof(*epos));
+   rpos = malloc(prep->NSlab*sizeof(*rpos));
+   last = malloc(prep->NSlab*sizeof(*last));
+   if( !prep->Slab || !prep->Hole || !epos || !rpos || !last ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      goto error;
+   }
+   for(s=0; s<prep->NSlab; ++s)
+      last[s] = -1;
+   for(r=0; r<Poly->num_contours; ++r) {
+      prep->Hole[r] = Poly->hole[r]!=0;
+      for(i=Poly->contour[r].num_vertices-1,j=0; j<Poly->contour[r].num_vertices; i=j++) {
+         vi = &Poly->contour[r].vertex[i];
+         vj = &Poly->contour[r].vertex[j];
+         if( vi->y!=vj->y ) {
+            s1 = gpce_prepared_slab(prep,fmax(vi->y,vj->y));
+            for(s=gpce_prepared_slab(prep,fmin(vi->y,vj->y)); s<=s1; ++s) {
+               epos[s+1]++;
+               if( last[s]!=r ) {
+                  last[s] = r;
+                  prep->Slab[s+1]++;
+               }
+            }
+         }
+      }
+   }
+   for(s=0; s<prep->NSlab; ++s) {
+      prep->Slab[s+1] += prep->Slab[s];
+      epos[s+1] += epos[s];
+      rpos[s] = prep->Slab[s];
+      last[s] = -1;
+   }
+   prep->NRun = prep->Slab[prep->NSlab];
+   prep->NEdge = epos[prep->NSlab];
+
+   // Fill the slabs, ring by ring so that the edges of a ring stay contiguous in every slab
+   prep->Run = malloc((prep->NRun+1)*sizeof(*prep->Run));
+   prep->Ring = malloc((prep->NRun?prep->NRun:1)*sizeof(*prep->Ring));
+   prep->X0 = malloc((prep->NEdge?prep->NEdge:1)*sizeof(*prep->X0));
+   prep->Y0 = malloc((prep->NEdge?prep->NEdge:1)*sizeof(*prep->Y0));
+   prep->X1 = malloc((prep->NEdge?prep->NEdge:1)*sizeof(*prep->X1));
+   prep->Y1 = malloc((prep->NEdge?prep->NEdge:1)*sizeof(*prep->Y1));
+   if( !prep->Run || !prep->Ring || !prep->X0 || !prep->Y0 || !prep->X1 || !prep->Y1 ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      goto error;
+   }
+   for(r=0; r<Poly->num_contours; ++r) {
+      for(i=Poly->contour[r].num_vertices-1,j=0; j<Poly->contour[r].num_vertices; i=j++) {
+         vi = &Poly->contour[r].vertex[i];
+         vj = &Poly->contour[r].vertex[j];
+         if( vi->y!=vj->y ) {
+            s0 = gpce_prepared_slab(prep,fmin(vi->y,vj->y));
+            s1 = gpce_prepared_slab(prep,fmax(vi->y,vj->y));
+            for(s=s0; s<=s1; ++s) {
+               if( last[s]!=r ) {
+                  last[s] = r;
+                  prep->Run[rpos[s]] = epos[s];
+                  prep->Ring[rpos[s]++] = r;
+               }
+               // Keep the ring orientation so that the crossings are computed exactly as in gpce_ring_contains_point
+               prep->X0[epos[s]] = vi->x;
+               prep->Y0[epos[s]] = vi->y;
+               prep->X1[epos[s]] = vj->x;
+               prep->Y1[epos[s]++] = vj->y;
+            }
+         }
+      }
+   }
+   prep->Run[prep->NRun] = prep->NEdge;
+
+   free(epos);
+   free(rpos);
+   free(last);
+   return prep;
+
+error:
+   free(epos);
+   free(rpos);
+   free(last);
+   gpce_prepared_free(prep);
+   return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_prepared_free>
+ * Creation : October 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Free a prepared polygon
+ *
+ * Args :
+ *   <Prep>    : The prepared polygon
+ *
+ * Return:
+ *
+ * Remarks :
+ *----------------------------------------------------------------------------
+ */
+void gpce_prepared_free(gpce_prepared *restrict Prep) {
+   if( Prep ) {
+      free(Prep->Slab);
+      free(Prep->Run);
+      free(Prep->Ring);
+      free(Prep->Hole);
+      free(Prep->X0);
+      free(Prep->Y0);
+      free(Prep->X1);
+      free(Prep->Y1);
+      free(Prep);
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_prepared_contains_point>
+ * Creation : October 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Check whether a point is contained in a prepared polygon
+ *
+ * Args :
+ *   <Prep>    : The prepared polygon
+ *   <P>       : The point
+ *
+ * Return: 1 if contained, 0 otherwise
+ *
+ * Remarks :
+ *----------------------------------------------------------------------------
+ */
+int gpce_prepared_contains_point(const gpce_prepared *restrict Prep,gpc_vertex P) {
+   int s,r,e,e1,c,in=0;
+
+   if( !GPCE_PT_IN_ENV(Prep->Env,P) )
+      return 0;
+
+   s = gpce_prepared_slab(Prep,P.y);
+   for(r=Prep->Slab[s]; r<Prep->Slab[s+1]; ++r) {
+      // Branchless crossing count over the edges of the ring
+      e1 = Prep->Run[r+1];
+      c = 0;
+      #pragma omp simd reduction(^:c)
+      for(e=Prep->Run[r]; e<e1; ++e) {
+         c ^= ((Prep->Y0[e]>P.y)!=(Prep->Y1[e]>P.y)) & (P.x < (Prep->X1[e]-Prep->X0[e])*(P.y-Prep->Y0[e])/(Prep->Y1[e]-Prep->Y0[e]) + Prep->X0[e]);
+      }
+
+      if( c ) {
+         // Being in a hole means being outside of the polygon
+         if( Prep->Hole[Prep->Ring[r]] )
+            return 0;
+         in = 1;
+      }
+   }
+
+   return in;
+}
+
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_prepared_contains_points>
+ * Creation : October 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Check whether the points of an array are contained in a prepared polygon
+ *
+ * Args :
+ *   <Prep>    : The prepared polygon
+ *   <Pts>     : The points
+ *   <N>       : Number of points
+ *   <In>      : [OUT] 1 for every contained point, 0 otherwise
+ *
+ * Return: The number of contained points
+ *
+ * Remarks :
+ *----------------------------------------------------------------------------
+ */
+int gpce_prepared_contains_points(const gpce_prepared *restrict Prep,const gpc_vertex *restrict Pts,int N,char *restrict In) {
+   int n,nin=0;
+
+   for(n=0; n<N; ++n) {
+      nin += In[n] = gpce_prepared_contains_point(Prep,Pts[n]);
+   }
+   return nin;
+}
+
+/*----------------------------------------------------------------------------
+ * Name     : <gpce_prepared_contains_row>
+ * Creation : October 2026 - E. Legault-Ouellet - CMC/CMOE
+ *
+ * Purpose  : Check whether the evenly spaced points of a scanline are contained
+ *            in a prepared polygon
+ *
+ * Args :
+ *   <Prep>    : The prepared polygon
+ *   <Y>       : Y coordinate of the scanline
+ *   <X0>      : X coordinate of the first point
+ *   <DX>      : Spacing between the points (must be positive)
+ *   <N>       : Number of points
+ *   <In>      : [OUT] 1 for every contained point (X0+n*DX,Y), 0 otherwise
+ *
+ * Return: The number of contained points (-1 if error)
+ *
+ * Remarks :
+ *   - The crossings of the scanline with the slab edges are computed once and
+ *     sorted, the points are then classified in a single left to right sweep
+ *     toggling the rings as their crossings are passed. This makes the cost
+ *     O(edges + points) per row instead of O(edges x points)
+ *   - The result is the same as calling gpce_prepared_contains_point on every point
+ *----------------------------------------------------------------------------
+ */
+struct XRing {
+   double x;
+   int    ring;
+};
+static int QSort_XRing(const void *A,const void *B) {
+   const struct XRing *a=A,*b=B;
+
+   return (a->x>b->x)-(a->x<b->x);
+}
+int gpce_prepared_contains_row(const gpce_prepared *restrict Prep,double Y,double X0,double DX,int N,char *restrict In) {
+   struct XRing *xr;
+   double       *xc,x;
+   char         *state;
+   int          s,r,e,e0,n,nx=0,ix=0,next=0,nhole=0,nin=0;
+
+   if( N<=0 )
+      return 0;
+
+   memset(In,0,N);
+   if( !(Y>=Prep->Env.min.y && Y<=Prep->Env.max.y) )
+      return 0;
+
+   s = gpce_prepared_slab(Prep,Y);
+   e0 = Prep->Run[Prep->Slab[s]];
+   n = Prep->Run[Prep->Slab[s+1]]-e0;
+   if( !n )
+      return 0;
+
+   xc = malloc(n*sizeof(*xc));
+   xr = malloc(n*sizeof(*xr));
+   state = calloc(Prep->NRing,sizeof(*state));
+   if( !xc || !xr || !state ) {
+      fprintf(stderr,"%s: Could not allocate memory\n",__func__);
+      free(xc); free(xr); free(state);
+      return -1;
+   }
+
+   // Crossing abscissa of every edge with the scanline (NAN if the edge does not straddle it)
+   #pragma omp simd
+   for(e=0; e<n; ++e) {
+      xc[e] = ((Prep->Y0[e0+e]>Y)!=(Prep->Y1[e0+e]>Y)) ? (Prep->X1[e0+e]-Prep->X0[e0+e])*(Y-Prep->Y0[e0+e])/(Prep->Y1[e0+e]-Prep->Y0[e0+e]) + Prep->X0[e0+e] : NAN;
+   }
+
+   // Keep the actual crossings along with their ring and sort them
+   for(r=Prep->Slab[s]; r<Prep->Slab[s+1]; ++r) {
+      for(e=Prep->Run[r]-e0; e<Prep->Run[r+1]-e0; ++e) {
+         if( !isnan(xc[e]) ) {
+            xr[nx].x = xc[e];
+            xr[nx++].ring = Prep->Ring[r];
+         }
+      }
+   }
+   qsort(xr,nx,sizeof(*xr),QSort_XRing);
+
+   // A ring contains a point when an odd number of its crossings are left of it (or equivalently, right of it)
+   for(n=0; n<N; ++n) {
+      x = X0+n*DX;
+      for(; ix<nx && xr[ix].x<=x; ++ix) {
+         r = xr[ix].ring;
+         state[r] = !state[r];
+         if( Prep->Hole[r] ) {
+            nhole += state[r] ? 1 : -1;
+         } else {
+            next += state[r] ? 1 : -1;
+         }
+      }
+      nin += In[n] = next>0 && !nhole;
+   }
+
+   free(xc);
+   free(xr);
+   free(state);
+   return nin;
+}
+
 /*----------------------------------------------------------------------------
  * Nom      : <gpce_get_ring_envelope>
  * Creation : Juillet 2018 - E. Legault-Ouellet
@@ -26,6 +26,20 @@ typedef struct gpce_envelope {
     gpc_vertex max;
 } gpce_envelope;
 
+typedef struct gpce_prepared {
+   gpce_envelope Env;            // Envelope of the polygon
+   double        Inv;            // Number of slabs per unit of Y
+   int           NSlab;          // Number of horizontal slabs
+   int           NRun;           // Number of runs (edges of one ring in one slab)
+   int           NEdge;          // Number of edges (counting an edge once per slab it touches)
+   int           NRing;          // Number of rings
+   int           *Slab;          // Index of the first run of each slab (NSlab+1)
+   int           *Run;           // Index of the first edge of each run (NRun+1)
+   int           *Ring;          // Ring of each run
+   char          *Hole;          // Whether each ring is a hole
+   double        *X0,*Y0,*X1,*Y1;// Edge coordinates, grouped by slab and ring
+} gpce_prepared;
+
 // General geometry fct
 double gpce_vect_proj_vect(gpc_vertex A0,gpc_vertex A1,gpc_vertex B0,gpc_vertex B1,gpc_vertex *restrict Pt);
 int gpce_line_intersects_line(gpc_vertex A0,gpc_vertex A1,gpc_vertex B0,gpc_vertex B1,double *restrict FA,double *restrict FB);
@@ -49,8 +63,18 @@ int gpce_polygon_contains_ring(const gpc_polygon *restrict Poly,const gpce_envel
 int gpce_polygon_contains_polygon(const gpc_polygon *restrict OPoly,const gpce_envelope *restrict OEnv,const gpc_polygon *restrict IPoly,const gpce_envelope *restrict IEnv);
 int gpce_explode_multi_polygon(const gpc_polygon *restrict Poly,const gpce_envelope *restrict PEnv,gpc_polygon **PList,gpce_envelope ***EList);
 int gpce_poly_split_tile(const gpc_polygon *restrict Poly,const int MaxPoints,gpc_polygon **restrict Split,unsigned int *restrict NbSplit,unsigned int **restrict PolyIdx,unsigned int *restrict Size);
+int gpce_poly_split_tile_mt(const gpc_polygon *restrict Poly,const int MaxPoints,gpc_polygon **restrict Split,unsigned int *restrict NbSplit,unsigned int **restrict PolyIdx,int NThreads);
 int gpce_poly_wrap_split(const gpc_polygon *restrict Poly,const gpce_envelope *restrict Env,int Dim,double R0,double R1,gpc_polygon *restrict Wrapped);
 void gpce_poly_wrap_clamp(gpc_polygon *restrict Poly,int Dim,double R0,double R1);
+void gpce_polygon_clip(gpc_op Op,const gpc_polygon *restrict PolyA,const gpce_envelope *restrict EnvA,const gpc_polygon *restrict PolyB,const gpce_envelope *restrict EnvB,gpc_polygon *restrict Result);
+int gpce_polygon_cascade(gpc_op Op,gpc_polygon *restrict Polys,int N,gpc_polygon *restrict Result,int NThreads);
+
+// Prepared polygon
+gpce_prepared* gpce_prepare_polygon(const gpc_polygon *restrict Poly,int NSlab);
+void gpce_prepared_free(gpce_prepared *restrict Prep);
+int gpce_prepared_contains_point(const gpce_prepared *restrict Prep,gpc_vertex P);
+int gpce_prepared_contains_points(const gpce_prepared *restrict Prep,const gpc_vertex *restrict Pts,int N,char *restrict In);
+int gpce_prepared_contains_row(const gpce_prepared *restrict Prep,double Y,double X0,double DX,int N,char *restrict In);
 
 // Envelope related
 void gpce_get_ring_envelope(const gpc_vertex_list *restrict Ring,gpce_envelope *restrict PEnv);
@@ -52,7 +52,7 @@ int main(int argc, char *argv[]) {
 
    TDict_Encoding coding=DICT_UTF8;
    int            ok=1,lng=0,xml=0,ops=0,desc=DICT_SHORT,search=DICT_EXACT,st=DICT_ALL,ip1,ip2,ip3,d=0,code=EXIT_SUCCESS;
-   char          *var,*type,*lang,*encoding,*origin,*etiket,*state,*dicfile[APP_LISTMAX],*rpnfile[APP_LISTMAX],*cfgfile,dicdef[APP_BUFMAX],*env;
+   char          *var,*type,*lang,*encoding,*origin,*etiket,*state,*dicfile[APP_LISTMAX],*rpnfile[APP_LISTMAX],*cfgfile,*binfile,dicdef[APP_BUFMAX],*env;
 
    TApp_Arg appargs[]=
       { { APP_CHAR|APP_FLAG, &var,      1,             "n", "nomvar"      , "Search variable name ("APP_COLOR_GREEN"all"APP_COLOR_RESET")" },
@@ -66,7 +66,8 @@ int main(int argc, char *argv[]) {
         { APP_FLAG,          &xml,      1,             "x", "xml"         , "Output in XML format" },
         { APP_FLAG,          &search,   1,             "g", "glob"        , "Use glob search pattern" },
         { APP_CHAR,          &encoding, 1,             "e", "encoding"    , "Encoding type (iso8859-1,"APP_COLOR_GREEN"utf8"APP_COLOR_RESET",ascii)" },
-        { APP_CHAR,          dicfile,   APP_LISTMAX-1, "d", "dictionary"  , "Input dictionary file(s) ("APP_COLOR_GREEN"$CMCCONST/opdict/ops.variable_dictionary.xml"APP_COLOR_RESET")" },
+        { APP_CHAR,          dicfile,   APP_LISTMAX-1, "d", "dictionary"  , "Input dictionary file(s), XML or compiled ("APP_COLOR_GREEN"$CMCCONST/opdict/ops.variable_dictionary.xml"APP_COLOR_RESET")" },
+        { APP_CHAR,          &binfile,  1,             "w", "write"       , "Write the input dictionary(ies) to a compiled binary dictionary file" },
         { APP_CHAR,          rpnfile,   APP_LISTMAX-1, "f", "fstd"        , "Check RPN standard file(s) for unknown variables" },
         { APP_CHAR,          &cfgfile,  1,             "c", "cfg"         , "Check GEM configuration file for unknown variables" },
         { APP_FLAG,          &ops    ,  1,             "" , "ops"         , "Force check of operational standards when used with RPN file check" },
@@ -74,7 +75,7 @@ int main(int argc, char *argv[]) {
 
    memset(rpnfile,0x0,APP_LISTMAX*sizeof(rpnfile[0]));
    memset(dicfile,0x0,APP_LISTMAX*sizeof(dicfile[0]));
-   var=type=lang=encoding=cfgfile=origin=etiket=state=NULL;
+   var=type=lang=encoding=cfgfile=binfile=origin=etiket=state=NULL;
    ip1=ip2=ip3=-1;
 
    App_Init(APP_MASTER,APP_NAME,VERSION,APP_DESC,BUILD_TIMESTAMP);
@@ -85,7 +86,7 @@ int main(int argc, char *argv[]) {
 
    desc=xml?DICT_XML:lng?DICT_LONG:DICT_SHORT;
 
-   if (!var && !type && !cfgfile && !rpnfile[0] && ip1<0 && ip3<0 && !state && !origin) {
+   if (!var && !type && !cfgfile && !binfile && !rpnfile[0] && ip1<0 && ip3<0 && !state && !origin) {
       var=strdup("");
       type=strdup("");
       search=DICT_GLOB;
@@ -162,7 +163,10 @@ int main(int argc, char *argv[]) {
 
    fprintf(stderr,"\n");
 
-   if (rpnfile[0]) {
+   if (binfile) {
+      ok=Dict_Save(binfile);
+      code=ok?EXIT_SUCCESS:EXIT_FAILURE;
+   } else if (rpnfile[0]) {
       ok=Dict_CheckRPN(rpnfile,ops);
    } else if (cfgfile) {
       ok=Dict_CheckCFG(cfgfile);
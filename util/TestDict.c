@@ -0,0 +1,179 @@
+/*==============================================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadian
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Librairie de fonctions utiles
+ * Creation     : Octobre 2026
+ * Auteur       : Eric Legault-Ouellet
+ *
+ * Description: Dictionary loading and lookup benchmark (Dict)
+ *
+ * License:
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *==============================================================================
+ */
+
+#include "App.h"
+#include "Dict.h"
+#include "OMP_Utils.h"
+
+#define APP_NAME "TestDict"
+#define APP_DESC "Dictionary loading and lookup benchmark."
+
+static double Now(void) {
+   struct timeval t;
+
+   gettimeofday(&t,NULL);
+   return t.tv_sec+t.tv_usec*1e-6;
+}
+
+int TestAdd(void) {
+
+   TDictVar *var[2];
+   int       n;
+
+   // Names are at most 4 characters, this one can't be in a real dictionary
+   Dict_SetSearch(DICT_EXACT,DICT_ALL,NULL,-1,-1,-1,NULL);
+   if (Dict_GetVar("ZZ#")) {
+      App_Log(APP_ERROR,"Test variable already in dictionary\n");
+      return(0);
+   }
+
+   for(n=0;n<2;n++) {
+      if (!(var[n]=(TDictVar*)calloc(1,sizeof(TDictVar)))) {
+         return(0);
+      }
+      strcpy(var[n]->Name,"ZZ#");
+      var[n]->Nature=DICT_CURRENT;
+      var[n]->IP1=n?12000:-1;
+      var[n]->IP2=var[n]->IP3=-1;
+   }
+
+   // The indexes are rebuilt on the first lookup following each addition
+   Dict_AddVar(var[0]);
+   Dict_SetSearch(DICT_EXACT,DICT_CURRENT,NULL,-1,-1,-1,NULL);
+   if (Dict_GetVar("zz#")!=var[0]) {
+      App_Log(APP_ERROR,"Added variable not found through the name index\n");
+      return(0);
+   }
+
+   Dict_AddVar(var[1]);
+   Dict_SetSearch(DICT_EXACT,DICT_CURRENT,NULL,12000,-1,-1,NULL);
+   if (Dict_GetVar("ZZ#")!=var[1]) {
+      App_Log(APP_ERROR,"Added IP1 specific variable not found through the name index\n");
+      return(0);
+   }
+   Dict_SetSearch(DICT_GLOB,DICT_CURRENT,NULL,12000,-1,-1,NULL);
+   if (Dict_GetVar("^ZZ#")!=var[1]) {
+      App_Log(APP_ERROR,"Added IP1 specific variable not found through the IP1 index\n");
+      return(0);
+   }
+   App_Log(APP_INFO,"%-16s: added variables found\n","ADDVAR");
+
+   return(1);
+}
+
+int Test(char *Dictionary,char *Binary,int NLoop) {
+
+   TDictVar  *var;
+   TList     *iter=NULL;
+   char     **names;
+   int        n,l,nv=0,found[2]={0,0};
+   double     t0,t[2];
+
+   // Load the dictionary (XML or compiled)
+   t0=Now();
+   if (!Dict_Parse(Dictionary,DICT_UTF8)) {
+      return(0);
+   }
+   App_Log(APP_INFO,"%-16s: %8.4f s (%s)\n","LOAD",Now()-t0,Dict_Version());
+
+   if (Binary) {
+      t0=Now();
+      if (!Dict_Save(Binary)) {
+         return(0);
+      }
+      App_Log(APP_INFO,"%-16s: %8.4f s (%s)\n","SAVE",Now()-t0,Binary);
+   }
+
+   // Get the list of variable names
+   Dict_SetSearch(DICT_GLOB,DICT_ALL,NULL,-1,-1,-1,NULL);
+   while((var=Dict_IterateVar(&iter,NULL))) nv++;
+   if (!nv || !(names=(char**)malloc(nv*sizeof(char*)))) {
+      App_Log(APP_ERROR,"Empty dictionary\n");
+      return(0);
+   }
+   for(n=0,iter=NULL;(var=Dict_IterateVar(&iter,NULL));n++) {
+      names[n]=var->Name;
+   }
+
+   // Same lookups through the name index (exact) and through a list walk (glob without wildcards)
+   for(l=0;l<2;l++) {
+      Dict_SetSearch(l?DICT_GLOB:DICT_EXACT,DICT_CURRENT,NULL,-1,-1,-1,NULL);
+      t0=Now();
+      for(n=0;n<nv*NLoop;n++) {
+         found[l]+=Dict_GetVar(names[n%nv])!=NULL;
+      }
+      t[l]=Now()-t0;
+   }
+   App_Log(APP_INFO,"%-16s: indexed %8.4f s, list walk %8.4f s for %d lookups (%d/%d found)\n","GETVAR",t[0],t[1],nv*NLoop,found[0],found[1]);
+
+   free(names);
+   return(found[0]==found[1] && TestAdd());
+}
+
+int main(int argc, char *argv[]) {
+
+   int      ok=0,code=EXIT_FAILURE;
+   int      nloop=1,nthreads=0;
+   char     *dict=NULL,*bin=NULL,dicdef[APP_BUFMAX],*env;
+
+   TApp_Arg appargs[]=
+      { { APP_CHAR,   &dict,     1,             "d", "dictionary", "Dictionary file, XML or compiled ($CMCCONST/opdict/ops.variable_dictionary.xml)" },
+        { APP_CHAR,   &bin,      1,             "w", "write",      "Compiled dictionary file to write" },
+        { APP_INT32,  &nloop,    1,             "l", "loop",       "Number of lookups per variable (1)" },
+        { APP_INT32,  &nthreads, 1,             "t", "threads",    "Number of threads used to parse (0 for all available)" },
+        { 0 } };
+
+   App_Init(APP_MASTER,APP_NAME,VERSION,APP_DESC,__TIMESTAMP__);
+
+   if (!App_ParseArgs(appargs,argc,argv,APP_ARGSLOG)) {
+      exit(EXIT_FAILURE);
+   }
+
+   if (!dict) {
+      if (!(env=getenv("CMCCONST"))) {
+         App_Log(APP_ERROR,"No dictionary specified and CMCCONST not defined\n");
+         exit(EXIT_FAILURE);
+      }
+      snprintf(dicdef,APP_BUFMAX,"%s%s",env,"/opdict/ops.variable_dictionary.xml");
+      dict=dicdef;
+   }
+
+#ifdef _OPENMP
+   if (nthreads>0) omp_set_num_threads(nthreads);
+#endif
+
+   App_Start();
+   ok=Test(dict,bin,nloop);
+   code=App_End(ok?-1:EXIT_FAILURE);
+   App_Free();
+
+   exit(code);
+}
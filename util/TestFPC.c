@@ -0,0 +1,193 @@
+/*==============================================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadian
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Librairie de fonctions utiles
+ * Creation     : Octobre 2026
+ * Auteur       : Eric Legault-Ouellet
+ *
+ * Description: Floating point compressors benchmark (FPFC, FPC range coder, FPC rANS)
+ *
+ * License:
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *==============================================================================
+ */
+
+#include "App.h"
+#include "RPN.h"
+#include "FPFC.h"
+#include "FPCompressF.h"
+
+#define APP_NAME "TestFPC"
+#define APP_DESC "Floating point compressors benchmark."
+
+typedef struct TFPCStat {
+   const char *Name;
+   double     Comp,Infl;     // Compression and inflate time (s)
+   size_t     Size;          // Compressed size (bytes)
+   int        NFail;         // Number of fields that could not be compressed
+   int        NBad;          // Number of fields not inflated identically
+} TFPCStat;
+
+static double Now(void) {
+   struct timeval t;
+
+   gettimeofday(&t,NULL);
+   return t.tv_sec+t.tv_usec*1e-6;
+}
+
+static void Bench(TFPCStat *Stat,int Method,float *Data,float *Out,unsigned char *CData,int NI,int NJ,int NK) {
+   size_t n=(size_t)NI*NJ*NK,csize=0;
+   double t0,t1,t2;
+   int    ok;
+
+   t0=Now();
+   switch(Method) {
+      case 0: ok=FPFC_Compress(Data,n,CData,n*sizeof(*Data),&csize); break;
+      case 1: ok=FPC_CompressF(CData,-1,Data,NI,NJ,NK,&csize);        break;
+      case 2: ok=FPC_CompressRANSF(CData,Data,NI,NJ,NK,&csize);       break;
+   }
+   t1=Now();
+
+   if (ok!=APP_OK) {
+      Stat->Size+=n*sizeof(*Data);
+      Stat->NFail++;
+      return;
+   }
+
+   switch(Method) {
+      case 0: FPFC_Inflate(Out,n,CData,csize);               break;
+      case 1: FPC_InflateF(CData,-1,Out,NI,NJ,NK);           break;
+      case 2: FPC_InflateRANSF(CData,csize,Out,NI,NJ,NK);    break;
+   }
+   t2=Now();
+
+   Stat->Comp+=t1-t0;
+   Stat->Infl+=t2-t1;
+   Stat->Size+=csize;
+   Stat->NBad+=memcmp(Data,Out,n*sizeof(*Data))!=0;
+}
+
+// Round trip fields of a few points: the compressors must either fail cleanly (data stored as is) or inflate them identically.
+// The range coder (FPC_Compress) is left out as it needs some slack after the data size for its final bytes (FPC_SLACK)
+static int Tiny(void) {
+   TFPCStat       stat;
+   float          data[64],out[64];
+   unsigned char *cdata;
+   int            n,m,i,nbad=0;
+
+   for(n=1;n<=64;n++) {
+      for(i=0;i<n;i++) data[i]=sinf(i*0.3f)*100.0f;
+
+      for(m=0;m<3;m+=2) {
+         // Exactly sized buffer so that any overflow is caught by memory checkers
+         cdata=(unsigned char*)malloc(n*sizeof(*data));
+         memset(&stat,0,sizeof(stat));
+         Bench(&stat,m,data,out,cdata,n,1,1);
+         free(cdata);
+         if (stat.NBad) {
+            App_Log(APP_ERROR,"Tiny field of %d points not inflated identically by method %d\n",n,m);
+            nbad++;
+         }
+      }
+   }
+   return(!nbad);
+}
+
+int Test(char *File,char *Var) {
+
+#ifdef HAVE_RMN
+   TFPCStat       stats[3]={ { "FPFC" },{ "FPC range" },{ "FPC rANS" } };
+   float          *data=NULL,*out=NULL;
+   unsigned char  *cdata=NULL;
+   int            fid,idlst[RPNMAX],n,m,nid,ni,nj,nk,datyp,nbits;
+   size_t         nmax=0,total=0;
+   TRPNHeader     h;
+
+   if ((fid=cs_fstouv(File,"STD+RND+R/O"))<0) {
+      App_Log(APP_ERROR,"Problems opening input file %s\n",File);
+      return(0);
+   }
+
+   cs_fstinl(fid,&ni,&nj,&nk,-1,"",-1,-1,-1,"",Var?Var:"",idlst,&nid,RPNMAX);
+
+   for(n=0;n<nid;n++) {
+      cs_fstprm(idlst[n],&h.DATEO,&h.DEET,&h.NPAS,&ni,&nj,&nk,&nbits,&datyp,&h.IP1,&h.IP2,&h.IP3,h.TYPVAR,h.NOMVAR,h.ETIKET,
+         h.GRTYP,&h.IG1,&h.IG2,&h.IG3,&h.IG4,&h.SWA,&h.LNG,&h.DLTF,&h.UBC,&h.EX1,&h.EX2,&h.EX3);
+
+      // Only real fields
+      if ((datyp&~0x80)!=1 && (datyp&~0x80)!=5 && (datyp&~0x80)!=6) continue;
+
+      if ((size_t)ni*nj*nk>nmax) {
+         nmax=(size_t)ni*nj*nk;
+         data=realloc(data,nmax*sizeof(*data));
+         out=realloc(out,nmax*sizeof(*out));
+         cdata=realloc(cdata,nmax*sizeof(*data)+FPC_SLACK);
+      }
+      cs_fstluk(data,idlst[n],&ni,&nj,&nk);
+
+      for(m=0;m<3;m++) {
+         Bench(&stats[m],m,data,out,cdata,ni,nj,nk);
+      }
+      total+=(size_t)ni*nj*nk*sizeof(*data);
+   }
+   cs_fstfrm(fid);
+
+   App_Log(APP_INFO,"%zu bytes of real fields in %s\n",total,File);
+   for(m=0;m<3;m++) {
+      App_Log(APP_INFO,"   %-10s: ratio %.4f, compress %8.2f MB/s, inflate %8.2f MB/s, failed %d, bad %d\n",stats[m].Name,(double)stats[m].Size/total,
+         total*1e-6/stats[m].Comp,total*1e-6/stats[m].Infl,stats[m].NFail,stats[m].NBad);
+   }
+
+   free(data);
+   free(out);
+   free(cdata);
+#endif
+
+   return(1);
+}
+
+int main(int argc, char *argv[]) {
+
+   int      ok=0,code=EXIT_FAILURE;
+   char     *in=NULL,*var=NULL;
+
+   TApp_Arg appargs[]=
+      { { APP_CHAR,  &in,   1,             "i", "input",  "Input standard file" },
+        { APP_CHAR,  &var,  1,             "n", "nomvar", "Variable to process (all real fields if not specified)" },
+        { 0 } };
+
+   App_Init(APP_MASTER,APP_NAME,VERSION,APP_DESC,__TIMESTAMP__);
+
+   if (!App_ParseArgs(appargs,argc,argv,APP_NOARGSFAIL|APP_ARGSLOG)) {
+      exit(EXIT_FAILURE);
+   }
+
+   if (in==NULL) {
+      App_Log(APP_ERROR,"No input standard file specified\n");
+      exit(EXIT_FAILURE);
+   }
+
+   App_Start();
+   ok=Tiny() && Test(in,var);
+   code=App_End(ok?-1:EXIT_FAILURE);
+   App_Free();
+
+   exit(code);
+}
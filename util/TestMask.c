@@ -0,0 +1,164 @@
+/*==============================================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadian
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Librairie de fonctions utiles
+ * Creation     : Octobre 2026
+ * Auteur       : Eric Legault-Ouellet
+ *
+ * Description: Point in polygon benchmark, ring scan vs prepared polygon
+ *              (gpce_polygon_contains_point and gpce_prepared_*)
+ *
+ * License:
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *==============================================================================
+ */
+
+#include "App.h"
+#include "GeoRef.h"
+#include "OGR.h"
+
+#define APP_NAME "TestMask"
+#define APP_DESC "Ring scan vs prepared polygon point in polygon benchmark."
+
+static double Now(void) {
+   struct timeval t;
+
+   gettimeofday(&t,NULL);
+   return t.tv_sec+t.tv_usec*1e-6;
+}
+
+#ifdef HAVE_GPC
+// Build a synthetic coastline: a jagged continent of NV points with a lake and some islands
+static void Coastline(gpc_polygon *Poly,int NV,int NIsland) {
+   gpc_vertex_list *ring;
+   double           a,r,cx,cy,rr,walk;
+   int              c,i;
+
+   srand(1);
+   Poly->num_contours=NIsland+2;
+   Poly->hole=(int*)calloc(Poly->num_contours,sizeof(int));
+   Poly->contour=(gpc_vertex_list*)malloc(Poly->num_contours*sizeof(gpc_vertex_list));
+
+   for(c=0;c<Poly->num_contours;c++) {
+      ring=&Poly->contour[c];
+      if (c==0) {
+         ring->num_vertices=NV; cx=cy=0.0; rr=1000.0;
+      } else if (c==1) {
+         ring->num_vertices=NV/50+3; cx=cy=0.0; rr=50.0;
+         Poly->hole[c]=1;
+      } else {
+         ring->num_vertices=NV/(10*NIsland)+3; cx=rand()%1600-800.0; cy=rand()%1600-800.0; rr=20.0+rand()%60;
+      }
+      ring->vertex=(gpc_vertex*)malloc(ring->num_vertices*sizeof(gpc_vertex));
+
+      for(i=0,walk=0.0;i<ring->num_vertices;i++) {
+         a=2.0*M_PI*i/ring->num_vertices;
+         walk=0.98*(walk+(rand()%1000-500)/5000.0);
+         r=rr*(1.0+0.15*sin(a*37.0)+0.05*sin(a*511.0)+0.2*walk/(1.0+fabs(walk)));
+         ring->vertex[i].x=cx+r*cos(a);
+         ring->vertex[i].y=cy+r*sin(a);
+      }
+   }
+}
+
+#endif
+
+int Test(int NV,int NI,int NJ) {
+
+#ifdef HAVE_GPC
+   gpc_polygon    poly;
+   gpce_envelope *env;
+   gpce_prepared *prep;
+   gpc_vertex     p;
+   char          *in[3];
+   double         t0,t[4]={0.0,0.0,0.0,0.0};
+   int            i,j,n,nin=0,diff=0;
+
+   Coastline(&poly,NV,40);
+   env=gpce_get_envelopes(&poly);
+   for(n=0;n<3;n++) in[n]=(char*)malloc(NI);
+
+   t0=Now(); prep=gpce_prepare_polygon(&poly,0); t[3]=Now()-t0;
+   App_Log(APP_INFO,"Coastline of %d vertices in %d rings, %d slabs, %d edges, prepared in %.3f s\n",gpce_get_num_vertices(&poly),poly.num_contours,prep->NSlab,prep->NEdge,t[3]);
+
+   // Grid of NIxNJ points over the coastline
+   for(j=0;j<NJ;j++) {
+      p.y=-1200.0+2400.0*j/NJ;
+
+      t0=Now();
+      for(i=0;i<NI;i++) {
+         p.x=-1200.0+2400.0*i/NI;
+         in[0][i]=gpce_polygon_contains_point(&poly,env,p);
+      }
+      t[0]+=Now()-t0;
+
+      t0=Now();
+      for(i=0;i<NI;i++) {
+         p.x=-1200.0+2400.0*i/NI;
+         in[1][i]=gpce_prepared_contains_point(prep,p);
+      }
+      t[1]+=Now()-t0;
+
+      t0=Now();
+      gpce_prepared_contains_row(prep,p.y,-1200.0,2400.0/NI,NI,in[2]);
+      t[2]+=Now()-t0;
+
+      for(i=0;i<NI;i++) {
+         nin+=in[0][i];
+         diff+=(in[0][i]!=in[1][i])+(in[0][i]!=in[2][i]);
+      }
+   }
+   App_Log(APP_INFO,"%d points, %d inside: ring scan %8.3f s, prepared point %8.3f s, prepared row %8.3f s, differences %d\n",NI*NJ,nin,t[0],t[1],t[2],diff);
+
+   for(n=0;n<3;n++) free(in[n]);
+   gpce_prepared_free(prep);
+   free(env);
+   gpc_free_polygon(&poly);
+   return(!diff);
+#else
+   App_Log(APP_ERROR,"Library was not built with GPC support\n");
+   return(0);
+#endif
+}
+
+int main(int argc, char *argv[]) {
+
+   int ok=0,code=EXIT_FAILURE;
+   int nv=100000,ni=1000,nj=1000;
+
+   TApp_Arg appargs[]=
+      { { APP_INT32,  &nv,  1, "n", "points", "Number of points of the synthetic coastline (100000)" },
+        { APP_INT32,  &ni,  1, "i", "ni",     "Number of grid points in I (1000)" },
+        { APP_INT32,  &nj,  1, "j", "nj",     "Number of grid points in J (1000)" },
+        { 0 } };
+
+   App_Init(APP_MASTER,APP_NAME,VERSION,APP_DESC,__TIMESTAMP__);
+
+   if (!App_ParseArgs(appargs,argc,argv,APP_ARGSLOG)) {
+      exit(EXIT_FAILURE);
+   }
+
+   App_Start();
+   ok=Test(nv,ni,nj);
+   code=App_End(ok?-1:EXIT_FAILURE);
+   App_Free();
+
+   exit(code);
+}
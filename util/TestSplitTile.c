@@ -0,0 +1,193 @@
+/*==============================================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadian
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Librairie de fonctions utiles
+ * Creation     : Octobre 2026
+ * Auteur       : Eric Legault-Ouellet
+ *
+ * Description: Serial vs task parallel polygon tiling benchmark
+ *              (gpce_poly_split_tile and OGM_PolySplitTile)
+ *
+ * License:
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *==============================================================================
+ */
+
+#include "App.h"
+#include "GeoRef.h"
+#include "OGR.h"
+
+#define APP_NAME "TestSplitTile"
+#define APP_DESC "Serial vs task parallel polygon tiling benchmark."
+
+static double Now(void) {
+   struct timeval t;
+
+   gettimeofday(&t,NULL);
+   return t.tv_sec+t.tv_usec*1e-6;
+}
+
+#ifdef HAVE_GPC
+// Build a synthetic coastline: a jagged continent of NV points with a lake and some islands
+static void Coastline(gpc_polygon *Poly,int NV,int NIsland) {
+   gpc_vertex_list *ring;
+   double           a,r,cx,cy,rr,walk;
+   int              c,i;
+
+   srand(1);
+   Poly->num_contours=NIsland+2;
+   Poly->hole=(int*)calloc(Poly->num_contours,sizeof(int));
+   Poly->contour=(gpc_vertex_list*)malloc(Poly->num_contours*sizeof(gpc_vertex_list));
+
+   for(c=0;c<Poly->num_contours;c++) {
+      ring=&Poly->contour[c];
+      if (c==0) {
+         ring->num_vertices=NV; cx=cy=0.0; rr=1000.0;
+      } else if (c==1) {
+         ring->num_vertices=NV/50+3; cx=cy=0.0; rr=50.0;
+         Poly->hole[c]=1;
+      } else {
+         ring->num_vertices=NV/(10*NIsland)+3; cx=rand()%1600-800.0; cy=rand()%1600-800.0; rr=20.0+rand()%60;
+      }
+      ring->vertex=(gpc_vertex*)malloc(ring->num_vertices*sizeof(gpc_vertex));
+
+      for(i=0,walk=0.0;i<ring->num_vertices;i++) {
+         a=2.0*M_PI*i/ring->num_vertices;
+         walk=0.98*(walk+(rand()%1000-500)/5000.0);
+         r=rr*(1.0+0.15*sin(a*37.0)+0.05*sin(a*511.0)+0.2*walk/(1.0+fabs(walk)));
+         ring->vertex[i].x=cx+r*cos(a);
+         ring->vertex[i].y=cy+r*sin(a);
+      }
+   }
+}
+
+static int Same(gpc_polygon *P0,unsigned int N0,gpc_polygon *P1,unsigned int N1) {
+   unsigned int n;
+   int          c;
+
+   if (N0!=N1) return(0);
+   for(n=0;n<N0;n++) {
+      if (P0[n].num_contours!=P1[n].num_contours) return(0);
+      for(c=0;c<P0[n].num_contours;c++) {
+         if (P0[n].hole[c]!=P1[n].hole[c] || P0[n].contour[c].num_vertices!=P1[n].contour[c].num_vertices ||
+             memcmp(P0[n].contour[c].vertex,P1[n].contour[c].vertex,P0[n].contour[c].num_vertices*sizeof(gpc_vertex))) return(0);
+      }
+   }
+   return(1);
+}
+#endif
+
+int Test(char *File,int NV,int MaxPoints,int NThreads) {
+
+#ifdef HAVE_GPC
+   gpc_polygon  poly,*split[2];
+   unsigned int nsplit[2],n,s;
+   double       t0,t[2];
+
+   OGM_GPCNew(&poly);
+
+#ifdef HAVE_GDAL
+   OGRGeometryH geom=NULL,res[2];
+   OGRDataSourceH src;
+   OGRFeatureH    feature;
+
+   // Merge the polygons of the first layer into one multi-polygon
+   if (File) {
+      if (!(src=OGROpen(File,FALSE,NULL))) {
+         App_Log(APP_ERROR,"Unable to open %s\n",File);
+         return(0);
+      }
+      geom=OGR_G_CreateGeometry(wkbMultiPolygon);
+      OGR_L_ResetReading(OGR_DS_GetLayer(src,0));
+      while((feature=OGR_L_GetNextFeature(OGR_DS_GetLayer(src,0)))) {
+         OGRGeometryH g=OGR_F_GetGeometryRef(feature);
+         if (g && OGR_G_GetGeometryType(g)==wkbPolygon) {
+            OGR_G_AddGeometry(geom,g);
+         } else if (g && OGR_G_GetGeometryType(g)==wkbMultiPolygon) {
+            for(n=0;n<OGR_G_GetGeometryCount(g);n++) OGR_G_AddGeometry(geom,OGR_G_GetGeometryRef(g,n));
+         }
+         OGR_F_Destroy(feature);
+      }
+      OGR_DS_Destroy(src);
+      OGM_GPCFromOGR(&poly,geom);
+
+      t0=Now(); res[0]=OGM_PolySplitTile(geom,MaxPoints,NULL); t[0]=Now()-t0;
+      t0=Now(); res[1]=OGM_PolySplitTileMT(geom,MaxPoints,NThreads); t[1]=Now()-t0;
+      App_Log(APP_INFO,"%-22s: serial %8.3f s (%d), tasks %8.3f s (%d), equal %s\n","OGM_PolySplitTile",
+         t[0],res[0]?OGR_G_GetGeometryCount(res[0]):0,t[1],res[1]?OGR_G_GetGeometryCount(res[1]):0,
+         res[0] && res[1] && OGR_G_Equals(res[0],res[1])?"yes":"no");
+      if (res[0]) OGR_G_DestroyGeometry(res[0]);
+      if (res[1]) OGR_G_DestroyGeometry(res[1]);
+      OGR_G_DestroyGeometry(geom);
+   }
+#endif
+
+   if (!poly.num_contours) {
+      Coastline(&poly,NV,40);
+   }
+   App_Log(APP_INFO,"Coastline of %d vertices in %d rings, tiles of at most %d vertices\n",gpce_get_num_vertices(&poly),poly.num_contours,MaxPoints);
+
+   t0=Now(); gpce_poly_split_tile(&poly,MaxPoints,&split[0],&nsplit[0],NULL,NULL); t[0]=Now()-t0;
+   t0=Now(); gpce_poly_split_tile_mt(&poly,MaxPoints,&split[1],&nsplit[1],NULL,NThreads); t[1]=Now()-t0;
+   App_Log(APP_INFO,"%-22s: serial %8.3f s (%u), tasks %8.3f s (%u), identical %s\n","gpce_poly_split_tile",
+      t[0],nsplit[0],t[1],nsplit[1],Same(split[0],nsplit[0],split[1],nsplit[1])?"yes":"no");
+
+   for(s=0;s<2;s++) {
+      for(n=0;n<nsplit[s];n++) gpc_free_polygon(&split[s][n]);
+      free(split[s]);
+   }
+   gpc_free_polygon(&poly);
+   return(1);
+#else
+   App_Log(APP_ERROR,"Library was not built with GPC support\n");
+   return(0);
+#endif
+}
+
+int main(int argc, char *argv[]) {
+
+   int   ok=0,code=EXIT_FAILURE;
+   int   nv=1000000,maxp=2000,nthreads=0;
+   char *file=NULL;
+
+   TApp_Arg appargs[]=
+      { { APP_CHAR,   &file,     1, "i", "input",   "Coastline file readable by OGR (synthetic coastline if none)" },
+        { APP_INT32,  &nv,       1, "n", "points",  "Number of points of the synthetic coastline (1000000)" },
+        { APP_INT32,  &maxp,     1, "m", "max",     "Maximum number of points per tile (2000)" },
+        { APP_INT32,  &nthreads, 1, "t", "threads", "Number of threads (0 for all available)" },
+        { 0 } };
+
+   App_Init(APP_MASTER,APP_NAME,VERSION,APP_DESC,__TIMESTAMP__);
+
+   if (!App_ParseArgs(appargs,argc,argv,APP_ARGSLOG)) {
+      exit(EXIT_FAILURE);
+   }
+
+#ifdef HAVE_GDAL
+   OGRRegisterAll();
+#endif
+
+   App_Start();
+   ok=Test(file,nv,maxp,nthreads);
+   code=App_End(ok?-1:EXIT_FAILURE);
+   App_Free();
+
+   exit(code);
+}
@@ -0,0 +1,200 @@
+/*==============================================================================
+ * Environnement Canada
+ * Centre Meteorologique Canadian
+ * 2100 Trans-Canadienne
+ * Dorval, Quebec
+ *
+ * Projet       : Librairie de fonctions utiles
+ * Creation     : Octobre 2026
+ * Auteur       : Eric Legault-Ouellet
+ *
+ * Description: Comparison of the native vertical interpolation engine with
+ *              RMNLIB's interp1d routines (ZRefInterp)
+ *
+ * License:
+ *    This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation,
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the
+ *    Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ *    Boston, MA 02111-1307, USA.
+ *
+ *==============================================================================
+ */
+
+#include "App.h"
+#include "ZRefInterp.h"
+
+#define APP_NAME "TestZRefInterp"
+#define APP_DESC "Native vs RMNLIB vertical interpolation comparison."
+
+static double Now(void) {
+   struct timeval t;
+
+   gettimeofday(&t,NULL);
+   return t.tv_sec+t.tv_usec*1e-6;
+}
+
+// Build a vertical reference with a synthetic log(p) cube over NIJ columns
+static TZRef* Column(int NK,float PTop,float PBot,int NIJ) {
+   TZRef *zref;
+   float *lvl;
+   int    k,ij;
+
+   lvl=(float*)malloc(NK*sizeof(float));
+   for(k=0;k<NK;k++) lvl[k]=PTop+(PBot-PTop)*k/(NK-1);
+   zref=ZRef_Define(LVL_PRES,NK,lvl);
+   free(lvl);
+
+   zref->PCube=(float*)malloc(NIJ*NK*sizeof(float));
+   for(k=0;k<NK;k++) {
+      for(ij=0;ij<NIJ;ij++) {
+         // Vary the columns a bit so that positions differ from column to column
+         zref->PCube[k*NIJ+ij]=logf(zref->Levels[k]*(1.0f+0.02f*sinf(ij*0.01f)));
+      }
+   }
+   return(zref);
+}
+
+int Test(int NI,int NJ,int NKSrc,int NKDest,float Tol) {
+
+   static const char *schemes[]={ "NEAREST","LINEAR","CUBICWITHDERIVS","CUBIC",NULL };
+   static const char *extraps[]={ "LAPSERATE","CLAMPED",NULL };
+   TZRef       *src,*dst;
+   TZRefInterp *native,*rmn=NULL;
+   float       *in,*din,*out[2],*dout[2],e,emax;
+   int          nij=NI*NJ,k,ij,s,x,n,code[2],ok=1;
+   double       t0,t[2]={0.0,0.0};
+
+   src=Column(NKSrc,10.0f,1000.0f,nij);
+   dst=Column(NKDest,5.0f,1050.0f,nij);    // Goes beyond the source on both ends
+
+   in=(float*)malloc(nij*NKSrc*sizeof(float));
+   din=(float*)malloc(nij*NKSrc*sizeof(float));
+   for(n=0;n<2;n++) {
+      out[n]=(float*)malloc(nij*NKDest*sizeof(float));
+      dout[n]=(float*)malloc(nij*NKDest*sizeof(float));
+   }
+   for(k=0;k<NKSrc;k++) {
+      for(ij=0;ij<nij;ij++) {
+         e=src->PCube[k*nij+ij];
+         in[k*nij+ij]=200.0f+10.0f*e+3.0f*sinf(e*2.0f);
+         din[k*nij+ij]=10.0f+6.0f*cosf(e*2.0f);
+      }
+   }
+
+   native=ZRefInterp_DefineOpt(dst,src,NI,NJ,ZRNATIVE|ZRLAPSERATE);
+#ifdef HAVE_RMN
+   rmn=ZRefInterp_DefineOpt(dst,src,NI,NJ,ZRLAPSERATE);
+
+   for(n=0;n<nij*NKDest;n++) {
+      if (native->Loc->Idx[n]+1!=rmn->Indexes[n]) {
+         App_Log(APP_ERROR,"Position differs at %d (%d vs %d)\n",n,native->Loc->Idx[n]+1,rmn->Indexes[n]);
+         ok=0;
+         break;
+      }
+   }
+#else
+   App_Log(APP_WARNING,"Built without RMNLIB, only the native engine is checked\n");
+#endif
+
+   for(x=0;extraps[x];x++) {
+      ZRefInterp_SetOptionOf(native,"EXTRAP_DEGREE",extraps[x]);
+      if (rmn) ZRefInterp_SetOptionOf(rmn,"EXTRAP_DEGREE",extraps[x]);
+
+      for(s=0;schemes[s];s++) {
+         ZRefInterp_SetOptionOf(native,"INTERP_DEGREE",schemes[s]);
+         t0=Now();
+         code[0]=ZRefInterp(native,out[0],in,dout[0],din,-6.5e-3f,6.5e-3f);
+         t[0]=Now()-t0;
+
+         if (rmn) {
+            ZRefInterp_SetOptionOf(rmn,"INTERP_DEGREE",schemes[s]);
+            t0=Now();
+            code[1]=ZRefInterp(rmn,out[1],in,dout[1],din,-6.5e-3f,6.5e-3f);
+            t[1]=Now()-t0;
+
+            for(n=0,emax=0.0f;n<nij*NKDest;n++) {
+               e=fabsf(out[0][n]-out[1][n])/fmaxf(1.0f,fabsf(out[1][n]));
+               emax=(isnan(e) || e>emax)?e:emax;
+            }
+            App_Log(APP_INFO,"%-9s %-16s: native %8.4f s, rmnlib %8.4f s, max relative difference %e\n",extraps[x],schemes[s],t[0],t[1],emax);
+
+            if (code[0]!=code[1]) {
+               App_Log(APP_ERROR,"%s %s: Return codes differ (native %d, rmnlib %d)\n",extraps[x],schemes[s],code[0],code[1]);
+               ok=0;
+            }
+            if (!(emax<=Tol)) {
+               App_Log(APP_ERROR,"%s %s: Results differ by more than %e\n",extraps[x],schemes[s],Tol);
+               ok=0;
+            }
+         } else {
+            App_Log(APP_INFO,"%-9s %-16s: native %8.4f s\n",extraps[x],schemes[s],t[0]);
+
+            // Without RMNLIB, at least check the return code the RMNLIB engine would give
+            if (code[0]!=(x==1?0:1)) {
+               App_Log(APP_ERROR,"%s %s: Unexpected return code %d\n",extraps[x],schemes[s],code[0]);
+               ok=0;
+            }
+         }
+      }
+   }
+
+   // Both variables at once through the locator, which must give the same result as the interpolator
+   ZRefInterp_SetOptionOf(native,"INTERP_DEGREE","LINEAR");
+   ZRefInterp(native,out[1],in,NULL,NULL,-6.5e-3f,6.5e-3f);
+   t0=Now();
+   ZRefLocator_Apply(native->Loc,(float*[]){ out[0],dout[0] },(const float**)(float*[]){ in,din },2);
+   App_Log(APP_INFO,"%-16s: native %8.4f s for 2 variables\n","LOCATOR",Now()-t0);
+   if (memcmp(out[0],out[1],nij*NKDest*sizeof(float))) {
+      App_Log(APP_ERROR,"Locator and linear interpolation differ\n");
+      ok=0;
+   }
+
+   ZRefInterp_Free(native);
+   ZRefInterp_Free(rmn);
+   ZRef_Free(src);
+   ZRef_Free(dst);
+   free(in); free(din);
+   for(n=0;n<2;n++) {
+      free(out[n]);
+      free(dout[n]);
+   }
+   return(ok);
+}
+
+int main(int argc, char *argv[]) {
+
+   int      ok=0,code=EXIT_FAILURE;
+   int      ni=1000,nj=1000,nks=80,nkd=60;
+   float    tol=1e-4f;
+
+   TApp_Arg appargs[]=
+      { { APP_INT32,  &ni,   1,             "i", "ni",     "Number of columns in I (1000)" },
+        { APP_INT32,  &nj,   1,             "j", "nj",     "Number of columns in J (1000)" },
+        { APP_INT32,  &nks,  1,             "s", "source", "Number of source levels (80)" },
+        { APP_INT32,  &nkd,  1,             "d", "dest",   "Number of destination levels (60)" },
+        { APP_FLOAT32,&tol,  1,             "t", "tol",    "Maximum relative difference between the engines (1e-4)" },
+        { 0 } };
+
+   App_Init(APP_MASTER,APP_NAME,VERSION,APP_DESC,__TIMESTAMP__);
+
+   if (!App_ParseArgs(appargs,argc,argv,APP_ARGSLOG)) {
+      exit(EXIT_FAILURE);
+   }
+
+   App_Start();
+   ok=Test(ni,nj,nks,nkd,tol);
+   code=App_End(ok?-1:EXIT_FAILURE);
+   App_Free();
+
+   exit(code);
+}